@@ -11,12 +11,15 @@
 
 #include "boomerang/core/Settings.h"
 #include "boomerang/db/Prog.h"
+#include "boomerang/passes/PassManager.h"
+#include "boomerang/ssl/type/Type.h"
 #include "boomerang/util/CFGDotWriter.h"
 #include "boomerang/util/log/Log.h"
 
 #include <QCoreApplication>
 #include <QTextStream>
 
+#include <algorithm>
 #include <iostream>
 
 
@@ -30,7 +33,6 @@ CommandlineDriver::CommandlineDriver(QObject *_parent)
     , m_kill_timer(this)
 {
     this->connect(&m_kill_timer, &QTimer::timeout, this, &CommandlineDriver::onCompilationTimeout);
-    m_project->addWatcher(m_debugger.get());
 }
 
 
@@ -44,19 +46,27 @@ static void help()
 "Usage:\n"
 "  boomerang-cli [ switches ] [ -- ] program\n"
 "  boomerang-cli -i [ command_file ]\n"
+"  boomerang-cli --daemon [ switches ]\n"
 "  boomerang-cli ( -h | --help | --version )\n"
 "\n"
 "\n"
 "Symbols\n"
 "  -s <addr> <name> : Define a symbol\n"
 "  -sf <filename>   : Read a symbol/signature file\n"
+"  --no-lib-sigs    : Do not recognize statically linked library functions by their bytes\n"
 "\n"
 "Decoding/decompilation options\n"
 "  --decode-only    : Decode only, do not decompile\n"
+"  --decode-cache   : Keep up to 65536 decoded instructions for re-decoding procedures\n"
+"                     (fixed-width instruction sets only)\n"
+"  --stream [<n>]   : Generate code for procedures as soon as they are decompiled, keeping\n"
+"                     at most n decompiled procedures (not bytes) in memory (default: 256)\n"
 "  -e <addr>        : Decode or decompile the procedure beginning at addr, and callees\n"
 "  -E <addr>        : Equivalent to -nc -e <addr>\n"
 "  -ic              : Decode through type 0 Indirect Calls\n"
-"  -S <min>         : Stop decompilation after specified number of minutes\n"
+"  -S <min>         : Stop decompilation after specified number of minutes (not in daemon mode)\n"
+"  --proc-time <s>  : Finalize procedures without further analysis after <s> seconds\n"
+"  --proc-passes <n>: Finalize procedures without further analysis after <n> passes\n"
 "  -t               : Trace (print address of) every instruction decoded\n"
 "  -a               : Assume ABI compliance\n"
 "\n"
@@ -70,10 +80,13 @@ static void help()
 "  -gc              : Generate a call graph to callgraph.dot\n"
 "  -gs              : Generate a symbol file (symbols.h)\n"
 "  -iw              : Write indirect call report to output/indirect.txt\n"
+"  --mem-report     : Log the memory used by statements and expressions after decompilation\n"
 "\n"
 "Misc.\n"
 "  -i [<file>]      : Interactive mode; execute commands from <file>, if present\n"
+"  --daemon         : Daemon mode; read jobs ([ switches ] program) from stdin, one per line\n"
 "  -P <path>        : Path to Boomerang files, defaults to the path to the Boomerang executable\n"
+"  --no-ssl-cache   : Always parse SSL files instead of reading them from the cache directory\n"
 "  -X               : activate eXperimental code; errors likely\n"
 "  --               : No effect (used for testing)\n"
 "\n"
@@ -114,6 +127,7 @@ static void usage()
 "Usage:\n"
 "  boomerang-cli [ switches ] [ -- ] program\n"
 "  boomerang-cli -i [ command_file ]\n"
+"  boomerang-cli --daemon [ switches ]\n"
 "  boomerang-cli ( -h | --help | --version )\n";
     // clang-format on
 }
@@ -122,6 +136,7 @@ static void usage()
 int CommandlineDriver::applyCommandline(const QStringList &args)
 {
     bool interactiveMode = false;
+    bool daemonMode      = false;
 
     if (args.size() < 2) {
         usage();
@@ -223,6 +238,48 @@ int CommandlineDriver::applyCommandline(const QStringList &args)
                 m_project->getSettings()->stopBeforeDecompile = true;
                 break;
             }
+            else if (arg == "--no-lib-sigs") {
+                m_project->getSettings()->matchLibSignatures = false;
+                break;
+            }
+            else if (arg == "--no-ssl-cache") {
+                m_project->getSettings()->useSSLCache = false;
+                break;
+            }
+            else if (arg == "--decode-cache") {
+                m_project->getSettings()->decodeCache = true;
+                break;
+            }
+            else if (arg == "--stream") {
+                m_project->getSettings()->streamDecompilation = true;
+
+                if ((i + 1 < args.size()) && !args[i + 1].startsWith("-")) {
+                    bool converted   = false;
+                    const int budget = args[i + 1].toInt(&converted);
+
+                    if (converted) {
+                        m_project->getSettings()->streamProcBudget = std::max(budget, 1);
+                        i++;
+                    }
+                }
+                break;
+            }
+            else if (arg == "--proc-time" && i + 1 < args.size()) {
+                m_project->getSettings()->procTimeBudget = std::max(args[++i].toInt(), 0);
+                break;
+            }
+            else if (arg == "--proc-passes" && i + 1 < args.size()) {
+                m_project->getSettings()->procPassBudget = std::max(args[++i].toInt(), 0);
+                break;
+            }
+            else if (arg == "--mem-report") {
+                m_project->getSettings()->printMemoryReport = true;
+                break;
+            }
+            else if (arg == "--daemon") {
+                daemonMode = true;
+                break;
+            }
             break;
 
         case 'i':
@@ -323,7 +380,11 @@ int CommandlineDriver::applyCommandline(const QStringList &args)
             case 'g': m_project->getSettings()->debugGen = true; break;
             case 'l': m_project->getSettings()->debugLiveness = true; break;
             case 'p': m_project->getSettings()->debugProof = true; break;
-            case 's': m_project->getSettings()->stopAtDebugPoints = true; break;
+            case 's':
+                m_project->getSettings()->stopAtDebugPoints = true;
+                m_project->addWatcher(m_debugger.get(),
+                                      watchEventMask(WatchEvent::DecompileDebugPoint));
+                break;
             case 't': m_project->getSettings()->debugTA = true; break;
             case 'u': m_project->getSettings()->debugUnused = true; break;
             default: help();
@@ -348,9 +409,22 @@ int CommandlineDriver::applyCommandline(const QStringList &args)
         }
     }
 
-    if (interactiveMode) {
+    if (m_daemonMode && (interactiveMode || daemonMode)) {
+        LOG_ERROR("Interactive and daemon mode cannot be used for daemon jobs");
+        return 1;
+    }
+    else if ((m_daemonMode || daemonMode) && minsToStopAfter > 0) {
+        // the kill timer exits the process, which would also stop the daemon
+        LOG_ERROR("-S cannot be used in daemon mode");
+        return 1;
+    }
+    else if (interactiveMode) {
         return interactiveMain();
     }
+    else if (daemonMode) {
+        m_daemonMode = true;
+        return daemonMain();
+    }
 
     if (minsToStopAfter > 0) {
         LOG_MSG("Stopping decompile after %1 minutes", minsToStopAfter);
@@ -396,6 +470,122 @@ int CommandlineDriver::interactiveMain()
 }
 
 
+/**
+ * Splits a job line into arguments at whitespace.
+ * Arguments containing whitespace can be enclosed in double quotes.
+ */
+static QStringList splitJobLine(const QString &jobLine)
+{
+    QStringList args;
+    QString current;
+    bool inQuotes = false;
+    bool hasArg   = false;
+
+    for (const QChar c : jobLine) {
+        if (c == '"') {
+            inQuotes = !inQuotes;
+            hasArg   = true;
+        }
+        else if (c.isSpace() && !inQuotes) {
+            if (hasArg) {
+                args.push_back(current);
+                current.clear();
+                hasArg = false;
+            }
+        }
+        else {
+            current += c;
+            hasArg = true;
+        }
+    }
+
+    if (hasArg) {
+        args.push_back(current);
+    }
+
+    return args;
+}
+
+
+int CommandlineDriver::daemonMain()
+{
+    // Settings given on the command line of the daemon are the defaults for all jobs
+    const Settings defaultSettings = *m_project->getSettings();
+
+    const QString daemonOutputDir = defaultSettings.getOutputDirectory().absolutePath();
+
+    Log::getOrCreateLog().addDefaultLogSinks(daemonOutputDir);
+    m_project->loadPlugins();
+
+    QTextStream strm(stdin);
+    int jobNumber = 0;
+
+    while (!strm.atEnd()) {
+        const QString line = strm.readLine().trimmed();
+
+        if (line.isEmpty()) {
+            continue;
+        }
+        else if (line == "exit" || line == "quit") {
+            break;
+        }
+
+        *m_project->getSettings() = defaultSettings;
+        const int result          = runJob(line);
+
+        resetAfterJob(daemonOutputDir);
+
+        std::cout << "job " << ++jobNumber << (result == 0 ? " done: " : " failed: ")
+                  << line.toStdString() << std::endl;
+    }
+
+    return 2;
+}
+
+
+void CommandlineDriver::resetAfterJob(const QString &daemonOutputDir)
+{
+    // Free all memory used by the job before starting the next one.
+    m_project->unloadBinaryFile();
+
+    // -ds only applies to the job that requested it
+    m_project->removeWatcher(m_debugger.get());
+
+    // Passes may keep state of the last decompilation
+    PassManager::get()->reset();
+
+    // Named types are read from the signature files and debug info of the last binary
+    Type::clearNamedTypes();
+
+    // Continue logging to the log file of the daemon
+    Log::getOrCreateLog().removeAllSinks();
+    Log::getOrCreateLog().addDefaultLogSinks(daemonOutputDir, true);
+}
+
+
+int CommandlineDriver::runJob(const QString &jobLine)
+{
+    minsToStopAfter = 0;
+    m_pathToBinary.clear();
+
+    if (applyCommandline(QStringList("boomerang-cli") + splitJobLine(jobLine)) != 0 ||
+        m_pathToBinary.isEmpty() || m_pathToBinary.startsWith('-')) {
+        LOG_ERROR("Invalid job '%1'", jobLine);
+        return 1;
+    }
+
+    // Each job gets its own log file in its output directory
+    Log::getOrCreateLog().removeAllSinks();
+    Log::getOrCreateLog().addDefaultLogSinks(
+        m_project->getSettings()->getOutputDirectory().absolutePath());
+
+    QDir wd       = m_project->getSettings()->getWorkingDirectory();
+    QFileInfo inf = QFileInfo(wd.absoluteFilePath(m_pathToBinary));
+
+    return decompile(inf.absoluteFilePath(), inf.baseName());
+}
+
+
 int CommandlineDriver::decompile()
 {
     Log::getOrCreateLog().addDefaultLogSinks(
@@ -38,7 +38,32 @@ public:
      */
     int interactiveMain();
 
+    /**
+     * Reads decompilation jobs from stdin, one job per line, and decompiles them one after another.
+     * Each job consists of command line switches followed by the program to decompile.
+     * Switches given on the command line of the daemon are the defaults for all jobs;
+     * the settings are reset to these defaults before each job. Jobs run one after another.
+     * Plugins are only loaded once for all jobs. -S is not supported in daemon mode.
+     *
+     * \retval 2 stdin was closed or the user typed exit or quit.
+     *           All jobs have already been handled, so nothing is left to decompile.
+     */
+    int daemonMain();
+
 private:
+    /**
+     * Run a single job read by daemonMain.
+     * \param jobLine the switches and the program to decompile
+     * \returns Zero on success, nonzero on failure.
+     */
+    int runJob(const QString &jobLine);
+
+    /**
+     * Undo all changes to global state made by the last job, so they do not leak into the next one.
+     * \param daemonOutputDir output directory of the daemon; logging continues there.
+     */
+    void resetAfterJob(const QString &daemonOutputDir);
+
     /**
      * Loads the executable file and decodes it.
      * \param fname The name of the file to load.
@@ -68,4 +93,5 @@ private:
     QTimer m_kill_timer;
     int minsToStopAfter = 0;
     QString m_pathToBinary;
+    bool m_daemonMode = false;
 };
@@ -14,6 +14,7 @@
 #include "boomerang/db/Prog.h"
 #include "boomerang/db/module/Module.h"
 #include "boomerang/db/proc/UserProc.h"
+#include "boomerang/decomp/IncrementalDecompiler.h"
 #include "boomerang/ifc/ICodeGenerator.h"
 #include "boomerang/util/CFGDotWriter.h"
 #include "boomerang/util/CallGraphDotWriter.h"
@@ -339,7 +340,9 @@ CommandStatus Console::handleMove(const QStringList &args)
             return CommandStatus::Failure;
         }
 
+        Module *oldModule = proc->getModule();
         proc->setModule(module);
+        m_project->getIncrementalDecompiler()->functionMoved(proc, oldModule);
     }
     else if (args[0] == "module") {
         if (args.size() < 3) {
@@ -362,6 +365,7 @@ CommandStatus Console::handleMove(const QStringList &args)
         }
 
         parentModule->addChild(module);
+        m_project->getIncrementalDecompiler()->moduleChanged(module);
     }
     else {
         std::cerr << "Unknown argument " << args[0].toStdString() << " for command 'move'."
@@ -512,6 +516,7 @@ CommandStatus Console::handleRename(const QStringList &args)
         }
 
         proc->setName(args[2]);
+        m_project->getIncrementalDecompiler()->functionRenamed(proc);
         return CommandStatus::Success;
     }
     else if (args[0] == "module") {
@@ -535,6 +540,7 @@ CommandStatus Console::handleRename(const QStringList &args)
         }
 
         module->setName(args[2]);
+        m_project->getIncrementalDecompiler()->moduleChanged(module);
         return CommandStatus::Success;
     }
     else {
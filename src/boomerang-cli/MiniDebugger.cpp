@@ -72,16 +72,12 @@ void MiniDebugger::miniDebugger(UserProc *proc, const char *description)
                 QStringList parts = line.trimmed().split(" ", QString::SkipEmptyParts);
 
                 if (parts.size() > 1) {
-                    int n = parts[1].toInt();
-                    StatementList stmts;
-                    proc->getStatements(stmts);
-                    StatementList::iterator it;
-
-                    for (it = stmts.begin(); it != stmts.end(); ++it) {
-                        if ((*it)->getNumber() == n) {
-                            watches.insert(*it);
-                            q_cout << "watching " << *it << "\n";
-                        }
+                    int n           = parts[1].toInt();
+                    Statement *stmt = proc->getStatementByNumber(n);
+
+                    if (stmt) {
+                        watches.insert(stmt);
+                        q_cout << "watching " << stmt << "\n";
                     }
                 }
             }
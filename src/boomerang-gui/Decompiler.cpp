@@ -19,13 +19,14 @@
 #include "boomerang/db/proc/LibProc.h"
 #include "boomerang/db/proc/UserProc.h"
 #include "boomerang/db/signature/Signature.h"
+#include "boomerang/decomp/IncrementalDecompiler.h"
 #include "boomerang/ifc/ICodeGenerator.h"
 #include "boomerang/ifc/IFrontEnd.h"
 #include "boomerang/ssl/type/CompoundType.h"
 #include "boomerang/ssl/type/NamedType.h"
 #include "boomerang/util/log/Log.h"
 
-#include <QThread>
+#include <QMutexLocker>
 
 
 Decompiler::Decompiler()
@@ -34,7 +35,13 @@ Decompiler::Decompiler()
     Log::getOrCreateLog().addDefaultLogSinks(
         m_project.getSettings()->getOutputDirectory().absolutePath());
 
-    m_project.addWatcher(this);
+    m_project.addWatcher(this, watchEventMask(WatchEvent::DecompileDebugPoint) |
+                                   watchEventMask(WatchEvent::FunctionDiscovered) |
+                                   watchEventMask(WatchEvent::DecompileInProgress) |
+                                   watchEventMask(WatchEvent::FunctionCreated) |
+                                   watchEventMask(WatchEvent::FunctionRemoved) |
+                                   watchEventMask(WatchEvent::SignatureUpdated) |
+                                   watchEventMask(WatchEvent::EndDecompile));
     m_project.loadPlugins();
 }
 
@@ -48,6 +55,21 @@ void Decompiler::addEntryPoint(Address entryAddr, const QString &name)
 {
     m_userEntrypoints.push_back(entryAddr);
     m_project.getLoadedBinaryFile()->getSymbols()->createSymbol(entryAddr, name);
+
+    IncrementalDecompiler *incDecompiler = m_project.getIncrementalDecompiler();
+
+    if (incDecompiler && incDecompiler->isProgDecompiled()) {
+        // Only decode and decompile the new entry point on the next decompilation
+        Prog *prog = m_project.getProg();
+
+        if (prog->decodeEntryPoint(entryAddr)) {
+            Function *func = prog->getFunctionByAddr(entryAddr);
+
+            if (func && !func->isLib()) {
+                incDecompiler->entryPointAdded(static_cast<UserProc *>(func));
+            }
+        }
+    }
 }
 
 
@@ -118,6 +140,7 @@ void Decompiler::decode()
     }
 
     LOG_MSG("Decoding finished!");
+    publishAllSnapshots();
     emit decodeCompleted();
 }
 
@@ -129,6 +152,7 @@ void Decompiler::decompile()
     LOG_MSG("Starting decompile...");
     m_project.decompileBinaryFile();
     LOG_MSG("Decompile finished!");
+    publishAllSnapshots();
 
     emit decompileCompleted();
 }
@@ -167,6 +191,7 @@ void Decompiler::generateCode()
         }
     }
 
+    publishAllSnapshots();
     LOG_MSG("Generating code completed!");
     emit generateCodeCompleted();
 }
@@ -230,39 +255,101 @@ void Decompiler::onSignatureUpdated(Function *p)
 }
 
 
-bool Decompiler::getRTLForProc(const QString &name, QString &rtl)
+void Decompiler::onEndDecompile(UserProc *proc)
+{
+    publishSnapshot(proc);
+}
+
+
+std::shared_ptr<const ProcSnapshot> Decompiler::getProcSnapshot(const QString &name) const
 {
-    Function *p = m_project.getProg()->getFunctionByName(name);
+    QMutexLocker locker(&m_snapshotMutex);
 
-    if (p->isLib()) {
+    auto it = m_procSnapshots.find(name);
+    return (it != m_procSnapshots.end()) ? it->second : nullptr;
+}
+
+
+bool Decompiler::getRTLForProc(const QString &name, QString &rtl) const
+{
+    std::shared_ptr<const ProcSnapshot> snapshot = getProcSnapshot(name);
+
+    if (!snapshot) {
         return false;
     }
 
-    UserProc *up = static_cast<UserProc *>(p);
-    OStream os(&rtl);
-    up->print(os);
+    rtl = snapshot->rtl;
     return true;
 }
 
 
+void Decompiler::publishSnapshot(UserProc *proc)
+{
+    // Print the procedure without holding the lock, so readers are never blocked by this.
+    auto snapshot = std::make_shared<ProcSnapshot>();
+    OStream os(&snapshot->rtl);
+    proc->print(os);
+
+    QMutexLocker locker(&m_snapshotMutex);
+    snapshot->version                = ++m_snapshotVersion;
+    m_procSnapshots[proc->getName()] = snapshot;
+}
+
+
+void Decompiler::publishAllSnapshots()
+{
+    for (const auto &module : m_project.getProg()->getModuleList()) {
+        for (Function *function : *module) {
+            if (!function->isLib()) {
+                publishSnapshot(static_cast<UserProc *>(function));
+            }
+        }
+    }
+}
+
+
 void Decompiler::onDecompileDebugPoint(UserProc *proc, const char *description)
 {
     LOG_VERBOSE("%1: %2", proc->getName(), description);
 
-    if (m_debugging) {
-        m_waiting = true;
-        emit debugPointHit(proc->getName(), description);
+    QMutexLocker locker(&m_debugMutex);
 
-        while (m_waiting) {
-            QThread::yieldCurrentThread();
-        }
+    if (!m_debugging) {
+        return;
+    }
+
+    // Make the current state of the procedure visible to the UI before stopping
+    locker.unlock();
+    publishSnapshot(proc);
+    locker.relock();
+
+    m_waiting = true;
+    emit debugPointHit(proc->getName(), description);
+
+    // Sleep until the UI tells us to continue, or debugging is disabled
+    while (m_waiting && m_debugging) {
+        m_debugResumed.wait(&m_debugMutex);
     }
+
+    m_waiting = false;
 }
 
 
 void Decompiler::stopWaiting()
 {
+    QMutexLocker locker(&m_debugMutex);
+
     m_waiting = false;
+    m_debugResumed.wakeAll();
+}
+
+
+void Decompiler::setDebugEnabled(bool debug)
+{
+    QMutexLocker locker(&m_debugMutex);
+
+    m_debugging = debug;
+    m_debugResumed.wakeAll();
 }
 
 
@@ -297,6 +384,15 @@ void Decompiler::renameProc(const QString &oldName, const QString &newName)
 
     if (proc) {
         proc->setName(newName);
+        m_project.getIncrementalDecompiler()->functionRenamed(proc);
+
+        QMutexLocker locker(&m_snapshotMutex);
+        auto it = m_procSnapshots.find(oldName);
+
+        if (it != m_procSnapshots.end()) {
+            m_procSnapshots[newName] = it->second;
+            m_procSnapshots.erase(oldName);
+        }
     }
 }
 
@@ -12,9 +12,14 @@
 #include "boomerang/core/Project.h"
 #include "boomerang/core/Watcher.h"
 
+#include <QMutex>
 #include <QObject>
 #include <QString>
 #include <QTableWidget>
+#include <QWaitCondition>
+
+#include <map>
+#include <memory>
 
 
 class Module;
@@ -26,6 +31,18 @@ class BinaryFile;
 Q_DECLARE_METATYPE(Address)
 
 
+/**
+ * Immutable copy of the state of a procedure, published by the decompiler thread.
+ * The UI only reads snapshots and never accesses the procedure itself,
+ * so it does not race with the decompiler thread.
+ */
+struct ProcSnapshot
+{
+    int version; ///< Increases with every snapshot published for any procedure
+    QString rtl; ///< RTLs of the procedure at the time of the snapshot
+};
+
+
 /**
  * Interface between libboomerang and the GUI.
  */
@@ -45,6 +62,7 @@ public:
     virtual void onFunctionCreated(Function *function) override;
     virtual void onFunctionRemoved(Function *function) override;
     virtual void onSignatureUpdated(Function *function) override;
+    virtual void onEndDecompile(UserProc *proc) override;
 
 signals: // Decompiler -> ui
     void loadingStarted();
@@ -85,25 +103,45 @@ public slots: // ui -> Decompiler
     void addEntryPoint(Address entryAddr, const QString &name);
     void removeEntryPoint(Address entryAddr);
 
-    // todo: provide thread-safe access mechanism
 public:
-    bool getRTLForProc(const QString &name, QString &rtl);
+    /// \returns the latest snapshot of the procedure named \p name,
+    /// or nullptr if no snapshot of it has been published yet.
+    /// Can be called from any thread.
+    std::shared_ptr<const ProcSnapshot> getProcSnapshot(const QString &name) const;
+
+    /// Get the RTLs of the latest snapshot of procedure \p name.
+    /// Can be called from any thread.
+    bool getRTLForProc(const QString &name, QString &rtl) const;
+
+    // todo: provide thread-safe access mechanism
     QString getSigFilePath(const QString &name);
     QString getClusterFile(const QString &name);
     void renameProc(const QString &oldName, const QString &newName);
     void getCompoundMembers(const QString &name, QTableWidget *tbl);
 
-    void setDebugEnabled(bool debug) { m_debugging = debug; }
+    void setDebugEnabled(bool debug);
     Project *getProject() { return &m_project; }
 
 private:
     /// After code generation, update the list of modules
     void moduleAndChildrenUpdated(Module *root);
 
+    /// Publish a new snapshot of \p proc. Must only be called from the decompiler thread.
+    void publishSnapshot(UserProc *proc);
+
+    /// Publish new snapshots of all user procedures.
+    void publishAllSnapshots();
+
 protected:
+    QMutex m_debugMutex;           ///< Protects m_debugging and m_waiting
+    QWaitCondition m_debugResumed; ///< Signalled when the decompiler may continue
     bool m_debugging = false;
     bool m_waiting   = false;
 
+    mutable QMutex m_snapshotMutex; ///< Protects m_procSnapshots and m_snapshotVersion
+    std::map<QString, std::shared_ptr<const ProcSnapshot>> m_procSnapshots;
+    int m_snapshotVersion = 0;
+
     Project m_project;
 
     std::vector<Address> m_userEntrypoints;
@@ -136,6 +136,9 @@ MainWindow::MainWindow(QWidget *_parent)
 
 MainWindow::~MainWindow()
 {
+    // Do not leave the decompiler thread sleeping at a debug point
+    m_decompiler->setDebugEnabled(false);
+
     m_decompilerThread.quit();
     m_decompilerThread.wait();
 
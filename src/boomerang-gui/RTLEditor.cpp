@@ -29,11 +29,13 @@ RTLEditor::RTLEditor(Decompiler *_decompiler, const QString &_name)
 
 void RTLEditor::updateContents()
 {
-    QString rtl;
+    std::shared_ptr<const ProcSnapshot> snapshot = decompiler->getProcSnapshot(name);
 
-    if (decompiler->getRTLForProc(name, rtl)) {
+    // Only update the text if the procedure changed since the last update
+    if (snapshot && snapshot->version != version) {
         int n = verticalScrollBar()->value();
-        setPlainText(rtl);
+        setPlainText(snapshot->rtl);
         verticalScrollBar()->setValue(n);
+        version = snapshot->version;
     }
 }
@@ -36,4 +36,5 @@ public slots:
 private:
     Decompiler *decompiler;
     QString name;
+    int version = -1; ///< Version of the currently displayed snapshot
 };
@@ -20,6 +20,7 @@
 
 #include <QBuffer>
 #include <QFile>
+#include <QHash>
 
 
 struct SectionParam
@@ -49,6 +50,14 @@ struct Translated_ElfSym
     Address Value;
 };
 
+/// A symbol read from the symbol table that has not yet been added to the BinarySymbolTable
+struct PendingElfSymbol
+{
+    Translated_ElfSym sym;
+    int symIdx; ///< index into the ELF symbol section
+    QString sourceFile;
+};
+
 typedef std::map<QString, int, std::less<QString>> StrIntMap;
 
 
@@ -321,7 +330,7 @@ bool ElfBinaryLoader::loadFromMemory(QByteArray &img)
             }
 
             if (par.sectionType == SHT_STRTAB) {
-                sect->setAttributeForRange("StringsSection", true, sect->getSourceAddr(),
+                sect->setAttributeForRange(SectionAttr::StringsSection, sect->getSourceAddr(),
                                            sect->getSourceAddr() + sect->getSize());
             }
         }
@@ -478,11 +487,8 @@ Address ElfBinaryLoader::findRelPltOffset(int i)
 }
 
 
-void ElfBinaryLoader::processSymbol(Translated_ElfSym &sym, int e_type, int i,
-                                    const QString &currentFile)
+bool ElfBinaryLoader::processSymbol(Translated_ElfSym &sym, int e_type, int i)
 {
-    bool imported              = sym.SectionIdx == SHT_NULL;
-    bool local                 = sym.Binding == STB_LOCAL || sym.Binding == STB_WEAK;
     const BinarySection *siPlt = m_binaryImage->getSectionByName(".plt");
 
     if (sym.Value.isZero() && siPlt) { // && i < max_i_for_hack) {
@@ -505,37 +511,43 @@ void ElfBinaryLoader::processSymbol(Translated_ElfSym &sym, int e_type, int i,
 
     // Ensure no overwriting (except functions)
     if (symbol != nullptr) { // TODO: if symbol already exists
-        return;
+        return false;
     }
     else if (sym.Binding == STB_WEAK && sym.Type == STT_NOTYPE) {
-        return;
+        return false;
     }
     else if (sym.Type == STT_FILE) {
-        return;
+        return false;
     }
     else if (sym.Name.isEmpty()) {
-        return;
+        return false;
     }
 
     if (sym.Value.isZero()) {
         LOG_WARN("Skipping symbol %1 with unknown location", sym.Name);
-        return;
+        return false;
     }
 
+    return true;
+}
+
+
+void ElfBinaryLoader::setSymbolAttributes(BinarySymbol *symbol, const Translated_ElfSym &sym,
+                                          int i, const QString &currentFile)
+{
     // TODO: add more symbol information here (function/export etc. ) ?
-    BinarySymbol *new_symbol(m_symbols->createSymbol(sym.Value, sym.Name, local));
-    new_symbol->setSize(elfRead4(&m_symbolSection[i].st_size));
+    symbol->setSize(elfRead4(&m_symbolSection[i].st_size));
 
-    if (imported) {
-        new_symbol->setAttribute("Imported", true);
+    if (sym.SectionIdx == SHT_NULL) {
+        symbol->setAttribute("Imported", true);
     }
 
     if (sym.Type == STT_FUNC) {
-        new_symbol->setAttribute("Function", true);
+        symbol->setAttribute("Function", true);
     }
 
     if (!currentFile.isEmpty()) {
-        new_symbol->setAttribute("SourceFile", currentFile);
+        symbol->setAttribute("SourceFile", currentFile);
     }
 }
 
@@ -576,6 +588,13 @@ void ElfBinaryLoader::addSymbolsForSection(int secIndex)
     const int numSymbols = section.Size / section.entry_size;
     QString fileName;
 
+    // Symbols are added to the symbol table in one go after all of them have been read.
+    // Symbols at the same address as a previous symbol are dropped by createSymbols().
+    std::vector<PendingElfSymbol> pendingSymbols;
+    std::vector<BinarySymbolTable::SymbolDefinition> definitions;
+    pendingSymbols.reserve(numSymbols);
+    definitions.reserve(numSymbols);
+
     // Index 0 is a dummy entry
     for (int i = 1; i < numSymbols; i++) {
         Translated_ElfSym translatedSym;
@@ -605,7 +624,22 @@ void ElfBinaryLoader::addSymbolsForSection(int secIndex)
             fileName.clear();
         }
 
-        processSymbol(translatedSym, symbolType, i, fileName);
+        if (processSymbol(translatedSym, symbolType, i)) {
+            const bool local = translatedSym.Binding == STB_LOCAL ||
+                               translatedSym.Binding == STB_WEAK;
+
+            definitions.push_back({ translatedSym.Value, translatedSym.Name, local });
+            pendingSymbols.push_back({ translatedSym, i, fileName });
+        }
+    }
+
+    const std::vector<BinarySymbol *> newSymbols = m_symbols->createSymbols(definitions);
+
+    for (std::size_t j = 0; j < newSymbols.size(); j++) {
+        if (newSymbols[j] != nullptr) {
+            setSymbolAttributes(newSymbols[j], pendingSymbols[j].sym, pendingSymbols[j].symIdx,
+                                pendingSymbols[j].sourceFile);
+        }
     }
 
     const Address addressOfMain = getMainEntryPoint();
@@ -633,6 +667,10 @@ void ElfBinaryLoader::addRelocsAsSyms(uint32_t relSecIdx)
     const int strSecIdx = m_shLink[symSecIdx];
     const int numRelocs = section.Size / section.entry_size;
 
+    // Externs are added to the symbol table in one go after processing all relocations.
+    QHash<QString, Address> newExterns;
+    std::vector<BinarySymbolTable::SymbolDefinition> definitions;
+
     // Index 0 is a dummy entry
     for (int i = 1; i < numRelocs; i++) {
         const Address val  = Address(elfRead4(&m_relocSection[i].r_offset));
@@ -667,16 +705,26 @@ void ElfBinaryLoader::addRelocsAsSyms(uint32_t relSecIdx)
         symbolName = symbolName.left(symbolName.indexOf("@@"));
 
         const BinarySymbol *symbol = m_symbols->findSymbolByName(symbolName);
-        // Add new extern
-        Address location = symbol ? symbol->getLocation() : m_nextExtern;
+        Address location           = Address::INVALID;
 
-        if (nullptr == symbol) {
-            m_symbols->createSymbol(m_nextExtern, symbolName);
+        if (symbol != nullptr) {
+            location = symbol->getLocation();
+        }
+        else if (newExterns.contains(symbolName)) {
+            location = newExterns[symbolName];
+        }
+        else {
+            // Add new extern
+            location               = m_nextExtern;
+            newExterns[symbolName] = m_nextExtern;
+            definitions.push_back({ m_nextExtern, symbolName });
             m_nextExtern += 4;
         }
 
         m_binaryImage->writeNative4(val, (location - val - 4).value());
     }
+
+    m_symbols->createSymbols(definitions);
 }
 
 
@@ -20,6 +20,7 @@ struct Elf32_Rel;
 struct Elf32_Sym;
 struct Translated_ElfSym;
 class BinaryImage;
+class BinarySymbol;
 class BinarySymbolTable;
 class QFile;
 class BinarySection;
@@ -124,7 +125,13 @@ private:
      */
     void markImports();
 
-    void processSymbol(Translated_ElfSym &sym, int e_type, int i, const QString &currentFile = "");
+    /// Fix up the value of \p sym.
+    /// \returns true if \p sym should be added to the symbol table.
+    bool processSymbol(Translated_ElfSym &sym, int e_type, int i);
+
+    /// Set size and attributes of a symbol created from \p sym.
+    void setSymbolAttributes(BinarySymbol *symbol, const Translated_ElfSym &sym, int i,
+                             const QString &currentFile);
 
 private:
     size_t m_loadedImageSize = 0;       ///< Size of image in bytes
@@ -198,12 +198,10 @@ protected:
     DWord win32Read4(const void *src) const; ///< Read 4 bytes from native addr
 
 public:
+    /// Check the debug information for statically linked library procedures.
+    /// \note Statically linked MinGW and CRT helpers are recognized by their bytes instead,
+    /// see ByteSignatureMatcher and signatures/mingw32.sig.
     bool isStaticLinkedLibProc(Address addr) const;
-    bool isMinGWsAllocStack(Address addr) const;
-    bool isMinGWsFrameInit(Address addr) const;
-    bool isMinGWsFrameEnd(Address addr) const;
-    bool isMinGWsCleanupSetup(Address addr) const;
-    bool isMinGWsMalloc(Address addr) const;
 
 protected:
     void processIAT();
@@ -221,7 +219,6 @@ private:
     PEHeader *m_peHeader; ///< Pointer to pe header
     int m_numRelocs;      ///< Number of relocation entries
     bool m_hasDebugInfo;
-    bool m_mingwMain;
 
     BinaryImage *m_binaryImage;
     BinarySymbolTable *m_symbols;
@@ -305,12 +305,13 @@ bool MachOBinaryLoader::loadFromMemory(QByteArray &img)
         sect->setHostAddr(HostAddress(base) + BMMH(segments[i].vmaddr) - loaded_addr);
         assert(sect->getHostAddr() + sect->getSize() <= HostAddress(base) + loaded_size);
 
-        unsigned long l = BMMH(segments[i].initprot);
+        unsigned long l     = BMMH(segments[i].initprot);
+        const bool readOnly = (l & VM_PROT_WRITE) == 0;
         sect->setBss(false); // TODO
         sect->setEndian((machine == Machine::PPC) ? Endian::Big : Endian::Little);
         sect->setCode((l & VM_PROT_EXECUTE) != 0);
         sect->setData((l & VM_PROT_READ) != 0);
-        sect->setReadOnly((l & VM_PROT_WRITE) == 0);
+        sect->setReadOnly(readOnly);
 
         for (size_t s_idx = 0; s_idx < sections.size(); s_idx++) {
             if (strcmp(sections[s_idx].segname, segments[i].segname) != 0) {
@@ -320,20 +321,25 @@ bool MachOBinaryLoader::loadFromMemory(QByteArray &img)
             if ((0 == strcmp(sections[s_idx].sectname, "__cfstring")) ||
                 (0 == strcmp(sections[s_idx].sectname, "__cstring"))) {
                 sect->setAttributeForRange(
-                    "StringsSection", true, Address(BMMH(sections[s_idx].addr)),
+                    SectionAttr::StringsSection, Address(BMMH(sections[s_idx].addr)),
                     Address(BMMH(sections[s_idx].addr) + BMMH(sections[s_idx].size)));
             }
 
-            sect->setAttributeForRange(
-                "ReadOnly", (BMMH(sections[i].flags) & VM_PROT_WRITE) ? true : false,
-                Address(BMMH(sections[s_idx].addr)),
-                Address(BMMH(sections[s_idx].addr) + BMMH(sections[s_idx].size)));
+            // Sections have no protection of their own; they inherit it from their segment
+            if (readOnly) {
+                sect->setAttributeForRange(
+                    SectionAttr::ReadOnly, Address(BMMH(sections[s_idx].addr)),
+                    Address(BMMH(sections[s_idx].addr) + BMMH(sections[s_idx].size)));
+            }
         }
 
         DEBUG_PRINT("loaded segment %1 %2 in mem %3 in file code=%4 data=%5 readonly=%6", a.value(),
                     sz, fsz, sect->isCode(), sect->isData(), sect->isReadOnly());
     }
 
+    // Symbols are added to the symbol table in one go after reading the stubs and the symbols.
+    std::vector<BinarySymbolTable::SymbolDefinition> definitions;
+
     // process stubs_sects
     for (unsigned j = 0; j < stubs_sects.size(); j++) {
         for (unsigned i = 0; i < BMMH(stubs_sects[j].size) / BMMH(stubs_sects[j].reserved2); i++) {
@@ -349,12 +355,12 @@ bool MachOBinaryLoader::loadFromMemory(QByteArray &img)
                 name++;
             }
 
-            BinarySymbol *sym = Symbols->createSymbol(addr, name);
-            sym->setAttribute("Function", true);
-            sym->setAttribute("Imported", true);
+            definitions.push_back({ addr, name });
         }
     }
 
+    const std::size_t numStubs = definitions.size();
+
     // process the remaining symbols
     for (unsigned i = 0; i < symbols.size(); i++) {
         char *name = &strtbl.at(BMMH(symbols[i].n_un.n_strx));
@@ -375,7 +381,16 @@ bool MachOBinaryLoader::loadFromMemory(QByteArray &img)
                 name++;
             }
 
-            Symbols->createSymbol(Address(BMMH(symbols[i].n_value)), name);
+            definitions.push_back({ Address(BMMH(symbols[i].n_value)), name });
+        }
+    }
+
+    const std::vector<BinarySymbol *> newSymbols = Symbols->createSymbols(definitions);
+
+    for (std::size_t i = 0; i < numStubs; i++) {
+        if (newSymbols[i] != nullptr) {
+            newSymbols[i]->setAttribute("Function", true);
+            newSymbols[i]->setAttribute("Imported", true);
         }
     }
 
@@ -60,11 +60,32 @@ void CCodeGenerator::generateCode(const Prog *prog, Module *cluster, UserProc *p
     const bool generate_all = cluster == nullptr || cluster == prog->getRootModule();
     bool all_procedures     = (proc == nullptr);
 
+    if (all_procedures) {
+        // Replace the code of modules that were generated completely before
+        // (e.g. when generating code again after interactive edits) instead of appending to it.
+        for (const auto &module : prog->getModuleList()) {
+            if (generate_all || module.get() == cluster) {
+                if (!m_generatedModules.insert(module.get()).second) {
+                    m_writer.restartModule(module.get());
+                    m_declaredGlobals.erase(module.get());
+                    m_declaredProcs.erase(module.get());
+                }
+            }
+        }
+    }
+
+    // Declarations written before procedures that were streamed out are not repeated.
+    const Module *declModule = generate_all ? prog->getRootModule() : cluster;
+
     if (generate_all) {
         if (proc == nullptr) {
             bool global = false;
 
             for (auto &elem : prog->getGlobals()) {
+                if (!m_declaredGlobals[declModule].insert(elem->getName()).second) {
+                    continue;
+                }
+
                 // Check for an initial value
                 SharedExp e = elem->getInitialValue();
                 // if (e) {
@@ -79,20 +100,24 @@ void CCodeGenerator::generateCode(const Prog *prog, Module *cluster, UserProc *p
     }
 
     // First declare prototypes
-    for (const auto &module : prog->getModuleList()) {
-        for (Function *func : *module) {
-            if (func->isLib()) {
-                continue;
-            }
+    if (all_procedures) {
+        for (const auto &module : prog->getModuleList()) {
+            for (Function *func : *module) {
+                if (func->isLib()) {
+                    continue;
+                }
 
-            UserProc *_proc = static_cast<UserProc *>(func);
-            addPrototype(_proc); // May be the wrong signature if up has ellipsis
+                UserProc *_proc = static_cast<UserProc *>(func);
+                if (m_declaredProcs[declModule].insert(_proc).second) {
+                    addPrototype(_proc); // May be the wrong signature if up has ellipsis
+                }
+            }
         }
-    }
 
-    if (generate_all) {
-        appendLine(""); // Separate prototype(s) from first proc
-        print(prog->getRootModule());
+        if (generate_all) {
+            appendLine(""); // Separate prototype(s) from first proc
+            print(prog->getRootModule());
+        }
     }
 
     for (const auto &module : prog->getModuleList()) {
@@ -107,14 +132,18 @@ void CCodeGenerator::generateCode(const Prog *prog, Module *cluster, UserProc *p
 
             UserProc *_proc = static_cast<UserProc *>(func);
 
-            if (!_proc->isDecoded()) {
-                continue;
+            if (!_proc->isDecoded() || _proc->isStateReleased()) {
+                continue; // Body was already written when the proc was streamed out
             }
 
             if (!all_procedures && (proc != _proc)) {
                 continue;
             }
 
+            if (!all_procedures) {
+                addMissingDeclarations(prog, _proc);
+            }
+
             CFGCompressor().compressCFG(_proc->getCFG());
 
             generateCode(_proc);
@@ -413,6 +442,38 @@ void CCodeGenerator::addPrototype(UserProc *proc)
 }
 
 
+void CCodeGenerator::addMissingDeclarations(const Prog *prog, UserProc *proc)
+{
+    const Module *module = proc->getModule();
+    bool declared        = false;
+
+    // All globals the procedure uses exist by now, but later procedures may add more.
+    for (auto &global : prog->getGlobals()) {
+        if (m_declaredGlobals[module].insert(global->getName()).second) {
+            addGlobal(global->getName(), global->getType(), global->getInitialValue());
+            declared = true;
+        }
+    }
+
+    // The definition of the procedure declares it as well.
+    std::set<const UserProc *> &declaredProcs = m_declaredProcs[module];
+    declaredProcs.insert(proc);
+
+    // Callees are decompiled before their callers, so their signatures are final.
+    for (Function *callee : proc->getCallees()) {
+        if (!callee->isLib() && declaredProcs.insert(static_cast<UserProc *>(callee)).second) {
+            addPrototype(static_cast<UserProc *>(callee));
+            declared = true;
+        }
+    }
+
+    if (declared) {
+        appendLine(""); // Separate declarations from the procedure
+        print(module);
+    }
+}
+
+
 void CCodeGenerator::generateCode(UserProc *proc)
 {
     m_lines.clear();
@@ -879,6 +940,10 @@ void CCodeGenerator::addProcStart(UserProc *proc)
 
     s << "/** address: " << proc->getEntryAddress() << " */";
     appendLine(tgt);
+
+    if (!proc->getDecompileNote().isEmpty()) {
+        appendLine("/** " + proc->getDecompileNote() + " */");
+    }
     addFunctionSignature(proc, true);
 }
 
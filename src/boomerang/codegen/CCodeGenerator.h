@@ -20,6 +20,7 @@
 
 #include <list>
 #include <map>
+#include <set>
 #include <unordered_set>
 
 
@@ -114,6 +115,13 @@ private:
     /// Add a prototype (for forward declaration)
     void addPrototype(UserProc *proc);
 
+    /**
+     * Declare the globals of \p prog and the callees of \p proc that were not declared
+     * in the output of the module of \p proc yet. Used when code is generated
+     * for a single procedure at a time (e.g. when streaming).
+     */
+    void addMissingDeclarations(const Prog *prog, UserProc *proc);
+
     /// Generate code for a single procedure.
     void generateCode(UserProc *proc);
 
@@ -304,4 +312,13 @@ private:
 
     CodeWriter m_writer;
     QStringList m_lines; ///< The generated code.
+
+    /// Modules whose code was generated completely (i.e. for all procedures) at least once.
+    std::set<const Module *> m_generatedModules;
+
+    /// Names of the globals declared in the current output of each module.
+    std::map<const Module *, std::set<QString>> m_declaredGlobals;
+
+    /// Procedures declared or defined in the current output of each module.
+    std::map<const Module *, std::set<const UserProc *>> m_declaredProcs;
 };
@@ -53,5 +53,12 @@ bool CodeWriter::writeCode(const Module *module, const QStringList &lines)
 
     assert(it != m_dests.end());
     it->second.m_os << lines.join('\n') << '\n';
+    it->second.m_os.flush(); // procedures may be written one at a time while decompiling
     return true;
 }
+
+
+void CodeWriter::restartModule(const Module *module)
+{
+    m_dests.erase(module);
+}
@@ -43,6 +43,10 @@ class CodeWriter
 public:
     bool writeCode(const Module *module, const QStringList &lines);
 
+    /// Close the output file of \p module.
+    /// The next write to it will start the file from scratch.
+    void restartModule(const Module *module);
+
 private:
     WriteDestMap m_dests;
 };
@@ -11,7 +11,9 @@
 
 #include "boomerang/db/BasicBlock.h"
 #include "boomerang/db/proc/ProcCFG.h"
-#include "boomerang/util/log/Log.h"
+#include "boomerang/util/Util.h"
+
+#include <algorithm>
 
 
 ControlFlowAnalyzer::ControlFlowAnalyzer()
@@ -23,6 +25,8 @@ void ControlFlowAnalyzer::structureCFG(ProcCFG *cfg)
 {
     m_cfg = cfg;
 
+    numberBlocks();
+
     if (m_cfg->findRetNode() == nullptr) {
         return;
     }
@@ -38,165 +42,231 @@ void ControlFlowAnalyzer::structureCFG(ProcCFG *cfg)
 }
 
 
+void ControlFlowAnalyzer::numberBlocks()
+{
+    const std::size_t numBBs = m_cfg->getNumBBs();
+
+    m_blocks.clear();
+    m_indices.clear();
+    m_postOrdering.clear();
+    m_revPostOrdering.clear();
+
+    m_blocks.reserve(numBBs);
+    m_indices.reserve(numBBs);
+
+    for (const BasicBlock *bb : *m_cfg) {
+        m_indices[bb] = static_cast<int>(m_blocks.size());
+        m_blocks.push_back(bb);
+    }
+
+    m_info.assign(numBBs, BBStructInfo());
+    m_successors.assign(numBBs, {});
+    m_predecessors.assign(numBBs, {});
+
+    for (std::size_t i = 0; i < numBBs; i++) {
+        for (const BasicBlock *succ : m_blocks[i]->getSuccessors()) {
+            assert(bbToIndex(succ) != -1);
+            m_successors[i].push_back(bbToIndex(succ));
+        }
+
+        for (const BasicBlock *pred : m_blocks[i]->getPredecessors()) {
+            assert(bbToIndex(pred) != -1);
+            m_predecessors[i].push_back(bbToIndex(pred));
+        }
+    }
+}
+
+
+int ControlFlowAnalyzer::bbToIndex(const BasicBlock *bb) const
+{
+    auto it = m_indices.find(bb);
+    return it != m_indices.end() ? it->second : -1;
+}
+
+
+int ControlFlowAnalyzer::getSuccessor(int bb, int i) const
+{
+    if (!Util::inRange(i, 0, static_cast<int>(m_successors[bb].size()))) {
+        return -1;
+    }
+
+    return m_successors[bb][i];
+}
+
+
+const BBStructInfo &ControlFlowAnalyzer::getInfo(const BasicBlock *bb) const
+{
+    static const BBStructInfo noInfo;
+
+    const int idx = bbToIndex(bb);
+    return idx != -1 ? m_info[idx] : noInfo;
+}
+
+
+BBStructInfo &ControlFlowAnalyzer::getInfo(const BasicBlock *bb)
+{
+    const int idx = bbToIndex(bb);
+    assert(idx != -1);
+    return m_info[idx];
+}
+
+
 void ControlFlowAnalyzer::setTimeStamps()
 {
+    const int entry = bbToIndex(findEntryBB());
+    assert(entry != -1);
+
     // set the parenthesis for the nodes as well as setting the post-order ordering between the
     // nodes
     int time = 1;
     m_postOrdering.clear();
 
-    updateLoopStamps(findEntryBB(), time);
+    updateLoopStamps(entry, time);
 
     // set the reverse parenthesis for the nodes
     time = 1;
-    updateRevLoopStamps(findEntryBB(), time);
-
-    BasicBlock *retNode = findExitBB();
-    assert(retNode);
-    m_revPostOrdering.clear();
-    updateRevOrder(retNode);
+    updateRevLoopStamps(entry, time);
 }
 
 
 void ControlFlowAnalyzer::updateImmedPDom()
 {
-    // traverse the nodes in order (i.e from the bottom up)
-    for (int i = m_revPostOrdering.size() - 1; i >= 0; i--) {
-        const BasicBlock *bb = m_revPostOrdering[i];
+    const int exitNode = bbToIndex(findExitBB());
+    assert(exitNode != -1);
 
-        for (BasicBlock *succ : bb->getSuccessors()) {
-            if (getRevOrd(succ) > getRevOrd(bb)) {
-                setImmPDom(bb, findCommonPDom(getImmPDom(bb), succ));
-            }
-        }
-    }
+    // Order the nodes according to a DFS of the reverse graph. Nodes that cannot reach the exit
+    // node become additional roots, i.e. they are successors of the virtual exit node.
+    // Prefer dead ends (e.g. calls to noreturn functions), then the deepest remaining node
+    // (usually the latch of an endless loop).
+    std::vector<bool> isRoot(m_blocks.size(), false);
 
-    // make a second pass but consider the original CFG ordering this time
-    for (const BasicBlock *bb : m_postOrdering) {
-        if (bb->getNumSuccessors() <= 1) {
-            continue;
+    m_revPostOrdering.clear();
+    isRoot[exitNode] = true;
+    updateRevOrder(exitNode);
+
+    for (int node : m_postOrdering) {
+        if (m_successors[node].empty() && (m_info[node].m_travType != TravType::DFS_PDom)) {
+            isRoot[node] = true;
+            updateRevOrder(node);
         }
+    }
 
-        for (auto &succ : bb->getSuccessors()) {
-            BasicBlock *succNode = succ;
-            setImmPDom(bb, findCommonPDom(getImmPDom(bb), succNode));
+    for (int node : m_postOrdering) {
+        if (m_info[node].m_travType != TravType::DFS_PDom) {
+            isRoot[node] = true;
+            updateRevOrder(node);
         }
     }
 
-    // one final pass to fix up nodes involved in a loop
-    for (const BasicBlock *bb : m_postOrdering) {
-        if (bb->getNumSuccessors() > 1) {
-            for (auto &succ : bb->getSuccessors()) {
-                BasicBlock *succNode = succ;
+    // The virtual exit node comes last in the post ordering.
+    const int virtualExit = static_cast<int>(m_blocks.size());
+    std::vector<int> pdom(m_blocks.size() + 1, -1);
+    pdom[virtualExit] = virtualExit;
 
-                if (isBackEdge(bb, succNode) && (bb->getNumSuccessors() > 1) &&
-                    getImmPDom(succNode) &&
-                    (getPostOrdering(getImmPDom(succ)) < getPostOrdering(getImmPDom(bb)))) {
-                    setImmPDom(bb, findCommonPDom(getImmPDom(succNode), getImmPDom(bb)));
-                }
-                else {
-                    setImmPDom(bb, findCommonPDom(getImmPDom(bb), succNode));
-                }
+    auto revOrd = [this, virtualExit](int node) {
+        return node == virtualExit ? static_cast<int>(m_revPostOrdering.size())
+                                   : m_info[node].m_revPostOrderIndex;
+    };
+
+    auto intersect = [&pdom, &revOrd](int node1, int node2) {
+        while (node1 != node2) {
+            while (revOrd(node1) < revOrd(node2)) {
+                node1 = pdom[node1];
+            }
+
+            while (revOrd(node2) < revOrd(node1)) {
+                node2 = pdom[node2];
             }
         }
-    }
-}
 
+        return node1;
+    };
 
-const BasicBlock *ControlFlowAnalyzer::findCommonPDom(const BasicBlock *currImmPDom,
-                                                      const BasicBlock *succImmPDom)
-{
-    if (!currImmPDom) {
-        return succImmPDom;
-    }
+    bool changed = true;
 
-    if (!succImmPDom) {
-        return currImmPDom;
-    }
+    while (changed) {
+        changed = false;
 
-    if (getRevOrd(currImmPDom) == getRevOrd(succImmPDom)) {
-        return currImmPDom; // ordering hasn't been done
-    }
+        // traverse the nodes in reverse post order of the reverse graph
+        for (auto it = m_revPostOrdering.rbegin(); it != m_revPostOrdering.rend(); ++it) {
+            const int node = *it;
+            int newPDom    = isRoot[node] ? virtualExit : -1;
 
-    const BasicBlock *oldCurImmPDom  = currImmPDom;
-    const BasicBlock *oldSuccImmPDom = succImmPDom;
+            for (int succ : m_successors[node]) {
+                if (pdom[succ] == -1) {
+                    continue; // not processed yet
+                }
 
-    int giveup = 0;
-#define GIVEUP 10000
+                newPDom = (newPDom == -1) ? succ : intersect(succ, newPDom);
+            }
 
-    while (giveup < GIVEUP && currImmPDom && succImmPDom && (currImmPDom != succImmPDom)) {
-        if (getRevOrd(currImmPDom) > getRevOrd(succImmPDom)) {
-            succImmPDom = getImmPDom(succImmPDom);
-        }
-        else {
-            currImmPDom = getImmPDom(currImmPDom);
+            if (newPDom != pdom[node]) {
+                pdom[node] = newPDom;
+                changed    = true;
+            }
         }
-
-        giveup++;
     }
 
-    if (giveup >= GIVEUP) {
-        LOG_VERBOSE("Failed to find commonPDom for %1 and %2", oldCurImmPDom->getLowAddr(),
-                    oldSuccImmPDom->getLowAddr());
-
-        return oldCurImmPDom; // no change
+    for (int node : m_revPostOrdering) {
+        m_info[node].m_immPDom = (pdom[node] != virtualExit) ? pdom[node] : -1;
     }
-
-    return currImmPDom;
 }
 
 
 void ControlFlowAnalyzer::structConds()
 {
     // Process the nodes in order
-    for (const BasicBlock *currNode : m_postOrdering) {
-        if (currNode->getNumSuccessors() <= 1) {
+    for (int currNode : m_postOrdering) {
+        if (m_successors[currNode].size() <= 1) {
             // not an if/case condition
             continue;
         }
 
         // if the current conditional header is a two way node and has a back edge, then it
         // won't have a follow
-        if (hasBackEdge(currNode) && (currNode->getType() == BBType::Twoway)) {
+        if (hasBackEdge(currNode) && (m_blocks[currNode]->getType() == BBType::Twoway)) {
             setStructType(currNode, StructType::Cond);
             continue;
         }
 
         // set the follow of a node to be its immediate post dominator
-        setCondFollow(currNode, getImmPDom(currNode));
+        m_info[currNode].m_condFollow = m_info[currNode].m_immPDom;
 
         // set the structured type of this node
         setStructType(currNode, StructType::Cond);
 
         // if this is an nway header, then we have to tag each of the nodes within the body of
         // the nway subgraph
-        if (getCondType(currNode) == CondType::Case) {
-            setCaseHead(currNode, currNode, getCondFollow(currNode));
+        if (m_info[currNode].m_conditionHeaderType == CondType::Case) {
+            setCaseHead(currNode, currNode, m_info[currNode].m_condFollow);
         }
     }
 }
 
 
-void ControlFlowAnalyzer::determineLoopType(const BasicBlock *header, bool *&loopNodes)
+void ControlFlowAnalyzer::determineLoopType(int header, const std::vector<bool> &loopNodes)
 {
-    assert(getLatchNode(header));
+    const int latch = m_info[header].m_latchNode;
+    assert(latch != -1);
 
     // if the latch node is a two way node then this must be a post tested loop
-    if (getLatchNode(header)->getType() == BBType::Twoway) {
+    if (m_blocks[latch]->getType() == BBType::Twoway) {
         setLoopType(header, LoopType::PostTested);
 
         // if the head of the loop is a two way node and the loop spans more than one block  then it
         // must also be a conditional header
-        if ((header->getType() == BBType::Twoway) && (header != getLatchNode(header))) {
+        if ((m_blocks[header]->getType() == BBType::Twoway) && (header != latch)) {
             setStructType(header, StructType::LoopCond);
         }
     }
     // otherwise it is either a pretested or endless loop
-    else if (header->getType() == BBType::Twoway) {
+    else if (m_blocks[header]->getType() == BBType::Twoway) {
         // if the header is a two way node then it must have a conditional follow (since it can't
         // have any backedges leading from it). If this follow is within the loop then this must be
         // an endless loop
-        if (getCondFollow(header) && loopNodes[getPostOrdering(getCondFollow(header))]) {
+        const int condFollow = m_info[header].m_condFollow;
+
+        if ((condFollow != -1) && loopNodes[m_info[condFollow].m_postOrderIndex]) {
             setLoopType(header, LoopType::Endless);
 
             // retain the fact that this is also a conditional header
@@ -213,41 +283,45 @@ void ControlFlowAnalyzer::determineLoopType(const BasicBlock *header, bool *&loo
 }
 
 
-void ControlFlowAnalyzer::findLoopFollow(const BasicBlock *header, bool *&loopNodes)
+void ControlFlowAnalyzer::findLoopFollow(int header, const std::vector<bool> &loopNodes)
 {
-    assert(getStructType(header) == StructType::Loop ||
-           getStructType(header) == StructType::LoopCond);
-    const LoopType loopType = getLoopType(header);
-    const BasicBlock *latch = getLatchNode(header);
+    assert(m_info[header].m_structuringType == StructType::Loop ||
+           m_info[header].m_structuringType == StructType::LoopCond);
+    const LoopType loopType = m_info[header].m_loopHeaderType;
+    const int latch         = m_info[header].m_latchNode;
+
+    auto isInLoop = [this, &loopNodes](int node) {
+        return loopNodes[m_info[node].m_postOrderIndex];
+    };
 
     if (loopType == LoopType::PreTested) {
         // if the 'while' loop's true child is within the loop, then its false child is the loop
         // follow
-        if (loopNodes[getPostOrdering(header->getSuccessor(BTHEN))]) {
-            setLoopFollow(header, header->getSuccessor(BELSE));
+        if (isInLoop(getSuccessor(header, BTHEN))) {
+            m_info[header].m_loopFollow = getSuccessor(header, BELSE);
         }
         else {
-            setLoopFollow(header, header->getSuccessor(BTHEN));
+            m_info[header].m_loopFollow = getSuccessor(header, BTHEN);
         }
     }
     else if (loopType == LoopType::PostTested) {
         // the follow of a post tested ('repeat') loop is the node on the end of the non-back edge
         // from the latch node
-        if (latch->getSuccessor(BELSE) == header) {
-            setLoopFollow(header, latch->getSuccessor(BTHEN));
+        if (getSuccessor(latch, BELSE) == header) {
+            m_info[header].m_loopFollow = getSuccessor(latch, BTHEN);
         }
         else {
-            setLoopFollow(header, latch->getSuccessor(BELSE));
+            m_info[header].m_loopFollow = getSuccessor(latch, BELSE);
         }
     }
     else {
         // endless loop
-        const BasicBlock *follow = nullptr;
+        int follow = -1;
 
         // traverse the ordering array between the header and latch nodes.
-        // BasicBlock * latch = header->getLatchNode(); initialized at function start
-        for (int i = getPostOrdering(header) - 1; i > getPostOrdering(latch); i--) {
-            const BasicBlock *&desc = m_postOrdering[i];
+        for (int i = m_info[header].m_postOrderIndex - 1; i > m_info[latch].m_postOrderIndex;
+             i--) {
+            const int desc = m_postOrdering[i];
             // the follow for an endless loop will have the following
             // properties:
             //   i) it will have a parent that is a conditional header inside the loop whose follow
@@ -256,13 +330,15 @@ void ControlFlowAnalyzer::findLoopFollow(const BasicBlock *header, bool *&loopNo
             //  ii) it will be outside the loop according to its loop stamp pair
             // iii) have the highest ordering of all suitable follows (i.e. highest in the graph)
 
-            if ((getStructType(desc) == StructType::Cond) && getCondFollow(desc) &&
-                (getLoopHead(desc) == header)) {
-                if (loopNodes[getPostOrdering(getCondFollow(desc))]) {
+            const int descFollow = m_info[desc].m_condFollow;
+
+            if ((m_info[desc].m_structuringType == StructType::Cond) && (descFollow != -1) &&
+                (m_info[desc].m_loopHead == header)) {
+                if (isInLoop(descFollow)) {
                     // if the conditional's follow is in the same loop AND is lower in the loop,
                     // jump to this follow
-                    if (getPostOrdering(desc) > getPostOrdering(getCondFollow(desc))) {
-                        i = getPostOrdering(getCondFollow(desc));
+                    if (m_info[desc].m_postOrderIndex > m_info[descFollow].m_postOrderIndex) {
+                        i = m_info[descFollow].m_postOrderIndex;
                     }
                     else {
                         // otherwise there is a backward jump somewhere to a node earlier in this
@@ -274,20 +350,22 @@ void ControlFlowAnalyzer::findLoopFollow(const BasicBlock *header, bool *&loopNo
                 else {
                     // otherwise find the child (if any) of the conditional header that isn't inside
                     // the same loop
-                    const BasicBlock *succ = desc->getSuccessor(BTHEN);
+                    int succ = getSuccessor(desc, BTHEN);
 
-                    if (loopNodes[getPostOrdering(succ)]) {
-                        if (!loopNodes[getPostOrdering(desc->getSuccessor(BELSE))]) {
-                            succ = desc->getSuccessor(BELSE);
+                    if (isInLoop(succ)) {
+                        if (!isInLoop(getSuccessor(desc, BELSE))) {
+                            succ = getSuccessor(desc, BELSE);
                         }
                         else {
-                            succ = nullptr;
+                            succ = -1;
                         }
                     }
 
                     // if a potential follow was found, compare its ordering with the currently
                     // found follow
-                    if (succ && (!follow || (getPostOrdering(succ) > getPostOrdering(follow)))) {
+                    if ((succ != -1) &&
+                        ((follow == -1) ||
+                         (m_info[succ].m_postOrderIndex > m_info[follow].m_postOrderIndex))) {
                         follow = succ;
                     }
                 }
@@ -296,14 +374,14 @@ void ControlFlowAnalyzer::findLoopFollow(const BasicBlock *header, bool *&loopNo
 
         // if a follow was found, assign it to be the follow of the loop under
         // investigation
-        if (follow) {
-            setLoopFollow(header, follow);
+        if (follow != -1) {
+            m_info[header].m_loopFollow = follow;
         }
     }
 }
 
 
-void ControlFlowAnalyzer::tagNodesInLoop(const BasicBlock *header, bool *&loopNodes)
+void ControlFlowAnalyzer::tagNodesInLoop(int header, std::vector<bool> &loopNodes)
 {
     // traverse the ordering structure from the header to the latch node tagging the nodes
     // determined to be within the loop. These are nodes that satisfy the following:
@@ -315,15 +393,15 @@ void ControlFlowAnalyzer::tagNodesInLoop(const BasicBlock *header, bool *&loopNo
     //    OR
     //  iii) curNode is the latch node
 
-    const BasicBlock *latch = getLatchNode(header);
-    assert(latch);
+    const int latch = m_info[header].m_latchNode;
+    assert(latch != -1);
 
-    for (int i = getPostOrdering(header) - 1; i >= getPostOrdering(latch); i--) {
+    for (int i = m_info[header].m_postOrderIndex - 1; i >= m_info[latch].m_postOrderIndex; i--) {
         if (isBBInLoop(m_postOrdering[i], header, latch)) {
             // update the membership map to reflect that this node is within the loop
             loopNodes[i] = true;
 
-            setLoopHead(m_postOrdering[i], header);
+            m_info[m_postOrdering[i]].m_loopHead = header;
         }
     }
 }
@@ -331,9 +409,12 @@ void ControlFlowAnalyzer::tagNodesInLoop(const BasicBlock *header, bool *&loopNo
 
 void ControlFlowAnalyzer::structLoops()
 {
+    // maps each node (by its post ordering index) to whether or not it is within the current loop
+    std::vector<bool> loopNodes(m_postOrdering.size(), false);
+
     for (int i = m_postOrdering.size() - 1; i >= 0; i--) {
-        const BasicBlock *currNode = m_postOrdering[i]; // the current node under investigation
-        const BasicBlock *latch    = nullptr;           // the latching node of the loop
+        const int currNode = m_postOrdering[i]; // the current node under investigation
+        int latch          = -1;                // the latching node of the loop
 
         // If the current node has at least one back edge into it, it is a loop header. If there are
         // numerous back edges into the header, determine which one comes form the proper latching
@@ -346,34 +427,30 @@ void ControlFlowAnalyzer::structLoops()
         //    vi) has a lower ordering than all other suitable candiates
         // If no nodes meet the above criteria, then the current node is not a loop header
 
-        for (const BasicBlock *pred : currNode->getPredecessors()) {
-            if ((getCaseHead(pred) == getCaseHead(currNode)) &&                      // ii)
-                (getLoopHead(pred) == getLoopHead(currNode)) &&                      // iii)
-                (!latch || (getPostOrdering(latch) > getPostOrdering(pred))) &&      // vi)
-                !(getLoopHead(pred) && (getLatchNode(getLoopHead(pred)) == pred)) && // v)
-                isBackEdge(pred, currNode)) {                                        // i)
+        for (int pred : m_predecessors[currNode]) {
+            const int predLoopHead = m_info[pred].m_loopHead;
+
+            if ((m_info[pred].m_caseHead == m_info[currNode].m_caseHead) && // ii)
+                (predLoopHead == m_info[currNode].m_loopHead) &&             // iii)
+                ((latch == -1) ||
+                 (m_info[latch].m_postOrderIndex > m_info[pred].m_postOrderIndex)) && // vi)
+                !((predLoopHead != -1) && (m_info[predLoopHead].m_latchNode == pred)) && // v)
+                isBackEdge(pred, currNode)) {                                             // i)
                 latch = pred;
             }
         }
 
         // if a latching node was found for the current node then it is a loop header.
-        if (!latch) {
+        if (latch == -1) {
             continue;
         }
 
-        // define the map that maps each node to whether or not it is within the current loop
-        bool *loopNodes = new bool[m_postOrdering.size()];
-
-        for (unsigned int j = 0; j < m_postOrdering.size(); j++) {
-            loopNodes[j] = false;
-        }
-
-        setLatchNode(currNode, latch);
+        m_info[currNode].m_latchNode = latch;
 
         // the latching node may already have been structured as a conditional header. If it is
         // not also the loop header (i.e. the loop is over more than one block) then reset it to
         // be a sequential node otherwise it will be correctly set as a loop header only later
-        if ((latch != currNode) && (getStructType(latch) == StructType::Cond)) {
+        if ((latch != currNode) && (m_info[latch].m_structuringType == StructType::Cond)) {
             setStructType(latch, StructType::Seq);
         }
 
@@ -389,31 +466,36 @@ void ControlFlowAnalyzer::structLoops()
         // calculate the follow node of this loop
         findLoopFollow(currNode, loopNodes);
 
-        delete[] loopNodes;
+        // Only nodes between the header and the latch in the post ordering can be tagged,
+        // so only reset these for the next loop.
+        std::fill(loopNodes.begin() + m_info[latch].m_postOrderIndex,
+                  loopNodes.begin() + m_info[currNode].m_postOrderIndex + 1, false);
     }
 }
 
 
 void ControlFlowAnalyzer::checkConds()
 {
-    for (const BasicBlock *currNode : m_postOrdering) {
+    for (int currNode : m_postOrdering) {
+        BBStructInfo &currInfo = m_info[currNode];
+
         // consider only conditional headers that have a follow and aren't case headers
-        if (((getStructType(currNode) == StructType::Cond) ||
-             (getStructType(currNode) == StructType::LoopCond)) &&
-            getCondFollow(currNode) && (getCondType(currNode) != CondType::Case)) {
+        if (((currInfo.m_structuringType == StructType::Cond) ||
+             (currInfo.m_structuringType == StructType::LoopCond)) &&
+            (currInfo.m_condFollow != -1) && (currInfo.m_conditionHeaderType != CondType::Case)) {
             // define convenient aliases for the relevant loop and case heads and the out edges
-            const BasicBlock *myLoopHead = (getStructType(currNode) == StructType::LoopCond)
-                                               ? currNode
-                                               : getLoopHead(currNode);
-            const BasicBlock *follLoopHead = getLoopHead(getCondFollow(currNode));
-            const BasicBlock *bbThen       = currNode->getSuccessor(BTHEN);
-            const BasicBlock *bbElse       = currNode->getSuccessor(BELSE);
+            const int myLoopHead   = (currInfo.m_structuringType == StructType::LoopCond)
+                                         ? currNode
+                                         : currInfo.m_loopHead;
+            const int follLoopHead = m_info[currInfo.m_condFollow].m_loopHead;
+            const int bbThen       = getSuccessor(currNode, BTHEN);
+            const int bbElse       = getSuccessor(currNode, BELSE);
 
             // analyse whether this is a jump into/outof a loop
             if (myLoopHead != follLoopHead) {
                 // we want to find the branch that the latch node is on for a jump out of a loop
-                if (myLoopHead) {
-                    const BasicBlock *myLoopLatch = getLatchNode(myLoopHead);
+                if (myLoopHead != -1) {
+                    const int myLoopLatch = m_info[myLoopHead].m_latchNode;
 
                     // does the then branch goto the loop latch?
                     if (isBackEdge(bbThen, myLoopLatch)) {
@@ -427,7 +509,8 @@ void ControlFlowAnalyzer::checkConds()
                     }
                 }
 
-                if ((getUnstructType(currNode) == UnstructType::Structured) && follLoopHead) {
+                if ((currInfo.m_unstructuredType == UnstructType::Structured) &&
+                    (follLoopHead != -1)) {
                     // find the branch that the loop head is on for a jump into a loop body. If a
                     // branch has already been found, then it will match this one anyway
 
@@ -446,20 +529,21 @@ void ControlFlowAnalyzer::checkConds()
 
             // this is a jump into a case body if either of its children don't have the same same
             // case header as itself
-            if ((getUnstructType(currNode) == UnstructType::Structured) &&
-                ((getCaseHead(currNode) != getCaseHead(bbThen)) ||
-                 (getCaseHead(currNode) != getCaseHead(bbElse)))) {
-                const BasicBlock *myCaseHead   = getCaseHead(currNode);
-                const BasicBlock *thenCaseHead = getCaseHead(bbThen);
-                const BasicBlock *elseCaseHead = getCaseHead(bbElse);
+            if ((currInfo.m_unstructuredType == UnstructType::Structured) &&
+                ((currInfo.m_caseHead != m_info[bbThen].m_caseHead) ||
+                 (currInfo.m_caseHead != m_info[bbElse].m_caseHead))) {
+                const int myCaseHead   = currInfo.m_caseHead;
+                const int thenCaseHead = m_info[bbThen].m_caseHead;
+                const int elseCaseHead = m_info[bbElse].m_caseHead;
 
                 if ((thenCaseHead == myCaseHead) &&
-                    (!myCaseHead || (elseCaseHead != getCondFollow(myCaseHead)))) {
+                    ((myCaseHead == -1) || (elseCaseHead != m_info[myCaseHead].m_condFollow))) {
                     setUnstructType(currNode, UnstructType::JumpIntoCase);
                     setCondType(currNode, CondType::IfElse);
                 }
                 else if ((elseCaseHead == myCaseHead) &&
-                         (!myCaseHead || (thenCaseHead != getCondFollow(myCaseHead)))) {
+                         ((myCaseHead == -1) ||
+                          (thenCaseHead != m_info[myCaseHead].m_condFollow))) {
                     setUnstructType(currNode, UnstructType::JumpIntoCase);
                     setCondType(currNode, CondType::IfThen);
                 }
@@ -469,18 +553,18 @@ void ControlFlowAnalyzer::checkConds()
         // for 2 way conditional headers that don't have a follow (i.e. are the source of a back
         // edge) and haven't been structured as latching nodes, set their follow to be the non-back
         // edge child.
-        if ((getStructType(currNode) == StructType::Cond) && !getCondFollow(currNode) &&
-            (getCondType(currNode) != CondType::Case) &&
-            (getUnstructType(currNode) == UnstructType::Structured)) {
+        if ((currInfo.m_structuringType == StructType::Cond) && (currInfo.m_condFollow == -1) &&
+            (currInfo.m_conditionHeaderType != CondType::Case) &&
+            (currInfo.m_unstructuredType == UnstructType::Structured)) {
             // latching nodes will already have been reset to Seq structured type
             if (hasBackEdge(currNode)) {
-                if (isBackEdge(currNode, currNode->getSuccessor(BTHEN))) {
+                if (isBackEdge(currNode, getSuccessor(currNode, BTHEN))) {
                     setCondType(currNode, CondType::IfThen);
-                    setCondFollow(currNode, currNode->getSuccessor(BELSE));
+                    currInfo.m_condFollow = getSuccessor(currNode, BELSE);
                 }
                 else {
                     setCondType(currNode, CondType::IfElse);
-                    setCondFollow(currNode, currNode->getSuccessor(BTHEN));
+                    currInfo.m_condFollow = getSuccessor(currNode, BTHEN);
                 }
             }
         }
@@ -489,6 +573,19 @@ void ControlFlowAnalyzer::checkConds()
 
 
 bool ControlFlowAnalyzer::isBackEdge(const BasicBlock *source, const BasicBlock *dest) const
+{
+    if (dest == source) {
+        return true;
+    }
+
+    const int sourceIdx = bbToIndex(source);
+    const int destIdx   = bbToIndex(dest);
+
+    return sourceIdx != -1 && destIdx != -1 && isBackEdge(sourceIdx, destIdx);
+}
+
+
+bool ControlFlowAnalyzer::isBackEdge(int source, int dest) const
 {
     return dest == source || isAncestorOf(dest, source);
 }
@@ -496,12 +593,13 @@ bool ControlFlowAnalyzer::isBackEdge(const BasicBlock *source, const BasicBlock
 
 bool ControlFlowAnalyzer::isCaseOption(const BasicBlock *bb) const
 {
-    if (!getCaseHead(bb)) {
+    const BasicBlock *caseHead = getCaseHead(bb);
+    if (!caseHead) {
         return false;
     }
 
-    for (int i = 0; i < getCaseHead(bb)->getNumSuccessors() - 1; i++) {
-        if (getCaseHead(bb)->getSuccessor(i) == bb) {
+    for (int i = 0; i < caseHead->getNumSuccessors() - 1; i++) {
+        if (caseHead->getSuccessor(i) == bb) {
             return true;
         }
     }
@@ -510,7 +608,7 @@ bool ControlFlowAnalyzer::isCaseOption(const BasicBlock *bb) const
 }
 
 
-bool ControlFlowAnalyzer::isAncestorOf(const BasicBlock *bb, const BasicBlock *other) const
+bool ControlFlowAnalyzer::isAncestorOf(int bb, int other) const
 {
     return (m_info[bb].m_preOrderID < m_info[other].m_preOrderID &&
             m_info[bb].m_postOrderID > m_info[other].m_postOrderID) ||
@@ -519,21 +617,17 @@ bool ControlFlowAnalyzer::isAncestorOf(const BasicBlock *bb, const BasicBlock *o
 }
 
 
-void ControlFlowAnalyzer::updateLoopStamps(const BasicBlock *bb, int &time)
+void ControlFlowAnalyzer::updateLoopStamps(int bb, int &time)
 {
     // timestamp the current node with the current time
     // and set its traversed flag
-    setTravType(bb, TravType::DFS_LNum);
+    m_info[bb].m_travType   = TravType::DFS_LNum;
     m_info[bb].m_preOrderID = time;
 
-    // recurse on unvisited children and set inedges for all children
-    for (const BasicBlock *succ : bb->getSuccessors()) {
-        // set the in edge from this child to its parent (the current node)
-        // (not done here, might be a problem)
-        // outEdges[i]->inEdges.Add(this);
-
+    // recurse on unvisited children
+    for (int succ : m_successors[bb]) {
         // recurse on this child if it hasn't already been visited
-        if (getTravType(succ) != TravType::DFS_LNum) {
+        if (m_info[succ].m_travType != TravType::DFS_LNum) {
             updateLoopStamps(succ, ++time);
         }
     }
@@ -547,17 +641,17 @@ void ControlFlowAnalyzer::updateLoopStamps(const BasicBlock *bb, int &time)
 }
 
 
-void ControlFlowAnalyzer::updateRevLoopStamps(const BasicBlock *bb, int &time)
+void ControlFlowAnalyzer::updateRevLoopStamps(int bb, int &time)
 {
     // timestamp the current node with the current time and set its traversed flag
-    setTravType(bb, TravType::DFS_RNum);
+    m_info[bb].m_travType      = TravType::DFS_RNum;
     m_info[bb].m_revPreOrderID = time;
 
     // recurse on the unvisited children in reverse order
-    for (int i = bb->getNumSuccessors() - 1; i >= 0; i--) {
+    for (auto it = m_successors[bb].rbegin(); it != m_successors[bb].rend(); ++it) {
         // recurse on this child if it hasn't already been visited
-        if (getTravType(bb->getSuccessor(i)) != TravType::DFS_RNum) {
-            updateRevLoopStamps(bb->getSuccessor(i), ++time);
+        if (m_info[*it].m_travType != TravType::DFS_RNum) {
+            updateRevLoopStamps(*it, ++time);
         }
     }
 
@@ -565,14 +659,14 @@ void ControlFlowAnalyzer::updateRevLoopStamps(const BasicBlock *bb, int &time)
 }
 
 
-void ControlFlowAnalyzer::updateRevOrder(const BasicBlock *bb)
+void ControlFlowAnalyzer::updateRevOrder(int bb)
 {
     // Set this node as having been traversed during the post domimator DFS ordering traversal
-    setTravType(bb, TravType::DFS_PDom);
+    m_info[bb].m_travType = TravType::DFS_PDom;
 
     // recurse on unvisited children
-    for (const BasicBlock *pred : bb->getPredecessors()) {
-        if (getTravType(pred) != TravType::DFS_PDom) {
+    for (int pred : m_predecessors[bb]) {
+        if (m_info[pred].m_travType != TravType::DFS_PDom) {
             updateRevOrder(pred);
         }
     }
@@ -584,12 +678,11 @@ void ControlFlowAnalyzer::updateRevOrder(const BasicBlock *bb)
 }
 
 
-void ControlFlowAnalyzer::setCaseHead(const BasicBlock *bb, const BasicBlock *head,
-                                      const BasicBlock *follow)
+void ControlFlowAnalyzer::setCaseHead(int bb, int head, int follow)
 {
-    assert(!getCaseHead(bb));
+    assert(m_info[bb].m_caseHead == -1);
 
-    setTravType(bb, TravType::DFS_Case);
+    m_info[bb].m_travType = TravType::DFS_Case;
 
     // don't tag this node if it is the case header under investigation
     if (bb != head) {
@@ -598,9 +691,11 @@ void ControlFlowAnalyzer::setCaseHead(const BasicBlock *bb, const BasicBlock *he
 
     // if this is a nested case header, then it's member nodes
     // will already have been tagged so skip straight to its follow
-    if (bb->isType(BBType::Nway) && (bb != head)) {
-        if (getCondFollow(bb) && (getTravType(getCondFollow(bb)) != TravType::DFS_Case) &&
-            (getCondFollow(bb) != follow)) {
+    if (m_blocks[bb]->isType(BBType::Nway) && (bb != head)) {
+        const int condFollow = m_info[bb].m_condFollow;
+
+        if ((condFollow != -1) && (m_info[condFollow].m_travType != TravType::DFS_Case) &&
+            (condFollow != follow)) {
             setCaseHead(bb, head, follow);
         }
     }
@@ -609,8 +704,8 @@ void ControlFlowAnalyzer::setCaseHead(const BasicBlock *bb, const BasicBlock *he
         //   i) isn't on a back-edge,
         //  ii) hasn't already been traversed in a case tagging traversal and,
         // iii) isn't the follow node.
-        for (BasicBlock *succ : bb->getSuccessors()) {
-            if (!isBackEdge(bb, succ) && (getTravType(succ) != TravType::DFS_Case) &&
+        for (int succ : m_successors[bb]) {
+            if (!isBackEdge(bb, succ) && (m_info[succ].m_travType != TravType::DFS_Case) &&
                 (succ != follow)) {
                 setCaseHead(succ, head, follow);
             }
@@ -620,17 +715,27 @@ void ControlFlowAnalyzer::setCaseHead(const BasicBlock *bb, const BasicBlock *he
 
 
 void ControlFlowAnalyzer::setStructType(const BasicBlock *bb, StructType structType)
+{
+    const int idx = bbToIndex(bb);
+    assert(idx != -1);
+    setStructType(idx, structType);
+}
+
+
+void ControlFlowAnalyzer::setStructType(int bb, StructType structType)
 {
     // if this is a conditional header, determine exactly which type of conditional header it is
     // (i.e. switch, if-then, if-then-else etc.)
     if (structType == StructType::Cond) {
-        if (bb->isType(BBType::Nway)) {
+        const int condFollow = m_info[bb].m_condFollow;
+
+        if (m_blocks[bb]->isType(BBType::Nway)) {
             m_info[bb].m_conditionHeaderType = CondType::Case;
         }
-        else if (getCondFollow(bb) == bb->getSuccessor(BELSE)) {
+        else if (condFollow == getSuccessor(bb, BELSE)) {
             m_info[bb].m_conditionHeaderType = CondType::IfThen;
         }
-        else if (getCondFollow(bb) == bb->getSuccessor(BTHEN)) {
+        else if (condFollow == getSuccessor(bb, BTHEN)) {
             m_info[bb].m_conditionHeaderType = CondType::IfElse;
         }
         else {
@@ -642,7 +747,7 @@ void ControlFlowAnalyzer::setStructType(const BasicBlock *bb, StructType structT
 }
 
 
-void ControlFlowAnalyzer::setUnstructType(const BasicBlock *bb, UnstructType unstructType)
+void ControlFlowAnalyzer::setUnstructType(int bb, UnstructType unstructType)
 {
     assert((m_info[bb].m_structuringType == StructType::Cond ||
             m_info[bb].m_structuringType == StructType::LoopCond) &&
@@ -653,24 +758,27 @@ void ControlFlowAnalyzer::setUnstructType(const BasicBlock *bb, UnstructType uns
 
 UnstructType ControlFlowAnalyzer::getUnstructType(const BasicBlock *bb) const
 {
-    assert((m_info[bb].m_structuringType == StructType::Cond ||
-            m_info[bb].m_structuringType == StructType::LoopCond));
+    const BBStructInfo &info = getInfo(bb);
+    assert((info.m_structuringType == StructType::Cond ||
+            info.m_structuringType == StructType::LoopCond));
     // fails when cenerating code for switches; not sure if actually needed TODO
     // assert(m_conditionHeaderType != CondType::Case);
 
-    return m_info[bb].m_unstructuredType;
+    return info.m_unstructuredType;
 }
 
 
-void ControlFlowAnalyzer::setLoopType(const BasicBlock *bb, LoopType l)
+void ControlFlowAnalyzer::setLoopType(int bb, LoopType l)
 {
-    assert(getStructType(bb) == StructType::Loop || getStructType(bb) == StructType::LoopCond);
+    assert(m_info[bb].m_structuringType == StructType::Loop ||
+           m_info[bb].m_structuringType == StructType::LoopCond);
     m_info[bb].m_loopHeaderType = l;
 
     // set the structured class (back to) just Loop if the loop type is PreTested OR it's PostTested
     // and is a single block loop
     if ((m_info[bb].m_loopHeaderType == LoopType::PreTested) ||
-        ((m_info[bb].m_loopHeaderType == LoopType::PostTested) && (bb == getLatchNode(bb)))) {
+        ((m_info[bb].m_loopHeaderType == LoopType::PostTested) &&
+         (bb == m_info[bb].m_latchNode))) {
         setStructType(bb, StructType::Loop);
     }
 }
@@ -678,61 +786,70 @@ void ControlFlowAnalyzer::setLoopType(const BasicBlock *bb, LoopType l)
 
 LoopType ControlFlowAnalyzer::getLoopType(const BasicBlock *bb) const
 {
-    assert(getStructType(bb) == StructType::Loop || getStructType(bb) == StructType::LoopCond);
-    return m_info[bb].m_loopHeaderType;
+    const BBStructInfo &info = getInfo(bb);
+    assert(info.m_structuringType == StructType::Loop ||
+           info.m_structuringType == StructType::LoopCond);
+    return info.m_loopHeaderType;
 }
 
 
-void ControlFlowAnalyzer::setCondType(const BasicBlock *bb, CondType condType)
+void ControlFlowAnalyzer::setCondType(int bb, CondType condType)
 {
-    assert(getStructType(bb) == StructType::Cond || getStructType(bb) == StructType::LoopCond);
+    assert(m_info[bb].m_structuringType == StructType::Cond ||
+           m_info[bb].m_structuringType == StructType::LoopCond);
     m_info[bb].m_conditionHeaderType = condType;
 }
 
 
 CondType ControlFlowAnalyzer::getCondType(const BasicBlock *bb) const
 {
-    assert(getStructType(bb) == StructType::Cond || getStructType(bb) == StructType::LoopCond);
-    return m_info[bb].m_conditionHeaderType;
+    const BBStructInfo &info = getInfo(bb);
+    assert(info.m_structuringType == StructType::Cond ||
+           info.m_structuringType == StructType::LoopCond);
+    return info.m_conditionHeaderType;
 }
 
 
-bool ControlFlowAnalyzer::isBBInLoop(const BasicBlock *bb, const BasicBlock *header,
-                                     const BasicBlock *latch) const
+bool ControlFlowAnalyzer::isBBInLoop(int bb, int header, int latch) const
 {
-    assert(getLatchNode(header) == latch);
-    assert(header == latch || ((m_info[header].m_preOrderID > m_info[latch].m_preOrderID &&
-                                m_info[latch].m_postOrderID > m_info[header].m_postOrderID) ||
-                               (m_info[header].m_preOrderID < m_info[latch].m_preOrderID &&
-                                m_info[latch].m_postOrderID < m_info[header].m_postOrderID)));
+    const BBStructInfo &bbInfo     = m_info[bb];
+    const BBStructInfo &headerInfo = m_info[header];
+    const BBStructInfo &latchInfo  = m_info[latch];
+
+    assert(headerInfo.m_latchNode == latch);
+    assert(header == latch ||
+           ((headerInfo.m_preOrderID > latchInfo.m_preOrderID &&
+             latchInfo.m_postOrderID > headerInfo.m_postOrderID) ||
+            (headerInfo.m_preOrderID < latchInfo.m_preOrderID &&
+             latchInfo.m_postOrderID < headerInfo.m_postOrderID)));
 
     // this node is in the loop if it is the latch node OR
     // this node is within the header and the latch is within this when using the forward loop
     // stamps OR this node is within the header and the latch is within this when using the reverse
     // loop stamps
     return bb == latch ||
-           (m_info[header].m_preOrderID < m_info[bb].m_preOrderID &&
-            m_info[bb].m_postOrderID < m_info[header].m_postOrderID &&
-            m_info[bb].m_preOrderID < m_info[latch].m_preOrderID &&
-            m_info[latch].m_postOrderID < m_info[bb].m_postOrderID) ||
-           (m_info[header].m_revPreOrderID < m_info[bb].m_revPreOrderID &&
-            m_info[bb].m_revPostOrderID < m_info[header].m_revPostOrderID &&
-            m_info[bb].m_revPreOrderID < m_info[latch].m_revPreOrderID &&
-            m_info[latch].m_revPostOrderID < m_info[bb].m_revPostOrderID);
+           (headerInfo.m_preOrderID < bbInfo.m_preOrderID &&
+            bbInfo.m_postOrderID < headerInfo.m_postOrderID &&
+            bbInfo.m_preOrderID < latchInfo.m_preOrderID &&
+            latchInfo.m_postOrderID < bbInfo.m_postOrderID) ||
+           (headerInfo.m_revPreOrderID < bbInfo.m_revPreOrderID &&
+            bbInfo.m_revPostOrderID < headerInfo.m_revPostOrderID &&
+            bbInfo.m_revPreOrderID < latchInfo.m_revPreOrderID &&
+            latchInfo.m_revPostOrderID < bbInfo.m_revPostOrderID);
 }
 
 
-bool ControlFlowAnalyzer::hasBackEdge(const BasicBlock *bb) const
+bool ControlFlowAnalyzer::hasBackEdge(int bb) const
 {
-    return std::any_of(bb->getSuccessors().begin(), bb->getSuccessors().end(),
-                       [this, bb](const BasicBlock *succ) { return isBackEdge(bb, succ); });
+    return std::any_of(m_successors[bb].begin(), m_successors[bb].end(),
+                       [this, bb](int succ) { return isBackEdge(bb, succ); });
 }
 
 
 void ControlFlowAnalyzer::unTraverse()
 {
-    for (auto &elem : m_info) {
-        elem.second.m_travType = TravType::Untraversed;
+    for (BBStructInfo &info : m_info) {
+        info.m_travType = TravType::Untraversed;
     }
 }
 
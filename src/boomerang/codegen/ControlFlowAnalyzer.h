@@ -10,6 +10,8 @@
 #pragma once
 
 
+#include "boomerang/core/BoomerangAPI.h"
+
 #include <unordered_map>
 #include <vector>
 
@@ -88,6 +90,7 @@ enum class SBBType : uint8_t
 
 
 /// Holds all information about control Flow Structure.
+/// Blocks are referred to by their index in ControlFlowAnalyzer::m_blocks (-1 for none).
 struct BBStructInfo
 {
     /// Control flow analysis stuff, lifted from Doug Simon's honours thesis.
@@ -118,20 +121,23 @@ struct BBStructInfo
     LoopType m_loopHeaderType      = LoopType::Invalid; ///< the loop type of a loop header
 
     // analysis information
-    const BasicBlock *m_immPDom    = nullptr; ///< immediate post dominator
-    const BasicBlock *m_loopHead   = nullptr; ///< head of the most nested enclosing loop
-    const BasicBlock *m_caseHead   = nullptr; ///< head of the most nested enclosing case
-    const BasicBlock *m_condFollow = nullptr; ///< follow of a conditional header
-    const BasicBlock *m_loopFollow = nullptr; ///< follow of a loop header
-    const BasicBlock *m_latchNode  = nullptr; ///< latching node of a loop header
+    int m_immPDom    = -1; ///< immediate post dominator
+    int m_loopHead   = -1; ///< head of the most nested enclosing loop
+    int m_caseHead   = -1; ///< head of the most nested enclosing case
+    int m_condFollow = -1; ///< follow of a conditional header
+    int m_loopFollow = -1; ///< follow of a loop header
+    int m_latchNode  = -1; ///< latching node of a loop header
 };
 
 
 /**
  * Control flow analysis stuff, lifted from Doug Simon's honours thesis.
  * Analyzes the control flow of a CFG and tags loop constructs etc.
+ *
+ * All blocks of the CFG are numbered densely before structuring;
+ * the analysis itself only works on block indices.
  */
-class ControlFlowAnalyzer
+class BOOMERANG_API ControlFlowAnalyzer
 {
 public:
     ControlFlowAnalyzer();
@@ -156,83 +162,76 @@ public:
 
     inline const BasicBlock *getLatchNode(const BasicBlock *bb) const
     {
-        return m_info[bb].m_latchNode;
+        return indexToBB(getInfo(bb).m_latchNode);
     }
 
     inline const BasicBlock *getLoopHead(const BasicBlock *bb) const
     {
-        return m_info[bb].m_loopHead;
+        return indexToBB(getInfo(bb).m_loopHead);
     }
 
     inline const BasicBlock *getLoopFollow(const BasicBlock *bb) const
     {
-        return m_info[bb].m_loopFollow;
+        return indexToBB(getInfo(bb).m_loopFollow);
     }
 
     inline const BasicBlock *getCondFollow(const BasicBlock *bb) const
     {
-        return m_info[bb].m_condFollow;
+        return indexToBB(getInfo(bb).m_condFollow);
     }
 
     inline const BasicBlock *getCaseHead(const BasicBlock *bb) const
     {
-        return m_info[bb].m_caseHead;
+        return indexToBB(getInfo(bb).m_caseHead);
     }
 
-    TravType getTravType(const BasicBlock *bb) const { return m_info[bb].m_travType; }
-    StructType getStructType(const BasicBlock *bb) const { return m_info[bb].m_structuringType; }
+    TravType getTravType(const BasicBlock *bb) const { return getInfo(bb).m_travType; }
+    StructType getStructType(const BasicBlock *bb) const { return getInfo(bb).m_structuringType; }
     CondType getCondType(const BasicBlock *bb) const;
     UnstructType getUnstructType(const BasicBlock *bb) const;
     LoopType getLoopType(const BasicBlock *bb) const;
 
-    void setTravType(const BasicBlock *bb, TravType type) { m_info[bb].m_travType = type; }
+    void setTravType(const BasicBlock *bb, TravType type) { getInfo(bb).m_travType = type; }
     void setStructType(const BasicBlock *bb, StructType s);
 
     bool isCaseOption(const BasicBlock *bb) const;
 
 private:
-    void updateLoopStamps(const BasicBlock *bb, int &time);
-    void updateRevLoopStamps(const BasicBlock *bb, int &time);
-    void updateRevOrder(const BasicBlock *bb);
-
-    void setLoopHead(const BasicBlock *bb, const BasicBlock *head) { m_info[bb].m_loopHead = head; }
-    void setLatchNode(const BasicBlock *bb, const BasicBlock *latch)
-    {
-        m_info[bb].m_latchNode = latch;
-    }
+    /// Assign a dense index to each BB of the CFG and cache the edges as indices.
+    void numberBlocks();
 
-    void setCaseHead(const BasicBlock *bb, const BasicBlock *head, const BasicBlock *follow);
+    /// \returns the index of \p bb, or -1 if \p bb is not part of the CFG.
+    int bbToIndex(const BasicBlock *bb) const;
+    const BasicBlock *indexToBB(int idx) const { return idx >= 0 ? m_blocks[idx] : nullptr; }
 
-    void setUnstructType(const BasicBlock *bb, UnstructType unstructType);
-    void setLoopType(const BasicBlock *bb, LoopType loopType);
-    void setCondType(const BasicBlock *bb, CondType condType);
+    /// \returns the index of the \p i-th successor of \p bb, or -1 if it does not exist.
+    int getSuccessor(int bb, int i) const;
 
-    void setLoopFollow(const BasicBlock *bb, const BasicBlock *follow)
-    {
-        m_info[bb].m_loopFollow = follow;
-    }
+    /// \returns the structuring information for \p bb.
+    /// Blocks that are not part of the CFG do not have any structuring information.
+    const BBStructInfo &getInfo(const BasicBlock *bb) const;
+    BBStructInfo &getInfo(const BasicBlock *bb);
 
-    void setCondFollow(const BasicBlock *bb, const BasicBlock *follow)
-    {
-        m_info[bb].m_condFollow = follow;
-    }
+    void updateLoopStamps(int bb, int &time);
+    void updateRevLoopStamps(int bb, int &time);
+    void updateRevOrder(int bb);
 
-    /// establish if this bb has any back edges leading FROM it
-    bool hasBackEdge(const BasicBlock *bb) const;
+    void setCaseHead(int bb, int head, int follow);
 
-    /// \returns true if \p bb is an ancestor of \p other
-    bool isAncestorOf(const BasicBlock *bb, const BasicBlock *other) const;
-    bool isBBInLoop(const BasicBlock *bb, const BasicBlock *header, const BasicBlock *latch) const;
+    void setStructType(int bb, StructType structType);
+    void setUnstructType(int bb, UnstructType unstructType);
+    void setLoopType(int bb, LoopType loopType);
+    void setCondType(int bb, CondType condType);
 
-    int getPostOrdering(const BasicBlock *bb) const { return m_info[bb].m_postOrderIndex; }
-    int getRevOrd(const BasicBlock *bb) const { return m_info[bb].m_revPostOrderIndex; }
+    /// establish if \p source has a back edge to \p dest
+    bool isBackEdge(int source, int dest) const;
 
-    const BasicBlock *getImmPDom(const BasicBlock *bb) const { return m_info[bb].m_immPDom; }
+    /// establish if this bb has any back edges leading FROM it
+    bool hasBackEdge(int bb) const;
 
-    void setImmPDom(const BasicBlock *bb, const BasicBlock *immPDom)
-    {
-        m_info[bb].m_immPDom = immPDom;
-    }
+    /// \returns true if \p bb is an ancestor of \p other
+    bool isAncestorOf(int bb, int other) const;
+    bool isBBInLoop(int bb, int header, int latch) const;
 
     void unTraverse();
 
@@ -242,9 +241,10 @@ private:
     /**
      * Finds the immediate post dominator of each node in the CFG.
      *
-     * Adapted version of the dominators algorithm by Hecht and Ullman;
-     * finds immediate post dominators only.
-     * \note graph should be reducible
+     * Uses the iterative dominator algorithm by Cooper, Harvey and Kennedy on the reverse CFG.
+     * Nodes that cannot reach the exit node (e.g. endless loops or calls to noreturn functions)
+     * are connected to a virtual exit node. Nodes that are only post dominated by
+     * the virtual exit node do not have an immediate post dominator.
      */
     void updateImmedPDom();
 
@@ -262,22 +262,18 @@ private:
     /// forward jumps are considered as unstructured backward jumps will always be generated nicely.
     void checkConds();
 
-    /// Finds the common post dominator of the current immediate post dominator and its successor's
-    /// immediate post dominator
-    const BasicBlock *findCommonPDom(const BasicBlock *curImmPDom, const BasicBlock *succImmPDom);
-
     /// \pre  The loop induced by (head,latch) has already had all its member nodes tagged
     /// \post The type of loop has been deduced
-    void determineLoopType(const BasicBlock *header, bool *&loopNodes);
+    void determineLoopType(int header, const std::vector<bool> &loopNodes);
 
     /// \pre  The loop headed by header has been induced and all it's member nodes have been tagged
     /// \post The follow of the loop has been determined.
-    void findLoopFollow(const BasicBlock *header, bool *&loopNodes);
+    void findLoopFollow(int header, const std::vector<bool> &loopNodes);
 
     /// \pre header has been detected as a loop header and has the details of the
     ///        latching node
     /// \post the nodes within the loop have been tagged
-    void tagNodesInLoop(const BasicBlock *header, bool *&loopNodes);
+    void tagNodesInLoop(int header, std::vector<bool> &loopNodes);
 
     BasicBlock *findEntryBB() const;
     BasicBlock *findExitBB() const;
@@ -285,16 +281,21 @@ private:
 private:
     ProcCFG *m_cfg = nullptr;
 
+    std::vector<const BasicBlock *> m_blocks;             ///< Maps index -> BasicBlock
+    std::unordered_map<const BasicBlock *, int> m_indices; ///< Maps BasicBlock -> index
+
+    std::vector<std::vector<int>> m_successors;   ///< Successors of each block (indices)
+    std::vector<std::vector<int>> m_predecessors; ///< Predecessors of each block (indices)
+
     /// Post Ordering according to a DFS starting at the entry BB.
-    std::vector<const BasicBlock *> m_postOrdering;
+    std::vector<int> m_postOrdering;
 
-    /// Post Ordering according to a DFS starting at the exit BB (usually the return BB).
+    /// Post Ordering according to a DFS of the reverse graph starting at the exit BB
+    /// (usually the return BB) and at all nodes that cannot reach the exit BB.
     /// Note that this is not the reverse of m_postOrdering
     /// for functions containing calls to noreturn functions or infinite loops.
-    std::vector<const BasicBlock *> m_revPostOrdering;
+    std::vector<int> m_revPostOrdering;
 
-private:
-    /// mutable to allow using the map in const methods (might create entries).
-    /// DO NOT change BBStructInfo in const methods!
-    mutable std::unordered_map<const BasicBlock *, BBStructInfo> m_info;
+    /// Structuring information of each block.
+    std::vector<BBStructInfo> m_info;
 };
@@ -12,19 +12,26 @@
 #include "boomerang/codegen/CCodeGenerator.h"
 #include "boomerang/core/Settings.h"
 #include "boomerang/core/Watcher.h"
+#include "boomerang/db/Global.h"
 #include "boomerang/db/Prog.h"
 #include "boomerang/db/binary/BinarySymbolTable.h"
+#include "boomerang/decomp/IncrementalDecompiler.h"
 #include "boomerang/decomp/ProgDecompiler.h"
 #include "boomerang/frontend/mips/MIPSFrontEnd.h"
 #include "boomerang/frontend/pentium/PentiumFrontEnd.h"
 #include "boomerang/frontend/ppc/PPCFrontEnd.h"
 #include "boomerang/frontend/sparc/SPARCFrontEnd.h"
 #include "boomerang/frontend/st20/ST20FrontEnd.h"
+#include "boomerang/ssl/type/Type.h"
 #include "boomerang/type/dfa/DFATypeRecovery.h"
 #include "boomerang/util/CallGraphDotWriter.h"
+#include "boomerang/util/IRMemoryReport.h"
+#include "boomerang/util/OStream.h"
 #include "boomerang/util/ProgSymbolWriter.h"
 #include "boomerang/util/log/Log.h"
 
+#include <algorithm>
+
 
 Project::Project()
     : m_settings(new Settings())
@@ -87,6 +94,12 @@ const ITypeRecovery *Project::getTypeRecoveryEngine() const
 }
 
 
+IncrementalDecompiler *Project::getIncrementalDecompiler()
+{
+    return m_incrementalDecompiler.get();
+}
+
+
 const char *Project::getVersionStr() const
 {
     return BOOMERANG_VERSION;
@@ -150,6 +163,7 @@ bool Project::isBinaryLoaded() const
 
 void Project::unloadBinaryFile()
 {
+    m_incrementalDecompiler.reset();
     m_prog.reset();
     m_loadedBinary.reset();
 }
@@ -206,8 +220,29 @@ bool Project::decompileBinaryFile()
         return false;
     }
 
+    if (m_incrementalDecompiler->isProgDecompiled()) {
+        if (!m_incrementalDecompiler->hasInvalidatedProcs()) {
+            LOG_MSG("No procedures need to be decompiled again.");
+            return true;
+        }
+
+        m_incrementalDecompiler->redecompile();
+        return true;
+    }
+
     ProgDecompiler dcomp(m_prog.get());
     dcomp.decompile();
+    m_incrementalDecompiler->setProgDecompiled(true);
+
+    if (getSettings()->printMemoryReport) {
+        IRMemoryReport report;
+        report.addProg(m_prog.get());
+
+        QString tgt;
+        OStream os(&tgt);
+        report.print(os);
+        LOG_MSG("Memory used by the intermediate representation:\n%1", tgt);
+    }
 
     return true;
 }
@@ -225,7 +260,65 @@ bool Project::generateCode(Module *module)
     }
 
     LOG_MSG("Generating code...");
-    m_codeGenerator->generateCode(getProg(), module);
+
+    if (module == nullptr && m_incrementalDecompiler->isCodeGenerated()) {
+        // Only the code of modules changed by edits since the last code generation is outdated.
+        const std::set<Module *> changedModules = m_incrementalDecompiler->getChangedModules();
+
+        if (changedModules.find(getProg()->getRootModule()) != changedModules.end()) {
+            // the root module contains the prototypes of all procedures
+            m_codeGenerator->generateCode(getProg(), nullptr);
+        }
+        else {
+            for (Module *changed : changedModules) {
+                m_codeGenerator->generateCode(getProg(), changed);
+            }
+        }
+    }
+    else {
+        m_codeGenerator->generateCode(getProg(), module);
+    }
+
+    if (module == nullptr) {
+        m_incrementalDecompiler->clearChangedModules();
+        m_incrementalDecompiler->setCodeGenerated(m_incrementalDecompiler->isProgDecompiled());
+    }
+
+    return true;
+}
+
+
+bool Project::generateProcCode(UserProc *proc)
+{
+    if (!m_prog) {
+        LOG_ERROR("Cannot generate code: No binary file is loaded.");
+        return false;
+    }
+    else if (!m_fe) {
+        LOG_ERROR("Cannot generate code: No suitable frontend found.");
+        return false;
+    }
+
+    m_codeGenerator->generateCode(getProg(), proc->getModule(), proc);
+    return true;
+}
+
+
+bool Project::setGlobalType(const QString &name, SharedType type)
+{
+    Global *global = m_prog ? m_prog->getGlobalByName(name) : nullptr;
+    if (!global) {
+        LOG_ERROR("Cannot change type of global '%1': No such global.", name);
+        return false;
+    }
+
+    const bool changed = !global->getType() || !type || *global->getType() != *type;
+    m_prog->setGlobalType(name, type);
+
+    if (changed) {
+        m_incrementalDecompiler->globalChanged(global);
+    }
+
     return true;
 }
 
@@ -238,11 +331,13 @@ Prog *Project::createProg(BinaryFile *file, const QString &name)
     }
 
     // unload old Prog before creating a new one
+    m_incrementalDecompiler.reset();
     m_fe.reset();
     m_prog.reset();
 
     m_prog.reset(new Prog(name, this));
     m_fe.reset(createFrontEnd());
+    m_incrementalDecompiler.reset(new IncrementalDecompiler(m_prog.get()));
 
     m_prog->setFrontEnd(m_fe.get());
     return m_prog.get();
@@ -284,6 +379,10 @@ void Project::loadSymbols()
 
     m_prog->readDefaultLibraryCatalogues();
 
+    if (getSettings()->matchLibSignatures) {
+        m_prog->recognizeStaticLibraryFunctions();
+    }
+
     for (auto &sf : getSettings()->m_symbolFiles) {
         LOG_MSG("Reading symbol file '%1'", sf);
         m_prog->addSymbolsFromSymbolFile(sf);
@@ -361,15 +460,40 @@ void Project::loadPlugins()
 }
 
 
-void Project::addWatcher(IWatcher *watcher)
+void Project::addWatcher(IWatcher *watcher, WatchEventMask events)
 {
-    m_watchers.insert(watcher);
+    m_watchers[watcher] = events;
+
+    for (int i = 0; i < static_cast<int>(WatchEvent::NumEvents); i++) {
+        std::vector<IWatcher *> &subscribers = m_subscribers[i];
+        auto it = std::find(subscribers.begin(), subscribers.end(), watcher);
+
+        if ((events & watchEventMask(static_cast<WatchEvent>(i))) == 0) {
+            if (it != subscribers.end()) {
+                subscribers.erase(it);
+            }
+        }
+        else if (it == subscribers.end()) {
+            subscribers.push_back(watcher);
+        }
+    }
+}
+
+
+void Project::removeWatcher(IWatcher *watcher)
+{
+    m_watchers.erase(watcher);
+
+    for (std::vector<IWatcher *> &subscribers : m_subscribers) {
+        subscribers.erase(std::remove(subscribers.begin(), subscribers.end(), watcher),
+                          subscribers.end());
+    }
 }
 
 
 void Project::alertDecompileDebugPoint(UserProc *p, const char *description)
 {
-    for (IWatcher *elem : m_watchers) {
+    for (IWatcher *elem : getSubscribers(WatchEvent::DecompileDebugPoint)) {
         elem->onDecompileDebugPoint(p, description);
     }
 }
@@ -377,7 +501,7 @@ void Project::alertDecompileDebugPoint(UserProc *p, const char *description)
 
 void Project::alertFunctionCreated(Function *function)
 {
-    for (IWatcher *it : m_watchers) {
+    for (IWatcher *it : getSubscribers(WatchEvent::FunctionCreated)) {
         it->onFunctionCreated(function);
     }
 }
@@ -385,7 +509,7 @@ void Project::alertFunctionCreated(Function *function)
 
 void Project::alertFunctionRemoved(Function *function)
 {
-    for (IWatcher *it : m_watchers) {
+    for (IWatcher *it : getSubscribers(WatchEvent::FunctionRemoved)) {
         it->onFunctionRemoved(function);
     }
 }
@@ -393,7 +517,11 @@ void Project::alertFunctionRemoved(Function *function)
 
 void Project::alertSignatureUpdated(Function *function)
 {
-    for (IWatcher *it : m_watchers) {
+    if (m_incrementalDecompiler) {
+        m_incrementalDecompiler->signatureChanged(function);
+    }
+
+    for (IWatcher *it : getSubscribers(WatchEvent::SignatureUpdated)) {
         it->onSignatureUpdated(function);
     }
 }
@@ -401,15 +529,38 @@ void Project::alertSignatureUpdated(Function *function)
 
 void Project::alertInstructionDecoded(Address pc, int numBytes)
 {
-    for (IWatcher *it : m_watchers) {
-        it->onInstructionDecoded(pc, numBytes);
+    if (!isWatched(WatchEvent::InstructionsDecoded)) {
+        return;
+    }
+
+    // Coalesce consecutive instructions
+    if (!m_pendingDecoded.empty()) {
+        DecodedRange &last = m_pendingDecoded.back();
+
+        if (last.start + last.numBytes == pc) {
+            last.numBytes += numBytes;
+            last.numInstructions++;
+            return;
+        }
+    }
+
+    m_pendingDecoded.push_back({ pc, numBytes, 1 });
+
+    if (!m_decodedFlushTimer.isValid()) {
+        m_decodedFlushTimer.start();
+    }
+    else if (m_pendingDecoded.size() >= MAX_PENDING_DECODED_RANGES ||
+             m_decodedFlushTimer.elapsed() >= DECODED_FLUSH_INTERVAL_MS) {
+        flushDecodedInstructions();
     }
 }
 
 
 void Project::alertBadDecode(Address pc)
 {
-    for (IWatcher *it : m_watchers) {
+    flushDecodedInstructions();
+
+    for (IWatcher *it : getSubscribers(WatchEvent::BadDecode)) {
         it->onBadDecode(pc);
     }
 }
@@ -417,7 +568,9 @@ void Project::alertBadDecode(Address pc)
 
 void Project::alertFunctionDecoded(Function *p, Address pc, Address last, int numBytes)
 {
-    for (IWatcher *it : m_watchers) {
+    flushDecodedInstructions();
+
+    for (IWatcher *it : getSubscribers(WatchEvent::FunctionDecoded)) {
         it->onFunctionDecoded(p, pc, last, numBytes);
     }
 }
@@ -425,7 +578,7 @@ void Project::alertFunctionDecoded(Function *p, Address pc, Address last, int nu
 
 void Project::alertStartDecode(Address start, int numBytes)
 {
-    for (IWatcher *it : m_watchers) {
+    for (IWatcher *it : getSubscribers(WatchEvent::StartDecode)) {
         it->onStartDecode(start, numBytes);
     }
 }
@@ -433,7 +586,9 @@ void Project::alertStartDecode(Address start, int numBytes)
 
 void Project::alertEndDecode()
 {
-    for (IWatcher *it : m_watchers) {
+    flushDecodedInstructions();
+
+    for (IWatcher *it : getSubscribers(WatchEvent::EndDecode)) {
         it->onEndDecode();
     }
 }
@@ -441,7 +596,7 @@ void Project::alertEndDecode()
 
 void Project::alertStartDecompile(UserProc *proc)
 {
-    for (IWatcher *it : m_watchers) {
+    for (IWatcher *it : getSubscribers(WatchEvent::StartDecompile)) {
         it->onStartDecompile(proc);
     }
 }
@@ -449,7 +604,7 @@ void Project::alertStartDecompile(UserProc *proc)
 
 void Project::alertProcStatusChanged(UserProc *proc)
 {
-    for (IWatcher *it : m_watchers) {
+    for (IWatcher *it : getSubscribers(WatchEvent::ProcStatusChange)) {
         it->onProcStatusChange(proc);
     }
 }
@@ -457,7 +612,7 @@ void Project::alertProcStatusChanged(UserProc *proc)
 
 void Project::alertEndDecompile(UserProc *proc)
 {
-    for (IWatcher *it : m_watchers) {
+    for (IWatcher *it : getSubscribers(WatchEvent::EndDecompile)) {
         it->onEndDecompile(proc);
     }
 }
@@ -465,7 +620,7 @@ void Project::alertEndDecompile(UserProc *proc)
 
 void Project::alertDiscovered(Function *function)
 {
-    for (IWatcher *it : m_watchers) {
+    for (IWatcher *it : getSubscribers(WatchEvent::FunctionDiscovered)) {
         it->onFunctionDiscovered(function);
     }
 }
@@ -473,7 +628,7 @@ void Project::alertDiscovered(Function *function)
 
 void Project::alertDecompiling(UserProc *proc)
 {
-    for (IWatcher *it : m_watchers) {
+    for (IWatcher *it : getSubscribers(WatchEvent::DecompileInProgress)) {
         it->onDecompileInProgress(proc);
     }
 }
@@ -481,12 +636,27 @@ void Project::alertDecompiling(UserProc *proc)
 
 void Project::alertDecompilationEnd()
 {
-    for (IWatcher *w : m_watchers) {
+    for (IWatcher *w : getSubscribers(WatchEvent::DecompilationEnd)) {
         w->onDecompilationEnd();
     }
 }
 
 
+void Project::flushDecodedInstructions()
+{
+    if (m_pendingDecoded.empty()) {
+        return;
+    }
+
+    for (IWatcher *it : getSubscribers(WatchEvent::InstructionsDecoded)) {
+        it->onInstructionsDecoded(m_pendingDecoded);
+    }
+
+    m_pendingDecoded.clear();
+    m_decodedFlushTimer.restart();
+}
+
+
 IFileLoader *Project::getBestLoader(const QString &filePath) const
 {
     QFile inputBinary(filePath);
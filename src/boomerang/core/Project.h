@@ -11,30 +11,43 @@
 
 
 #include "boomerang/core/BoomerangAPI.h"
+#include "boomerang/core/Watcher.h"
 #include "boomerang/ifc/IFileLoader.h"
 #include "boomerang/util/Address.h"
 
+#include <QElapsedTimer>
+
+#include <array>
+#include <map>
 #include <memory>
-#include <set>
 #include <vector>
 
 
 class BinaryFile;
 class ICodeGenerator;
 class IFrontEnd;
+class IncrementalDecompiler;
 class ITypeRecovery;
-class IWatcher;
 class Function;
 class Module;
 class Prog;
 class Settings;
+class Type;
 class UserProc;
 
 class QString;
 
+typedef std::shared_ptr<Type> SharedType;
+
 
 class BOOMERANG_API Project
 {
+public:
+    /// Decoded instructions are delivered to the watchers at most once per interval,
+    /// unless a function is completely decoded or too many ranges are pending.
+    static constexpr int DECODED_FLUSH_INTERVAL_MS = 50;
+    static constexpr std::size_t MAX_PENDING_DECODED_RANGES = 4096;
+
 public:
     Project();
     Project(const Project &other) = delete;
@@ -59,6 +72,10 @@ public:
     ITypeRecovery *getTypeRecoveryEngine();
     const ITypeRecovery *getTypeRecoveryEngine() const;
 
+    /// \returns the object tracking user edits of the decompiled program,
+    /// or nullptr if no binary file is loaded.
+    IncrementalDecompiler *getIncrementalDecompiler();
+
 public:
     /// \returns the library version string
     const char *getVersionStr() const;
@@ -109,6 +126,8 @@ public:
 
     /**
      * Decompile the decoded binary file.
+     * If the binary file has been decompiled before, only the procedures
+     * affected by user edits since then are decompiled again.
      * \returns true on success, false if no binary is decoded or an error occurred.
      */
     bool decompileBinaryFile();
@@ -119,10 +138,36 @@ public:
      */
     bool generateCode(Module *module = nullptr);
 
+    /**
+     * Generate code for the single procedure \p proc. Globals and callees of \p proc
+     * that were not declared in the output of its module yet are declared first.
+     * \returns true on success, false if no binary is decompiled or an error occurred.
+     */
+    bool generateProcCode(UserProc *proc);
+
+    /**
+     * Change the type of the global variable \p name on behalf of the user.
+     * The procedures using the global are decompiled again by the next call
+     * to decompileBinaryFile(). Analyses change global types through Prog::setGlobalType,
+     * which does not invalidate anything.
+     * \returns false if there is no global named \p name.
+     */
+    bool setGlobalType(const QString &name, SharedType type);
+
 public:
-    /// Register a watcher to receive events about the decompilation.
-    /// Does NOT take ownership of the pointer.
-    void addWatcher(IWatcher *watcher);
+    /**
+     * Register a watcher to receive events about the decompilation.
+     * Does NOT take ownership of the pointer.
+     * \param events the events the watcher is notified about. If the watcher is already
+     *               registered, its subscription is replaced.
+     */
+    void addWatcher(IWatcher *watcher, WatchEventMask events = ALL_WATCH_EVENTS);
+
+    /// Unregister a watcher previously registered with addWatcher.
+    void removeWatcher(IWatcher *watcher);
+
+    /// \returns true if at least one watcher is subscribed to \p event.
+    bool isWatched(WatchEvent event) const { return !getSubscribers(event).empty(); }
 
     /// Called once after a function was created.
     void alertFunctionCreated(Function *function);
@@ -137,6 +182,7 @@ public:
     void alertStartDecode(Address start, int numBytes);
 
     /// Called every time an instruction is decoded.
+    /// The instructions are passed on to the watchers in batches.
     /// \param numBytes size of the instruction
     void alertInstructionDecoded(Address pc, int numBytes);
 
@@ -170,6 +216,14 @@ public:
     void alertDecompilationEnd();
 
 private:
+    const std::vector<IWatcher *> &getSubscribers(WatchEvent event) const
+    {
+        return m_subscribers[static_cast<int>(event)];
+    }
+
+    /// Deliver all pending decoded instructions to the watchers.
+    void flushDecodedInstructions();
+
     /// Get the best loader that is able to load the file at \p filePath
     IFileLoader *getBestLoader(const QString &filePath) const;
 
@@ -203,8 +257,15 @@ private:
 private:
     std::unique_ptr<Settings> m_settings;
 
-    /// The watchers which are interested in this decompilation.
-    std::set<IWatcher *> m_watchers;
+    /// The watchers which are interested in this decompilation, with their subscriptions.
+    std::map<IWatcher *, WatchEventMask> m_watchers;
+
+    /// The subscribed watchers for each kind of event
+    std::array<std::vector<IWatcher *>, static_cast<int>(WatchEvent::NumEvents)> m_subscribers;
+
+    /// Decoded instructions not yet delivered to the watchers
+    std::vector<DecodedRange> m_pendingDecoded;
+    QElapsedTimer m_decodedFlushTimer; ///< Time since the last delivery of decoded instructions
 
     // Plugins
     std::vector<std::unique_ptr<LoaderPlugin>> m_loaderPlugins;
@@ -215,4 +276,6 @@ private:
     std::unique_ptr<IFrontEnd> m_fe;                 ///< front end
     std::unique_ptr<ITypeRecovery> m_typeRecovery;   ///< middle end
     std::unique_ptr<ICodeGenerator> m_codeGenerator; ///< back end
+
+    std::unique_ptr<IncrementalDecompiler> m_incrementalDecompiler;
 };
@@ -12,6 +12,7 @@
 #include "boomerang/util/log/Log.h"
 
 #include <QCoreApplication>
+#include <QStandardPaths>
 
 
 Settings::Settings()
@@ -22,6 +23,8 @@ Settings::Settings()
     setDataDirectory(appDirPath + "/../share/boomerang");
     setPluginDirectory(appDirPath + "/../lib/boomerang/plugins");
     setOutputDirectory("./output");
+    setCacheDirectory(QStandardPaths::writableLocation(QStandardPaths::GenericCacheLocation) +
+                      "/boomerang");
 }
 
 
@@ -51,3 +54,10 @@ void Settings::setOutputDirectory(const QString &directoryPath)
     m_outputDirectory = m_workingDirectory.absoluteFilePath(directoryPath);
     LOG_VERBOSE("od now '%1'", m_outputDirectory.absolutePath());
 }
+
+
+void Settings::setCacheDirectory(const QString &directoryPath)
+{
+    m_cacheDirectory = m_workingDirectory.absoluteFilePath(directoryPath);
+    LOG_VERBOSE("cd now '%1'", m_cacheDirectory.absolutePath());
+}
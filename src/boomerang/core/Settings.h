@@ -32,6 +32,7 @@ public:
     void setDataDirectory(const QString &directoryPath);
     void setPluginDirectory(const QString &directoryPath);
     void setOutputDirectory(const QString &directoryPath);
+    void setCacheDirectory(const QString &directoryPath);
 
     /// Get the path where the boomerang executable is run from.
     QDir getWorkingDirectory() const { return m_workingDirectory; }
@@ -45,6 +46,9 @@ public:
     /// Get the path where the decompiled files should be put
     QDir getOutputDirectory() const { return m_outputDirectory; }
 
+    /// Get the path where files are cached between runs, e.g. parsed SSL files.
+    QDir getCacheDirectory() const { return m_cacheDirectory; }
+
 public:
     // Command line flags
     bool verboseOutput       = false;
@@ -61,6 +65,9 @@ public:
     bool useDataflow         = true;
     bool stopBeforeDecompile = false;
     bool traceDecoder        = false;
+    bool decodeCache         = false; ///< Keep decoded instructions for re-decoding procedures
+    bool matchLibSignatures  = true;  ///< Recognize statically linked library functions
+    bool useSSLCache         = true;  ///< Cache parsed SSL files in the cache directory
 
     /// The file in which the dotty graph is saved
     QString dotFile;
@@ -87,6 +94,31 @@ public:
     bool assumeABI         = false; ///< Assume ABI compliance
     bool experimental      = false; ///< Activate experimental code. Caution!
 
+    /// Maximum number of instructions kept in the decode cache (see \a decodeCache).
+    /// Instructions decoded after the cache is full are not cached.
+    int decodeCacheSize = 65536;
+
+    /// When true, generate code for procedures as soon as they are decompiled
+    /// and free their decompilation state afterwards.
+    bool streamDecompilation = false;
+
+    /// Maximum number of decompiled procedures kept in memory while waiting for their callers
+    /// in streaming mode. If exceeded, the oldest procedures are streamed out early.
+    /// This is a number of procedures, not a memory limit; the memory used by
+    /// a procedure depends on its size.
+    int streamProcBudget = 256;
+
+    /// Log the memory used by statements and expressions after decompilation
+    bool printMemoryReport = false;
+
+    /// Maximum time in seconds spent analysing a single procedure (0 = unlimited).
+    /// Procedures exceeding it are finalized without further propagation and type analysis.
+    int procTimeBudget = 0;
+
+    /// Maximum number of passes executed for a single procedure (0 = unlimited).
+    /// \sa procTimeBudget
+    int procPassBudget = 0;
+
     QString replayFile; ///< file with commands to execute in interactive mode
 
     /// A vector which contains all know entrypoints for the Prog.
@@ -103,4 +135,5 @@ private:
     QDir m_dataDirectory;
     QDir m_pluginDirectory;
     QDir m_outputDirectory;
+    QDir m_cacheDirectory;
 };
@@ -25,7 +25,7 @@ void IWatcher::onSignatureUpdated(Function *)
 }
 
 
-void IWatcher::onInstructionDecoded(Address, int)
+void IWatcher::onInstructionsDecoded(const std::vector<DecodedRange> &)
 {
 }
 
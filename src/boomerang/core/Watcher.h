@@ -13,11 +13,59 @@
 #include "boomerang/core/BoomerangAPI.h"
 #include "boomerang/util/Address.h"
 
+#include <cstdint>
+#include <vector>
+
 
 class Function;
 class UserProc;
 
 
+/// Kinds of events a watcher can subscribe to (see Project::addWatcher).
+enum class WatchEvent : uint8_t
+{
+    FunctionCreated,
+    FunctionRemoved,
+    SignatureUpdated,
+    StartDecode,
+    InstructionsDecoded,
+    BadDecode,
+    FunctionDecoded,
+    EndDecode,
+    StartDecompile,
+    ProcStatusChange,
+    EndDecompile,
+    FunctionDiscovered,
+    DecompileInProgress,
+    DecompileDebugPoint,
+    DecompilationEnd,
+
+    NumEvents
+};
+
+
+/// A set of WatchEvents, one bit per event kind.
+typedef uint32_t WatchEventMask;
+
+/// \returns the mask containing only the event \p event.
+constexpr WatchEventMask watchEventMask(WatchEvent event)
+{
+    return WatchEventMask(1) << static_cast<int>(event);
+}
+
+/// The mask containing all events.
+constexpr WatchEventMask ALL_WATCH_EVENTS = ~WatchEventMask(0);
+
+
+/// A range of consecutive decoded instructions.
+struct DecodedRange
+{
+    Address start;       ///< Address of the first instruction
+    int numBytes;        ///< Total size of all instructions in the range
+    int numInstructions; ///< Number of instructions in the range
+};
+
+
 /// Virtual class to monitor the decompilation.
 class BOOMERANG_API IWatcher
 {
@@ -38,9 +86,12 @@ public:
     /// Called once on decode start.
     virtual void onStartDecode(Address start, int numBytes);
 
-    /// Called every time an instruction is decoded.
-    /// \param numBytes the size of the instruction.
-    virtual void onInstructionDecoded(Address pc, int numBytes);
+    /**
+     * Called with batches of decoded instructions. Consecutive instructions are coalesced
+     * into ranges, and batches are delivered at a bounded rate. All instructions of a function
+     * are delivered before the function is reported by onFunctionDecoded.
+     */
+    virtual void onInstructionsDecoded(const std::vector<DecodedRange> &ranges);
 
     /// Called every time a function was decoded completely.
     virtual void onFunctionDecoded(Function *function, Address pc, Address last, int numBytes);
@@ -102,6 +102,7 @@ BasicBlock &BasicBlock::operator=(const BasicBlock &bb)
 void BasicBlock::setRTLs(std::unique_ptr<RTLList> rtls)
 {
     m_listOfRTLs = std::move(rtls);
+    layoutChanged();
     updateBBAddresses();
 
     if (!m_listOfRTLs) {
@@ -109,6 +110,8 @@ void BasicBlock::setRTLs(std::unique_ptr<RTLList> rtls)
     }
 
     for (auto &rtl : *m_listOfRTLs) {
+        rtl->setBB(this);
+
         for (Statement *stmt : *rtl) {
             assert(stmt != nullptr);
             stmt->setBB(this);
@@ -294,7 +297,7 @@ Function *BasicBlock::getCallDestProc() const
 }
 
 
-Statement *BasicBlock::getFirstStmt(RTLIterator &rit, StatementList::iterator &sit)
+Statement *BasicBlock::getFirstStmt(RTLIterator &rit, StatementList::const_iterator &sit)
 {
     if ((m_listOfRTLs == nullptr) || m_listOfRTLs->empty()) {
         return nullptr;
@@ -317,7 +320,7 @@ Statement *BasicBlock::getFirstStmt(RTLIterator &rit, StatementList::iterator &s
 }
 
 
-Statement *BasicBlock::getNextStmt(RTLIterator &rit, StatementList::iterator &sit)
+Statement *BasicBlock::getNextStmt(RTLIterator &rit, StatementList::const_iterator &sit)
 {
     if (++sit != (*rit)->end()) {
         return *sit; // End of current RTL not reached, so return next
@@ -335,7 +338,7 @@ Statement *BasicBlock::getNextStmt(RTLIterator &rit, StatementList::iterator &si
 }
 
 
-Statement *BasicBlock::getPrevStmt(RTLRIterator &rit, StatementList::reverse_iterator &sit)
+Statement *BasicBlock::getPrevStmt(RTLRIterator &rit, StatementList::const_reverse_iterator &sit)
 {
     if (++sit != (*rit)->rend()) {
         return *sit; // Beginning of current RTL not reached, so return next
@@ -353,7 +356,7 @@ Statement *BasicBlock::getPrevStmt(RTLRIterator &rit, StatementList::reverse_ite
 }
 
 
-Statement *BasicBlock::getLastStmt(RTLRIterator &rit, StatementList::reverse_iterator &sit)
+Statement *BasicBlock::getLastStmt(RTLRIterator &rit, StatementList::const_reverse_iterator &sit)
 {
     if (m_listOfRTLs == nullptr) {
         return nullptr;
@@ -643,6 +646,7 @@ ImplicitAssign *BasicBlock::addImplicitAssign(const SharedExp &lhs)
 
     if (m_listOfRTLs->empty() || m_listOfRTLs->front()->getAddress() != Address::ZERO) {
         m_listOfRTLs->push_front(std::unique_ptr<RTL>(new RTL(Address::ZERO)));
+        m_listOfRTLs->front()->setBB(this);
     }
 
     // do not allow BB with 2 zero address RTLs
@@ -677,6 +681,7 @@ PhiAssign *BasicBlock::addPhi(const SharedExp &usedExp)
 
     if (m_listOfRTLs->empty() || m_listOfRTLs->front()->getAddress() != Address::ZERO) {
         m_listOfRTLs->push_front(std::unique_ptr<RTL>(new RTL(Address::ZERO)));
+        m_listOfRTLs->front()->setBB(this);
     }
 
     // do not allow BB with 2 zero address RTLs
@@ -770,6 +775,15 @@ void BasicBlock::removeRTL(RTL *rtl)
 
     if (it != m_listOfRTLs->end()) {
         m_listOfRTLs->erase(it);
+        layoutChanged();
         updateBBAddresses();
     }
 }
+
+
+void BasicBlock::layoutChanged()
+{
+    if (m_function && !m_function->isLib()) {
+        static_cast<UserProc *>(m_function)->getCFG()->layoutChanged();
+    }
+}
@@ -193,6 +193,10 @@ public:
 
     void removeRTL(RTL *rtl);
 
+    /// Must be called whenever the RTLs of this BB or their statements change.
+    /// Invalidates the cached statement index of the proc (\sa ProcCFG::getLayoutVersion).
+    void layoutChanged();
+
     /**
      * Update the RTL list of this basic block. Takes ownership of the pointer.
      * \param rtls a list of RTLs
@@ -204,10 +208,10 @@ public:
      * Somewhat intricate because of the post call semantics; these funcs save a lot of duplicated,
      * easily-bugged code
      */
-    Statement *getFirstStmt(RTLIterator &rit, StatementList::iterator &sit);
-    Statement *getNextStmt(RTLIterator &rit, StatementList::iterator &sit);
-    Statement *getLastStmt(RTLRIterator &rit, StatementList::reverse_iterator &sit);
-    Statement *getPrevStmt(RTLRIterator &rit, StatementList::reverse_iterator &sit);
+    Statement *getFirstStmt(RTLIterator &rit, StatementList::const_iterator &sit);
+    Statement *getNextStmt(RTLIterator &rit, StatementList::const_iterator &sit);
+    Statement *getLastStmt(RTLRIterator &rit, StatementList::const_reverse_iterator &sit);
+    Statement *getPrevStmt(RTLRIterator &rit, StatementList::const_reverse_iterator &sit);
 
     Statement *getFirstStmt();
     const Statement *getFirstStmt() const;
@@ -0,0 +1,183 @@
+#pragma region License
+/*
+ * This file is part of the Boomerang Decompiler.
+ *
+ * See the file "LICENSE.TERMS" for information on usage and
+ * redistribution of this file, and for a DISCLAIMER OF ALL
+ * WARRANTIES.
+ */
+#pragma endregion License
+#include "CallGraphIndex.h"
+
+#include "boomerang/db/proc/UserProc.h"
+
+#include <algorithm>
+
+
+void CallGraphIndex::build(const std::vector<Function *> &procs)
+{
+    clear();
+
+    m_procs = procs;
+    m_indexOf.reserve(m_procs.size());
+
+    for (int i = 0; i < getNumProcs(); i++) {
+        m_indexOf[m_procs[i]] = i;
+    }
+
+    // callees
+    m_calleeOffsets.reserve(m_procs.size() + 1);
+    m_calleeOffsets.push_back(0);
+
+    for (Function *func : m_procs) {
+        if (!func->isLib()) {
+            for (Function *callee : static_cast<UserProc *>(func)->getCallees()) {
+                const int calleeIdx = getIndexOf(callee);
+                if (calleeIdx != -1) {
+                    m_callees.push_back(calleeIdx);
+                }
+            }
+        }
+
+        m_calleeOffsets.push_back(static_cast<int>(m_callees.size()));
+    }
+
+    // callers, by counting sort of the callee edges
+    m_callerOffsets.assign(m_procs.size() + 1, 0);
+    for (int callee : m_callees) {
+        m_callerOffsets[callee + 1]++;
+    }
+
+    for (std::size_t i = 1; i < m_callerOffsets.size(); i++) {
+        m_callerOffsets[i] += m_callerOffsets[i - 1];
+    }
+
+    m_callers.resize(m_callees.size());
+    std::vector<int> insertPos(m_callerOffsets.begin(), m_callerOffsets.end() - 1);
+
+    for (int caller = 0; caller < getNumProcs(); caller++) {
+        for (int callee : getCallees(caller)) {
+            m_callers[insertPos[callee]++] = caller;
+        }
+    }
+
+    computeSCCs();
+}
+
+
+void CallGraphIndex::clear()
+{
+    m_procs.clear();
+    m_indexOf.clear();
+    m_calleeOffsets.clear();
+    m_callees.clear();
+    m_callerOffsets.clear();
+    m_callers.clear();
+    m_numSCCs = 0;
+    m_scc.clear();
+    m_isRecursive.clear();
+    m_bottomUpOrder.clear();
+}
+
+
+int CallGraphIndex::getIndexOf(const Function *func) const
+{
+    auto it = m_indexOf.find(func);
+    return (it != m_indexOf.end()) ? it->second : -1;
+}
+
+
+CallGraphIndex::IndexRange CallGraphIndex::getCallees(int idx) const
+{
+    const int *data = m_callees.data();
+    return IndexRange(data + m_calleeOffsets[idx], data + m_calleeOffsets[idx + 1]);
+}
+
+
+CallGraphIndex::IndexRange CallGraphIndex::getCallers(int idx) const
+{
+    const int *data = m_callers.data();
+    return IndexRange(data + m_callerOffsets[idx], data + m_callerOffsets[idx + 1]);
+}
+
+
+void CallGraphIndex::computeSCCs()
+{
+    const int numProcs = getNumProcs();
+
+    m_scc.assign(numProcs, -1);
+    m_isRecursive.assign(numProcs, false);
+    m_bottomUpOrder.reserve(numProcs);
+
+    std::vector<int> dfsNum(numProcs, -1);
+    std::vector<int> lowLink(numProcs, 0);
+    std::vector<int> sccStack;
+    int nextDfsNum = 0;
+
+    // (proc, position of the next callee to visit)
+    std::vector<std::pair<int, int>> dfsStack;
+
+    for (int root = 0; root < numProcs; root++) {
+        if (dfsNum[root] != -1) {
+            continue;
+        }
+
+        dfsNum[root] = lowLink[root] = nextDfsNum++;
+        sccStack.push_back(root);
+        dfsStack.push_back({ root, m_calleeOffsets[root] });
+
+        while (!dfsStack.empty()) {
+            const int proc = dfsStack.back().first;
+            int &calleePos = dfsStack.back().second;
+
+            if (calleePos < m_calleeOffsets[proc + 1]) {
+                const int callee = m_callees[calleePos++];
+
+                if (dfsNum[callee] == -1) {
+                    dfsNum[callee] = lowLink[callee] = nextDfsNum++;
+                    sccStack.push_back(callee);
+                    dfsStack.push_back({ callee, m_calleeOffsets[callee] });
+                }
+                else if (m_scc[callee] == -1) {
+                    // callee is still on the SCC stack
+                    lowLink[proc] = std::min(lowLink[proc], dfsNum[callee]);
+                }
+
+                continue;
+            }
+
+            // all callees visited
+            if (lowLink[proc] == dfsNum[proc]) {
+                const std::size_t sccStart = m_bottomUpOrder.size();
+                int member;
+
+                do {
+                    member = sccStack.back();
+                    sccStack.pop_back();
+
+                    m_scc[member] = m_numSCCs;
+                    m_bottomUpOrder.push_back(member);
+                } while (member != proc);
+
+                const bool isGroup = m_bottomUpOrder.size() - sccStart > 1;
+
+                for (std::size_t i = sccStart; i < m_bottomUpOrder.size(); i++) {
+                    const int p      = m_bottomUpOrder[i];
+                    IndexRange calls = getCallees(p);
+
+                    m_isRecursive[p] = isGroup ||
+                                       std::find(calls.begin(), calls.end(), p) != calls.end();
+                }
+
+                m_numSCCs++;
+            }
+
+            dfsStack.pop_back();
+
+            if (!dfsStack.empty()) {
+                const int caller = dfsStack.back().first;
+                lowLink[caller]  = std::min(lowLink[caller], lowLink[proc]);
+            }
+        }
+    }
+}
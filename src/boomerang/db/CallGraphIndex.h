@@ -0,0 +1,119 @@
+#pragma region License
+/*
+ * This file is part of the Boomerang Decompiler.
+ *
+ * See the file "LICENSE.TERMS" for information on usage and
+ * redistribution of this file, and for a DISCLAIMER OF ALL
+ * WARRANTIES.
+ */
+#pragma endregion License
+#pragma once
+
+
+#include "boomerang/core/BoomerangAPI.h"
+
+#include <unordered_map>
+#include <vector>
+
+
+class Function;
+
+
+/**
+ * Compact snapshot of the call graph of a program.
+ * Every procedure gets a dense index; callees and callers of each procedure are stored
+ * in contiguous arrays (compressed sparse rows), so they can be iterated without
+ * touching the procedures themselves.
+ *
+ * On construction, the strongly connected components of the call graph (i.e. the
+ * recursion groups) and a bottom-up order of all procedures are computed as well.
+ *
+ * \sa Prog::getCallGraph
+ */
+class BOOMERANG_API CallGraphIndex
+{
+public:
+    /// A range of procedure indices.
+    class IndexRange
+    {
+    public:
+        IndexRange(const int *begin, const int *end)
+            : m_begin(begin)
+            , m_end(end)
+        {
+        }
+
+        const int *begin() const { return m_begin; }
+        const int *end() const { return m_end; }
+
+        bool empty() const { return m_begin == m_end; }
+        int size() const { return static_cast<int>(m_end - m_begin); }
+
+    private:
+        const int *m_begin;
+        const int *m_end;
+    };
+
+public:
+    CallGraphIndex() = default;
+
+public:
+    /// Build the index for \p procs. Callees not contained in \p procs are ignored.
+    void build(const std::vector<Function *> &procs);
+
+    /// Remove all procedures from the index.
+    void clear();
+
+    int getNumProcs() const { return static_cast<int>(m_procs.size()); }
+
+    /// \returns the index of \p func, or -1 if \p func is not part of the call graph.
+    int getIndexOf(const Function *func) const;
+
+    /// \returns the procedure with index \p idx.
+    Function *getProc(int idx) const { return m_procs[idx]; }
+
+    /// \returns the indices of the procedures called by procedure \p idx,
+    /// in the order they were added to the procedure.
+    IndexRange getCallees(int idx) const;
+
+    /// \returns the indices of the procedures calling procedure \p idx.
+    IndexRange getCallers(int idx) const;
+
+    /// \returns the number of strongly connected components.
+    int getNumSCCs() const { return m_numSCCs; }
+
+    /**
+     * \returns the strongly connected component containing procedure \p idx.
+     * Components are numbered bottom-up, i.e. a component only calls
+     * components with a lower or equal number.
+     */
+    int getSCC(int idx) const { return m_scc[idx]; }
+
+    /// \returns true if procedure \p idx can call itself, directly or indirectly.
+    bool isRecursive(int idx) const { return m_isRecursive[idx]; }
+
+    /**
+     * \returns the indices of all procedures in bottom-up order, i.e. callees come before
+     * their callers, except for calls inside a recursion group.
+     * The members of each strongly connected component are adjacent.
+     */
+    const std::vector<int> &getBottomUpOrder() const { return m_bottomUpOrder; }
+
+private:
+    /// Find the strongly connected components (iterative version of Tarjan's algorithm).
+    void computeSCCs();
+
+private:
+    std::vector<Function *> m_procs;
+    std::unordered_map<const Function *, int> m_indexOf;
+
+    std::vector<int> m_calleeOffsets; ///< Callees of proc i are at [offsets[i], offsets[i+1])
+    std::vector<int> m_callees;
+    std::vector<int> m_callerOffsets; ///< Callers of proc i are at [offsets[i], offsets[i+1])
+    std::vector<int> m_callers;
+
+    int m_numSCCs = 0;
+    std::vector<int> m_scc;
+    std::vector<bool> m_isRecursive;
+    std::vector<int> m_bottomUpOrder;
+};
@@ -300,7 +300,7 @@ bool DataFlow::placePhiFunctions()
     // Recreate each call because propagation and other changes make old data invalid
     for (int n = 0; n < numBB; n++) {
         BasicBlock::RTLIterator rit;
-        StatementList::iterator sit;
+        StatementList::const_iterator sit;
         BasicBlock *bb = m_BBs[n];
 
         for (Statement *stmt = bb->getFirstStmt(rit, sit); stmt; stmt = bb->getNextStmt(rit, sit)) {
@@ -376,7 +376,7 @@ void DataFlow::convertImplicits()
     ProcCFG *cfg = m_proc->getCFG();
 
     // Convert statements in A_phi from m[...]{-} to m[...]{0}
-    std::map<SharedExp, std::set<int>, lessExpStar> A_phi_copy = m_A_phi; // Object copy
+    ExpHashMap<std::set<int>> A_phi_copy = m_A_phi; // Object copy
     ImplicitConverter ic(cfg);
     m_A_phi.clear();
 
@@ -413,14 +413,14 @@ void DataFlow::convertImplicits()
 
 
 void DataFlow::findLiveAtDomPhi(LocationSet &usedByDomPhi, LocationSet &usedByDomPhi0,
-                                std::map<SharedExp, PhiAssign *, lessExpStar> &defdByPhi)
+                                ExpHashMap<PhiAssign *> &defdByPhi)
 {
     return findLiveAtDomPhi(0, usedByDomPhi, usedByDomPhi0, defdByPhi);
 }
 
 
 void DataFlow::findLiveAtDomPhi(int n, LocationSet &usedByDomPhi, LocationSet &usedByDomPhi0,
-                                std::map<SharedExp, PhiAssign *, lessExpStar> &defdByPhi)
+                                ExpHashMap<PhiAssign *> &defdByPhi)
 {
     if (m_BBs.empty()) {
         return;
@@ -428,7 +428,7 @@ void DataFlow::findLiveAtDomPhi(int n, LocationSet &usedByDomPhi, LocationSet &u
 
     // For each statement this BB
     BasicBlock::RTLIterator rit;
-    StatementList::iterator sit;
+    StatementList::const_iterator sit;
     BasicBlock *bb                 = m_BBs[n];
     const bool assumeABICompliance = m_proc->getProg()->getProject()->getSettings()->assumeABI;
 
@@ -10,6 +10,7 @@
 #pragma once
 
 
+#include "boomerang/ssl/exp/ExpHelp.h"
 #include "boomerang/util/LocationSet.h"
 
 #include <map>
@@ -77,7 +78,7 @@ public:
      * use or not.
      */
     void findLiveAtDomPhi(LocationSet &usedByDomPhi, LocationSet &usedByDomPhi0,
-                          std::map<SharedExp, PhiAssign *, lessExpStar> &defdByPhi);
+                          ExpHashMap<PhiAssign *> &defdByPhi);
 
     // for testing
 public:
@@ -140,7 +141,7 @@ private:
     void allocateData();
 
     void findLiveAtDomPhi(int n, LocationSet &usedByDomPhi, LocationSet &usedByDomPhi0,
-                          std::map<SharedExp, PhiAssign *, lessExpStar> &defdByPhi);
+                          ExpHashMap<PhiAssign *> &defdByPhi);
 
 private:
     UserProc *m_proc = nullptr;
@@ -177,16 +178,17 @@ private:
     std::vector<ExSet> m_definedAt; // was: m_A_orig
 
     /// For a given expression e, stores the BBs needing a phi for e
-    std::map<SharedExp, std::set<int>, lessExpStar> m_A_phi;
+    ExpHashMap<std::set<int>> m_A_phi;
 
-    /// For a given expression e, stores the BBs where e is defined
+    /// For a given expression e, stores the BBs where e is defined.
+    /// This is ordered since it determines the order in which phi functions are placed.
     std::map<SharedExp, std::set<int>, lessExpStar> m_defsites;
 
     /// Set of block numbers defining all variables
     std::set<int> m_defallsites;
 
     /// A Boomerang requirement: Statements defining particular subscripted locations
-    std::map<SharedExp, Statement *, lessExpStar> m_defStmts;
+    ExpHashMap<Statement *> m_defStmts;
 
     /**
      * Initially false, meaning that locals and parameters are not renamed and hence not propagated.
@@ -14,6 +14,8 @@
 
 #include <QtAlgorithms>
 
+#include <algorithm>
+
 
 DefCollector::~DefCollector()
 {
@@ -28,19 +30,34 @@ void DefCollector::clear()
 }
 
 
-void DefCollector::updateDefs(std::map<SharedExp, std::deque<Statement *>, lessExpStar> &Stacks,
-                              UserProc *proc)
+void DefCollector::updateDefs(ExpHashMap<std::deque<Statement *>> &Stacks, UserProc *proc)
 {
+    // Apart from its own LHS, a definition can only define other locations if its LHS
+    // has the form foo@[m:n]. Without such definitions, the (linear) search
+    // for matching locations can be skipped.
+    bool hasAtDefs = std::any_of(m_defs.begin(), m_defs.end(), [](const Assign *def) {
+        return def->getLeft()->getOper() == opAt;
+    });
+
     for (auto &Stack : Stacks) {
         if (Stack.second.empty()) {
             continue; // This variable's definition doesn't reach here
         }
 
+        // Check first, so no Assign is created for locations that already have a definition
+        // (e.g. when renaming again)
+        const SharedExp &loc = Stack.first;
+        if (m_defs.lookupLoc(loc) != nullptr || (hasAtDefs && m_defs.definesLoc(loc))) {
+            continue;
+        }
+
         // Create an assignment of the form loc := loc{def}
-        auto re    = RefExp::get(Stack.first->clone(), Stack.second.back());
-        Assign *as = new Assign(Stack.first->clone(), re);
+        auto re    = RefExp::get(loc->clone(), Stack.second.back());
+        Assign *as = new Assign(loc->clone(), re);
         as->setProc(proc); // Simplify sometimes needs this
-        insert(as);
+        m_defs.insert(as);
+
+        hasAtDefs |= loc->getOper() == opAt;
     }
 
     m_initialised = true;
@@ -89,8 +106,27 @@ void DefCollector::print(OStream &os) const
 }
 
 
+bool DefCollector::existsOnLeft(SharedExp e) const
+{
+    // Fast path: the definitions are sorted by their LHS
+    const Assign *def = m_defs.lookupLoc(e);
+    if (def && def->definesLoc(e)) {
+        return true;
+    }
+
+    // e.g. wildcards or foo@[m:n]
+    return m_defs.definesLoc(e);
+}
+
+
 SharedExp DefCollector::findDefFor(SharedExp e) const
 {
+    // Fast path: the definitions are sorted by their LHS
+    const Assign *sameLoc = m_defs.lookupLoc(e);
+    if (sameLoc && *sameLoc->getLeft() == *e) {
+        return sameLoc->getRight();
+    }
+
     for (Assign *def : m_defs) {
         SharedExp lhs = def->getLeft();
 
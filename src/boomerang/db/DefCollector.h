@@ -67,14 +67,15 @@ public:
     /// Print the collected locations to stream os
     void print(OStream &os) const;
 
-    bool existsOnLeft(SharedExp e) const { return m_defs.definesLoc(e); }
+    /// \returns true if this collector contains a definition of \p e
+    bool existsOnLeft(SharedExp e) const;
 
     /**
      * Update the definitions with the current set of reaching definitions
-     * proc is the enclosing procedure
+     * proc is the enclosing procedure.
+     * Locations that already have a definition in this collector keep it.
      */
-    void updateDefs(std::map<SharedExp, std::deque<Statement *>, lessExpStar> &Stacks,
-                    UserProc *proc);
+    void updateDefs(ExpHashMap<std::deque<Statement *>> &Stacks, UserProc *proc);
 
     /**
      * Find the definition for a location.
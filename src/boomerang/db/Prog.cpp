@@ -13,6 +13,7 @@
 #include "boomerang/c/parser/AnsiCParser.h"
 #include "boomerang/core/Project.h"
 #include "boomerang/core/Settings.h"
+#include "boomerang/db/CallGraphIndex.h"
 #include "boomerang/db/DebugInfo.h"
 #include "boomerang/db/Global.h"
 #include "boomerang/db/binary/BinaryFile.h"
@@ -20,6 +21,8 @@
 #include "boomerang/db/binary/BinarySection.h"
 #include "boomerang/db/binary/BinarySymbol.h"
 #include "boomerang/db/binary/BinarySymbolTable.h"
+#include "boomerang/db/binary/ByteSignatureMatcher.h"
+#include "boomerang/db/binary/StringLiteralIndex.h"
 #include "boomerang/db/module/Module.h"
 #include "boomerang/db/proc/LibProc.h"
 #include "boomerang/db/proc/ProcCFG.h"
@@ -45,6 +48,7 @@
 #include "boomerang/util/log/Log.h"
 
 #include <QDir>
+#include <QFile>
 #include <QFileInfo>
 #include <QSaveFile>
 
@@ -72,6 +76,7 @@ void Prog::setFrontEnd(IFrontEnd *frontEnd)
 {
     m_fe = frontEnd;
 
+    invalidateCallGraph();
     m_moduleList.clear();
     m_rootModule = getOrInsertModule(m_name);
 }
@@ -266,6 +271,8 @@ bool Prog::removeFunction(const QString &name)
 
     if (function) {
         function->removeFromModule();
+        m_proofCache.invalidate(function);
+        invalidateCallGraph();
         m_project->alertFunctionRemoved(function);
         // FIXME: this function removes the function from module, but it leaks it
         return true;
@@ -372,6 +379,35 @@ void Prog::readDefaultLibraryCatalogues()
 }
 
 
+int Prog::recognizeStaticLibraryFunctions()
+{
+    QString sigFileName;
+    if (m_binaryFile && m_binaryFile->getFormat() == LoadFmt::PE &&
+        getMachine() == Machine::PENTIUM) {
+        // MinGW runtime functions; the other formats and compilers have no signatures yet
+        sigFileName = "signatures/mingw32.sig";
+    }
+
+    const QDir dataDir    = m_project->getSettings()->getDataDirectory();
+    const QString sigPath = dataDir.absoluteFilePath(sigFileName);
+
+    if (!m_binaryFile || sigFileName.isEmpty() || !QFile::exists(sigPath)) {
+        return 0; // no signatures for this machine
+    }
+
+    ByteSignatureMatcher matcher;
+    if (!matcher.readSignatureFile(sigPath)) {
+        return 0;
+    }
+
+    const int numRecognized = matcher.recognizeFunctions(m_binaryFile->getImage(),
+                                                         m_binaryFile->getSymbols());
+
+    LOG_MSG("Recognized %1 statically linked library functions", numRecognized);
+    return numRecognized;
+}
+
+
 bool Prog::addSymbolsFromSymbolFile(const QString &fname)
 {
     return m_symbolProvider->addSymbolsFromSymbolFile(fname);
@@ -411,6 +447,12 @@ const char *Prog::getStringConstant(Address addr, bool knownString /* = false */
         return nullptr;
     }
 
+    const StringLiteralIndex::StringLiteral *lit = getStringLiterals().findLiteral(addr);
+    if (lit) {
+        return lit->data + (addr - lit->addr).value();
+    }
+
+    // Not an indexed literal, e.g. a string in a code section or a very short string
     const BinarySection *sect = m_binaryFile->getImage()->getSectionByAddr(addr);
 
     // Too many compilers put constants, including string constants,
@@ -441,7 +483,7 @@ const char *Prog::getStringConstant(Address addr, bool knownString /* = false */
         else if (std::isprint(static_cast<Byte>(p[i]))) {
             numPrintables++;
         }
-        else if (*p == '\n' || *p == '\t' || *p == '\r') {
+        else if (p[i] == '\n' || p[i] == '\t' || p[i] == '\r') {
             numControl++;
         }
     }
@@ -518,9 +560,48 @@ bool Prog::isReadOnly(Address a) const
 
 bool Prog::isInStringsSection(Address a) const
 {
+    const StringLiteralIndex::StringLiteral *lit = getStringLiterals().findLiteral(a);
+    if (lit && lit->stringsRange != StringLiteralIndex::StringsRange::Partial) {
+        return lit->stringsRange == StringLiteralIndex::StringsRange::Inside;
+    }
+
     const BinarySection *si = static_cast<const BinarySection *>(
         m_binaryFile->getImage()->getSectionByAddr(a));
-    return si && si->isAttributeInRange("StringsSection", a, a + 1);
+    return si && si->isStringsRange(a, a + 1);
+}
+
+
+const CallGraphIndex &Prog::getCallGraph() const
+{
+    if (!m_callGraph) {
+        std::vector<Function *> procs;
+
+        for (const auto &module : m_moduleList) {
+            procs.insert(procs.end(), module->begin(), module->end());
+        }
+
+        m_callGraph.reset(new CallGraphIndex);
+        m_callGraph->build(procs);
+    }
+
+    return *m_callGraph;
+}
+
+
+void Prog::invalidateCallGraph()
+{
+    m_callGraph.reset();
+}
+
+
+const StringLiteralIndex &Prog::getStringLiterals() const
+{
+    if (!m_stringLiterals) {
+        m_stringLiterals.reset(new StringLiteralIndex);
+        m_stringLiterals->build(m_binaryFile ? m_binaryFile->getImage() : nullptr);
+    }
+
+    return *m_stringLiterals;
 }
 
 
@@ -12,6 +12,7 @@
 
 #include "boomerang/core/BoomerangAPI.h"
 #include "boomerang/db/Global.h"
+#include "boomerang/db/ProofCache.h"
 #include "boomerang/db/binary/BinaryFile.h"
 #include "boomerang/db/module/ModuleFactory.h"
 #include "boomerang/frontend/SigEnum.h"
@@ -30,6 +31,7 @@ class ArrayType;
 class BinaryFile;
 class BinarySection;
 class BinarySymbol;
+class CallGraphIndex;
 class Function;
 class IFrontEnd;
 class LibProc;
@@ -37,6 +39,7 @@ class Module;
 class Project;
 class Signature;
 class ISymbolProvider;
+class StringLiteralIndex;
 
 
 class BOOMERANG_API Prog
@@ -152,6 +155,13 @@ public:
     Machine getMachine() const;
 
     void readDefaultLibraryCatalogues();
+
+    /// Recognize statically linked library functions using the default byte signatures
+    /// for this binary format and machine, so they become library procedures
+    /// instead of being decompiled.
+    /// \returns the number of recognized functions.
+    int recognizeStaticLibraryFunctions();
+
     bool addSymbolsFromSymbolFile(const QString &fname);
     std::shared_ptr<Signature> getLibSignature(const QString &name);
 
@@ -197,6 +207,19 @@ public:
 
     const std::list<UserProc *> &getEntryProcs() const { return m_entryProcs; }
 
+    /// \returns the cache for the results of preservation proofs of all procedures.
+    ProofCache &getProofCache() { return m_proofCache; }
+
+    /**
+     * \returns the call graph of all procedures of the program.
+     * It is rebuilt on first use after procedures or calls were added or removed;
+     * the returned reference is only valid until then.
+     */
+    const CallGraphIndex &getCallGraph() const;
+
+    /// Called when procedures or calls between procedures were added or removed.
+    void invalidateCallGraph();
+
     // globals
 
     /**
@@ -246,6 +269,10 @@ public:
     /// Set the type of a global variable
     void setGlobalType(const QString &name, SharedType ty);
 
+private:
+    /// \returns the index of string literals in the binary file; it is built on first use.
+    const StringLiteralIndex &getStringLiterals() const;
+
 private:
     QString m_name; ///< name of the program
     std::unique_ptr<ISymbolProvider> m_symbolProvider;
@@ -261,4 +288,9 @@ private:
     // FIXME: is a set of Globals the most appropriate data structure? Surely not.
     GlobalSet m_globals;         ///< globals to print at code generation time
     DataIntervalMap m_globalMap; ///< Map from address to DataInterval (has size, name, type)
+
+    ProofCache m_proofCache;
+
+    mutable std::unique_ptr<StringLiteralIndex> m_stringLiterals;
+    mutable std::unique_ptr<CallGraphIndex> m_callGraph;
 };
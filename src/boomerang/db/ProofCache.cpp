@@ -0,0 +1,130 @@
+#pragma region License
+/*
+ * This file is part of the Boomerang Decompiler.
+ *
+ * See the file "LICENSE.TERMS" for information on usage and
+ * redistribution of this file, and for a DISCLAIMER OF ALL
+ * WARRANTIES.
+ */
+#pragma endregion License
+#include "ProofCache.h"
+
+#include "boomerang/ssl/exp/Const.h"
+
+
+bool ProofCache::lookup(const Function *proc, const SharedConstExp &loc, int offset,
+                        bool &result)
+{
+    auto procIt = m_results.find(proc);
+    if (procIt == m_results.end()) {
+        return false;
+    }
+
+    auto it = procIt->second.find({ loc, offset });
+    if (it == procIt->second.end()) {
+        return false;
+    }
+
+    for (const auto &[func, version] : it->second.dependencies) {
+        if (getVersion(func) != version) {
+            return false; // stale
+        }
+    }
+
+    // A proof using this result depends on everything the result depends on
+    for (const auto &dependency : it->second.dependencies) {
+        addDependency(dependency.first);
+    }
+
+    result = it->second.proven;
+    return true;
+}
+
+
+void ProofCache::store(const Function *proc, const SharedConstExp &loc, int offset, bool result)
+{
+    Result &res = m_results[proc][{ loc->clone(), offset }];
+    res.proven  = result;
+    res.dependencies.clear();
+    res.dependencies.reserve(m_dependencies.size());
+
+    for (const Function *func : m_dependencies) {
+        res.dependencies.push_back({ func, getVersion(func) });
+    }
+}
+
+
+void ProofCache::beginProof(const Function *proc)
+{
+    if (m_proofDepth++ == 0) {
+        m_dependencies.clear();
+    }
+
+    addDependency(proc);
+}
+
+
+void ProofCache::endProof()
+{
+    assert(m_proofDepth > 0);
+    m_proofDepth--;
+}
+
+
+void ProofCache::addDependency(const Function *func)
+{
+    if (func && m_proofDepth > 0) {
+        m_dependencies.insert(func);
+    }
+}
+
+
+void ProofCache::invalidate(const Function *func)
+{
+    m_versions[func]++;
+    m_results.erase(func);
+}
+
+
+void ProofCache::clear()
+{
+    m_results.clear();
+    m_versions.clear();
+    m_dependencies.clear();
+}
+
+
+bool ProofCache::getPreservationOffset(const SharedConstExp &left, const SharedConstExp &right,
+                                       int &offset)
+{
+    if (*left == *right) {
+        offset = 0;
+        return true;
+    }
+    else if ((right->getOper() != opPlus && right->getOper() != opMinus) ||
+             !right->getSubExp2()->isIntConst() || !(*right->getSubExp1() == *left)) {
+        return false;
+    }
+
+    const int value = right->access<const Const, 2>()->getInt();
+    offset          = (right->getOper() == opPlus) ? value : -value;
+    return true;
+}
+
+
+bool ProofCache::ResultKeyLess::operator()(const std::pair<SharedConstExp, int> &lhs,
+                                           const std::pair<SharedConstExp, int> &rhs) const
+{
+    if (lhs.second != rhs.second) {
+        return lhs.second < rhs.second;
+    }
+
+    return lessExpStar()(lhs.first, rhs.first);
+}
+
+
+std::size_t ProofCache::getVersion(const Function *func) const
+{
+    auto it = m_versions.find(func);
+    return it != m_versions.end() ? it->second : 0;
+}
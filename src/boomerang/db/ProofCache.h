@@ -0,0 +1,108 @@
+#pragma region License
+/*
+ * This file is part of the Boomerang Decompiler.
+ *
+ * See the file "LICENSE.TERMS" for information on usage and
+ * redistribution of this file, and for a DISCLAIMER OF ALL
+ * WARRANTIES.
+ */
+#pragma endregion License
+#pragma once
+
+
+#include "boomerang/ssl/exp/ExpHelp.h"
+
+#include <map>
+#include <set>
+#include <unordered_map>
+#include <vector>
+
+
+class Function;
+
+
+/**
+ * Program wide cache for the results of preservation proofs,
+ * i.e. proofs of the form loc = loc + offset for a procedure (see UserProc::proveEqual).
+ *
+ * Both successful and failed proofs are cached. A result depends on the procedure
+ * it was proven for and on the summaries of all procedures consulted during the proof.
+ * Every procedure has a version number which is increased by invalidate();
+ * cached results are only returned if none of their dependencies was invalidated since.
+ */
+class BOOMERANG_API ProofCache
+{
+public:
+    ProofCache() = default;
+
+public:
+    /**
+     * Look up the result of proving loc = loc + offset for \p proc.
+     * If a proof is in progress, it inherits all dependencies of the cached result.
+     * \param result set to the cached result, if any.
+     * \returns true if a valid result was found.
+     */
+    bool lookup(const Function *proc, const SharedConstExp &loc, int offset, bool &result);
+
+    /// Store the result of the last top level proof for \p proc.
+    /// The dependencies recorded during this proof are stored along with it.
+    void store(const Function *proc, const SharedConstExp &loc, int offset, bool result);
+
+    /// Start a (possibly nested) proof for \p proc.
+    void beginProof(const Function *proc);
+
+    /// End the proof started by the last call to beginProof().
+    void endProof();
+
+    /// Record that the proof in progress depends on the summary of \p func.
+    void addDependency(const Function *func);
+
+    /// Called when a procedure assumes a new premise for recursion group analysis.
+    void addPremise() { m_numPremises++; }
+
+    /// Called when a premise added by addPremise() is removed again.
+    void removePremise() { m_numPremises--; }
+
+    /// \returns true if any procedure currently assumes a premise.
+    /// Proofs done while premises exist are conditional on them and must not be cached.
+    bool hasPremises() const { return m_numPremises > 0; }
+
+    /// Discard all results that depend on \p func, e.g. because its statements,
+    /// its return statement or its proven preservations have changed.
+    void invalidate(const Function *func);
+
+    /// Discard all results.
+    void clear();
+
+    /**
+     * Split the equation \p left = \p right into loc = loc + offset.
+     * \returns false if the equation does not have the form of a preservation.
+     */
+    static bool getPreservationOffset(const SharedConstExp &left, const SharedConstExp &right,
+                                      int &offset);
+
+private:
+    struct Result
+    {
+        bool proven;
+        std::vector<std::pair<const Function *, std::size_t>> dependencies;
+    };
+
+    struct ResultKeyLess
+    {
+        bool operator()(const std::pair<SharedConstExp, int> &lhs,
+                        const std::pair<SharedConstExp, int> &rhs) const;
+    };
+
+    using ResultMap = std::map<std::pair<SharedConstExp, int>, Result, ResultKeyLess>;
+
+    std::size_t getVersion(const Function *func) const;
+
+private:
+    std::unordered_map<const Function *, ResultMap> m_results;
+    std::unordered_map<const Function *, std::size_t> m_versions;
+
+    int m_proofDepth  = 0;
+    int m_numPremises = 0;
+    std::set<const Function *> m_dependencies; ///< Dependencies of the current top level proof
+};
@@ -227,7 +227,7 @@ bool BinaryImage::isReadOnly(Address addr) const
         return true;
     }
 
-    return section->isAttributeInRange("ReadOnly", addr, addr + 1);
+    return section->isReadOnlyRange(addr, addr + 1);
 }
 
 
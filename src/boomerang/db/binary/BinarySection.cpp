@@ -9,29 +9,25 @@
 #pragma endregion License
 #include "BinarySection.h"
 
-#include "boomerang/util/IntervalMap.h"
 #include "boomerang/util/IntervalSet.h"
 #include "boomerang/util/Util.h"
 #include "boomerang/util/log/Log.h"
 
-#include <QVariantMap>
+#include <algorithm>
+#include <vector>
 
 
-struct VariantHolder
+class BinarySectionImpl
 {
-    mutable QVariantMap val;
-    QVariantMap &get() const { return val; }
-    VariantHolder &operator+=(const VariantHolder &other)
+public:
+    /// A range of addresses with the same attributes
+    struct AttrRange
     {
-        val = val.unite(other.val);
-        return *this;
-    }
+        Address from;
+        Address to;
+        uint8_t attrs; ///< bitwise or of SectionAttr
+    };
 
-    bool operator==(const VariantHolder &other) const { return val == other.val; }
-};
-
-class BinarySectionImpl
-{
 public:
     void clearDefinedArea() { m_hasDefinedValue.clear(); }
 
@@ -45,58 +41,108 @@ public:
         return !m_hasDefinedValue.isContained(a);
     }
 
-    void setAttributeForRange(const QString &name, const QVariant &val, Address from, Address to)
+    void addAttributes(uint8_t attrs, Address from, Address to)
     {
-        QVariantMap vmap;
+        if (from >= to) {
+            return;
+        }
 
-        vmap[name] = val;
-        VariantHolder map{ vmap };
-        m_attributeMap.insert(from, to, map);
-    }
+        // Split all ranges overlapping [from, to) at from and to, so the ranges stay disjoint
+        std::vector<AttrRange> result;
+        result.reserve(m_attributes.size() + 3);
+        Address pos = from; // start of the part of [from, to) not yet added
 
-    QVariant attributeInRange(const QString &attrib, Address from, Address to) const
-    {
-        auto startIt = m_attributeMap.find(from);
-        auto endIt   = m_attributeMap.find(to);
+        for (const AttrRange &range : m_attributes) {
+            if (range.to <= from) {
+                result.push_back(range);
+                continue;
+            }
+            else if (range.from >= to) {
+                if (pos < to) {
+                    result.push_back({ pos, to, attrs });
+                    pos = to;
+                }
+
+                result.push_back(range);
+                continue;
+            }
+
+            if (range.from < from) {
+                result.push_back({ range.from, from, range.attrs });
+            }
+            else if (pos < range.from) {
+                result.push_back({ pos, range.from, attrs });
+            }
+
+            const Address overlapEnd = std::min(range.to, to);
+            result.push_back({ std::max(range.from, from), overlapEnd,
+                               static_cast<uint8_t>(range.attrs | attrs) });
+            pos = overlapEnd;
 
-        if (startIt == m_attributeMap.end()) {
-            return QVariant();
+            if (range.to > to) {
+                result.push_back({ to, range.to, range.attrs });
+            }
         }
 
-        QList<QVariant> vals;
+        if (pos < to) {
+            result.push_back({ pos, to, attrs });
+        }
 
-        for (auto iter = startIt; iter != endIt; ++iter) {
-            if (iter->second.get().contains(attrib)) {
-                vals << iter->second.get()[attrib];
+        // merge adjacent ranges with the same attributes
+        m_attributes.clear();
+        for (const AttrRange &range : result) {
+            if (!m_attributes.empty() && m_attributes.back().to == range.from &&
+                m_attributes.back().attrs == range.attrs) {
+                m_attributes.back().to = range.to;
+            }
+            else {
+                m_attributes.push_back(range);
             }
         }
+    }
 
-        if (vals.size() == 1) {
-            return vals.front();
+    uint8_t getAttributes(Address from, Address to) const
+    {
+        // first range ending after from
+        auto it = std::upper_bound(m_attributes.begin(), m_attributes.end(), from,
+                                   [](Address addr, const AttrRange &range) {
+                                       return addr < range.to;
+                                   });
+
+        uint8_t attrs = 0;
+        for (; it != m_attributes.end() && it->from < to; ++it) {
+            attrs |= it->attrs;
         }
 
-        return QVariant(vals);
+        return attrs;
     }
 
-    QVariantMap getAttributesForRange(Address from, Address to)
+    /// \returns the attributes that all addresses in [from, to) have in common
+    uint8_t getCommonAttributes(Address from, Address to) const
     {
-        QVariantMap res;
-        auto v = m_attributeMap.equalRange(from, to);
+        auto it = std::upper_bound(m_attributes.begin(), m_attributes.end(), from,
+                                   [](Address addr, const AttrRange &range) {
+                                       return addr < range.to;
+                                   });
 
-        if (v.first == m_attributeMap.end()) {
-            return res;
-        }
+        uint8_t attrs = 0xFF;
+        Address pos   = from; // all addresses before pos are covered
+
+        for (; it != m_attributes.end() && it->from < to && pos < to; ++it) {
+            if (it->from > pos) {
+                return 0; // gap without attributes
+            }
 
-        for (auto iter = v.first; iter != v.second; ++iter) {
-            res.unite(iter->second.get());
+            attrs &= it->attrs;
+            pos = it->to;
         }
 
-        return res;
+        return (pos >= to) ? attrs : 0;
     }
 
 public:
     IntervalSet<Address> m_hasDefinedValue;
-    IntervalMap<Address, VariantHolder> m_attributeMap;
+    std::vector<AttrRange> m_attributes; ///< Sorted, disjoint ranges with their attributes
 };
 
 
@@ -170,20 +216,25 @@ void BinarySection::addDefinedArea(Address from, Address to)
 }
 
 
-void BinarySection::setAttributeForRange(const QString &name, const QVariant &val, Address from,
-                                         Address to)
+void BinarySection::setAttributeForRange(SectionAttr attr, Address from, Address to)
+{
+    m_impl->addAttributes(static_cast<uint8_t>(attr), from, to);
+}
+
+
+bool BinarySection::isAttributeInRange(SectionAttr attr, Address from, Address to) const
 {
-    m_impl->setAttributeForRange(name, val, from, to);
+    return (m_impl->getAttributes(from, to) & static_cast<uint8_t>(attr)) != 0;
 }
 
 
-QVariantMap BinarySection::getAttributesForRange(Address from, Address to)
+bool BinarySection::isAttributeInWholeRange(SectionAttr attr, Address from, Address to) const
 {
-    return m_impl->getAttributesForRange(from, to);
+    return from < to && (m_impl->getCommonAttributes(from, to) & static_cast<uint8_t>(attr)) != 0;
 }
 
 
-bool BinarySection::isAttributeInRange(const QString &attrib, Address from, Address to) const
+bool BinarySection::hasAttributesInRange(Address from, Address to) const
 {
-    return !m_impl->attributeInRange(attrib, from, to).isNull();
+    return m_impl->getAttributes(from, to) != 0;
 }
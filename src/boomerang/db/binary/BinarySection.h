@@ -15,10 +15,14 @@
 #include "boomerang/util/Types.h"
 
 #include <QString>
-#include <QVariant>
 
 
-class QVariant;
+/// Attributes of address ranges of a section, see BinarySection::setAttributeForRange
+enum class SectionAttr : uint8_t
+{
+    StringsSection = 1 << 0, ///< The range contains string literals only
+    ReadOnly       = 1 << 1, ///< The range is read-only, even if the whole section is not
+};
 
 
 /// File-format independent access to sections of binary files.
@@ -65,9 +69,28 @@ public:
     void clearDefinedArea();
     void addDefinedArea(Address from, Address to);
 
-    void setAttributeForRange(const QString &name, const QVariant &val, Address from, Address to);
-    QVariantMap getAttributesForRange(Address from, Address to);
-    bool isAttributeInRange(const QString &attrib, Address from, Address to) const;
+    /// Give all addresses in [\p from, \p to) the attribute \p attr.
+    void setAttributeForRange(SectionAttr attr, Address from, Address to);
+
+    /// \returns true if any address in [\p from, \p to) has the attribute \p attr.
+    bool isAttributeInRange(SectionAttr attr, Address from, Address to) const;
+
+    /// \returns true if all addresses in the non-empty range [\p from, \p to)
+    /// have the attribute \p attr.
+    bool isAttributeInWholeRange(SectionAttr attr, Address from, Address to) const;
+
+    /// \returns true if any address in [\p from, \p to) has any attribute.
+    bool hasAttributesInRange(Address from, Address to) const;
+
+    bool isStringsRange(Address from, Address to) const
+    {
+        return isAttributeInRange(SectionAttr::StringsSection, from, to);
+    }
+
+    bool isReadOnlyRange(Address from, Address to) const
+    {
+        return isAttributeInRange(SectionAttr::ReadOnly, from, to);
+    }
 
 private:
     class BinarySectionImpl *m_impl;
@@ -9,12 +9,24 @@
 #pragma endregion License
 #include "BinarySymbolTable.h"
 
-#include "boomerang/db/binary/BinarySymbol.h"
 #include "boomerang/util/log/Log.h"
 
+#include <QHash>
+
+#include <algorithm>
 #include <cassert>
 
 
+namespace
+{
+bool addrLess(const std::pair<Address, BinarySymbol *> &lhs,
+              const std::pair<Address, BinarySymbol *> &rhs)
+{
+    return lhs.first < rhs.first;
+}
+}
+
+
 BinarySymbolTable::BinarySymbolTable()
 {
 }
@@ -29,64 +41,180 @@ BinarySymbolTable::~BinarySymbolTable()
 void BinarySymbolTable::clear()
 {
     m_addrIndex.clear();
+    m_nameSlots.clear();
+    m_addrOverlay.clear();
+    m_nameOverlay.clear();
     m_symbolList.clear();
-    m_nameIndex.clear();
+    m_symbols.clear();
 }
 
 
 BinarySymbol *BinarySymbolTable::createSymbol(Address addr, const QString &name, bool local)
 {
-    if (m_addrIndex.find(addr) != m_addrIndex.end()) {
+    if (findSymbolByAddress(addr) != nullptr) {
         return nullptr; // symbol already exists
     }
 
     // If the symbol already exists, redirect the new symbol to the old one.
-    std::map<QString, std::shared_ptr<BinarySymbol>>::iterator it = m_nameIndex.find(name);
+    BinarySymbol *existingSymbol = findSymbolByName(name);
 
-    if (it != m_nameIndex.end()) {
+    if (existingSymbol != nullptr) {
         LOG_WARN("Symbol '%1' already exists in the global symbol table!", name);
-        std::shared_ptr<BinarySymbol> existingSymbol = it->second;
-        m_addrIndex[addr]                            = existingSymbol;
-        return existingSymbol.get();
+        m_addrOverlay[addr] = existingSymbol;
+        return existingSymbol;
     }
 
-    std::shared_ptr<BinarySymbol> sym = std::make_shared<BinarySymbol>(addr, name);
-    m_addrIndex[addr]                 = sym;
+    m_symbols.emplace_back(addr, name);
+    BinarySymbol *sym = &m_symbols.back();
+
+    m_symbolList.push_back(sym);
+    m_addrOverlay[addr] = sym;
 
     if (!local) {
-        m_nameIndex[name] = sym;
+        m_nameOverlay[name] = sym;
+    }
+
+    return sym;
+}
+
+
+std::vector<BinarySymbol *>
+BinarySymbolTable::createSymbols(const std::vector<SymbolDefinition> &definitions)
+{
+    std::vector<BinarySymbol *> result(definitions.size(), nullptr);
+    if (definitions.empty()) {
+        return result;
+    }
+
+    // Only the first definition of every address can create a symbol.
+    std::vector<bool> isDuplicateAddr(definitions.size(), false);
+    {
+        std::vector<std::size_t> order(definitions.size());
+        for (std::size_t i = 0; i < order.size(); i++) {
+            order[i] = i;
+        }
+
+        std::stable_sort(order.begin(), order.end(), [&definitions](std::size_t a, std::size_t b) {
+            return definitions[a].addr < definitions[b].addr;
+        });
+
+        for (std::size_t i = 1; i < order.size(); i++) {
+            if (definitions[order[i]].addr == definitions[order[i - 1]].addr) {
+                isDuplicateAddr[order[i]] = true;
+            }
+        }
+    }
+
+    // Rebuild the name hash from all symbols currently reachable by name
+    // plus the new symbols, so that the name overlay can be dropped.
+    std::vector<int> indexedSymbols;
+    for (int i = 0; i < static_cast<int>(m_symbolList.size()); i++) {
+        if (findSymbolByName(m_symbolList[i]->getName()) == m_symbolList[i]) {
+            indexedSymbols.push_back(i);
+        }
+    }
+
+    std::size_t numNamed = indexedSymbols.size();
+    for (const SymbolDefinition &def : definitions) {
+        numNamed += def.local ? 0 : 1;
+    }
+
+    std::size_t capacity = 16;
+    while (capacity < 2 * numNamed) {
+        capacity *= 2;
+    }
+
+    m_nameSlots.assign(capacity, -1);
+    m_nameOverlay.clear();
+
+    for (int symbolIdx : indexedSymbols) {
+        insertIntoNameHash(symbolIdx);
+    }
+
+    std::vector<std::pair<Address, BinarySymbol *>> newAddrs;
+    newAddrs.reserve(definitions.size() + m_addrOverlay.size());
+
+    for (std::size_t i = 0; i < definitions.size(); i++) {
+        const SymbolDefinition &def = definitions[i];
+
+        if (isDuplicateAddr[i] || findSymbolByAddress(def.addr) != nullptr) {
+            continue; // symbol already exists
+        }
+
+        BinarySymbol *existingSymbol = findInNameHash(def.name);
+
+        if (existingSymbol != nullptr) {
+            LOG_WARN("Symbol '%1' already exists in the global symbol table!", def.name);
+            newAddrs.push_back({ def.addr, existingSymbol });
+            result[i] = existingSymbol;
+            continue;
+        }
+
+        m_symbols.emplace_back(def.addr, def.name);
+        BinarySymbol *sym = &m_symbols.back();
+
+        m_symbolList.push_back(sym);
+        newAddrs.push_back({ def.addr, sym });
+
+        if (!def.local) {
+            insertIntoNameHash(static_cast<int>(m_symbolList.size()) - 1);
+        }
+
+        result[i] = sym;
     }
 
-    m_symbolList.push_back(sym.get());
-    return sym.get();
+    // Merge the new addresses and the address overlay into the sorted address index.
+    newAddrs.insert(newAddrs.end(), m_addrOverlay.begin(), m_addrOverlay.end());
+    m_addrOverlay.clear();
+
+    std::sort(newAddrs.begin(), newAddrs.end(), addrLess);
+
+    const std::size_t oldSize = m_addrIndex.size();
+    m_addrIndex.insert(m_addrIndex.end(), newAddrs.begin(), newAddrs.end());
+    std::inplace_merge(m_addrIndex.begin(), m_addrIndex.begin() + oldSize, m_addrIndex.end(),
+                       addrLess);
+
+    return result;
 }
 
 
 BinarySymbol *BinarySymbolTable::findSymbolByAddress(Address addr)
 {
-    auto ff = m_addrIndex.find(addr);
-    return (ff != m_addrIndex.end()) ? ff->second.get() : nullptr;
+    return const_cast<BinarySymbol *>(
+        static_cast<const BinarySymbolTable *>(this)->findSymbolByAddress(addr));
 }
 
 
 const BinarySymbol *BinarySymbolTable::findSymbolByAddress(Address addr) const
 {
-    auto ff = m_addrIndex.find(addr);
-    return (ff != m_addrIndex.end()) ? ff->second.get() : nullptr;
+    auto overlayIt = m_addrOverlay.find(addr);
+    if (overlayIt != m_addrOverlay.end()) {
+        return overlayIt->second;
+    }
+
+    auto it = std::lower_bound(m_addrIndex.begin(), m_addrIndex.end(),
+                               std::make_pair(addr, static_cast<BinarySymbol *>(nullptr)),
+                               addrLess);
+
+    return (it != m_addrIndex.end() && it->first == addr) ? it->second : nullptr;
 }
 
 
 BinarySymbol *BinarySymbolTable::findSymbolByName(const QString &name)
 {
-    auto ff = m_nameIndex.find(name);
-    return (ff != m_nameIndex.end()) ? ff->second.get() : nullptr;
+    return const_cast<BinarySymbol *>(
+        static_cast<const BinarySymbolTable *>(this)->findSymbolByName(name));
 }
 
 
 const BinarySymbol *BinarySymbolTable::findSymbolByName(const QString &name) const
 {
-    auto ff = m_nameIndex.find(name);
-    return (ff != m_nameIndex.end()) ? ff->second.get() : nullptr;
+    auto overlayIt = m_nameOverlay.find(name);
+    if (overlayIt != m_nameOverlay.end()) {
+        return overlayIt->second;
+    }
+
+    return findInNameHash(name);
 }
 
 
@@ -96,24 +224,59 @@ bool BinarySymbolTable::renameSymbol(const QString &oldName, const QString &newN
         return true;
     }
 
-    auto oldIt = m_nameIndex.find(oldName);
-    auto newIt = m_nameIndex.find(newName);
+    BinarySymbol *oldSymbol = findSymbolByName(oldName);
 
-    if (oldIt == m_nameIndex.end()) { // symbol not found
+    if (oldSymbol == nullptr) { // symbol not found
         LOG_ERROR("Could not rename symbol '%1' to '%2': A symbol with name '%1' was not found.",
                   oldName, newName);
         return false;
     }
-    else if (newIt != m_nameIndex.end()) { // symbol name clash
+    else if (findSymbolByName(newName) != nullptr) { // symbol name clash
         LOG_ERROR("Could not rename symbol '%1' to '%2': A symbol with name '%2' already exists",
                   oldName, newName);
         return false;
     }
 
-    std::shared_ptr<BinarySymbol> oldSymbol = oldIt->second;
-    m_nameIndex.erase(oldIt);
-    oldSymbol->m_name    = newName;
-    m_nameIndex[newName] = oldSymbol;
+    // The hash slot of the old name no longer matches since slots are compared
+    // against the current name of the symbol.
+    m_nameOverlay.erase(oldName);
+    oldSymbol->m_name      = newName;
+    m_nameOverlay[newName] = oldSymbol;
 
     return true;
 }
+
+
+BinarySymbol *BinarySymbolTable::findInNameHash(const QString &name) const
+{
+    if (m_nameSlots.empty()) {
+        return nullptr;
+    }
+
+    const std::size_t mask = m_nameSlots.size() - 1;
+
+    for (std::size_t slot = qHash(name) & mask; m_nameSlots[slot] != -1;) {
+        BinarySymbol *sym = m_symbolList[m_nameSlots[slot]];
+        if (sym->getName() == name) {
+            return sym;
+        }
+
+        slot = (slot + 1) & mask;
+    }
+
+    return nullptr;
+}
+
+
+void BinarySymbolTable::insertIntoNameHash(int symbolIdx)
+{
+    assert(!m_nameSlots.empty());
+    const std::size_t mask = m_nameSlots.size() - 1;
+
+    std::size_t slot = qHash(m_symbolList[symbolIdx]->getName()) & mask;
+    while (m_nameSlots[slot] != -1) {
+        slot = (slot + 1) & mask;
+    }
+
+    m_nameSlots[slot] = symbolIdx;
+}
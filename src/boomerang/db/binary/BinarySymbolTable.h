@@ -10,24 +10,21 @@
 #pragma once
 
 
+#include "boomerang/db/binary/BinarySymbol.h"
 #include "boomerang/util/Address.h"
 
+#include <deque>
 #include <map>
-#include <memory>
 #include <vector>
 
 
-class BinarySymbol;
-
-
 /**
  * A simple class to implement a symbol table than can be looked up by address or by name.
  *
- * \note Can't readily use operator[] overloaded for address and string parameters.
- * The main problem is that when you do symtab[0x100] = "main", the string map
- * doesn't see the string. If you have one of the maps be a pointer to the other string
- * and use a special comparison operator, then if the strings are ever changed,
- * then the map's internal rb-tree becomes invalid.
+ * Symbols are usually added in bulk by the loaders via createSymbols(), which builds
+ * a sorted address index and an open addressing name hash in one go.
+ * Symbols added or renamed later on are kept in small overlay maps
+ * until the next bulk insertion merges them into the main indices.
  */
 class BOOMERANG_API BinarySymbolTable
 {
@@ -38,6 +35,15 @@ class BOOMERANG_API BinarySymbolTable
     typedef SymbolList::reverse_iterator reverse_iterator;
     typedef SymbolList::const_reverse_iterator const_reverse_iterator;
 
+public:
+    /// Parameters of a symbol to be created by createSymbols()
+    struct SymbolDefinition
+    {
+        Address addr;
+        QString name;
+        bool local = false;
+    };
+
 public:
     BinarySymbolTable();
     BinarySymbolTable(const BinarySymbolTable &other) = delete;
@@ -67,6 +73,13 @@ public:
     /// Creates a symbol if it does not exist.
     BinarySymbol *createSymbol(Address addr, const QString &name, bool local = false);
 
+    /**
+     * Create many symbols at once. This has the same effect as calling createSymbol()
+     * for every definition in order, but the lookup indices are only rebuilt once.
+     * \returns for every definition, the symbol createSymbol() would have returned.
+     */
+    std::vector<BinarySymbol *> createSymbols(const std::vector<SymbolDefinition> &definitions);
+
     BinarySymbol *findSymbolByAddress(Address addr);
     const BinarySymbol *findSymbolByAddress(Address addr) const;
 
@@ -77,11 +90,32 @@ public:
     bool renameSymbol(const QString &oldName, const QString &newName);
 
 private:
-    /// The map indexed by address.
-    std::map<Address, std::shared_ptr<BinarySymbol>> m_addrIndex;
+    /// Look up \p name in the name hash only (i.e. not in the overlay)
+    BinarySymbol *findInNameHash(const QString &name) const;
 
-    /// The map indexed by string. Note that the strings are stored twice.
-    std::map<QString, std::shared_ptr<BinarySymbol>> m_nameIndex;
+    /// Add the symbol with index \p symbolIdx in m_symbolList to the name hash.
+    /// The hash must have enough free slots.
+    void insertIntoNameHash(int symbolIdx);
 
+private:
+    /// Storage of all symbols. Never shrinks except on clear(), so pointers stay valid.
+    std::deque<BinarySymbol> m_symbols;
+
+    /// All symbols in insertion order.
     SymbolList m_symbolList;
+
+    /// Address index built by createSymbols(), sorted by address.
+    /// Several addresses may refer to the same symbol.
+    std::vector<std::pair<Address, BinarySymbol *>> m_addrIndex;
+
+    /// Open addressing hash (linear probing) of the non-local symbols built by createSymbols().
+    /// Contains indices into m_symbolList, or -1 for empty slots. Renamed symbols simply
+    /// stop matching their old slot, since slots are compared to the current symbol name.
+    std::vector<int> m_nameSlots;
+
+    /// Symbols created by createSymbol() since the last bulk insertion
+    std::map<Address, BinarySymbol *> m_addrOverlay;
+
+    /// Symbols created by createSymbol() or renamed since the last bulk insertion
+    std::map<QString, BinarySymbol *> m_nameOverlay;
 };
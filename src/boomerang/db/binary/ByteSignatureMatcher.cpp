@@ -0,0 +1,150 @@
+#pragma region License
+/*
+ * This file is part of the Boomerang Decompiler.
+ *
+ * See the file "LICENSE.TERMS" for information on usage and
+ * redistribution of this file, and for a DISCLAIMER OF ALL
+ * WARRANTIES.
+ */
+#pragma endregion License
+#include "ByteSignatureMatcher.h"
+
+#include "boomerang/db/binary/BinaryImage.h"
+#include "boomerang/db/binary/BinarySection.h"
+#include "boomerang/db/binary/BinarySymbol.h"
+#include "boomerang/db/binary/BinarySymbolTable.h"
+#include "boomerang/util/log/Log.h"
+
+#include <QFile>
+#include <QRegExp>
+#include <QTextStream>
+
+
+bool ByteSignatureMatcher::readSignatureFile(const QString &path)
+{
+    QFile file(path);
+
+    if (!file.open(QFile::ReadOnly | QFile::Text)) {
+        LOG_ERROR("Cannot open byte signature file '%1'", path);
+        return false;
+    }
+
+    QTextStream is(&file);
+    int lineNum = 0;
+
+    while (!is.atEnd()) {
+        QString line = is.readLine();
+        lineNum++;
+
+        line = line.mid(0, line.indexOf('#')).trimmed(); // cut the line to first '#'
+        if (line.isEmpty()) {
+            continue;
+        }
+
+        const int nameEnd = line.indexOf(QRegExp("\\s"));
+        if (nameEnd == -1 || !addSignature(line.left(nameEnd), line.mid(nameEnd + 1))) {
+            LOG_WARN("Ignoring invalid byte signature in '%1', line %2", path, lineNum);
+        }
+    }
+
+    return true;
+}
+
+
+bool ByteSignatureMatcher::addSignature(const QString &name, const QString &pattern)
+{
+    if (name.isEmpty()) {
+        return false;
+    }
+
+    const int id = m_patterns.addPattern(pattern);
+    if (id == -1) {
+        return false;
+    }
+    else if (m_patterns.getNumFixedBytes(id) < MIN_FIXED_BYTES) {
+        // The pattern cannot be removed from the set again; it is just never reported.
+        m_names.push_back(QString());
+        return false;
+    }
+
+    m_names.push_back(name);
+    return true;
+}
+
+
+int ByteSignatureMatcher::recognizeFunctions(const BinaryImage *image,
+                                             BinarySymbolTable *symbols) const
+{
+    if (!image || !symbols || m_patterns.size() == 0) {
+        return 0;
+    }
+
+    std::vector<BinarySymbolTable::SymbolDefinition> definitions;
+    int numRecognized = 0;
+
+    for (const BinarySection *section : *image) {
+        if (!section->isCode() || section->getHostAddr() == HostAddress::INVALID) {
+            continue;
+        }
+
+        const Byte *data = reinterpret_cast<const Byte *>(section->getHostAddr().value());
+
+        const std::vector<std::pair<std::size_t, int>> matches = m_patterns.findAllMatches(
+            data, section->getSize());
+
+        // Matches are sorted by offset. Of several matches at the same offset, use the one
+        // with the longest pattern; ignore matches inside an already recognized function.
+        std::size_t recognizedEnd = 0;
+
+        for (std::size_t i = 0; i < matches.size();) {
+            const std::size_t offset = matches[i].first;
+            int bestID               = -1;
+
+            for (; i < matches.size() && matches[i].first == offset; i++) {
+                const int id = matches[i].second;
+                if (m_names[id].isEmpty()) {
+                    continue;
+                }
+                else if (bestID == -1 ||
+                         m_patterns.getPatternLength(id) > m_patterns.getPatternLength(bestID)) {
+                    bestID = id;
+                }
+            }
+
+            if (bestID == -1 || offset < recognizedEnd) {
+                continue;
+            }
+
+            const Address addr        = section->getSourceAddr() + offset;
+            const QString &name       = m_names[bestID];
+            BinarySymbol *existingSym = symbols->findSymbolByAddress(addr);
+
+            if (existingSym != nullptr) {
+                if (existingSym->getName() != name) {
+                    continue; // trust symbol information from the binary file
+                }
+
+                existingSym->setAttribute("Function", true);
+                existingSym->setAttribute("StaticFunction", true);
+            }
+            else {
+                definitions.push_back({ addr, name });
+            }
+
+            LOG_VERBOSE("Recognized statically linked library function '%1' at address %2",
+                        name, addr);
+
+            recognizedEnd = offset + m_patterns.getPatternLength(bestID);
+            numRecognized++;
+        }
+    }
+
+    for (BinarySymbol *sym : symbols->createSymbols(definitions)) {
+        if (sym != nullptr) {
+            sym->setAttribute("Function", true);
+            sym->setAttribute("StaticFunction", true);
+        }
+    }
+
+    return numRecognized;
+}
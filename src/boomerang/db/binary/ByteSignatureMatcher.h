@@ -0,0 +1,69 @@
+#pragma region License
+/*
+ * This file is part of the Boomerang Decompiler.
+ *
+ * See the file "LICENSE.TERMS" for information on usage and
+ * redistribution of this file, and for a DISCLAIMER OF ALL
+ * WARRANTIES.
+ */
+#pragma endregion License
+#pragma once
+
+
+#include "boomerang/util/BytePatternSet.h"
+
+#include <QString>
+
+#include <vector>
+
+
+class BinaryImage;
+class BinarySymbolTable;
+
+
+/**
+ * Recognizes statically linked library functions by the bytes at their entry point.
+ *
+ * Signatures are read from signature files containing one signature per line:
+ * \code
+ *   # comment
+ *   <function name> <hex bytes, ?? for any byte>
+ * \endcode
+ * Wildcard bytes are typically used for relocated addresses and displacements.
+ *
+ * Recognized functions get a symbol with the attributes "Function" and "StaticFunction",
+ * which makes Prog create a LibProc for them instead of decoding them.
+ */
+class BOOMERANG_API ByteSignatureMatcher
+{
+public:
+    /// Signatures with fewer non-wildcard bytes are rejected
+    /// since they would cause too many false positives.
+    static constexpr int MIN_FIXED_BYTES = 8;
+
+public:
+    ByteSignatureMatcher() = default;
+
+public:
+    /// Read all signatures from the signature file at \p path.
+    /// \returns false if the file could not be read.
+    bool readSignatureFile(const QString &path);
+
+    /// Add a single signature for the function \p name.
+    /// \returns false if \p pattern is malformed or too short.
+    bool addSignature(const QString &name, const QString &pattern);
+
+    /// \returns the number of signatures.
+    int size() const { return m_patterns.size(); }
+
+    /**
+     * Scan all code sections of \p image for known library functions and add symbols
+     * for them to \p symbols. Existing symbols of other names are never overridden.
+     * \returns the number of recognized functions.
+     */
+    int recognizeFunctions(const BinaryImage *image, BinarySymbolTable *symbols) const;
+
+private:
+    BytePatternSet m_patterns;
+    std::vector<QString> m_names; ///< Function names, indexed by pattern ID
+};
@@ -0,0 +1,120 @@
+#pragma region License
+/*
+ * This file is part of the Boomerang Decompiler.
+ *
+ * See the file "LICENSE.TERMS" for information on usage and
+ * redistribution of this file, and for a DISCLAIMER OF ALL
+ * WARRANTIES.
+ */
+#pragma endregion License
+#include "StringLiteralIndex.h"
+
+#include "boomerang/db/binary/BinaryImage.h"
+#include "boomerang/db/binary/BinarySection.h"
+
+#include <algorithm>
+#include <cstring>
+
+
+void StringLiteralIndex::build(const BinaryImage *image)
+{
+    clear();
+
+    if (!image) {
+        return;
+    }
+
+    for (const BinarySection *section : *image) {
+        if (section->isCode() || section->getHostAddr() == HostAddress::INVALID ||
+            section->getSize() <= 0) {
+            continue;
+        }
+
+        scanSection(section);
+    }
+
+    // Sections are not necessarily sorted by address
+    std::sort(m_literals.begin(), m_literals.end(),
+              [](const StringLiteral &a, const StringLiteral &b) { return a.addr < b.addr; });
+}
+
+
+void StringLiteralIndex::clear()
+{
+    m_literals.clear();
+}
+
+
+const StringLiteralIndex::StringLiteral *StringLiteralIndex::findLiteral(Address addr) const
+{
+    // find the last literal starting at or before addr
+    auto it = std::upper_bound(m_literals.begin(), m_literals.end(), addr,
+                               [](Address a, const StringLiteral &lit) { return a < lit.addr; });
+
+    if (it == m_literals.begin()) {
+        return nullptr;
+    }
+
+    --it;
+    return (addr < it->addr + it->length) ? &*it : nullptr;
+}
+
+
+void StringLiteralIndex::scanSection(const BinarySection *section)
+{
+    const Byte *begin = reinterpret_cast<const Byte *>(section->getHostAddr().value());
+    const Byte *end   = begin + section->getSize();
+
+    for (const Byte *p = begin; p < end;) {
+        // memchr is much faster than testing every byte on its own
+        const Byte *nul = static_cast<const Byte *>(std::memchr(p, 0, end - p));
+        if (!nul) {
+            break; // not terminated
+        }
+
+        const uint32_t length = static_cast<uint32_t>(nul - p);
+
+        if (length >= MIN_LITERAL_LENGTH) {
+            uint32_t numNonText = 0;
+            for (const Byte *c = p; c < nul && numNonText < 2; ++c) {
+                if (!isTextChar(*c)) {
+                    numNonText++;
+                }
+            }
+
+            if (numNonText < 2) {
+                addLiteral(section, section->getSourceAddr() + (p - begin), length);
+            }
+        }
+
+        p = nul + 1;
+    }
+}
+
+
+void StringLiteralIndex::addLiteral(const BinarySection *section, Address addr, uint32_t length)
+{
+    if (section->isAddressBss(addr)) {
+        return;
+    }
+
+    const HostAddress hostAddr = section->getHostAddr() - section->getSourceAddr() + addr;
+    const Address end          = addr + length;
+
+    StringLiteral lit;
+    lit.addr   = addr;
+    lit.data   = reinterpret_cast<const char *>(hostAddr.value());
+    lit.length = length;
+
+    if (!section->isStringsRange(addr, end)) {
+        lit.stringsRange = StringsRange::Outside;
+    }
+    else if (section->isAttributeInWholeRange(SectionAttr::StringsSection, addr, end)) {
+        lit.stringsRange = StringsRange::Inside;
+    }
+    else {
+        lit.stringsRange = StringsRange::Partial;
+    }
+
+    m_literals.push_back(lit);
+}
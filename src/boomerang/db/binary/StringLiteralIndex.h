@@ -0,0 +1,85 @@
+#pragma region License
+/*
+ * This file is part of the Boomerang Decompiler.
+ *
+ * See the file "LICENSE.TERMS" for information on usage and
+ * redistribution of this file, and for a DISCLAIMER OF ALL
+ * WARRANTIES.
+ */
+#pragma endregion License
+#pragma once
+
+
+#include "boomerang/util/Address.h"
+#include "boomerang/util/Types.h"
+
+#include <vector>
+
+
+class BinaryImage;
+class BinarySection;
+
+
+/**
+ * A sorted index of the NUL-terminated string literals in the data sections
+ * of a binary image. The sections are scanned once in build(), after which
+ * the literal containing an address can be found by binary search.
+ *
+ * Literals may contain at most one non-text character (this is the tolerance
+ * of the heuristic in Prog::getStringConstant).
+ */
+class BOOMERANG_API StringLiteralIndex
+{
+public:
+    /// How the characters of a literal lie in SectionAttr::StringsSection ranges
+    enum class StringsRange : uint8_t
+    {
+        Outside, ///< No character is in a strings range
+        Inside,  ///< All characters are in a strings range
+        Partial  ///< Some characters are in a strings range, others are not
+    };
+
+    struct StringLiteral
+    {
+        Address addr;              ///< Address of the first character
+        const char *data;          ///< Host pointer to the first character
+        uint32_t length;           ///< Number of characters, excluding the terminator
+        StringsRange stringsRange; ///< Whether the characters are in a strings range
+    };
+
+    /// Shorter literals are not indexed, since they would mostly be false positives.
+    static constexpr uint32_t MIN_LITERAL_LENGTH = 4;
+
+public:
+    StringLiteralIndex() = default;
+
+public:
+    /// Scan all non-code sections of \p image and index the string literals in them.
+    void build(const BinaryImage *image);
+
+    /// Remove all literals from the index.
+    void clear();
+
+    /// \returns the number of indexed literals.
+    int size() const { return static_cast<int>(m_literals.size()); }
+
+    /**
+     * \returns the literal that contains the character at address \p addr,
+     * or nullptr if there is no such literal.
+     */
+    const StringLiteral *findLiteral(Address addr) const;
+
+    /// \returns true if \p c is a printable ASCII character or a tab or newline character.
+    static bool isTextChar(unsigned int c)
+    {
+        return (c >= 0x20 && c < 0x7F) || c == '\t' || c == '\n' || c == '\r';
+    }
+
+private:
+    void scanSection(const BinarySection *section);
+
+    void addLiteral(const BinarySection *section, Address addr, uint32_t length);
+
+private:
+    std::vector<StringLiteral> m_literals; ///< Sorted by address
+};
@@ -281,6 +281,7 @@ Function *Module::createFunction(const QString &name, Address entryAddr, bool li
     }
 
     m_functionList.push_back(function); // Append this to list of procs
+    m_prog->invalidateCallGraph();
     m_prog->getProject()->alertFunctionCreated(function);
 
     // TODO: add platform agnostic way of using debug information, should be moved to Loaders, Prog
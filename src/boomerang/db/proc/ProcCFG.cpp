@@ -46,6 +46,7 @@ void ProcCFG::clear()
     m_entryBB    = nullptr;
     m_exitBB     = nullptr;
     m_wellFormed = true;
+    layoutChanged();
 }
 
 
@@ -289,6 +290,7 @@ void ProcCFG::removeBB(BasicBlock *bb)
     }
 
     delete bb;
+    layoutChanged();
 }
 
 
@@ -494,6 +496,7 @@ BasicBlock *ProcCFG::splitBB(BasicBlock *bb, Address splitAddr, BasicBlock *_new
             splitIt = bb->getRTLs()->erase(splitIt); // deletes RTLs
         }
 
+        layoutChanged();
         bb->updateBBAddresses();
         _newBB->updateBBAddresses();
 
@@ -575,4 +578,6 @@ void ProcCFG::insertBB(BasicBlock *bb)
         // this is an orpahned BB (e.g. delay slot)
         m_bbStartMap.insert({ Address::ZERO, bb });
     }
+
+    layoutChanged();
 }
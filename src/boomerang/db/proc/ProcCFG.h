@@ -80,6 +80,16 @@ public:
     /// \returns the number of (complete and incomplete) BBs in this CFG.
     int getNumBBs() const { return m_bbStartMap.size(); }
 
+    /**
+     * \returns a counter that is incremented whenever BBs are added to or removed from this CFG,
+     * or statements or RTLs are added to, removed from or replaced in a BB of this CFG.
+     * Used to invalidate the cached statement index of the proc (\sa UserProc::getStatementIndex).
+     */
+    std::size_t getLayoutVersion() const { return m_layoutVersion; }
+
+    /// Must be called whenever the BBs of this CFG or their RTLs or statements change.
+    void layoutChanged() { ++m_layoutVersion; }
+
     /// Checks if the BB is part of this CFG
     bool hasBB(const BasicBlock *bb) const;
 
@@ -254,4 +264,6 @@ private:
     /// (e.g. with ad-hoc global assignment)
     bool m_implicitsDone      = false;
     mutable bool m_wellFormed = false;
+
+    std::size_t m_layoutVersion = 1; ///< \sa getLayoutVersion
 };
@@ -44,6 +44,10 @@ UserProc::UserProc(Address address, const QString &name, Module *module)
 UserProc::~UserProc()
 {
     qDeleteAll(m_parameters);
+
+    if (m_stateReleased) {
+        delete m_retStatement; // not owned by an RTL any more
+    }
 }
 
 
@@ -53,6 +57,9 @@ bool UserProc::isNoReturn() const
     if (!this->isDecoded()) {
         return false;
     }
+    else if (m_stateReleased) {
+        return m_releasedNoReturn;
+    }
 
     BasicBlock *exitbb = m_cfg->getExitBB();
 
@@ -114,6 +121,7 @@ void UserProc::setStatus(ProcStatus s)
     if (m_status != s) {
         m_status = s;
         if (m_prog) {
+            m_prog->getProofCache().invalidate(this);
             m_prog->getProject()->alertProcStatusChanged(this);
         }
     }
@@ -145,31 +153,117 @@ void UserProc::decompileRecursive()
 }
 
 
+void UserProc::releaseDecompilationState()
+{
+    if (m_stateReleased) {
+        return;
+    }
+
+    assert(isDecompiled());
+    m_releasedNoReturn = isNoReturn();
+
+    const auto stmts = getStatementIndex();
+
+    for (Statement *s : *stmts) {
+        if (s->isCall()) {
+            // The call is about to be deleted, so the callee must forget about it
+            Function *dest = static_cast<CallStatement *>(s)->getDestProc();
+            if (dest) {
+                dest->getCallers().erase(static_cast<CallStatement *>(s));
+            }
+        }
+    }
+
+    // Callers still refer to the return statement, so keep it alive.
+    if (m_retStatement && m_retStatement->getBB()) {
+        for (auto &rtl : *m_retStatement->getBB()->getRTLs()) {
+            auto it = std::find(rtl->begin(), rtl->end(), m_retStatement);
+            if (it != rtl->end()) {
+                rtl->erase(it);
+                break;
+            }
+        }
+
+        m_retStatement->setBB(nullptr);
+        m_retStatement->getCollector()->clear();
+    }
+
+    m_cfg.reset(new ProcCFG(this)); // deletes all BBs, RTLs and statements
+    m_df = DataFlow(this);
+    m_symbolMap.clear();
+    m_locals.clear();
+    m_procUseCollector.clear();
+    m_statementIndex.reset();
+
+    m_stateReleased = true;
+}
+
+
 void UserProc::numberStatements() const
 {
     int stmtNumber = 0;
 
-    for (BasicBlock *bb : *m_cfg) {
-        BasicBlock::RTLIterator rit;
-        StatementList::iterator sit;
-        for (Statement *s = bb->getFirstStmt(rit, sit); s; s = bb->getNextStmt(rit, sit)) {
-            s->setNumber(++stmtNumber);
-        }
+    for (Statement *s : *getStatementIndex()) {
+        s->setNumber(++stmtNumber);
     }
+
+    // the numbers have changed
+    m_statementIndex.reset();
 }
 
 
 void UserProc::getStatements(StatementList &stmts) const
 {
-    for (const BasicBlock *bb : *m_cfg) {
-        bb->appendStatementsTo(stmts);
+    for (Statement *s : *getStatementIndex()) {
+        stmts.append(s);
     }
+}
 
-    for (Statement *s : stmts) {
-        if (s->getProc() == nullptr) {
-            s->setProc(const_cast<UserProc *>(this));
+
+std::shared_ptr<const StatementIndex> UserProc::getStatementIndex() const
+{
+    if (m_statementIndex && m_statementIndexVersion == m_cfg->getLayoutVersion()) {
+        return m_statementIndex;
+    }
+
+    std::vector<Statement *> stmts;
+
+    for (const BasicBlock *bb : *m_cfg) {
+        const RTLList *rtls = bb->getRTLs();
+        if (!rtls) {
+            continue;
+        }
+
+        for (const auto &rtl : *rtls) {
+            for (Statement *s : *rtl) {
+                assert(s->getBB() == bb);
+
+                if (s->getProc() == nullptr) {
+                    s->setProc(const_cast<UserProc *>(this));
+                }
+
+                stmts.push_back(s);
+            }
         }
     }
+
+    m_statementIndex        = std::make_shared<const StatementIndex>(std::move(stmts));
+    m_statementIndexVersion = m_cfg->getLayoutVersion();
+    return m_statementIndex;
+}
+
+
+Statement *UserProc::getStatementByNumber(int number) const
+{
+    Statement *stmt = getStatementIndex()->findByNumber(number);
+
+    if (stmt && stmt->getNumber() != number) {
+        // renumbered without calling numberStatements()
+        m_statementIndex.reset();
+        stmt = getStatementIndex()->findByNumber(number);
+    }
+
+    return stmt;
 }
 
 
@@ -195,6 +289,7 @@ bool UserProc::removeStatement(Statement *stmt)
                         provenIt->first, provenIt->second);
 
             provenIt = m_provenTrue.erase(provenIt);
+            m_prog->getProofCache().invalidate(this);
             continue;
         }
 
@@ -208,7 +303,7 @@ bool UserProc::removeStatement(Statement *stmt)
     }
 
     for (auto &rtl : *bb->getRTLs()) {
-        for (RTL::iterator it = rtl->begin(); it != rtl->end(); ++it) {
+        for (RTL::const_iterator it = rtl->begin(); it != rtl->end(); ++it) {
             if (*it == stmt) {
                 rtl->erase(it);
                 return true;
@@ -275,7 +370,7 @@ bool UserProc::insertStatementAfter(Statement *afterThis, Statement *stmt)
         }
 
         for (const auto &rtl : *rtls) {
-            for (RTL::iterator ss = rtl->begin(); ss != rtl->end(); ++ss) {
+            for (RTL::const_iterator ss = rtl->begin(); ss != rtl->end(); ++ss) {
                 if (*ss == afterThis) {
                     rtl->insert(std::next(ss), stmt);
                     stmt->setBB(bb);
@@ -787,7 +882,7 @@ void UserProc::markAsNonChildless(const std::shared_ptr<ProcSet> &cs)
     assert(cs);
 
     BasicBlock::RTLRIterator rrit;
-    StatementList::reverse_iterator srit;
+    StatementList::const_reverse_iterator srit;
 
     for (BasicBlock *bb : *m_cfg) {
         CallStatement *c = dynamic_cast<CallStatement *>(bb->getLastStmt(rrit, srit));
@@ -811,6 +906,10 @@ void UserProc::addCallee(Function *callee)
     // is it already in? (this is much slower than using a set)
     if (std::find(m_calleeList.begin(), m_calleeList.end(), callee) == m_calleeList.end()) {
         m_calleeList.push_back(callee);
+
+        if (m_prog) {
+            m_prog->invalidateCallGraph();
+        }
     }
 }
 
@@ -850,10 +949,9 @@ QString UserProc::findFirstSymbol(const SharedConstExp &exp) const
 bool UserProc::searchAndReplace(const Exp &search, SharedExp replace)
 {
     bool ch = false;
-    StatementList stmts;
-    getStatements(stmts);
+    const auto stmts = getStatementIndex();
 
-    for (Statement *s : stmts) {
+    for (Statement *s : *stmts) {
         ch |= s->searchAndReplace(search, replace);
     }
 
@@ -869,10 +967,9 @@ void UserProc::markAsInitialParam(const SharedExp &loc)
 
 bool UserProc::allPhisHaveDefs() const
 {
-    StatementList stmts;
-    getStatements(stmts);
+    const auto stmts = getStatementIndex();
 
-    for (const Statement *stmt : stmts) {
+    for (const Statement *stmt : *stmts) {
         if (!stmt->isPhi()) {
             continue; // Might be able to optimise this a bit
         }
@@ -1117,6 +1214,39 @@ static const SharedExp defAll = Terminal::get(opDefineAll);
 
 
 bool UserProc::proveEqual(const SharedExp &queryLeft, const SharedExp &queryRight, bool conditional)
+{
+    ProofCache &proofCache = m_prog->getProofCache();
+    int offset             = 0;
+
+    // Results that rely on premises of procedures in a recursion group must not be cached
+    const bool cacheable = !conditional && !proofCache.hasPremises() &&
+                           ProofCache::getPreservationOffset(queryLeft, queryRight, offset);
+
+    bool result = false;
+
+    if (cacheable && proofCache.lookup(this, queryLeft, offset, result)) {
+        if (m_prog->getProject()->getSettings()->debugProof) {
+            LOG_MSG("found %1 in proof cache for %2 in %3", result ? "true" : "false",
+                    Binary::get(opEquals, queryLeft, queryRight), getName());
+        }
+
+        return result;
+    }
+
+    proofCache.beginProof(this);
+    result = proveEqualUncached(queryLeft, queryRight, conditional);
+    proofCache.endProof();
+
+    if (cacheable) {
+        proofCache.store(this, queryLeft, offset, result);
+    }
+
+    return result;
+}
+
+
+bool UserProc::proveEqualUncached(const SharedExp &queryLeft, const SharedExp &queryRight,
+                                  bool conditional)
 {
     if ((m_provenTrue.find(queryLeft) != m_provenTrue.end()) &&
         (*m_provenTrue[queryLeft] == *queryRight)) {
@@ -1169,6 +1299,7 @@ bool UserProc::proveEqual(const SharedExp &queryLeft, const SharedExp &queryRigh
                 }
 
                 m_provenTrue[origLeft->clone()] = right;
+                m_prog->getProofCache().invalidate(this);
                 return true;
             }
 
@@ -1183,7 +1314,7 @@ bool UserProc::proveEqual(const SharedExp &queryLeft, const SharedExp &queryRigh
 
     if (m_recursionGroup) { // If in involved in a recursion cycle
         //    then save the original query as a premise for bypassing calls
-        m_recurPremises[origLeft->clone()] = origRight;
+        setPremise(origLeft->clone(), origRight);
     }
 
     std::set<PhiAssign *> lastPhis;
@@ -1201,6 +1332,7 @@ bool UserProc::proveEqual(const SharedExp &queryLeft, const SharedExp &queryRigh
 
     if (result && !conditional) {
         m_provenTrue[origLeft] = origRight; // Save the now proven equation
+        m_prog->getProofCache().invalidate(this);
     }
 
     return result;
@@ -1270,6 +1402,9 @@ bool UserProc::prover(SharedExp query, std::set<PhiAssign *> &lastPhis,
                 CallStatement *call = dynamic_cast<CallStatement *>(s);
 
                 if (call) {
+                    // The result depends on what is known about the callee
+                    m_prog->getProofCache().addDependency(call->getDestProc());
+
                     // See if we can prove something about this register.
                     UserProc *destProc = dynamic_cast<UserProc *>(call->getDestProc());
                     SharedExp base     = r->getSubExp1();
@@ -1484,10 +1619,9 @@ bool UserProc::prover(SharedExp query, std::set<PhiAssign *> &lastPhis,
             // find a memory def for the right if there is a memof on the left
             // FIXME: this seems pretty much like a bad hack!
             if (!change && (query->getSubExp1()->getOper() == opMemOf)) {
-                StatementList stmts;
-                getStatements(stmts);
+                const auto stmts = getStatementIndex();
 
-                for (Statement *s : stmts) {
+                for (Statement *s : *stmts) {
                     Assign *as = dynamic_cast<Assign *>(s);
 
                     if (as && (*as->getRight() == *query->getSubExp2()) &&
@@ -1557,12 +1691,21 @@ SharedExp UserProc::getSymbolFor(const SharedConstExp &from, const SharedConstTy
 
 void UserProc::setPremise(const SharedExp &e)
 {
-    SharedExp premise  = e->clone();
-    m_recurPremises[e] = e;
+    setPremise(e, e);
+}
+
+
+void UserProc::setPremise(const SharedExp &e, const SharedExp &value)
+{
+    if (m_recurPremises.insert_or_assign(e, value).second) {
+        m_prog->getProofCache().addPremise();
+    }
 }
 
 
 void UserProc::killPremise(const SharedExp &e)
 {
-    m_recurPremises.erase(e);
+    if (m_recurPremises.erase(e) > 0) {
+        m_prog->getProofCache().removePremise();
+    }
 }
@@ -14,6 +14,7 @@
 #include "boomerang/db/UseCollector.h"
 #include "boomerang/db/proc/Proc.h"
 #include "boomerang/db/proc/ProcCFG.h"
+#include "boomerang/util/StatementIndex.h"
 #include "boomerang/util/StatementList.h"
 
 
@@ -111,9 +112,16 @@ public:
     bool isDecoded() const { return m_status >= PROC_DECODED; }
     bool isDecompiled() const { return m_status >= PROC_FINAL; }
 
+    /// \returns true if the decompilation state was freed by releaseDecompilationState().
+    bool isStateReleased() const { return m_stateReleased; }
+
     /// Records that this procedure has been decoded.
     void setDecoded();
 
+    /// \returns why the decompilation of this procedure is incomplete, or an empty string.
+    const QString &getDecompileNote() const { return m_decompileNote; }
+    void setDecompileNote(const QString &note) { m_decompileNote = note; }
+
     bool isEarlyRecursive() const
     {
         return m_recursionGroup != nullptr && m_status <= PROC_INCYCLE;
@@ -137,6 +145,14 @@ public:
     /// Decompile this procedure, and all callees.
     void decompileRecursive();
 
+    /**
+     * Free the CFG, the RTLs and the data flow information of this procedure after its code
+     * has been generated. Only the information used by callers and by prototype generation
+     * is kept, i.e. the signature, the parameters, the return statement and the proven
+     * preservations.
+     */
+    void releaseDecompilationState();
+
 public:
     // statement related
 
@@ -146,6 +162,18 @@ public:
     /// \returns all statements in this UserProc
     void getStatements(StatementList &stmts) const;
 
+    /**
+     * \returns all statements in this UserProc in CFG order, without copying them.
+     * The index is cached and only rebuilt after statements have been added, removed
+     * or renumbered. The returned index is a snapshot; it stays valid (but may become outdated)
+     * if the statements of this procedure are modified while iterating over it,
+     * as long as the caller keeps a reference to it.
+     */
+    std::shared_ptr<const StatementIndex> getStatementIndex() const;
+
+    /// \returns the statement with number \p number, or nullptr if there is no such statement.
+    Statement *getStatementByNumber(int number) const;
+
     /// Remove (but not delete) \p stmt from this UserProc
     /// \returns true iff successfully removed
     bool removeStatement(Statement *stmt);
@@ -362,6 +390,9 @@ private:
     /// \note this function was non-reentrant, but now reentrancy is frequently used
     bool proveEqual(const SharedExp &lhs, const SharedExp &rhs, bool conditional = false);
 
+    /// helper function for proveEqual(); does the actual proof without looking at the proof cache.
+    bool proveEqualUncached(const SharedExp &lhs, const SharedExp &rhs, bool conditional);
+
     /// helper function for proveEqual()
     bool prover(SharedExp query, std::set<PhiAssign *> &lastPhis,
                 std::map<PhiAssign *, SharedExp> &cache, PhiAssign *lastPhi = nullptr);
@@ -375,6 +406,9 @@ private:
     /// Set a location as a new premise, i.e. assume e=e
     void setPremise(const SharedExp &e);
 
+    /// Set a location as a new premise, i.e. assume \p e = \p value
+    void setPremise(const SharedExp &e, const SharedExp &value);
+
     void killPremise(const SharedExp &e);
 
 private:
@@ -453,4 +487,19 @@ private:
      * If no return statement, this will be nullptr.
      */
     ReturnStatement *m_retStatement = nullptr;
+
+    /// True after releaseDecompilationState(). m_retStatement is then owned by this proc.
+    bool m_stateReleased = false;
+
+    /// Result of isNoReturn() at the time the decompilation state was released
+    bool m_releasedNoReturn = false;
+
+    /// Set when some analyses were skipped, e.g. because the decompilation budget was exceeded.
+    QString m_decompileNote;
+
+    /// Cached result of getStatementIndex()
+    mutable std::shared_ptr<const StatementIndex> m_statementIndex;
+
+    /// Value of ProcCFG::getLayoutVersion() when m_statementIndex was built
+    mutable std::size_t m_statementIndexVersion = 0;
 };
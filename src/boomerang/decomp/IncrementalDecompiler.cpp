@@ -0,0 +1,287 @@
+#pragma region License
+/*
+ * This file is part of the Boomerang Decompiler.
+ *
+ * See the file "LICENSE.TERMS" for information on usage and
+ * redistribution of this file, and for a DISCLAIMER OF ALL
+ * WARRANTIES.
+ */
+#pragma endregion License
+#include "IncrementalDecompiler.h"
+
+#include "boomerang/core/Project.h"
+#include "boomerang/core/Settings.h"
+#include "boomerang/db/Global.h"
+#include "boomerang/db/Prog.h"
+#include "boomerang/db/module/Module.h"
+#include "boomerang/db/signature/Signature.h"
+#include "boomerang/decomp/UnusedReturnRemover.h"
+#include "boomerang/passes/PassManager.h"
+#include "boomerang/ssl/exp/Location.h"
+#include "boomerang/ssl/statements/CallStatement.h"
+#include "boomerang/util/StatementList.h"
+#include "boomerang/util/log/Log.h"
+
+#include <algorithm>
+
+
+IncrementalDecompiler::IncrementalDecompiler(Prog *prog)
+    : m_prog(prog)
+{
+}
+
+
+void IncrementalDecompiler::functionRenamed(Function *func)
+{
+    if (!m_progDecompiled) {
+        return;
+    }
+
+    if (!func->isLib()) {
+        invalidateCode(static_cast<UserProc *>(func));
+    }
+
+    // the name of the callee is part of the generated call statements
+    for (CallStatement *call : func->getCallers()) {
+        invalidateCode(call->getProc());
+    }
+
+    // and of the prototype in the root module
+    moduleChanged(m_prog->getRootModule());
+}
+
+
+void IncrementalDecompiler::functionMoved(Function *func, Module *oldModule)
+{
+    if (!m_progDecompiled) {
+        return;
+    }
+
+    // prototypes are declared for all procedures in every module, so only
+    // the old and the new module of the function are affected.
+    moduleChanged(oldModule);
+    moduleChanged(func->getModule());
+}
+
+
+void IncrementalDecompiler::signatureChanged(Function *func)
+{
+    if (!m_progDecompiled) {
+        return;
+    }
+
+    if (!func->isLib()) {
+        invalidate(static_cast<UserProc *>(func), PROC_DECODED);
+    }
+
+    for (CallStatement *call : func->getCallers()) {
+        invalidate(call->getProc(), PROC_DECODED);
+    }
+
+    moduleChanged(m_prog->getRootModule());
+}
+
+
+void IncrementalDecompiler::globalChanged(const Global *global)
+{
+    if (!m_progDecompiled) {
+        return;
+    }
+
+    // the root module declares all globals
+    moduleChanged(m_prog->getRootModule());
+
+    for (const auto &module : m_prog->getModuleList()) {
+        for (Function *func : *module) {
+            if (func->isLib()) {
+                continue;
+            }
+
+            UserProc *proc = static_cast<UserProc *>(func);
+            if (!proc->isDecompiled()) {
+                continue;
+            }
+
+            const SharedExp search = Location::global(global->getName(), proc);
+            const auto stmts = proc->getStatementIndex();
+
+            for (const Statement *s : *stmts) {
+                SharedExp result;
+                if (s->search(*search, result)) {
+                    invalidate(proc, PROC_DECODED);
+                    break;
+                }
+            }
+        }
+    }
+}
+
+
+void IncrementalDecompiler::moduleChanged(Module *module)
+{
+    if (m_progDecompiled && module) {
+        m_changedModules.insert(module);
+    }
+}
+
+
+void IncrementalDecompiler::entryPointAdded(UserProc *proc)
+{
+    if (m_progDecompiled && !proc->isDecompiled()) {
+        invalidate(proc, proc->getStatus());
+    }
+}
+
+
+void IncrementalDecompiler::redecompile()
+{
+    // number of times each procedure was decompiled again
+    std::map<UserProc *, int> numRedecompilations;
+
+    while (!m_invalidatedProcs.empty()) {
+        std::map<UserProc *, ProcStatus> work;
+        std::swap(work, m_invalidatedProcs);
+
+        // Save the old signatures to find out which callers need to be updated afterwards.
+        std::map<UserProc *, std::shared_ptr<Signature>> oldSignatures;
+        ProcSet redecompiled;
+
+        for (auto &[proc, status] : work) {
+            if (status >= PROC_FINAL) {
+                // decompilation results are still valid; only the code has to be generated again
+                invalidateCode(proc);
+                continue;
+            }
+            else if (numRedecompilations[proc] >= MAX_REDECOMPILATIONS) {
+                // e.g. signature changes of mutually recursive procedures
+                LOG_WARN("Not decompiling '%1' again: Maximum number of re-decompilations reached",
+                         proc->getName());
+                invalidateCode(proc);
+                continue;
+            }
+
+            oldSignatures[proc] = proc->getSignature()->clone();
+
+            if (resetProc(proc, status)) {
+                redecompiled.insert(proc);
+                numRedecompilations[proc]++;
+            }
+        }
+
+        for (UserProc *proc : redecompiled) {
+            if (!proc->isDecompiled()) {
+                LOG_MSG("Re-decompiling procedure '%1'", proc->getName());
+                proc->decompileRecursive();
+            }
+        }
+
+        globalAnalysis(redecompiled);
+
+        for (UserProc *proc : redecompiled) {
+            proc->numberStatements();
+            PassManager::get()->executePass(PassID::FromSSAForm, proc);
+            invalidateCode(proc);
+
+            if (*oldSignatures[proc] == *proc->getSignature()) {
+                continue;
+            }
+
+            // A changed signature affects the prototype and all callers of this procedure.
+            moduleChanged(m_prog->getRootModule());
+
+            for (CallStatement *call : proc->getCallers()) {
+                UserProc *caller = call->getProc();
+
+                if (redecompiled.find(caller) == redecompiled.end()) {
+                    invalidate(caller, PROC_DECODED);
+                }
+            }
+        }
+    }
+}
+
+
+void IncrementalDecompiler::globalAnalysis(const ProcSet &procs)
+{
+    if (procs.empty()) {
+        return;
+    }
+
+    for (UserProc *proc : procs) {
+        PassManager::get()->executePass(PassID::LocalTypeAnalysis, proc);
+    }
+
+    if (m_prog->getProject()->getSettings()->removeReturns) {
+        // All other procedures are out of SSA form already and must not be changed.
+        UnusedReturnRemover remover(m_prog);
+        remover.restrictTo(procs);
+
+        while (remover.removeUnusedReturns()) {
+            for (UserProc *proc : remover.getChangedProcs()) {
+                PassManager::get()->executePass(PassID::BranchAnalysis, proc);
+            }
+        }
+
+        for (UserProc *proc : procs) {
+            PassManager::get()->executePass(PassID::LocalTypeAnalysis, proc);
+        }
+    }
+}
+
+
+void IncrementalDecompiler::invalidate(UserProc *proc, ProcStatus status)
+{
+    if (!proc) {
+        return;
+    }
+
+    auto it = m_invalidatedProcs.find(proc);
+    if (it == m_invalidatedProcs.end()) {
+        m_invalidatedProcs[proc] = status;
+    }
+    else {
+        it->second = std::min(it->second, status);
+    }
+
+    invalidateCode(proc);
+}
+
+
+void IncrementalDecompiler::invalidateCode(UserProc *proc)
+{
+    if (!proc) {
+        return;
+    }
+
+    if (proc->getStatus() == PROC_CODE_GENERATED) {
+        proc->setStatus(PROC_FINAL);
+    }
+
+    moduleChanged(proc->getModule());
+}
+
+
+bool IncrementalDecompiler::resetProc(UserProc *proc, ProcStatus status)
+{
+    if (proc->getStatus() > status) {
+        LOG_VERBOSE("Discarding decompilation results for '%1'", proc->getName());
+
+        // Same as restarting decompilation after an indirect jump was analyzed
+        proc->removeRetStmt();
+        proc->getCFG()->clear();
+        proc->getDataFlow()->setRenameLocalsParams(false);
+        proc->setRecursionGroup(nullptr);
+        proc->setStatus(PROC_UNDECODED);
+    }
+
+    if (!proc->isDecoded()) {
+        if (!m_prog->reDecode(proc)) {
+            LOG_WARN("Could not decode procedure '%1' again", proc->getName());
+            return false;
+        }
+
+        proc->setDecoded();
+    }
+
+    return true;
+}
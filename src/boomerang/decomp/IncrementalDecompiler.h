@@ -0,0 +1,117 @@
+#pragma region License
+/*
+ * This file is part of the Boomerang Decompiler.
+ *
+ * See the file "LICENSE.TERMS" for information on usage and
+ * redistribution of this file, and for a DISCLAIMER OF ALL
+ * WARRANTIES.
+ */
+#pragma endregion License
+#pragma once
+
+
+#include "boomerang/core/BoomerangAPI.h"
+#include "boomerang/db/proc/UserProc.h"
+
+#include <map>
+#include <set>
+
+
+class Function;
+class Global;
+class Module;
+class Prog;
+
+
+/**
+ * Keeps track of user edits (renames, moves, signature changes etc.)
+ * of an already decompiled program, and re-runs only the procedures affected by them.
+ *
+ * Each edit invalidates a set of procedures. Depending on the kind of edit, a procedure
+ * either needs to be decompiled again from scratch (e.g. when the signature of a callee changed),
+ * or only needs its code to be generated again (e.g. when a callee was renamed).
+ * Changes to the signature of a re-decompiled procedure are propagated to its callers.
+ */
+class BOOMERANG_API IncrementalDecompiler
+{
+    /// Maximum number of times a procedure is decompiled again by a single call to
+    /// \ref redecompile. Signature changes of mutually dependent procedures could otherwise
+    /// make them invalidate each other indefinitely.
+    static constexpr int MAX_REDECOMPILATIONS = 4;
+
+public:
+    explicit IncrementalDecompiler(Prog *prog);
+
+public:
+    /// Record that the whole program has been decompiled.
+    /// Edits made before this point do not need to invalidate anything.
+    void setProgDecompiled(bool decompiled) { m_progDecompiled = decompiled; }
+    bool isProgDecompiled() const { return m_progDecompiled; }
+
+    /// Record that code has been generated for all modules.
+    /// Afterwards, only the code of changed modules needs to be generated again.
+    void setCodeGenerated(bool generated) { m_codeGenerated = generated; }
+    bool isCodeGenerated() const { return m_codeGenerated; }
+
+    /// \returns true if there are procedures that need to be decompiled again.
+    bool hasInvalidatedProcs() const { return !m_invalidatedProcs.empty(); }
+
+    /// \returns the modules whose code needs to be generated again.
+    const std::set<Module *> &getChangedModules() const { return m_changedModules; }
+
+    /// \p func was renamed. Code for \p func and all its callers needs to be generated again.
+    void functionRenamed(Function *func);
+
+    /// \p func was moved from \p oldModule to its current module.
+    void functionMoved(Function *func, Module *oldModule);
+
+    /// The signature of \p func was changed.
+    /// \p func (if it is a UserProc) and all its callers need to be decompiled again.
+    void signatureChanged(Function *func);
+
+    /// The type of \p global was changed.
+    /// All procedures using \p global need to be decompiled again.
+    void globalChanged(const Global *global);
+
+    /// \p module was added, removed or renamed.
+    void moduleChanged(Module *module);
+
+    /// \p proc was added as a new entry point.
+    void entryPointAdded(UserProc *proc);
+
+    /**
+     * Decompile all invalidated procedures again, including the global analyses
+     * (type analysis, removal of unused returns) restricted to these procedures.
+     * If the signature of a re-decompiled procedure changes as a result,
+     * its callers are re-decompiled as well, up to \ref MAX_REDECOMPILATIONS times.
+     */
+    void redecompile();
+
+    /// Forget about all changed modules, e.g. after code was generated for them.
+    void clearChangedModules() { m_changedModules.clear(); }
+
+private:
+    /// Schedule \p proc to be decompiled again, starting from status \p status.
+    void invalidate(UserProc *proc, ProcStatus status);
+
+    /// Schedule code generation for the module of \p proc
+    void invalidateCode(UserProc *proc);
+
+    /// Discard all decompilation results for \p proc and decode it again,
+    /// unless its status is not later than \p status already.
+    bool resetProc(UserProc *proc, ProcStatus status);
+
+    /// Do the global analyses of the decompilation for \p procs only.
+    void globalAnalysis(const ProcSet &procs);
+
+private:
+    Prog *m_prog;
+    bool m_progDecompiled = false;
+    bool m_codeGenerated  = false;
+
+    /// Procedures to decompile again, and the status they have to be reset to
+    std::map<UserProc *, ProcStatus> m_invalidatedProcs;
+
+    /// Modules that need to have their code generated again
+    std::set<Module *> m_changedModules;
+};
@@ -11,7 +11,9 @@
 
 #include "boomerang/core/Project.h"
 #include "boomerang/core/Settings.h"
+#include "boomerang/db/BasicBlock.h"
 #include "boomerang/db/Prog.h"
+#include "boomerang/db/proc/ProcCFG.h"
 #include "boomerang/db/proc/UserProc.h"
 #include "boomerang/ssl/RTL.h"
 #include "boomerang/ssl/exp/Binary.h"
@@ -23,6 +25,7 @@
 #include "boomerang/ssl/statements/PhiAssign.h"
 #include "boomerang/ssl/type/FuncType.h"
 #include "boomerang/ssl/type/PointerType.h"
+#include "boomerang/util/ExpPatternSet.h"
 #include "boomerang/util/log/Log.h"
 #include "boomerang/visitor/expmodifier/ConstGlobalConverter.h"
 
@@ -119,6 +122,38 @@ static const SharedConstExp vfc_none = Location::memOf(Location::memOf(Terminal:
 static const SharedConstExp hlVfc[] = { vfc_funcptr, vfc_both, vfc_vto, vfc_vfo, vfc_none };
 
 
+/// All switch forms, compiled for matching in a single pass.
+/// Pattern IDs are indices into \ref hlForms.
+static const ExpPatternSet &getSwitchFormPatterns()
+{
+    static const ExpPatternSet patterns = [] {
+        ExpPatternSet result;
+        for (const SwitchForm &form : hlForms) {
+            result.addPattern(form.pattern);
+        }
+        return result;
+    }();
+
+    return patterns;
+}
+
+
+/// All virtual function call forms, compiled for matching in a single pass.
+/// Pattern IDs are indices into \ref hlVfc.
+static const ExpPatternSet &getVfcPatterns()
+{
+    static const ExpPatternSet patterns = [] {
+        ExpPatternSet result;
+        for (const SharedConstExp &pattern : hlVfc) {
+            result.addPattern(pattern);
+        }
+        return result;
+    }();
+
+    return patterns;
+}
+
+
 /// Find all the possible constant values that the location defined by s could be assigned with
 static void findConstantValues(const Statement *s, std::list<int> &dests)
 {
@@ -253,11 +288,72 @@ void findSwParams(SwitchType form, SharedExp e, SharedExp &expr, Address &T)
 }
 
 
+bool IndirectJumpAnalyzer::analyzeIndirectTransfers(UserProc *proc)
+{
+    // Collect the indirect transfers first. Anything decoded during this round is not in SSA
+    // form yet and will be analyzed in the next round.
+    std::vector<BasicBlock *> icts;
+
+    for (BasicBlock *bb : *proc->getCFG()) {
+        if (bb->isType(BBType::CompJump) || bb->isType(BBType::CompCall)) {
+            icts.push_back(bb);
+        }
+    }
+
+    bool switchFound = false;
+
+    for (BasicBlock *bb : icts) {
+        const bool isJump = bb->isType(BBType::CompJump);
+
+        if (decodeIndirectJmp(bb, proc) && isJump) {
+            switchFound = true;
+        }
+    }
+
+    // The CFG of the current proc does not change when only callees of indirect calls are
+    // found, so decoding them does not require re-decoding the proc itself.
+    const int numNewCallees = decodeNewCallees(proc);
+
+    if (numNewCallees > 0) {
+        LOG_VERBOSE("Decoded %1 new procedures called indirectly from '%2'", numNewCallees,
+                    proc->getName());
+    }
+
+    return switchFound;
+}
+
+
+int IndirectJumpAnalyzer::decodeNewCallees(UserProc *proc)
+{
+    Prog *prog = proc->getProg();
+    m_decodedCallees.clear();
+
+    for (Address entryAddr : m_newCallees) {
+        if (prog->getFunctionByAddr(entryAddr) != nullptr) {
+            continue;
+        }
+
+        if (!prog->decodeEntryPoint(entryAddr)) {
+            continue;
+        }
+
+        UserProc *callee = dynamic_cast<UserProc *>(prog->getFunctionByAddr(entryAddr));
+
+        if (callee != nullptr && callee->isDecoded()) {
+            m_decodedCallees.push_back(callee);
+        }
+    }
+
+    m_newCallees.clear();
+    return static_cast<int>(m_decodedCallees.size());
+}
+
+
 bool IndirectJumpAnalyzer::decodeIndirectJmp(BasicBlock *bb, UserProc *proc)
 {
 #if CHECK_REAL_PHI_LOOPS
     rtlit rit;
-    StatementList::iterator sit;
+    StatementList::const_iterator sit;
     Statement *s = getFirstStmt(rit, sit);
 
     for (s = getFirstStmt(rit, sit); s; s = getNextStmt(rit, sit)) {
@@ -320,16 +416,13 @@ bool IndirectJumpAnalyzer::decodeIndirectJmp(BasicBlock *bb, UserProc *proc)
         SharedExp jumpDest = lastStmt->getDest();
 
         SwitchType switchType = SwitchType::Invalid;
+        const int formIdx     = getSwitchFormPatterns().findFirstMatch(jumpDest);
 
-        for (auto &val : hlForms) {
-            if (*jumpDest *= *val.pattern) { // *= compare ignores subscripts
-                switchType = val.type;
+        if (formIdx != -1) {
+            switchType = hlForms[formIdx].type;
 
-                if (proc->getProg()->getProject()->getSettings()->debugSwitch) {
-                    LOG_MSG("Indirect jump matches form %1", static_cast<char>(switchType));
-                }
-
-                break;
+            if (proc->getProg()->getProject()->getSettings()->debugSwitch) {
+                LOG_MSG("Indirect jump matches form %1", static_cast<char>(switchType));
             }
         }
 
@@ -463,25 +556,14 @@ bool IndirectJumpAnalyzer::decodeIndirectJmp(BasicBlock *bb, UserProc *proc)
                     e);
         }
 
-        int n           = sizeof(hlVfc) / sizeof(SharedExp);
-        bool recognised = false;
-        int i;
-
-        for (i = 0; i < n; i++) {
-            if (*e *= *hlVfc[i]) { // *= compare ignores subscripts
-                recognised = true;
+        const int i = getVfcPatterns().findFirstMatch(e);
 
-                if (proc->getProg()->getProject()->getSettings()->debugSwitch) {
-                    LOG_MSG("Indirect call matches form %1", i);
-                }
-
-                break;
-            }
-        }
-
-        if (!recognised) {
+        if (i == -1) {
             return false;
         }
+        else if (proc->getProg()->getProject()->getSettings()->debugSwitch) {
+            LOG_MSG("Indirect call matches form %1", i);
+        }
 
         lastStmt->setDest(e); // Keep the changes to the indirect call expression
         int K1, K2;
@@ -645,9 +727,9 @@ bool IndirectJumpAnalyzer::decodeIndirectJmp(BasicBlock *bb, UserProc *proc)
                     return false;
                 }
 
-                prog->decodeEntryPoint(pfunc);
-                // Since this was not decoded, this is a significant change, and we want to redecode
-                // the current function now that the callee has been decoded
+                // Don't decode it right now; decoding may add BBs to procs that are being
+                // analyzed. All new callees of a round are decoded by decodeNewCallees().
+                m_newCallees.insert(pfunc);
                 return true;
             }
         }
@@ -10,6 +10,13 @@
 #pragma once
 
 
+#include "boomerang/core/BoomerangAPI.h"
+#include "boomerang/util/Address.h"
+
+#include <list>
+#include <set>
+
+
 class BasicBlock;
 class UserProc;
 
@@ -18,14 +25,32 @@ class UserProc;
  * Analyzes indirect jumps and calls.
  * This includes virtual calls and switch statements.
  */
-class IndirectJumpAnalyzer
+class BOOMERANG_API IndirectJumpAnalyzer
 {
 public:
+    /**
+     * Analyze all indirect jumps and calls of \p proc in a single round.
+     * All switch statements are resolved before any new code is decoded, and the callees
+     * discovered through indirect calls are decoded together after the analysis.
+     * \returns true if at least one switch statement was resolved, i.e. the CFG of \p proc
+     * is incomplete and \p proc needs to be re-decoded.
+     */
+    bool analyzeIndirectTransfers(UserProc *proc);
+
     /// Find indirect jumps and calls
     /// Find any BBs of type COMPJUMP or COMPCALL. If found, analyse, and if possible decode extra
-    /// code and return true
+    /// code and return true. Callees of indirect calls are not decoded immediately,
+    /// but queued for \ref decodeNewCallees.
     bool decodeIndirectJmp(BasicBlock *bb, UserProc *proc);
 
+    /// Decode all callees queued by \ref decodeIndirectJmp that have not been decoded yet.
+    /// \returns the number of newly decoded procedures.
+    int decodeNewCallees(UserProc *proc);
+
+    /// \returns the procedures decoded by the last call to \ref decodeNewCallees.
+    /// They still need to be decompiled.
+    const std::list<UserProc *> &getDecodedCallees() const { return m_decodedCallees; }
+
     /**
      * Called when a switch has been identified. Visits the destinations of the switch,
      * adds out edges to the BB, etc.
@@ -47,4 +72,11 @@ public:
      * used as an index into the array of code pointers.
      */
     int findNumCases(const BasicBlock *bb);
+
+private:
+    /// Entry points of new procedures found by analyzing indirect calls
+    std::set<Address> m_newCallees;
+
+    /// Procedures decoded by \ref decodeNewCallees
+    std::list<UserProc *> m_decodedCallees;
 };
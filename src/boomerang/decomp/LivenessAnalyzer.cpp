@@ -76,7 +76,7 @@ bool LivenessAnalyzer::calcLiveness(BasicBlock *bb, ConnectionGraph &ig, UserPro
 
     if (bb->getRTLs()) { // this can be nullptr
         for (rit = bb->getRTLs()->rbegin(); rit != bb->getRTLs()->rend(); ++rit) {
-            std::list<Statement *>::reverse_iterator sit;
+            std::list<Statement *>::const_reverse_iterator sit;
 
             // For each statement this RTL
             for (sit = (*rit)->rbegin(); sit != (*rit)->rend(); ++sit) {
@@ -22,6 +22,8 @@
 #include "boomerang/util/log/Log.h"
 #include "boomerang/util/log/SeparateLogger.h"
 
+#include <QElapsedTimer>
+
 
 ProcDecompiler::ProcDecompiler()
 {
@@ -141,7 +143,7 @@ ProcStatus ProcDecompiler::tryDecompileRecursive(UserProc *proc)
                 continue;
             }
 
-            if (callee->getStatus() == PROC_FINAL) {
+            if (callee->getStatus() >= PROC_FINAL) {
                 // Already decompiled, but the return statement still needs to be set for this call
                 call->setCalleeReturn(callee->getRetStmt());
                 continue;
@@ -336,9 +338,9 @@ void ProcDecompiler::earlyDecompile(UserProc *proc)
     project->alertStartDecompile(proc);
     project->alertDecompileDebugPoint(proc, "Before Initialise");
 
-    PassManager::get()->executePass(PassID::StatementInit, proc);
-    PassManager::get()->executePass(PassID::BBSimplify, proc); // Remove branches with false guards
-    PassManager::get()->executePass(PassID::Dominators, proc);
+    executePass(PassID::StatementInit, proc);
+    executePass(PassID::BBSimplify, proc); // Remove branches with false guards
+    executePass(PassID::Dominators, proc);
 
     proc->debugPrintAll("After Decoding");
     project->alertDecompileDebugPoint(proc, "After Initialise");
@@ -351,20 +353,20 @@ void ProcDecompiler::earlyDecompile(UserProc *proc)
     LOG_VERBOSE("### Beginning early decompile for '%1' ###", proc->getName());
 
     // Update the defines in the calls. Will redo if involved in recursion
-    PassManager::get()->executePass(PassID::CallDefineUpdate, proc);
-    PassManager::get()->executePass(PassID::GlobalConstReplace, proc);
+    executePass(PassID::CallDefineUpdate, proc);
+    executePass(PassID::GlobalConstReplace, proc);
 
     // First placement of phi functions, renaming, and initial propagation. This is mostly for the
     // stack pointer
     // TODO: Check if this makes sense. It seems to me that we only want to do one pass of
     // propagation here, since the status == check had been knobbled below. Hopefully, one call to
     // placing phi functions etc will be equivalent to depth 0 in the old scheme
-    PassManager::get()->executePass(PassID::PhiPlacement, proc);
+    executePass(PassID::PhiPlacement, proc);
 
 
     // Rename variables
-    PassManager::get()->executePass(PassID::BlockVarRename, proc);
-    PassManager::get()->executePass(PassID::StatementPropagation, proc);
+    executePass(PassID::BlockVarRename, proc);
+    executePass(PassID::StatementPropagation, proc);
 
     project->alertDecompileDebugPoint(proc, "After Early");
 }
@@ -382,23 +384,22 @@ void ProcDecompiler::middleDecompile(UserProc *proc)
     // is a call. The first stage bypass yields m[r1{2}]{11}, which needs another round of
     // propagation to yield m[r1{-}-32]{11} (which can safely be processed at depth 1). Except that
     // this is now inherent in the visitor nature of the latest algorithm.
-    PassManager::get()->executePass(PassID::CallAndPhiFix,
-                                    proc); // Bypass children that are finalised (if any)
+    executePass(PassID::CallAndPhiFix, proc); // Bypass children that are finalised (if any)
     proc->debugPrintAll("After call and phi bypass (1)");
 
     if (proc->getStatus() != PROC_INCYCLE) { // FIXME: need this test?
-        PassManager::get()->executePass(PassID::StatementPropagation, proc);
+        executePass(PassID::StatementPropagation, proc);
     }
 
     // This part used to be calle middleDecompile():
 
-    PassManager::get()->executePass(PassID::SPPreservation, proc);
+    executePass(PassID::SPPreservation, proc);
     // Oops - the idea of splitting the sp from the rest of the preservations was to allow correct
     // naming of locals so you are alias conservative. But of course some locals are ebp (etc)
     // based, and so these will never be correct until all the registers have preservation analysis
     // done. So I may as well do them all together here.
-    PassManager::get()->executePass(PassID::PreservationAnalysis, proc);
-    PassManager::get()->executePass(PassID::CallAndPhiFix, proc); // Propagate and bypass sp
+    executePass(PassID::PreservationAnalysis, proc);
+    executePass(PassID::CallAndPhiFix, proc); // Propagate and bypass sp
 
     proc->debugPrintAll("After preservation, bypass and propagation");
 
@@ -426,23 +427,22 @@ void ProcDecompiler::middleDecompile(UserProc *proc)
     // initial arguments here (relatively early), and live with the fact that some apparently
     // distinct memof argument expressions (e.g. m[eax{30}] and m[esp{40}-4]) will turn out to be
     // duplicates, and so the duplicates must be eliminated.
-    bool change = PassManager::get()->executePass(PassID::PhiPlacement, proc);
+    bool change = executePass(PassID::PhiPlacement, proc);
 
-    PassManager::get()->executePass(PassID::BlockVarRename, proc);
+    executePass(PassID::BlockVarRename, proc);
 
     // Otherwise sometimes sp is not fully propagated
-    PassManager::get()->executePass(PassID::StatementPropagation, proc);
-    PassManager::get()->executePass(PassID::CallArgumentUpdate, proc);
-    PassManager::get()->executePass(PassID::StrengthReductionReversal, proc);
+    executePass(PassID::StatementPropagation, proc);
+    executePass(PassID::CallArgumentUpdate, proc);
+    executePass(PassID::StrengthReductionReversal, proc);
 
     // Repeat until no change
     int pass = 3;
 
     do {
         // Redo the renaming process to take into account the arguments
-        change = PassManager::get()->executePass(PassID::PhiPlacement, proc);
-        change |= PassManager::get()->executePass(PassID::BlockVarRename,
-                                                  proc); // E.g. for new arguments
+        change = executePass(PassID::PhiPlacement, proc);
+        change |= executePass(PassID::BlockVarRename, proc); // E.g. for new arguments
 
         // Seed the return statement with reaching definitions
         // FIXME: does this have to be in this loop?
@@ -473,17 +473,17 @@ void ProcDecompiler::middleDecompile(UserProc *proc)
                 LOG_VERBOSE("### update returns loop iteration %1 ###", i);
 
                 if (proc->getStatus() != PROC_INCYCLE) {
-                    PassManager::get()->executePass(PassID::BlockVarRename, proc);
+                    executePass(PassID::BlockVarRename, proc);
                 }
 
-                PassManager::get()->executePass(PassID::PreservationAnalysis, proc);
+                executePass(PassID::PreservationAnalysis, proc);
 
                 // Returns have uses which affect call defines (if childless)
-                PassManager::get()->executePass(PassID::CallDefineUpdate, proc);
-                PassManager::get()->executePass(PassID::CallAndPhiFix, proc);
+                executePass(PassID::CallDefineUpdate, proc);
+                executePass(PassID::CallAndPhiFix, proc);
 
                 // Preserveds subtract from returns
-                PassManager::get()->executePass(PassID::PreservationAnalysis, proc);
+                executePass(PassID::PreservationAnalysis, proc);
             }
 
             if (project->getSettings()->verboseOutput) {
@@ -498,14 +498,14 @@ void ProcDecompiler::middleDecompile(UserProc *proc)
 
         project->alertDecompileDebugPoint(proc, "Before propagating statements");
 
-        change |= PassManager::get()->executePass(PassID::StatementPropagation, proc);
-        change |= PassManager::get()->executePass(PassID::BlockVarRename, proc);
+        change |= executePass(PassID::StatementPropagation, proc);
+        change |= executePass(PassID::BlockVarRename, proc);
 
         project->alertDecompileDebugPoint(proc, "after propagating statements");
 
         // this is just to make it readable, do NOT rely on these statements being removed
-        PassManager::get()->executePass(PassID::AssignRemoval, proc);
-    } while (change && ++pass < 12);
+        executePass(PassID::AssignRemoval, proc);
+    } while (change && ++pass < 12 && !isOverBudget(proc));
 
     // At this point, there will be some memofs that have still not been renamed. They have been
     // prevented from getting renamed so that they didn't get renamed incorrectly (usually as {-}),
@@ -519,34 +519,42 @@ void ProcDecompiler::middleDecompile(UserProc *proc)
     proc->getDataFlow()->setRenameLocalsParams(true);
 
     // Now we need another pass to inert phis for the memofs, rename them and propagate them
-    PassManager::get()->executePass(PassID::PhiPlacement, proc);
-    PassManager::get()->executePass(PassID::BlockVarRename, proc);
+    executePass(PassID::PhiPlacement, proc);
+    executePass(PassID::BlockVarRename, proc);
 
     proc->debugPrintAll("after setting phis for memofs, renaming them");
-    PassManager::get()->executePass(PassID::StatementPropagation, proc);
+    executePass(PassID::StatementPropagation, proc);
 
     // Now that memofs are renamed, the bypassing for memofs can work
-    PassManager::get()->executePass(PassID::CallAndPhiFix,
-                                    proc); // Bypass children that are finalised (if any)
+    executePass(PassID::CallAndPhiFix, proc); // Bypass children that are finalised (if any)
 
     if (project->getSettings()->nameParameters) {
         // ? Crazy time to do this... haven't even done "final" parameters as yet
         // mapExpressionsToParameters();
     }
 
-    // Check for indirect jumps or calls not already removed by propagation of constants
-    bool changed = false;
+    // Check for indirect jumps or calls not already removed by propagation of constants.
+    // All of them are analyzed together, so there is at most one restart per round.
+    // Restarting is the most expensive thing we can do, so don't do it when out of budget.
     IndirectJumpAnalyzer analyzer;
+    const bool switchFound = !isOverBudget(proc) && analyzer.analyzeIndirectTransfers(proc);
 
-    for (BasicBlock *bb : *proc->getCFG()) {
-        changed |= analyzer.decodeIndirectJmp(bb, proc);
+    // Callees found through indirect calls are decompiled before this proc continues,
+    // like the callees of direct calls. Callees already being decompiled are left alone.
+    for (UserProc *callee : analyzer.getDecodedCallees()) {
+        if (callee->getStatus() < PROC_VISITED) {
+            LOG_VERBOSE("Preparing to decompile indirectly called callee '%1' of '%2'",
+                        callee->getName(), proc->getName());
+
+            callee->promoteSignature();
+            tryDecompileRecursive(callee);
+        }
     }
 
-    if (changed) {
-        // There was at least one indirect jump or call found and decoded. That means that most of
+    if (switchFound) {
+        // There was at least one indirect jump found and decoded. That means that most of
         // what has been done to this function so far is invalid. So redo everything. Very
-        // expensive!! Code pointed to by the switch table entries has merely had
-        // FrontEnd::processFragment() called on it
+        // expensive!! The switch arms are decoded by the front end when re-decoding the proc.
         LOG_MSG(
             "Restarting decompilation of '%1' because indirect jumps or calls have been analyzed",
             proc->getName());
@@ -578,7 +586,7 @@ void ProcDecompiler::middleDecompile(UserProc *proc)
         return;
     }
 
-    PassManager::get()->executePass(PassID::PreservationAnalysis, proc);
+    executePass(PassID::PreservationAnalysis, proc);
 
     // Used to be later...
     if (project->getSettings()->nameParameters) {
@@ -588,7 +596,7 @@ void ProcDecompiler::middleDecompile(UserProc *proc)
         proc->debugPrintAll("after replacing expressions, trimming params and returns");
     }
 
-    PassManager::get()->executePass(PassID::DuplicateArgsRemoval, proc);
+    executePass(PassID::DuplicateArgsRemoval, proc);
 
     proc->setStatus(PROC_EARLYDONE);
 
@@ -636,11 +644,10 @@ bool ProcDecompiler::decompileProcInRecursionGroup(UserProc *proc, ProcSet &visi
 
     // Need to propagate into the initial arguments, since arguments are uses,
     // and we are about to remove unused statements.
-    changed |= PassManager::get()->executePass(PassID::LocalAndParamMap, proc);
-    changed |= PassManager::get()->executePass(PassID::CallArgumentUpdate, proc);
-    changed |= PassManager::get()->executePass(PassID::Dominators, proc);
-    changed |= PassManager::get()->executePass(PassID::StatementPropagation,
-                                               proc); // Need to propagate into arguments
+    changed |= executePass(PassID::LocalAndParamMap, proc);
+    changed |= executePass(PassID::CallArgumentUpdate, proc);
+    changed |= executePass(PassID::Dominators, proc);
+    changed |= executePass(PassID::StatementPropagation, proc); // Need to propagate into arguments
 
     assert(m_callStack.back() == proc);
     m_callStack.pop_back();
@@ -704,39 +711,45 @@ void ProcDecompiler::lateDecompile(UserProc *proc)
 
     LOG_VERBOSE("### Removing unused statements for %1 ###", proc->getName());
 
+    // When out of budget, finalize the proc as it is. Without type analysis,
+    // we do not have full use information, so unused statements cannot be removed either.
+    const bool overBudget = isOverBudget(proc);
+
     // Perform type analysis. If we are relying (as we are at present) on TA to perform ellipsis
     // processing, do the local TA pass now. Ellipsis processing often reveals additional uses (e.g.
     // additional parameters to printf/scanf), and removing unused statements is unsafe without full
     // use information
-    if (proc->getStatus() < PROC_FINAL) {
-        PassManager::get()->executePass(PassID::LocalTypeAnalysis, proc);
+    if (proc->getStatus() < PROC_FINAL && !overBudget) {
+        executePass(PassID::LocalTypeAnalysis, proc);
 
         // Now that locals are identified, redo the dataflow
-        PassManager::get()->executePass(PassID::PhiPlacement, proc);
+        executePass(PassID::PhiPlacement, proc);
 
-        PassManager::get()->executePass(PassID::BlockVarRename, proc); // Rename the locals
-        PassManager::get()->executePass(PassID::StatementPropagation,
-                                        proc); // Surely need propagation too
+        executePass(PassID::BlockVarRename, proc); // Rename the locals
+        executePass(PassID::StatementPropagation, proc); // Surely need propagation too
 
         if (project->getSettings()->verboseOutput) {
             proc->debugPrintAll("after propagating locals");
         }
     }
 
-    PassManager::get()->executePass(PassID::UnusedStatementRemoval, proc);
-    PassManager::get()->executePass(PassID::FinalParameterSearch, proc);
+    if (!overBudget) {
+        executePass(PassID::UnusedStatementRemoval, proc);
+    }
+
+    executePass(PassID::FinalParameterSearch, proc);
 
     if (project->getSettings()->nameParameters) {
         // Replace the existing temporary parameters with the final ones:
         // mapExpressionsToParameters();
-        PassManager::get()->executePass(PassID::ParameterSymbolMap, proc);
+        executePass(PassID::ParameterSymbolMap, proc);
         proc->debugPrintAll("after adding new parameters");
     }
 
     // Or just CallArgumentUpdate?
-    PassManager::get()->executePass(PassID::CallDefineUpdate, proc);
-    PassManager::get()->executePass(PassID::CallArgumentUpdate, proc);
-    PassManager::get()->executePass(PassID::BranchAnalysis, proc);
+    executePass(PassID::CallDefineUpdate, proc);
+    executePass(PassID::CallArgumentUpdate, proc);
+    executePass(PassID::BranchAnalysis, proc);
 
     proc->debugPrintAll("after remove unused statements etc");
     project->alertDecompileDebugPoint(proc, "after final");
@@ -756,7 +769,7 @@ void ProcDecompiler::saveDecodedICTs(UserProc *proc)
 {
     for (BasicBlock *bb : *proc->getCFG()) {
         BasicBlock::RTLRIterator rrit;
-        StatementList::reverse_iterator srit;
+        StatementList::const_reverse_iterator srit;
         Statement *last = bb->getLastStmt(rrit, srit);
 
         if (last == nullptr) {
@@ -776,3 +789,48 @@ void ProcDecompiler::saveDecodedICTs(UserProc *proc)
         proc->getProg()->getFrontEnd()->saveDecodedRTL(bb->getHiAddr(), rtl);
     }
 }
+
+
+bool ProcDecompiler::executePass(PassID passID, UserProc *proc)
+{
+    ProcBudget &budget = m_budgets[proc];
+
+    QElapsedTimer timer;
+    timer.start();
+
+    const bool changed = PassManager::get()->executePass(passID, proc);
+
+    budget.elapsedNs += timer.nsecsElapsed();
+    budget.numPasses++;
+    return changed;
+}
+
+
+bool ProcDecompiler::isOverBudget(UserProc *proc)
+{
+    ProcBudget &budget       = m_budgets[proc];
+    const Settings *settings = proc->getProg()->getProject()->getSettings();
+
+    if (budget.exceeded) {
+        return true;
+    }
+
+    QString reason;
+
+    if (settings->procTimeBudget > 0 &&
+        budget.elapsedNs >= static_cast<qint64>(settings->procTimeBudget) * 1000000000) {
+        reason = QString("time budget of %1 s exceeded").arg(settings->procTimeBudget);
+    }
+    else if (settings->procPassBudget > 0 && budget.numPasses >= settings->procPassBudget) {
+        reason = QString("budget of %1 passes exceeded").arg(settings->procPassBudget);
+    }
+    else {
+        return false;
+    }
+
+    budget.exceeded = true;
+    proc->setDecompileNote("Decompilation incomplete: " + reason);
+
+    LOG_WARN("Decompilation of '%1' cut short: %2", proc->getName(), reason);
+    return true;
+}
@@ -11,6 +11,7 @@
 
 
 #include "boomerang/db/proc/UserProc.h"
+#include "boomerang/passes/Pass.h"
 
 #include <unordered_map>
 
@@ -62,9 +63,33 @@ private:
      */
     void saveDecodedICTs(UserProc *proc);
 
+    /// Execute the pass \p passID on \p proc and charge it to the budget of \p proc.
+    /// \returns true if the pass changed \p proc.
+    bool executePass(PassID passID, UserProc *proc);
+
+    /**
+     * \returns true if \p proc has used up its time or pass budget
+     * (see Settings::procTimeBudget and Settings::procPassBudget).
+     * Once exceeded, the remaining analyses of \p proc are skipped or cut short
+     * so that it is finalized with the results available so far.
+     */
+    bool isOverBudget(UserProc *proc);
+
+private:
+    /// Work spent on a single procedure
+    struct ProcBudget
+    {
+        qint64 elapsedNs = 0; ///< Time spent in passes of the procedure itself
+        int numPasses    = 0;
+        bool exceeded    = false;
+    };
+
 private:
     ProcList m_callStack;
 
+    /// Budgets are kept across restarts caused by newly decoded indirect jumps.
+    std::unordered_map<UserProc *, ProcBudget> m_budgets;
+
     /**
      * Pointer to a set of procedures involved in a recursion group.
      * The procedures in the ProcSet form a strongly connected component of the call graph.
@@ -19,6 +19,7 @@
 #include "boomerang/passes/PassManager.h"
 #include "boomerang/ssl/exp/Const.h"
 #include "boomerang/ssl/exp/Location.h"
+#include "boomerang/ssl/statements/CallStatement.h"
 #include "boomerang/util/log/Log.h"
 
 
@@ -33,6 +34,11 @@ void ProgDecompiler::decompile()
     assert(!m_prog->getModuleList().empty());
     LOG_VERBOSE("%1 procedures", m_prog->getNumFunctions(false));
 
+    const bool streaming = m_prog->getProject()->getSettings()->streamDecompilation;
+    if (streaming) {
+        m_prog->getProject()->addWatcher(this, watchEventMask(WatchEvent::EndDecompile));
+    }
+
     // Start decompiling each entry point
     for (UserProc *up : m_prog->getEntryProcs()) {
         LOG_MSG("Decompiling entry point '%1'", up->getName());
@@ -66,20 +72,26 @@ void ProgDecompiler::decompile()
         }
     }
 
+    if (streaming) {
+        streamPendingProcs(true);
+        m_prog->getProject()->removeWatcher(this);
+    }
+
     globalTypeAnalysis();
 
-    if (m_prog->getProject()->getSettings()->removeReturns) {
-        // Repeat until no change. Not 100% sure if needed.
-        while (removeUnusedParamsAndReturns()) {
-            for (auto &module : m_prog->getModuleList()) {
-                for (Function *proc : *module) {
-                    if (proc->isLib()) {
-                        continue;
-                    }
+    if (streaming) {
+        // Removing returns changes callers and callees after they are decompiled,
+        // which is not possible after their state has been released.
+        LOG_VERBOSE("Not removing unused returns in streaming mode");
+    }
+    else if (m_prog->getProject()->getSettings()->removeReturns) {
+        UnusedReturnRemover remover(m_prog);
 
-                    PassManager::get()->executePass(PassID::BranchAnalysis,
-                                                    static_cast<UserProc *>(proc));
-                }
+        // Repeat until no change. Not 100% sure if needed.
+        while (removeUnusedParamsAndReturns(remover)) {
+            // Only procedures changed by removing returns need their branches re-analysed.
+            for (UserProc *proc : remover.getChangedProcs()) {
+                PassManager::get()->executePass(PassID::BranchAnalysis, proc);
             }
         }
     }
@@ -89,10 +101,21 @@ void ProgDecompiler::decompile()
     // Now it is OK to transform out of SSA form
     fromSSAForm();
     removeUnusedGlobals();
+    reportIncompleteProcs();
     LOG_MSG("Decompilation finished.");
 }
 
 
+void ProgDecompiler::onEndDecompile(UserProc *proc)
+{
+    if (std::find(m_pendingProcs.begin(), m_pendingProcs.end(), proc) == m_pendingProcs.end()) {
+        m_pendingProcs.push_back(proc);
+    }
+
+    streamPendingProcs(false);
+}
+
+
 void ProgDecompiler::globalTypeAnalysis()
 {
     LOG_MSG("Performing global type analysis...");
@@ -105,9 +128,12 @@ void ProgDecompiler::globalTypeAnalysis()
         for (Function *pp : *module) {
             UserProc *proc = dynamic_cast<UserProc *>(pp);
 
-            if (!proc || !proc->isDecoded()) {
+            if (!proc || !proc->isDecoded() || proc->isStateReleased()) {
                 continue;
             }
+            else if (!proc->getDecompileNote().isEmpty()) {
+                continue; // finalized early; do not spend more time on it
+            }
 
             // FIXME: this just does local TA again. Need to meet types for all parameter/arguments,
             // and return/results! This will require a repeat until no change loop
@@ -135,26 +161,19 @@ void ProgDecompiler::removeUnusedGlobals()
                 continue;
             }
 
-            UserProc *proc = static_cast<UserProc *>(func);
-            Location search(opGlobal, Terminal::get(opWild), proc);
-            // Search each statement in u, excepting implicit assignments (their uses don't count,
-            // since they don't really exist in the program representation)
-            StatementList stmts;
-            StatementList::iterator ss;
-            proc->getStatements(stmts);
-
-            for (Statement *s : stmts) {
-                if (s->isImplicit()) {
-                    continue; // Ignore the uses in ImplicitAssigns
-                }
+            findUsedGlobals(static_cast<UserProc *>(func), usedGlobals);
+        }
+    }
 
-                bool found = s->searchAll(search, usedGlobals);
+    // Globals used by procs that were already streamed out, and by the remaining procs
+    std::set<QString> usedNames = m_streamedGlobals;
 
-                if (found && m_prog->getProject()->getSettings()->debugUnused) {
-                    LOG_VERBOSE("A global is used by stmt %1", s->getNumber());
-                }
-            }
+    for (const SharedExp &e : usedGlobals) {
+        if (m_prog->getProject()->getSettings()->debugUnused) {
+            LOG_MSG(" %1 is used", e);
         }
+
+        usedNames.insert(e->access<Const, 1>()->getStr());
     }
 
     // make a map to find a global by its name (could be a global var too)
@@ -168,12 +187,7 @@ void ProgDecompiler::removeUnusedGlobals()
     Prog::GlobalSet oldGlobals = m_prog->getGlobals();
     m_prog->getGlobals().clear();
 
-    for (const SharedExp &e : usedGlobals) {
-        if (m_prog->getProject()->getSettings()->debugUnused) {
-            LOG_MSG(" %1 is used", e);
-        }
-
-        QString name(e->access<Const, 1>()->getStr());
+    for (const QString &name : usedNames) {
         auto &usedGlobal = namedGlobals[name];
 
         if (usedGlobal) {
@@ -186,10 +200,10 @@ void ProgDecompiler::removeUnusedGlobals()
 }
 
 
-bool ProgDecompiler::removeUnusedParamsAndReturns()
+bool ProgDecompiler::removeUnusedParamsAndReturns(UnusedReturnRemover &remover)
 {
     LOG_MSG("Removing unused returns...");
-    return UnusedReturnRemover(m_prog).removeUnusedReturns();
+    return remover.removeUnusedReturns();
 }
 
 
@@ -204,8 +218,143 @@ void ProgDecompiler::fromSSAForm()
             }
 
             UserProc *proc = static_cast<UserProc *>(pp);
+            if (proc->isStateReleased()) {
+                continue;
+            }
+
             proc->numberStatements();
             PassManager::get()->executePass(PassID::FromSSAForm, proc);
         }
     }
 }
+
+
+void ProgDecompiler::findUsedGlobals(UserProc *proc, std::list<SharedExp> &usedGlobals)
+{
+    Location search(opGlobal, Terminal::get(opWild), proc);
+    // Search each statement in u, excepting implicit assignments (their uses don't count,
+    // since they don't really exist in the program representation)
+    const auto stmts = proc->getStatementIndex();
+
+    for (Statement *s : *stmts) {
+        if (s->isImplicit()) {
+            continue; // Ignore the uses in ImplicitAssigns
+        }
+
+        bool found = s->searchAll(search, usedGlobals);
+
+        if (found && m_prog->getProject()->getSettings()->debugUnused) {
+            LOG_VERBOSE("A global is used by stmt %1", s->getNumber());
+        }
+    }
+}
+
+
+void ProgDecompiler::streamPendingProcs(bool all)
+{
+    for (auto it = m_pendingProcs.begin(); it != m_pendingProcs.end();) {
+        UserProc *proc = *it;
+
+        if ((all && proc->isDecompiled()) || isReadyForStreaming(proc)) {
+            it = m_pendingProcs.erase(it);
+            streamProc(proc);
+        }
+        else {
+            ++it;
+        }
+    }
+
+    const std::size_t budget = static_cast<std::size_t>(
+        m_prog->getProject()->getSettings()->streamProcBudget);
+
+    // Over budget; callers that are decompiled later will only see the summary of these procs.
+    for (auto it = m_pendingProcs.begin();
+         it != m_pendingProcs.end() && m_pendingProcs.size() > budget;) {
+        UserProc *proc = *it;
+
+        // A caller that is still being decompiled may still update this proc
+        if (proc->isDecompiled() && !hasCallerInProgress(proc)) {
+            it = m_pendingProcs.erase(it);
+            streamProc(proc);
+        }
+        else {
+            ++it;
+        }
+    }
+}
+
+
+bool ProgDecompiler::isReadyForStreaming(UserProc *proc) const
+{
+    if (!proc->isDecompiled()) {
+        return false;
+    }
+
+    for (const CallStatement *caller : proc->getCallers()) {
+        if (!caller->getProc()->isDecompiled()) {
+            return false; // this caller may still change the proc
+        }
+    }
+
+    return true;
+}
+
+
+bool ProgDecompiler::hasCallerInProgress(UserProc *proc) const
+{
+    for (const CallStatement *caller : proc->getCallers()) {
+        const ProcStatus status = caller->getProc()->getStatus();
+
+        if (status >= PROC_VISITED && status < PROC_FINAL) {
+            return true;
+        }
+    }
+
+    return false;
+}
+
+
+void ProgDecompiler::streamProc(UserProc *proc)
+{
+    LOG_VERBOSE("Streaming out procedure '%1'", proc->getName());
+
+    if (proc->getDecompileNote().isEmpty()) {
+        PassManager::get()->executePass(PassID::LocalTypeAnalysis, proc);
+    }
+
+    proc->numberStatements();
+    PassManager::get()->executePass(PassID::FromSSAForm, proc);
+
+    std::list<SharedExp> usedGlobals;
+    findUsedGlobals(proc, usedGlobals);
+
+    for (const SharedExp &e : usedGlobals) {
+        m_streamedGlobals.insert(e->access<Const, 1>()->getStr());
+    }
+
+    m_prog->getProject()->generateProcCode(proc);
+    proc->releaseDecompilationState();
+}
+
+
+void ProgDecompiler::reportIncompleteProcs()
+{
+    std::list<UserProc *> incompleteProcs;
+
+    for (const auto &module : m_prog->getModuleList()) {
+        for (Function *func : *module) {
+            if (!func->isLib() && !static_cast<UserProc *>(func)->getDecompileNote().isEmpty()) {
+                incompleteProcs.push_back(static_cast<UserProc *>(func));
+            }
+        }
+    }
+
+    if (incompleteProcs.empty()) {
+        return;
+    }
+
+    LOG_WARN("Decompilation of %1 procedures is incomplete:", incompleteProcs.size());
+    for (UserProc *proc : incompleteProcs) {
+        LOG_WARN("    %1: %2", proc->getName(), proc->getDecompileNote());
+    }
+}
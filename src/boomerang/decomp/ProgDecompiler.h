@@ -11,12 +11,20 @@
 
 
 #include "boomerang/core/BoomerangAPI.h"
+#include "boomerang/core/Watcher.h"
+#include "boomerang/ssl/exp/ExpHelp.h"
+
+#include <QString>
+
+#include <list>
+#include <set>
 
 
 class Prog;
+class UnusedReturnRemover;
 
 
-class BOOMERANG_API ProgDecompiler
+class BOOMERANG_API ProgDecompiler : public IWatcher
 {
 public:
     ProgDecompiler(Prog *prog);
@@ -25,9 +33,14 @@ public:
     /// Do the main non-global decompilation steps
     void decompile();
 
+public:
+    /// \copydoc IWatcher::onEndDecompile
+    void onEndDecompile(UserProc *proc) override;
+
 private:
     /// Do global type analysis.
-    /// \note For now, it just does local type analysis for every procedure of the program.
+    /// \note For now, it just does local type analysis for every procedure of the program,
+    /// except for procedures that were finalized early (see UserProc::getDecompileNote).
     void globalTypeAnalysis();
 
     /// As the name suggests, removes globals unused in the decompiled code.
@@ -35,12 +48,45 @@ private:
 
     /// Remove unused or redundant parameters and return values from the program.
     /// \returns true if any change
-    bool removeUnusedParamsAndReturns();
+    bool removeUnusedParamsAndReturns(UnusedReturnRemover &remover);
 
     /// Have to transform out of SSA form after the above final pass
     /// Convert from SSA form
     void fromSSAForm();
 
+    /// Search the statements of \p proc for used globals and add them to \p usedGlobals.
+    void findUsedGlobals(UserProc *proc, std::list<SharedExp> &usedGlobals);
+
+    /**
+     * In streaming mode, generate code for all pending procs that cannot be changed any more
+     * and free their decompilation state. If there are still more pending procs than allowed
+     * by the budget afterwards, the oldest ones are streamed out early, unless one of their
+     * callers is still being decompiled.
+     * \param all If true, stream out all decompiled pending procs.
+     */
+    void streamPendingProcs(bool all);
+
+    /// \returns true if \p proc and all of its callers are decompiled.
+    bool isReadyForStreaming(UserProc *proc) const;
+
+    /// \returns true if the decompilation of any caller of \p proc has started but not finished,
+    /// i.e. the caller is on the call stack of ProcDecompiler or waits for its recursion group.
+    bool hasCallerInProgress(UserProc *proc) const;
+
+    /// Do the global steps of the decompilation for \p proc only,
+    /// generate its code and free its decompilation state.
+    void streamProc(UserProc *proc);
+
+    /// Log all procedures that were finalized early, e.g. because they exceeded
+    /// their decompilation budget.
+    void reportIncompleteProcs();
+
 private:
     Prog *m_prog;
+
+    /// Procs that finished decompilation but were not streamed out yet, oldest first.
+    std::list<UserProc *> m_pendingProcs;
+
+    /// Names of the globals used by procs that were already streamed out.
+    std::set<QString> m_streamedGlobals;
 };
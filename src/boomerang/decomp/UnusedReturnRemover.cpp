@@ -11,6 +11,7 @@
 
 #include "boomerang/core/Project.h"
 #include "boomerang/core/Settings.h"
+#include "boomerang/db/CallGraphIndex.h"
 #include "boomerang/db/Prog.h"
 #include "boomerang/db/module/Module.h"
 #include "boomerang/db/proc/UserProc.h"
@@ -22,6 +23,18 @@
 #include "boomerang/util/log/Log.h"
 #include "boomerang/visitor/expmodifier/ImplicitConverter.h"
 
+#include <vector>
+
+
+bool ProcAddrLess::operator()(const UserProc *lhs, const UserProc *rhs) const
+{
+    if (lhs->getEntryAddress() != rhs->getEntryAddress()) {
+        return lhs->getEntryAddress() < rhs->getEntryAddress();
+    }
+
+    return lhs < rhs;
+}
+
 
 UnusedReturnRemover::UnusedReturnRemover(Prog *prog)
     : m_prog(prog)
@@ -31,46 +44,90 @@ UnusedReturnRemover::UnusedReturnRemover(Prog *prog)
 
 bool UnusedReturnRemover::removeUnusedReturns()
 {
-    for (const auto &module : m_prog->getModuleList()) {
-        for (Function *proc : *module) {
-            if (proc && !proc->isLib() && static_cast<UserProc *>(proc)->isDecoded()) {
-                m_removeRetSet.insert(static_cast<UserProc *>(proc));
-            }
-            // else e.g. use -sf file to just prototype the proc
-        }
+    m_changedProcs.clear();
+    computeProcOrder();
+
+    for (const auto &[proc, order] : m_procOrder) {
+        m_removeRetSet[order] = proc;
     }
 
     bool change = false;
-    // The workset is processed in arbitrary order. May be able to do better,
-    // but note that sometimes changes propagate down the call tree
+    // The workset is processed in top-down call graph order.
+    // Note that sometimes changes propagate down the call tree
     // (no caller uses potential returns for child), and sometimes up the call tree
     // (removal of returns and/or dead code removes parameters, which affects all callers).
+    // Only procedures whose parameters or call livenesses changed are scheduled again.
     while (!m_removeRetSet.empty()) {
         auto it                   = m_removeRetSet.begin(); // Pick the first element of the set
-        const bool removedReturns = removeUnusedParamsAndReturns(*it);
+        UserProc *proc            = it->second;
+        const bool removedReturns = removeUnusedParamsAndReturns(proc);
 
         if (removedReturns) {
             // Removing returns changes the uses of the callee.
             // So we have to do type analyis to update the use information.
-            PassManager::get()->executePass(PassID::LocalTypeAnalysis, *it);
+            PassManager::get()->executePass(PassID::LocalTypeAnalysis, proc);
 
             // type analysis might propagate statements that could not be propagated before
-            PassManager::get()->executePass(PassID::UnusedStatementRemoval, *it);
+            PassManager::get()->executePass(PassID::UnusedStatementRemoval, proc);
         }
         change |= removedReturns;
 
         // Note: removing the currently processed item here should prevent
         // unnecessary reprocessing of self recursive procedures
-        m_removeRetSet.erase(it);
+        m_removeRetSet.erase(m_procOrder[proc]);
     }
 
     return change;
 }
 
 
+void UnusedReturnRemover::computeProcOrder()
+{
+    m_procOrder.clear();
+
+    const CallGraphIndex &callGraph  = m_prog->getCallGraph();
+    const std::vector<int> &bottomUp = callGraph.getBottomUpOrder();
+
+    int order = 0;
+    for (auto it = bottomUp.rbegin(); it != bottomUp.rend(); ++it) {
+        Function *func = callGraph.getProc(*it);
+
+        if (!func->isLib() && static_cast<UserProc *>(func)->isDecoded() &&
+            canProcess(static_cast<UserProc *>(func))) {
+            m_procOrder[static_cast<UserProc *>(func)] = order++;
+        }
+        // else e.g. use -sf file to just prototype the proc
+    }
+}
+
+
+void UnusedReturnRemover::scheduleProc(UserProc *proc)
+{
+    if (!canProcess(proc)) {
+        return;
+    }
+
+    auto it = m_procOrder.find(proc);
+
+    if (it == m_procOrder.end()) {
+        // not seen by computeProcOrder (e.g. not decoded at that time); process it last
+        const int order = static_cast<int>(m_procOrder.size());
+        it              = m_procOrder.insert({ proc, order }).first;
+    }
+
+    m_removeRetSet[it->second] = proc;
+}
+
+
+bool UnusedReturnRemover::canProcess(UserProc *proc) const
+{
+    return m_restrictedTo.empty() || m_restrictedTo.find(proc) != m_restrictedTo.end();
+}
+
+
 bool UnusedReturnRemover::removeUnusedParamsAndReturns(UserProc *proc)
 {
-    assert(m_removeRetSet.find(proc) != m_removeRetSet.end());
+    assert(m_procOrder.find(proc) != m_procOrder.end());
 
     m_prog->getProject()->alertDecompiling(proc);
     m_prog->getProject()->alertDecompileDebugPoint(proc, "before removing unused returns");
@@ -78,6 +135,10 @@ bool UnusedReturnRemover::removeUnusedParamsAndReturns(UserProc *proc)
     // First remove the unused parameters
     bool removedParams = PassManager::get()->executePass(PassID::UnusedParamRemoval, proc);
 
+    if (removedParams) {
+        m_changedProcs.insert(proc);
+    }
+
     if (proc->getRetStmt() == nullptr) {
         return removedParams;
     }
@@ -193,14 +254,17 @@ bool UnusedReturnRemover::removeUnusedParamsAndReturns(UserProc *proc)
     // removing returns might result in params that can be removed, might as well do it now.
     removedParams |= PassManager::get()->executePass(PassID::UnusedParamRemoval, proc);
 
-    ProcSet updateSet; // Set of procs to update
+    OrderedProcSet updateSet; // Set of procs to update
 
     if (removedParams || removedRets) {
         // Update the statements that call us
         for (CallStatement *call : proc->getCallers()) {
             PassManager::get()->executePass(PassID::CallArgumentUpdate, proc);
-            updateSet.insert(call->getProc());      // Make sure we redo the dataflow
-            m_removeRetSet.insert(call->getProc()); // Also schedule caller proc for more analysis
+            // Make sure we redo the dataflow. The caller is only scheduled for more analysis
+            // by updateForUseChange if its parameters or call livenesses actually change.
+            if (canProcess(call->getProc())) {
+                updateSet.insert(call->getProc());
+            }
         }
 
         // Now update myself
@@ -231,13 +295,15 @@ void UnusedReturnRemover::updateForUseChange(UserProc *proc)
         LOG_MSG("%%% updating dataflow:");
     }
 
+    m_changedProcs.insert(proc);
+
     // Save the old parameters and call liveness
     const size_t oldNumParameters = proc->getParameters().size();
     std::map<CallStatement *, UseCollector> callLiveness;
 
     for (BasicBlock *bb : *proc->getCFG()) {
         BasicBlock::RTLRIterator rrit;
-        StatementList::reverse_iterator srit;
+        StatementList::const_reverse_iterator srit;
         CallStatement *c = dynamic_cast<CallStatement *>(bb->getLastStmt(rrit, srit));
 
         // Note: we may have removed some statements, so there may no longer be a last statement!
@@ -305,9 +371,13 @@ void UnusedReturnRemover::updateForUseChange(UserProc *proc)
         const bool experimental            = m_prog->getProject()->getSettings()->experimental;
 
         for (CallStatement *cc : callers) {
+            if (!canProcess(cc->getProc())) {
+                continue;
+            }
+
             cc->updateArguments(experimental);
             // Schedule the callers for analysis
-            m_removeRetSet.insert(cc->getProc());
+            scheduleProc(cc->getProc());
         }
     }
 
@@ -321,7 +391,7 @@ void UnusedReturnRemover::updateForUseChange(UserProc *proc)
                         call->getDestProc()->getName(), proc->getName());
             }
 
-            m_removeRetSet.insert(static_cast<UserProc *>(call->getDestProc()));
+            scheduleProc(static_cast<UserProc *>(call->getDestProc()));
         }
     }
 }
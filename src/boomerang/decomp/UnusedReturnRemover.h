@@ -12,6 +12,7 @@
 
 #include "boomerang/ssl/exp/ExpHelp.h"
 
+#include <map>
 #include <set>
 
 
@@ -21,6 +22,15 @@ class UserProc;
 typedef std::set<UserProc *> ProcSet;
 
 
+/// Orders procedures by entry address, so sets of procedures are iterated deterministically.
+struct ProcAddrLess
+{
+    bool operator()(const UserProc *lhs, const UserProc *rhs) const;
+};
+
+typedef std::set<UserProc *, ProcAddrLess> OrderedProcSet;
+
+
 class UnusedReturnRemover
 {
 public:
@@ -42,6 +52,14 @@ public:
      */
     bool removeUnusedReturns();
 
+    /// \returns the procedures that were changed by the last call to \ref removeUnusedReturns,
+    /// ordered by entry address.
+    const OrderedProcSet &getChangedProcs() const { return m_changedProcs; }
+
+    /// Only process and change the procedures in \p procs,
+    /// e.g. because all other procedures are not in SSA form any more.
+    void restrictTo(const ProcSet &procs) { m_restrictedTo = procs; }
+
 private:
     /**
      * Remove any returns that are not used by any callers
@@ -82,7 +100,32 @@ private:
      */
     void updateForUseChange(UserProc *proc);
 
+    /**
+     * Number all decoded procedures of the program in top-down call graph order
+     * (reverse of the bottom-up order of the program's call graph).
+     * Callers are processed before their callees this way, so the liveness at all calls
+     * to a procedure is usually final by the time the procedure itself is processed.
+     */
+    void computeProcOrder();
+
+    /// Schedule \p proc for (re-)processing by \ref removeUnusedParamsAndReturns.
+    void scheduleProc(UserProc *proc);
+
+    /// \returns false if \p proc must not be changed, see \ref restrictTo.
+    bool canProcess(UserProc *proc) const;
+
 private:
     Prog *m_prog;
-    ProcSet m_removeRetSet; ///< UserProcs that need their returns updated
+
+    /// Position of each procedure in top-down call graph order
+    std::map<UserProc *, int> m_procOrder;
+
+    /// UserProcs that need their returns updated, ordered by their position in \ref m_procOrder
+    std::map<int, UserProc *> m_removeRetSet;
+
+    /// UserProcs that were changed by removing parameters or returns
+    OrderedProcSet m_changedProcs;
+
+    /// If not empty, only these UserProcs are processed
+    ProcSet m_restrictedTo;
 };
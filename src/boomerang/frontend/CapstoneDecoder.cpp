@@ -28,8 +28,11 @@ CapstoneDecoder::CapstoneDecoder(Prog *prog, cs::cs_arch arch, cs::cs_mode mode,
     cs::cs_open(arch, mode, &m_handle);
     cs::cs_option(m_handle, cs::CS_OPT_DETAIL, cs::CS_OPT_ON);
 
-    m_dict.readSSLFile(
-        prog->getProject()->getSettings()->getDataDirectory().absoluteFilePath(sslFileName));
+    const Settings *settings = prog->getProject()->getSettings();
+    const QString cacheDir   = settings->useSSLCache ? settings->getCacheDirectory().absolutePath()
+                                                     : QString();
+
+    m_dict.readSSLFile(settings->getDataDirectory().absoluteFilePath(sslFileName), cacheDir);
 }
 
 
@@ -38,6 +38,13 @@ public:
     CapstoneDecoder(Prog *prog, cs::cs_arch arch, cs::cs_mode mode, const QString &sslFileName);
     virtual ~CapstoneDecoder();
 
+public:
+    /// \copydoc IDecoder::getRegisterAliases
+    virtual const RegisterAliasModel *getRegisterAliases() const override
+    {
+        return &m_dict.getRegisterAliases();
+    }
+
 protected:
     bool isInstructionInGroup(const cs::cs_insn *instruction, uint8_t group);
 
@@ -25,14 +25,21 @@
 #include "boomerang/frontend/DecodeResult.h"
 #include "boomerang/ifc/IDecoder.h"
 #include "boomerang/ssl/RTL.h"
+#include "boomerang/ssl/exp/Binary.h"
 #include "boomerang/ssl/exp/Const.h"
 #include "boomerang/ssl/exp/Location.h"
+#include "boomerang/ssl/exp/Ternary.h"
+#include "boomerang/ssl/statements/Assign.h"
 #include "boomerang/ssl/statements/CallStatement.h"
 #include "boomerang/ssl/statements/ReturnStatement.h"
 #include "boomerang/ssl/type/FuncType.h"
+#include "boomerang/ssl/type/IntegerType.h"
 #include "boomerang/ssl/type/NamedType.h"
+#include "boomerang/util/LocationSet.h"
 #include "boomerang/util/log/Log.h"
 
+#include <algorithm>
+
 
 DefaultFrontEnd::DefaultFrontEnd(BinaryFile *binaryFile, Prog *prog)
     : m_binaryFile(binaryFile)
@@ -769,7 +776,53 @@ bool DefaultFrontEnd::processProc(UserProc *proc, Address addr)
 }
 
 
+/// Copy all fields of \p from to \p to, including a deep copy of the RTL.
+static void copyDecodeResult(const DecodeResult &from, DecodeResult &to)
+{
+    to.valid        = from.valid;
+    to.type         = from.type;
+    to.reDecode     = from.reDecode;
+    to.numBytes     = from.numBytes;
+    to.rtl          = from.rtl ? std::make_unique<RTL>(*from.rtl) : nullptr;
+    to.forceOutEdge = from.forceOutEdge;
+}
+
+
 bool DefaultFrontEnd::decodeSingleInstruction(Address pc, DecodeResult &result)
+{
+    if (!isDecodeCacheEnabled()) {
+        return decodeUncached(pc, result);
+    }
+
+    auto it = m_decodeCache.find(pc);
+    if (it != m_decodeCache.end()) {
+        copyDecodeResult(it->second, result);
+        return true;
+    }
+
+    if (!decodeUncached(pc, result)) {
+        return false;
+    }
+
+    // Only instructions reached by following control flow get here, so data embedded in code
+    // (literal pools, jump tables) is never cached.
+    const int maxCached = m_program->getProject()->getSettings()->decodeCacheSize;
+    if (result.valid && !result.reDecode && static_cast<int>(m_decodeCache.size()) < maxCached) {
+        copyDecodeResult(result, m_decodeCache[pc]);
+    }
+
+    return true;
+}
+
+
+bool DefaultFrontEnd::isDecodeCacheEnabled() const
+{
+    return m_program->getProject()->getSettings()->decodeCache && m_decoder &&
+           m_decoder->getFixedInstructionSize() > 0;
+}
+
+
+bool DefaultFrontEnd::decodeUncached(Address pc, DecodeResult &result)
 {
     BinaryImage *image = m_program->getBinaryFile()->getImage();
     if (!image || (image->getSectionByAddr(pc) == nullptr)) {
@@ -965,6 +1018,150 @@ bool DefaultFrontEnd::isHelperFunc(Address, Address, RTLList &)
 }
 
 
+/**
+ * Create the assignment that updates register \p useReg after register \p defReg was assigned to.
+ * \returns nullptr if neither register contains the other one.
+ */
+static Assign *createOverlapAssign(const RegisterAliasModel &aliases, int defReg, int useReg)
+{
+    const int defSize = aliases.getSize(defReg);
+    const int useSize = aliases.getSize(useReg);
+    const int defOff  = aliases.getBitOffset(defReg);
+    const int useOff  = aliases.getBitOffset(useReg);
+
+    if (useOff >= defOff && useOff + useSize <= defOff + defSize) {
+        // useReg is part of defReg, e.g.
+        // *16* r0 := trunc(32, 16, r24) or *8* r12 := r24@[15:8]
+        const int lo  = useOff - defOff;
+        SharedExp rhs = nullptr;
+
+        if (lo == 0) {
+            rhs = Ternary::get(opTruncu, Const::get(defSize), Const::get(useSize),
+                               Location::regOf(defReg));
+        }
+        else {
+            rhs = Ternary::get(opAt, Location::regOf(defReg), Const::get(lo + useSize - 1),
+                               Const::get(lo));
+        }
+
+        return new Assign(IntegerType::get(useSize), Location::regOf(useReg), rhs);
+    }
+    else if (defOff < useOff || defOff + defSize > useOff + useSize) {
+        return nullptr;
+    }
+
+    // defReg is part of useReg, e.g.
+    // *32* r24 := (r24 & 0xFFFF0000) | zfill(16, 32, r0) or
+    // *32* r24 := (r24 & 0xFFFF00FF) | (r12 << 8)
+    const int shift      = defOff - useOff;
+    const QWord useBits  = (useSize < 64) ? ((QWord(1) << useSize) - 1) : ~QWord(0);
+    const QWord defBits  = (defSize < 64) ? ((QWord(1) << defSize) - 1) : ~QWord(0);
+    const QWord keepMask = useBits & ~(defBits << shift);
+    const SharedExp keep = (useSize <= 32) ? Const::get(static_cast<uint32_t>(keepMask))
+                                           : Const::get(keepMask);
+
+    SharedExp newBits = nullptr;
+
+    if (shift == 0) {
+        newBits = Ternary::get(opZfill, Const::get(defSize), Const::get(useSize),
+                               Location::regOf(defReg));
+    }
+    else {
+        newBits = Binary::get(opShiftL, Location::regOf(defReg), Const::get(shift));
+    }
+
+    return new Assign(
+        IntegerType::get(useSize), Location::regOf(useReg),
+        Binary::get(opBitOr, Binary::get(opBitAnd, Location::regOf(useReg), keep), newBits));
+}
+
+
+void DefaultFrontEnd::processOverlappedRegs(UserProc *proc)
+{
+    const RegisterAliasModel *aliases = m_decoder ? m_decoder->getRegisterAliases() : nullptr;
+    if (!aliases || aliases->isEmpty()) {
+        return;
+    }
+
+    // never redo processing
+    std::vector<BasicBlock *> newBBs;
+    for (BasicBlock *bb : *proc->getCFG()) {
+        if (m_overlappedRegsProcessed.insert(bb).second && bb->getRTLs()) {
+            newBBs.push_back(bb);
+        }
+    }
+
+    if (newBBs.empty()) {
+        return;
+    }
+
+    // Uses in basic blocks processed earlier are remembered from previous calls
+    auto usedIt = m_usedOverlappedRegs.find(proc);
+    if (usedIt == m_usedOverlappedRegs.end()) {
+        usedIt = m_usedOverlappedRegs.insert({ proc, aliases->createMask() }).first;
+    }
+
+    RegisterAliasModel::RegMask &usedRegs = usedIt->second;
+    std::vector<Assignment *> defs;
+
+    for (BasicBlock *bb : newBBs) {
+        for (const auto &rtl : *bb->getRTLs()) {
+            for (Statement *s : *rtl) {
+                LocationSet locs;
+                s->addUsedLocs(locs);
+
+                for (const SharedExp &loc : locs) {
+                    if (loc->isRegOfConst()) {
+                        aliases->addToMask(usedRegs, loc->access<Const, 1>()->getInt());
+                    }
+                }
+
+                if (!s->isAssignment()) {
+                    continue;
+                }
+
+                const SharedExp lhs = static_cast<Assignment *>(s)->getLeft();
+                if (lhs->isRegOfConst() && aliases->isAliased(lhs->access<Const, 1>()->getInt())) {
+                    defs.push_back(static_cast<Assignment *>(s));
+                }
+            }
+        }
+    }
+
+    for (Assignment *def : defs) {
+        const int defReg = def->getLeft()->access<Const, 1>()->getInt();
+        if (isOverlapExcludedReg(proc, aliases->getRootReg(defReg))) {
+            continue;
+        }
+
+        // Insert the updates of the registers containing defReg (largest first)
+        // before those of the registers contained in defReg. Each update is inserted
+        // directly after the definition, so they end up in the reverse order.
+        std::vector<int> useRegs = aliases->getOverlappingRegs(defReg, usedRegs);
+        const int defSize        = aliases->getSize(defReg);
+
+        std::stable_sort(useRegs.begin(), useRegs.end(), [aliases, defSize](int a, int b) {
+            const int sizeA = aliases->getSize(a);
+            const int sizeB = aliases->getSize(b);
+            return sizeA > defSize && (sizeB < defSize || sizeA > sizeB);
+        });
+
+        for (int useReg : useRegs) {
+            Assign *a = createOverlapAssign(*aliases, defReg, useReg);
+            if (a) {
+                proc->insertStatementAfter(def, a);
+            }
+        }
+    }
+}
+
+
+bool DefaultFrontEnd::isOverlapExcludedReg(UserProc *proc, int rootReg) const
+{
+    return proc->getSignature() && rootReg == proc->getSignature()->getStackRegister();
+}
+
+
 bool DefaultFrontEnd::refersToImportedFunction(const SharedExp &exp)
 {
     if (exp && (exp->getOper() == opMemOf) && (exp->access<Exp, 1>()->getOper() == opIntConst)) {
@@ -1021,8 +1218,8 @@ void DefaultFrontEnd::preprocessProcGoto(std::list<Statement *>::iterator ss, Ad
         // also need to change it in the actual RTL
         assert(std::next(ss) == sl.end());
         assert(!originalRTL->empty());
-        originalRTL->back() = call;
-        *ss                 = call;
+        originalRTL->replace(std::prev(originalRTL->end()), call);
+        *ss = call;
     }
 }
 
@@ -10,12 +10,16 @@
 #pragma once
 
 
+#include "boomerang/frontend/DecodeResult.h"
 #include "boomerang/frontend/SigEnum.h"
 #include "boomerang/frontend/TargetQueue.h"
 #include "boomerang/ifc/IFrontEnd.h"
+#include "boomerang/ssl/RegisterAliasModel.h"
 
 #include <map>
 #include <memory>
+#include <unordered_map>
+#include <unordered_set>
 
 
 class Function;
@@ -73,6 +77,16 @@ public:
     /// Decode a single instruction at address \p addr
     virtual bool decodeSingleInstruction(Address pc, DecodeResult &result);
 
+    /**
+     * \returns true if decoded instructions are kept for re-decoding (see Settings::decodeCache).
+     * Only decoders with a fixed instruction width are supported, since other decoders
+     * (e.g. x86) may keep state between instructions.
+     */
+    bool isDecodeCacheEnabled() const;
+
+    /// \returns true if the decode result of the instruction at \p pc is in the decode cache.
+    bool isInstructionCached(Address pc) const { return m_decodeCache.count(pc) > 0; }
+
     /// Do extra processing of call instructions.
     /// Does nothing by default.
     virtual void extraProcessCall(CallStatement *call, const RTLList &BB_rtls);
@@ -112,6 +126,21 @@ protected:
      */
     virtual bool isHelperFunc(Address dest, Address addr, RTLList &lrtl);
 
+    /**
+     * Process for overlapped registers: After each assignment to a register that overlaps other
+     * registers (e.g. %ax and %eax on x86), emit assignments to the overlapping registers,
+     * but only if they are used in \p proc. Basic blocks are only processed once,
+     * so this can be called each time after new code of \p proc was decoded.
+     */
+    void processOverlappedRegs(UserProc *proc);
+
+    /**
+     * \returns true if processOverlappedRegs() must not emit assignments for registers contained
+     * in the register \p rootReg of \p proc. By default, this excludes the stack pointer,
+     * since emitting updates for it would interfere with stack pointer tracking.
+     */
+    virtual bool isOverlapExcludedReg(UserProc *proc, int rootReg) const;
+
 private:
     /// \returns true iff \p exp is a memof that references the address of an imported function.
     bool refersToImportedFunction(const SharedExp &exp);
@@ -138,6 +167,9 @@ private:
     /// Returns nullptr on failure.
     UserProc *createFunctionForEntryPoint(Address entryAddr, const QString &functionType);
 
+    /// Decode the instruction at \p pc using the decoder, bypassing the decode cache.
+    bool decodeUncached(Address pc, DecodeResult &result);
+
 protected:
     std::unique_ptr<IDecoder> m_decoder;
     BinaryFile *m_binaryFile;
@@ -151,4 +183,15 @@ protected:
     /// Map from address to previously decoded RTLs for decoded indirect control transfer
     /// instructions
     std::map<Address, RTL *> m_previouslyDecoded;
+
+    /// Valid decode results of instructions reached by following control flow,
+    /// keyed by instruction address. Holds at most Settings::decodeCacheSize entries.
+    /// The cached RTLs are never handed out; callers always get a copy.
+    std::map<Address, DecodeResult> m_decodeCache;
+
+    /// Basic blocks that have already been processed by processOverlappedRegs()
+    std::unordered_set<const BasicBlock *> m_overlappedRegsProcessed;
+
+    /// Overlapped registers used by each procedure in the basic blocks processed so far
+    std::unordered_map<const UserProc *, RegisterAliasModel::RegMask> m_usedOverlappedRegs;
 };
@@ -32,9 +32,12 @@ NJMCDecoder::NJMCDecoder(Prog *prog, const QString &sslFilePath)
     : m_rtlDict(prog->getProject()->getSettings()->debugDecoder)
     , m_prog(prog)
 {
-    QDir dataDir = prog->getProject()->getSettings()->getDataDirectory();
+    const Settings *settings = prog->getProject()->getSettings();
+    const QDir dataDir       = settings->getDataDirectory();
+    const QString cacheDir   = settings->useSSLCache ? settings->getCacheDirectory().absolutePath()
+                                                     : QString();
 
-    if (!m_rtlDict.readSSLFile(dataDir.absoluteFilePath(sslFilePath))) {
+    if (!m_rtlDict.readSSLFile(dataDir.absoluteFilePath(sslFilePath), cacheDir)) {
         LOG_ERROR("Cannot read SSL file '%1'", sslFilePath);
         throw std::runtime_error("Failed to read SSL file");
     }
@@ -70,6 +70,12 @@ public:
     /// \copydoc IDecoder::getRegIdx
     int getRegIdx(const QString &name) const override;
 
+    /// \copydoc IDecoder::getRegisterAliases
+    const RegisterAliasModel *getRegisterAliases() const override
+    {
+        return &m_rtlDict.getRegisterAliases();
+    }
+
 protected:
     /**
      * Given an instruction name and a variable list of expressions
@@ -37,4 +37,7 @@ public:
 public:
     /// \copydoc NJMCDecoder::decodeInstruction
     virtual bool decodeInstruction(Address pc, ptrdiff_t delta, DecodeResult &result) override;
+
+    /// \copydoc IDecoder::getFixedInstructionSize
+    virtual int getFixedInstructionSize() const override { return 4; }
 };
@@ -72,11 +72,6 @@ private:
      */
     void processStringInst(UserProc *proc);
 
-    /**
-     * Process for overlapped registers
-     */
-    void processOverlapped(UserProc *proc);
-
     /**
      * Checks for Pentium specific helper functions like __xtol which have specific sematics.
      *
@@ -90,6 +85,10 @@ private:
      */
     bool isHelperFunc(Address dest, Address addr, RTLList &lrtl) override;
 
+    /// \copydoc DefaultFrontEnd::isOverlapExcludedReg
+    /// Also excludes %esp/%sp and %eflags/%flags.
+    bool isOverlapExcludedReg(UserProc *proc, int rootReg) const override;
+
     /**
      * Finds a subexpression within this expression of the form
      * \code
@@ -111,17 +110,11 @@ private:
      */
     void bumpRegisterAll(SharedExp exp, int min, int max, int delta, int mask);
 
-    bool isOverlappedRegsProcessed(const BasicBlock *bb) const
-    {
-        return m_overlappedRegsProcessed.find(bb) != m_overlappedRegsProcessed.end();
-    }
-
     bool isFloatProcessed(const BasicBlock *bb) const
     {
         return m_floatProcessed.find(bb) != m_floatProcessed.end();
     }
 
 private:
-    std::unordered_set<const BasicBlock *> m_overlappedRegsProcessed;
     std::unordered_set<const BasicBlock *> m_floatProcessed;
 };
@@ -146,7 +146,7 @@ BasicBlock *StringInstructionProcessor::splitForBranch(BasicBlock *bb, RTL *stri
 
     rptBBRTLs->front()->setAddress(stringAddr + 1);
     rptBBRTLs->front()->pop_front();
-    rptBBRTLs->front()->back() = rptBranch;
+    rptBBRTLs->front()->replace(std::prev(rptBBRTLs->front()->end()), rptBranch);
 
     // remove the original string instruction from the CFG.
     bb->removeAllPredecessors();
@@ -39,6 +39,9 @@ public:
     /// \copydoc NJMCDecoder::decodeInstruction
     virtual bool decodeInstruction(Address pc, ptrdiff_t delta, DecodeResult &result) override;
 
+    /// \copydoc IDecoder::getFixedInstructionSize
+    virtual int getFixedInstructionSize() const override { return 4; }
+
 private:
     Exp *dis_RegImm(Address pc);
 
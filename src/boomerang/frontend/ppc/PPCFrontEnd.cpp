@@ -62,5 +62,8 @@ bool PPCFrontEnd::processProc(UserProc *proc, Address entryAddr)
     // This will get done twice; no harm
     proc->setEntryBB();
 
+    // Process code for side effects of overlapped registers
+    processOverlappedRegs(proc);
+
     return true;
 }
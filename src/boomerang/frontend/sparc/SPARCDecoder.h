@@ -47,6 +47,9 @@ public:
     /// \copydoc NJMCDecoder::decodeInstruction
     virtual bool decodeInstruction(Address pc, ptrdiff_t delta, DecodeResult &result) override;
 
+    /// \copydoc IDecoder::getFixedInstructionSize
+    virtual int getFixedInstructionSize() const override { return 4; }
+
     /**
      * Check to see if the instruction at the given offset is a restore instruction.
      *
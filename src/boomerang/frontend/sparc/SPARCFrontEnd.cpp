@@ -1043,6 +1043,9 @@ bool SPARCFrontEnd::processProc(UserProc *proc, Address pc)
     // MVE: Not 100% sure this is the right place for this
     proc->setEntryBB();
 
+    // Process code for side effects of overlapped registers
+    processOverlappedRegs(proc);
+
     return true;
 }
 
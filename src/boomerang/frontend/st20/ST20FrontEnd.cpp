@@ -58,5 +58,8 @@ bool ST20FrontEnd::processProc(UserProc *proc, Address entryAddr)
     // This will get done twice; no harm
     proc->setEntryBB();
 
+    // Process code for side effects of overlapped registers
+    processOverlappedRegs(proc);
+
     return true;
 }
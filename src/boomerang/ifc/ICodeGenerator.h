@@ -45,7 +45,7 @@ public:
      * \param program The program to generate code for.
      * \param module The module to generate code for, or nullptr to generate code for all modules.
      * \param proc The function to generate code for, or nullptr to generate code for all procedures
-     *             in a module.
+     *             in a module. Prototypes are only generated when generating all procedures.
      * \param intermixRTL Set this to true to intermix code with underlying
      * intermediate representation. Currently not implemented.
      */
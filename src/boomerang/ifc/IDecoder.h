@@ -16,6 +16,7 @@
 class Exp;
 class RTL;
 class Prog;
+class RegisterAliasModel;
 
 
 /**
@@ -35,6 +36,12 @@ public:
      */
     virtual bool decodeInstruction(Address pc, ptrdiff_t delta, DecodeResult &result) = 0;
 
+    /**
+     * \returns the size of every instruction in bytes if the instruction set has
+     * a fixed instruction width, or 0 if instructions are of variable length.
+     */
+    virtual int getFixedInstructionSize() const { return 0; }
+
     /// \returns machine-specific register name given its index
     virtual QString getRegName(int regID) const = 0;
 
@@ -46,4 +53,8 @@ public:
 
     /// \returns the size of the register with name \p name, in bits
     int getRegSize(const QString &name) const { return getRegSize(getRegIdx(name)); }
+
+    /// \returns the model of overlapping registers of the machine,
+    /// or nullptr if no registers overlap.
+    virtual const RegisterAliasModel *getRegisterAliases() const { return nullptr; }
 };
@@ -10,6 +10,7 @@
 #include "PassManager.h"
 
 #include "boomerang/core/Project.h"
+#include "boomerang/core/Settings.h"
 #include "boomerang/db/Prog.h"
 #include "boomerang/db/proc/UserProc.h"
 #include "boomerang/passes/call/CallArgumentUpdatePass.h"
@@ -48,6 +49,32 @@ static PassManager g_passManager;
 
 
 PassManager::PassManager()
+{
+    registerPasses();
+}
+
+
+PassManager::~PassManager()
+{
+}
+
+
+PassManager *PassManager::get()
+{
+    return &g_passManager;
+}
+
+
+void PassManager::reset()
+{
+    m_passGroups.clear();
+    m_passes.clear();
+
+    registerPasses();
+}
+
+
+void PassManager::registerPasses()
 {
     m_passes.resize(static_cast<size_t>(PassID::NUM_PASSES));
 
@@ -86,17 +113,6 @@ PassManager::PassManager()
 }
 
 
-PassManager::~PassManager()
-{
-}
-
-
-PassManager *PassManager::get()
-{
-    return &g_passManager;
-}
-
-
 bool PassManager::createPassGroup(const QString &name, const std::initializer_list<IPass *> &passes)
 {
     auto it = m_passGroups.find(name);
@@ -125,9 +141,19 @@ bool PassManager::executePass(IPass *pass, UserProc *proc)
 
     const bool changed = pass->execute(proc);
 
-    QString msg = QString("after executing pass '%1'").arg(pass->getName());
-    proc->debugPrintAll(qPrintable(msg));
-    proc->getProg()->getProject()->alertDecompileDebugPoint(proc, qPrintable(msg));
+    if (changed) {
+        proc->getProg()->getProofCache().invalidate(proc);
+    }
+
+    // Only build the message if somebody is interested in it
+    Project *project = proc->getProg()->getProject();
+
+    if (project->getSettings()->verboseOutput ||
+        project->isWatched(WatchEvent::DecompileDebugPoint)) {
+        QString msg = QString("after executing pass '%1'").arg(pass->getName());
+        proc->debugPrintAll(qPrintable(msg));
+        project->alertDecompileDebugPoint(proc, qPrintable(msg));
+    }
 
     return changed;
 }
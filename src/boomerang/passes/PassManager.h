@@ -37,6 +37,10 @@ public:
     static PassManager *get();
 
 public:
+    /// Remove all pass groups and replace all passes by freshly constructed ones,
+    /// so no state of a previous decompilation is left over.
+    void reset();
+
     /// Creates a pass group with name \p name and elements \p passes
     /// \returns true iff creation was successful.
     bool createPassGroup(const QString &name, const std::initializer_list<IPass *> &passes);
@@ -54,6 +58,8 @@ public:
     bool executePassGroup(const QString &name, UserProc *proc);
 
 private:
+    /// Create and register all passes.
+    void registerPasses();
     void registerPass(PassID passType, std::unique_ptr<IPass> pass);
 
 private:
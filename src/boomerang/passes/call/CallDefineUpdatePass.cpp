@@ -29,12 +29,11 @@ CallDefineUpdatePass::CallDefineUpdatePass()
 
 bool CallDefineUpdatePass::execute(UserProc *proc)
 {
-    StatementList stmts;
-    proc->getStatements(stmts);
+    const auto stmts = proc->getStatementIndex();
 
     bool changed = false;
 
-    for (Statement *s : stmts) {
+    for (Statement *s : *stmts) {
         if (!s->isCall()) {
             continue;
         }
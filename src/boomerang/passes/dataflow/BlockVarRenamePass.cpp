@@ -41,8 +41,8 @@ static SharedExp defineAll = Terminal::get(opDefineAll); // An expression repres
 
 
 // Subscript dataflow variables
-bool BlockVarRenamePass::renameBlockVars(
-    UserProc *proc, int n, std::map<SharedExp, std::deque<Statement *>, lessExpStar> &stacks)
+bool BlockVarRenamePass::renameBlockVars(UserProc *proc, int n,
+                                         ExpHashMap<std::deque<Statement *>> &stacks)
 {
     if (proc->getCFG()->getNumBBs() == 0) {
         return false;
@@ -53,7 +53,7 @@ bool BlockVarRenamePass::renameBlockVars(
 
     // For each statement S in block n
     BasicBlock::RTLIterator rit;
-    StatementList::iterator sit;
+    StatementList::const_iterator sit;
     BasicBlock *bb = proc->getDataFlow()->nodeToBB(n);
 
     for (Statement *S = bb->getFirstStmt(rit, sit); S; S = bb->getNextStmt(rit, sit)) {
@@ -259,7 +259,7 @@ bool BlockVarRenamePass::renameBlockVars(
     // algorithm to process the statments in the BB *backwards*. (It is not important in Appel's
     // algorithm, since he always pushes a definition for every variable defined on the Stacks).
     BasicBlock::RTLRIterator rrit;
-    StatementList::reverse_iterator srit;
+    StatementList::const_reverse_iterator srit;
 
     for (Statement *S = bb->getLastStmt(rrit, srit); S; S = bb->getPrevStmt(rrit, srit)) {
         // For each definition of some variable a in S
@@ -298,6 +298,6 @@ bool BlockVarRenamePass::renameBlockVars(
 bool BlockVarRenamePass::execute(UserProc *proc)
 {
     /// The stack which remembers the last definition of an expression.
-    std::map<SharedExp, std::deque<Statement *>, lessExpStar> stacks;
+    ExpHashMap<std::deque<Statement *>> stacks;
     return renameBlockVars(proc, 0, stacks);
 }
@@ -33,6 +33,5 @@ public:
     bool execute(UserProc *proc) override;
 
 private:
-    bool renameBlockVars(UserProc *proc, int n,
-                         std::map<SharedExp, std::deque<Statement *>, lessExpStar> &stacks);
+    bool renameBlockVars(UserProc *proc, int n, ExpHashMap<std::deque<Statement *>> &stacks);
 };
@@ -24,13 +24,12 @@ GlobalConstReplacePass::GlobalConstReplacePass()
 
 bool GlobalConstReplacePass::execute(UserProc *proc)
 {
-    StatementList stmts;
-    proc->getStatements(stmts);
+    const auto stmts = proc->getStatementIndex();
 
     const BinaryImage *image = proc->getProg()->getBinaryFile()->getImage();
     bool changed             = false;
 
-    for (Statement *st : stmts) {
+    for (Statement *st : *stmts) {
         Assign *assgn = dynamic_cast<Assign *>(st);
 
         if (assgn == nullptr) {
@@ -23,7 +23,7 @@ StatementInitPass::StatementInitPass()
 bool StatementInitPass::execute(UserProc *proc)
 {
     BasicBlock::RTLIterator rit;
-    StatementList::iterator sit;
+    StatementList::const_iterator sit;
 
     for (BasicBlock *bb : *proc->getCFG()) {
         for (Statement *stmt = bb->getFirstStmt(rit, sit); stmt != nullptr;
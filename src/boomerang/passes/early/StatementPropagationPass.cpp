@@ -28,18 +28,17 @@ StatementPropagationPass::StatementPropagationPass()
 
 bool StatementPropagationPass::execute(UserProc *proc)
 {
-    StatementList stmts;
-    proc->getStatements(stmts);
+    const auto stmts = proc->getStatementIndex();
 
     // Find the locations that are used by a live, dominating phi-function
     LocationSet usedByDomPhi;
     findLiveAtDomPhi(proc, usedByDomPhi);
 
     // Next pass: count the number of times each assignment LHS would be propagated somewhere
-    std::map<SharedExp, int, lessExpStar> destCounts;
+    ExpDestCounter::ExpCountMap destCounts;
 
     // Also maintain a set of locations which are used by phi statements
-    for (Statement *s : stmts) {
+    for (Statement *s : *stmts) {
         ExpDestCounter edc(destCounts);
         StmtDestCounter sdc(&edc);
         s->accept(&sdc);
@@ -50,7 +49,7 @@ bool StatementPropagationPass::execute(UserProc *proc)
     bool change = false;
 
     Settings *settings = proc->getProg()->getProject()->getSettings();
-    for (Statement *s : stmts) {
+    for (Statement *s : *stmts) {
         if (!s->isPhi()) {
             change |= s->propagateFlagsTo(settings);
         }
@@ -59,7 +58,7 @@ bool StatementPropagationPass::execute(UserProc *proc)
     // Finally the actual propagation
     bool convert = false;
 
-    for (Statement *s : stmts) {
+    for (Statement *s : *stmts) {
         if (!s->isPhi()) {
             change |= s->propagateTo(convert, settings, &destCounts, &usedByDomPhi);
         }
@@ -75,7 +74,7 @@ bool StatementPropagationPass::execute(UserProc *proc)
 void StatementPropagationPass::findLiveAtDomPhi(UserProc *proc, LocationSet &usedByDomPhi)
 {
     LocationSet usedByDomPhi0;
-    std::map<SharedExp, PhiAssign *, lessExpStar> defdByPhi;
+    ExpHashMap<PhiAssign *> defdByPhi;
 
     proc->getDataFlow()->findLiveAtDomPhi(usedByDomPhi, usedByDomPhi0, defdByPhi);
 
@@ -24,7 +24,7 @@ CallLivenessRemovalPass::CallLivenessRemovalPass()
 bool CallLivenessRemovalPass::execute(UserProc *proc)
 {
     BasicBlock::RTLRIterator rrit;
-    StatementList::reverse_iterator srit;
+    StatementList::const_reverse_iterator srit;
 
     for (BasicBlock *bb : *proc->getCFG()) {
         CallStatement *c = dynamic_cast<CallStatement *>(bb->getLastStmt(rrit, srit));
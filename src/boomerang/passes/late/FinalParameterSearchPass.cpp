@@ -66,10 +66,9 @@ bool FinalParameterSearchPass::execute(UserProc *proc)
 
     //    int sp = signature->getStackRegister();
     proc->getSignature()->setNumParams(0); // Clear any old ideas
-    StatementList stmts;
-    proc->getStatements(stmts);
+    const auto stmts = proc->getStatementIndex();
 
-    for (Statement *s : stmts) {
+    for (Statement *s : *stmts) {
         // Assume that all parameters will be m[]{0} or r[]{0}, and in the implicit definitions at
         // the start of the program
         if (!s->isImplicit()) {
@@ -23,12 +23,11 @@ ImplicitPlacementPass::ImplicitPlacementPass()
 
 bool ImplicitPlacementPass::execute(UserProc *proc)
 {
-    StatementList stmts;
-    proc->getStatements(stmts);
+    const auto stmts = proc->getStatementIndex();
     ImplicitConverter ic(proc->getCFG());
     StmtImplicitConverter sm(&ic, proc->getCFG());
 
-    for (Statement *stmt : stmts) {
+    for (Statement *stmt : *stmts) {
         stmt->accept(&sm);
     }
 
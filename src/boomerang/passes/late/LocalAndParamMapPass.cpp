@@ -28,10 +28,9 @@ bool LocalAndParamMapPass::execute(UserProc *proc)
 
     LOG_VERBOSE("### Mapping expressions to local variables for %1 ###", proc->getName());
 
-    StatementList stmts;
-    proc->getStatements(stmts);
+    const auto stmts = proc->getStatementIndex();
 
-    for (Statement *s : stmts) {
+    for (Statement *s : *stmts) {
         s->dfaMapLocals();
     }
 
@@ -102,10 +102,9 @@ bool UnusedParamRemovalPass::checkForGainfulUse(UserProc *proc, SharedExp bparam
 {
     visited.insert(proc); // Prevent infinite recursion
 
-    StatementList stmts;
-    proc->getStatements(stmts);
+    const auto stmts = proc->getStatementIndex();
 
-    for (Statement *s : stmts) {
+    for (Statement *s : *stmts) {
         // Special checking for recursive calls
         if (s->isCall()) {
             CallStatement *c = static_cast<CallStatement *>(s);
@@ -60,6 +60,8 @@ bool PreservationAnalysisPass::execute(UserProc *proc)
         LOG_MSG("### End proven true for procedure %1", proc->getName());
     }
 
+    const std::size_t numModifieds = proc->getRetStmt()->getModifieds().size();
+
     // Remove the preserved locations from the modifieds and the returns
     for (auto pp = proc->getProvenTrue().begin(); pp != proc->getProvenTrue().end(); ++pp) {
         SharedExp lhs = pp->first;
@@ -74,5 +76,5 @@ bool PreservationAnalysisPass::execute(UserProc *proc)
         proc->getRetStmt()->removeModified(lhs);
     }
 
-    return true;
+    return proc->getRetStmt()->getModifieds().size() != numModifieds;
 }
@@ -9,6 +9,7 @@
 #pragma endregion License
 #include "RTL.h"
 
+#include "boomerang/db/BasicBlock.h"
 #include "boomerang/ssl/exp/Const.h"
 #include "boomerang/ssl/exp/Operator.h"
 #include "boomerang/ssl/statements/Assign.h"
@@ -48,8 +49,16 @@ RTL::RTL(const RTL &other)
 }
 
 
+RTL::RTL(RTL &&other)
+    : m_stmts(std::move(other.m_stmts))
+    , m_nativeAddr(other.m_nativeAddr)
+{
+}
+
+
 RTL::~RTL()
 {
+    // Removing the RTL from its BB already changes the layout of the CFG.
     qDeleteAll(m_stmts);
 }
 
@@ -67,6 +76,25 @@ RTL &RTL::operator=(const RTL &other)
     clear();
 
     other.deepCopyList(m_stmts);
+    layoutChanged();
+    return *this;
+}
+
+
+RTL &RTL::operator=(RTL &&other)
+{
+    if (this == &other) {
+        return *this;
+    }
+
+    qDeleteAll(m_stmts);
+
+    // this RTL stays part of its own BB
+    m_stmts      = std::move(other.m_stmts);
+    m_nativeAddr = other.m_nativeAddr;
+    other.m_stmts.clear();
+
+    layoutChanged();
     return *this;
 }
 
@@ -89,6 +117,7 @@ void RTL::append(Statement *s)
     }
 
     m_stmts.push_back(s);
+    layoutChanged();
 }
 
 
@@ -97,6 +126,8 @@ void RTL::append(const std::list<Statement *> &stmts)
     for (Statement *stmt : stmts) {
         m_stmts.push_back(stmt->clone());
     }
+
+    layoutChanged();
 }
 
 
@@ -142,7 +173,7 @@ QString RTL::prints() const
 
 void RTL::simplify()
 {
-    for (iterator it = begin(); it != end();) {
+    for (StmtList::iterator it = m_stmts.begin(); it != m_stmts.end();) {
         Statement *s = *it;
         s->simplify();
 
@@ -152,7 +183,8 @@ void RTL::simplify()
             if (cond && (cond->getOper() == opIntConst)) {
                 if (cond->access<Const>()->getInt() == 0) {
                     LOG_VERBOSE("Removing branch with false condition at %1 %2", getAddress(), *it);
-                    it = this->erase(it);
+                    it = m_stmts.erase(it);
+                    layoutChanged();
                     continue;
                 }
 
@@ -161,6 +193,7 @@ void RTL::simplify()
                 BasicBlock *bb = (*it)->getBB();
                 *it = new GotoStatement(static_cast<BranchStatement *>(s)->getFixedDest());
                 (*it)->setBB(bb);
+                layoutChanged();
             }
         }
         else if (s->isAssign()) {
@@ -170,7 +203,8 @@ void RTL::simplify()
                           (guard->isIntConst() && (guard->access<Const>()->getInt() == 0)))) {
                 // This assignment statement can be deleted
                 LOG_VERBOSE("Removing assignment with false guard at %1 %2", getAddress(), *it);
-                it = erase(it);
+                it = m_stmts.erase(it);
+                layoutChanged();
                 continue;
             }
         }
@@ -203,7 +237,24 @@ Statement *RTL::getHlStmt() const
 }
 
 
-void RTL::insert(RTL::iterator where, const RTL::value_type &val)
+void RTL::insert(RTL::const_iterator where, const RTL::value_type &val)
 {
     m_stmts.insert(where, val);
+    layoutChanged();
+}
+
+
+void RTL::replace(RTL::const_iterator it, Statement *stmt)
+{
+    assert(it != m_stmts.end());
+    *m_stmts.erase(it, it) = stmt;
+    layoutChanged();
+}
+
+
+void RTL::layoutChanged()
+{
+    if (m_bb) {
+        m_bb->layoutChanged();
+    }
 }
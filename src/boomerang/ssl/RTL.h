@@ -16,6 +16,7 @@
 #include <memory>
 
 
+class BasicBlock;
 class Statement;
 class OStream;
 
@@ -33,12 +34,11 @@ class BOOMERANG_API RTL
 public:
     typedef StmtList::size_type size_type;
     typedef StmtList::value_type value_type;
-    typedef StmtList::reference reference;
     typedef StmtList::const_reference const_reference;
 
-    typedef StmtList::iterator iterator;
+    // Statements can only be added, removed or replaced via the member functions below,
+    // which keep the layout version of the CFG up to date (\sa ProcCFG::getLayoutVersion).
     typedef StmtList::const_iterator const_iterator;
-    typedef StmtList::reverse_iterator reverse_iterator;
     typedef StmtList::const_reverse_iterator const_reverse_iterator;
 
 public:
@@ -49,14 +49,16 @@ public:
     /// Take ownership of the statements in the initializer list.
     explicit RTL(Address instrAddr, const std::initializer_list<Statement *> &statements);
 
-    explicit RTL(const RTL &other); ///< Deep copies the content
-    explicit RTL(RTL &&other) = default;
+    explicit RTL(const RTL &other); ///< Deep copies the content; the copy is not part of any BB
+    explicit RTL(RTL &&other);      ///< The new RTL is not part of any BB
 
     ~RTL();
 
     /// Makes this RTL a deep copy of \p other.
     RTL &operator=(const RTL &other);
-    RTL &operator=(RTL &&other) = default;
+
+    /// Takes the statements of \p other. This RTL stays part of its BB.
+    RTL &operator=(RTL &&other);
 
 public:
     /// Return RTL's native address
@@ -100,40 +102,71 @@ public:
 
     const std::list<Statement *> &getStatements() const { return m_stmts; }
 
+    /// \returns the BB this RTL is part of, or nullptr if it is not part of a BB.
+    BasicBlock *getBB() const { return m_bb; }
+
+    /// Set the BB this RTL is part of. Changes to the statements of this RTL
+    /// are reported to the CFG of \p bb (\sa ProcCFG::layoutChanged).
+    void setBB(BasicBlock *bb) { m_bb = bb; }
+
+    /// Replace the statement at \p it by \p stmt. Does not delete the old statement.
+    void replace(const_iterator it, Statement *stmt);
+
     // delegates to std::list
 public:
     bool empty() const { return m_stmts.empty(); }
 
     size_type size() const { return m_stmts.size(); }
 
-    reference front() { return m_stmts.front(); }
-    reference back() { return m_stmts.back(); }
     const_reference front() const { return m_stmts.front(); }
     const_reference back() const { return m_stmts.back(); }
 
-    iterator begin() { return m_stmts.begin(); }
-    iterator end() { return m_stmts.end(); }
     const_iterator begin() const { return m_stmts.begin(); }
     const_iterator end() const { return m_stmts.end(); }
 
-    reverse_iterator rbegin() { return m_stmts.rbegin(); }
-    reverse_iterator rend() { return m_stmts.rend(); }
     const_reverse_iterator rbegin() const { return m_stmts.rbegin(); }
     const_reverse_iterator rend() const { return m_stmts.rend(); }
 
-    void pop_front() { m_stmts.pop_front(); }
-    void pop_back() { m_stmts.pop_back(); }
+    void pop_front()
+    {
+        m_stmts.pop_front();
+        layoutChanged();
+    }
+
+    void pop_back()
+    {
+        m_stmts.pop_back();
+        layoutChanged();
+    }
+
+    void push_front(const value_type &val)
+    {
+        m_stmts.push_front(val);
+        layoutChanged();
+    }
+
+    void insert(const_iterator where, const value_type &val);
+
+    void clear()
+    {
+        m_stmts.clear();
+        layoutChanged();
+    }
+
+    const_iterator erase(const_iterator it)
+    {
+        layoutChanged();
+        return m_stmts.erase(it);
+    }
 
-    void push_front(const value_type &val) { m_stmts.push_front(val); }
-
-    void insert(iterator where, const value_type &val);
-    void clear() { m_stmts.clear(); }
-
-    iterator erase(iterator it) { return m_stmts.erase(it); }
+private:
+    /// Tell the CFG of the BB this RTL is part of that its statements changed.
+    void layoutChanged();
 
 private:
     std::list<Statement *> m_stmts;
-    Address m_nativeAddr; ///< RTL's source program instruction address
+    Address m_nativeAddr;       ///< RTL's source program instruction address
+    BasicBlock *m_bb = nullptr; ///< BB this RTL is part of, if any
 };
 
 using SharedRTL = std::shared_ptr<RTL>;
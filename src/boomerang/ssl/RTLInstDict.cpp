@@ -10,6 +10,7 @@
 #include "RTLInstDict.h"
 
 #include "boomerang/ssl/RTL.h"
+#include "boomerang/ssl/RTLInstDictCache.h"
 #include "boomerang/ssl/exp/Binary.h"
 #include "boomerang/ssl/exp/Const.h"
 #include "boomerang/ssl/exp/Location.h"
@@ -45,28 +46,40 @@ int RTLInstDict::insert(const QString &name, std::list<QString> &params, const R
 }
 
 
-bool RTLInstDict::readSSLFile(const QString &sslFileName)
+bool RTLInstDict::readSSLFile(const QString &sslFileName, const QString &cacheDir)
 {
     LOG_MSG("Loading machine specifications from '%1'...", sslFileName);
-    // emptying the rtl dictionary
-    m_instructions.clear();
 
     // Clear all state
     reset();
 
-    // Attempt to parse the SSL file
-    SSLParser theParser(qPrintable(sslFileName),
-#ifdef DEBUG_SSLPARSER
-                        true
-#else
-                        false
-#endif
-    );
+    QString cacheFile;
+    QByteArray sslHash;
+
+    if (!cacheDir.isEmpty()) {
+        sslHash = RTLInstDictCache::hashSSLFile(sslFileName);
+
+        if (!sslHash.isEmpty()) {
+            cacheFile = RTLInstDictCache::getCacheFilePath(cacheDir, sslFileName, sslHash);
+        }
+    }
+
+    if (!cacheFile.isEmpty() && RTLInstDictCache::load(*this, cacheFile, sslHash)) {
+        LOG_VERBOSE("Loaded machine specifications from cache file '%1'", cacheFile);
+    }
+    else {
+        reset();
 
-    if (!theParser.theScanner || theParser.yyparse(*this) != 0) {
-        return false;
+        if (!parseSSLFile(sslFileName)) {
+            return false;
+        }
+        else if (!cacheFile.isEmpty() && !RTLInstDictCache::save(*this, cacheFile, sslHash)) {
+            LOG_WARN("Could not write SSL cache file '%1'", cacheFile);
+        }
     }
 
+    m_regAliases.compile(m_regInfo);
+
     if (m_verboseOutput) {
         OStream q_cout(stdout);
         q_cout << "\n=======Expanded RTL template dictionary=======\n";
@@ -78,6 +91,20 @@ bool RTLInstDict::readSSLFile(const QString &sslFileName)
 }
 
 
+bool RTLInstDict::parseSSLFile(const QString &sslFileName)
+{
+    SSLParser theParser(qPrintable(sslFileName),
+#ifdef DEBUG_SSLPARSER
+                        true
+#else
+                        false
+#endif
+    );
+
+    return theParser.theScanner && theParser.yyparse(*this) == 0;
+}
+
+
 void RTLInstDict::addRegister(const QString &name, int id, int size, bool flt)
 {
     m_regIDs[name] = id;
@@ -235,6 +262,7 @@ void RTLInstDict::reset()
     m_regIDs.clear();
     m_regInfo.clear();
     m_specialRegInfo.clear();
+    m_regAliases.clear();
     m_definedParams.clear();
     m_flagFuncs.clear();
     m_instructions.clear();
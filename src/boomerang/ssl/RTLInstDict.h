@@ -11,6 +11,7 @@
 
 
 #include "boomerang/ssl/Register.h"
+#include "boomerang/ssl/RegisterAliasModel.h"
 #include "boomerang/ssl/TableEntry.h"
 #include "boomerang/util/ByteUtil.h"
 
@@ -38,6 +39,7 @@ using SharedExp = std::shared_ptr<Exp>;
 class BOOMERANG_API RTLInstDict
 {
     friend class SSLParser;
+    friend class RTLInstDictCache;
 
 public:
     RTLInstDict(bool verboseOutput = false);
@@ -55,9 +57,12 @@ public:
      * (this object). This also reads and sets up the register map and flag functions.
      *
      * \param sslFileName the name of the file containing the SSL specification.
+     * \param cacheDir    If not empty, the expanded dictionary is read from a cache file
+     *                    in this directory instead of parsing the SSL file, if possible.
+     *                    Otherwise, the cache file is created after parsing the SSL file.
      * \returns           true if the file was read successfully.
      */
-    bool readSSLFile(const QString &sslFileName);
+    bool readSSLFile(const QString &sslFileName, const QString &cacheDir = QString());
 
     /// \returns the name and the number of operands of the instruction
     std::pair<QString, DWord> getSignature(const QString &name, bool *found = nullptr) const;
@@ -89,10 +94,16 @@ public:
     /// Returns 32 (the default register size) if the register was not found.
     int getRegSizeByID(int regID) const;
 
+    /// \returns the overlapping registers (SHARES declarations) of the SSL file.
+    const RegisterAliasModel &getRegisterAliases() const { return m_regAliases; }
+
 private:
     /// Reset the object to "undo" a readSSLFile()
     void reset();
 
+    /// Parse the SSL file \p sslFileName without using a cache file.
+    bool parseSSLFile(const QString &sslFileName);
+
     /**
      * Returns an instance of a register transfer list for the parameterized rtlist with the given
      * formals replaced with the actuals given as the third parameter.
@@ -149,6 +160,9 @@ private:
     /// to a Register object
     std::map<QString, Register> m_specialRegInfo;
 
+    /// Overlapping registers, compiled from m_regInfo after reading the SSL file.
+    RegisterAliasModel m_regAliases;
+
     /// FIXME this set contains all parameters of every flag function ever defined,
     /// not only those from the current flag function
     std::set<QString> m_definedParams;
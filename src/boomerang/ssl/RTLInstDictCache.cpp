@@ -0,0 +1,543 @@
+#pragma region License
+/*
+ * This file is part of the Boomerang Decompiler.
+ *
+ * See the file "LICENSE.TERMS" for information on usage and
+ * redistribution of this file, and for a DISCLAIMER OF ALL
+ * WARRANTIES.
+ */
+#pragma endregion License
+#include "RTLInstDictCache.h"
+
+#include "boomerang/ssl/RTLInstDict.h"
+#include "boomerang/ssl/exp/Binary.h"
+#include "boomerang/ssl/exp/Const.h"
+#include "boomerang/ssl/exp/Location.h"
+#include "boomerang/ssl/exp/Terminal.h"
+#include "boomerang/ssl/exp/Ternary.h"
+#include "boomerang/ssl/exp/TypedExp.h"
+#include "boomerang/ssl/statements/Assign.h"
+#include "boomerang/ssl/type/BooleanType.h"
+#include "boomerang/ssl/type/CharType.h"
+#include "boomerang/ssl/type/FloatType.h"
+#include "boomerang/ssl/type/IntegerType.h"
+#include "boomerang/ssl/type/SizeType.h"
+#include "boomerang/ssl/type/VoidType.h"
+#include "boomerang/visitor/expvisitor/RawExpVisitor.h"
+
+#include <QCryptographicHash>
+#include <QDataStream>
+#include <QDir>
+#include <QFile>
+#include <QFileInfo>
+#include <QSaveFile>
+
+
+/// Magic number at the start of every cache file ("BSSL")
+static const quint32 CACHE_MAGIC = 0x4253534C;
+
+
+/// Identifies the class of a serialized expression
+enum class ExpTag : quint8
+{
+    Null = 0,
+    Const,
+    Terminal,
+    Unary,
+    Binary,
+    Ternary,
+    TypedExp,
+    Location
+};
+
+
+static bool writeType(QDataStream &os, const SharedConstType &ty)
+{
+    if (!ty) {
+        os << quint8(0);
+        return true;
+    }
+
+    os << quint8(static_cast<int>(ty->getId()) + 1);
+
+    switch (ty->getId()) {
+    case TypeClass::Void:
+    case TypeClass::Boolean:
+    case TypeClass::Char: return true;
+
+    case TypeClass::Integer:
+        os << quint32(ty->getSize())
+           << qint8(static_cast<const IntegerType &>(*ty).getSign());
+        return true;
+
+    case TypeClass::Float:
+    case TypeClass::Size: os << quint32(ty->getSize()); return true;
+
+    default: return false; // not used by SSL files
+    }
+}
+
+
+static SharedType readType(QDataStream &is, bool &ok)
+{
+    quint8 tag = 0;
+    is >> tag;
+
+    if (tag == 0) {
+        return nullptr;
+    }
+
+    quint32 size = 0;
+
+    switch (static_cast<TypeClass>(tag - 1)) {
+    case TypeClass::Void: return VoidType::get();
+    case TypeClass::Boolean: return BooleanType::get();
+    case TypeClass::Char: return CharType::get();
+
+    case TypeClass::Integer: {
+        qint8 sign = 0;
+        is >> size >> sign;
+        return IntegerType::get(size, static_cast<Sign>(sign));
+    }
+
+    case TypeClass::Float: is >> size; return FloatType::get(size);
+    case TypeClass::Size: is >> size; return SizeType::get(size);
+    default: break;
+    }
+
+    ok = false;
+    return nullptr;
+}
+
+
+/// Writes an expression in pre-order.
+class ExpCacheWriter : public RawExpVisitor
+{
+public:
+    ExpCacheWriter(QDataStream &os)
+        : m_os(os)
+    {
+    }
+
+public:
+    bool preVisit(const Unary &exp, bool &visitChildren) override
+    {
+        m_os << quint8(ExpTag::Unary) << qint32(exp.getOper());
+        visitChildren = true;
+        return true;
+    }
+
+    bool preVisit(const Binary &exp, bool &visitChildren) override
+    {
+        m_os << quint8(ExpTag::Binary) << qint32(exp.getOper());
+        visitChildren = true;
+        return true;
+    }
+
+    bool preVisit(const Ternary &exp, bool &visitChildren) override
+    {
+        m_os << quint8(ExpTag::Ternary) << qint32(exp.getOper());
+        visitChildren = true;
+        return true;
+    }
+
+    bool preVisit(const TypedExp &exp, bool &visitChildren) override
+    {
+        m_os << quint8(ExpTag::TypedExp) << qint32(exp.getOper());
+        visitChildren = true;
+        return writeType(m_os, exp.getType());
+    }
+
+    bool preVisit(const FlagDef &, bool &) override
+    {
+        return false; // not used by SSL files
+    }
+
+    bool preVisit(const RefExp &, bool &) override
+    {
+        return false; // SSL files do not contain SSA form
+    }
+
+    bool preVisit(const Location &exp, bool &visitChildren) override
+    {
+        m_os << quint8(ExpTag::Location) << qint32(exp.getOper());
+        visitChildren = true;
+        return exp.getProc() == nullptr;
+    }
+
+    bool visit(const Const &exp) override
+    {
+        m_os << quint8(ExpTag::Const) << qint32(exp.getOper());
+
+        switch (exp.getOper()) {
+        case opIntConst: // may hold a 64 bit address
+        case opLongConst: m_os << quint64(exp.getLong()); break;
+        case opFltConst: m_os << exp.getFlt(); break;
+        case opStrConst: m_os << exp.getStr(); break;
+        default: return false; // function pointers cannot be stored
+        }
+
+        return writeType(m_os, exp.getType());
+    }
+
+    bool visit(const Terminal &exp) override
+    {
+        m_os << quint8(ExpTag::Terminal) << qint32(exp.getOper());
+        return true;
+    }
+
+private:
+    QDataStream &m_os;
+};
+
+
+static bool writeExp(QDataStream &os, const SharedConstExp &exp)
+{
+    if (!exp) {
+        os << quint8(ExpTag::Null);
+        return true;
+    }
+
+    ExpCacheWriter writer(os);
+    return exp->acceptVisitor(&writer);
+}
+
+
+static SharedExp readExp(QDataStream &is, bool &ok)
+{
+    quint8 tag  = 0;
+    qint32 oper = 0;
+    is >> tag;
+
+    if (tag == quint8(ExpTag::Null) || is.status() != QDataStream::Ok) {
+        return nullptr;
+    }
+
+    is >> oper;
+    if (oper < 0 || oper >= opNumOf) {
+        ok = false;
+        return nullptr;
+    }
+
+    const OPER op = static_cast<OPER>(oper);
+
+    switch (static_cast<ExpTag>(tag)) {
+    case ExpTag::Terminal: return Terminal::get(op);
+
+    case ExpTag::Const: {
+        std::shared_ptr<Const> c;
+
+        switch (op) {
+        case opIntConst: {
+            quint64 value;
+            is >> value;
+            c = Const::get(0);
+            c->setLong(QWord(value));
+            break;
+        }
+        case opLongConst: {
+            quint64 value;
+            is >> value;
+            c = Const::get(QWord(value));
+            break;
+        }
+        case opFltConst: {
+            double value;
+            is >> value;
+            c = Const::get(value);
+            break;
+        }
+        case opStrConst: {
+            QString value;
+            is >> value;
+            c = Const::get(value);
+            break;
+        }
+        default: ok = false; return nullptr;
+        }
+
+        c->setType(readType(is, ok));
+        return c;
+    }
+
+    case ExpTag::Unary: {
+        SharedExp subExp1 = readExp(is, ok);
+        return ok ? Unary::get(op, subExp1) : nullptr;
+    }
+
+    case ExpTag::Binary: {
+        SharedExp subExp1 = readExp(is, ok);
+        SharedExp subExp2 = readExp(is, ok);
+        return ok ? Binary::get(op, subExp1, subExp2) : nullptr;
+    }
+
+    case ExpTag::Ternary: {
+        SharedExp subExp1 = readExp(is, ok);
+        SharedExp subExp2 = readExp(is, ok);
+        SharedExp subExp3 = readExp(is, ok);
+        return ok ? Ternary::get(op, subExp1, subExp2, subExp3) : nullptr;
+    }
+
+    case ExpTag::TypedExp: {
+        SharedType ty     = readType(is, ok);
+        SharedExp subExp1 = readExp(is, ok);
+        return ok ? std::make_shared<TypedExp>(ty, subExp1) : nullptr;
+    }
+
+    case ExpTag::Location: {
+        SharedExp subExp1 = readExp(is, ok);
+        return ok ? Location::get(op, subExp1, nullptr) : nullptr;
+    }
+
+    default: break;
+    }
+
+    ok = false;
+    return nullptr;
+}
+
+
+static QDataStream &operator<<(QDataStream &os, const Register &reg)
+{
+    return os << reg.getName() << quint16(reg.getSize()) << reg.isFloat()
+              << qint32(reg.getMappedIndex()) << qint32(reg.getMappedOffset());
+}
+
+
+static QDataStream &operator>>(QDataStream &is, Register &reg)
+{
+    QString name;
+    quint16 size = 0;
+    bool isFloat = false;
+    qint32 mappedIndex = -1, mappedOffset = -1;
+
+    is >> name >> size >> isFloat >> mappedIndex >> mappedOffset;
+
+    reg = Register(name, size, isFloat);
+    reg.setMappedIndex(mappedIndex);
+    reg.setMappedOffset(mappedOffset);
+    return is;
+}
+
+
+static bool writeRTL(QDataStream &os, const RTL &rtl)
+{
+    os << quint64(rtl.getAddress().value()) << quint32(rtl.size());
+
+    for (const Statement *stmt : rtl) {
+        if (!stmt->isAssign()) {
+            return false; // SSL files only contain assignments
+        }
+
+        const Assign *asgn = static_cast<const Assign *>(stmt);
+        if (!writeType(os, asgn->getType()) || !writeExp(os, asgn->getLeft()) ||
+            !writeExp(os, asgn->getRight()) || !writeExp(os, asgn->getGuard())) {
+            return false;
+        }
+    }
+
+    return true;
+}
+
+
+static bool readRTL(QDataStream &is, RTL &rtl)
+{
+    quint64 addr     = 0;
+    quint32 numStmts = 0;
+    is >> addr >> numStmts;
+
+    rtl.setAddress(Address(addr));
+
+    bool ok = true;
+    for (quint32 i = 0; ok && i < numStmts && is.status() == QDataStream::Ok; i++) {
+        SharedType ty   = readType(is, ok);
+        SharedExp lhs   = readExp(is, ok);
+        SharedExp rhs   = readExp(is, ok);
+        SharedExp guard = readExp(is, ok);
+
+        if (ok) {
+            rtl.append(new Assign(ty, lhs, rhs, guard));
+        }
+    }
+
+    return ok && is.status() == QDataStream::Ok;
+}
+
+
+QByteArray RTLInstDictCache::hashSSLFile(const QString &sslFileName)
+{
+    QFile file(sslFileName);
+    if (!file.open(QFile::ReadOnly)) {
+        return QByteArray();
+    }
+
+    QCryptographicHash hash(QCryptographicHash::Sha1);
+    if (!hash.addData(&file)) {
+        return QByteArray();
+    }
+
+    // The expanded dictionary depends on the SSL parser and on the IR of this build.
+    hash.addData(BOOMERANG_VERSION);
+
+    return hash.result();
+}
+
+
+QString RTLInstDictCache::getCacheFilePath(const QString &cacheDir, const QString &sslFileName,
+                                           const QByteArray &sslHash)
+{
+    const QString fileName = QString("%1-%2.sslcache")
+                                 .arg(QFileInfo(sslFileName).completeBaseName())
+                                 .arg(QString::fromLatin1(sslHash.toHex()));
+
+    return QDir(cacheDir).absoluteFilePath(fileName);
+}
+
+
+bool RTLInstDictCache::load(RTLInstDict &dict, const QString &cacheFile,
+                            const QByteArray &sslHash)
+{
+    QFile file(cacheFile);
+    if (!file.open(QFile::ReadOnly)) {
+        return false;
+    }
+
+    // Prefer mapping the file into memory; fall back to reading it
+    QByteArray contents;
+    const uchar *mapped = file.map(0, file.size());
+
+    if (mapped) {
+        contents = QByteArray::fromRawData(reinterpret_cast<const char *>(mapped),
+                                           static_cast<int>(file.size()));
+    }
+    else {
+        contents = file.readAll();
+    }
+
+    QDataStream is(contents);
+    is.setVersion(QDataStream::Qt_5_0);
+
+    quint32 magic = 0, version = 0, numOpers = 0;
+    QByteArray hash;
+    is >> magic >> version >> numOpers >> hash;
+
+    if (magic != CACHE_MAGIC || version != FORMAT_VERSION || numOpers != quint32(opNumOf) ||
+        hash != sslHash) {
+        return false;
+    }
+
+    qint32 endianness = 0;
+    quint32 count     = 0;
+    is >> endianness;
+    dict.m_endianness = static_cast<Endian>(endianness);
+
+    is >> count;
+    for (quint32 i = 0; i < count && is.status() == QDataStream::Ok; i++) {
+        QString name;
+        qint32 id = 0;
+        is >> name >> id;
+        dict.m_regIDs[name] = id;
+    }
+
+    is >> count;
+    for (quint32 i = 0; i < count && is.status() == QDataStream::Ok; i++) {
+        qint32 id = 0;
+        Register reg;
+        is >> id >> reg;
+        dict.m_regInfo.insert({ id, reg });
+    }
+
+    is >> count;
+    for (quint32 i = 0; i < count && is.status() == QDataStream::Ok; i++) {
+        QString name;
+        Register reg;
+        is >> name >> reg;
+        dict.m_specialRegInfo.insert({ name, reg });
+    }
+
+    for (std::set<QString> *names : { &dict.m_definedParams, &dict.m_flagFuncs }) {
+        is >> count;
+        for (quint32 i = 0; i < count && is.status() == QDataStream::Ok; i++) {
+            QString name;
+            is >> name;
+            names->insert(name);
+        }
+    }
+
+    is >> count;
+    for (quint32 i = 0; i < count && is.status() == QDataStream::Ok; i++) {
+        QString name;
+        quint32 numParams = 0;
+        is >> name >> numParams;
+
+        TableEntry &entry = dict.m_instructions[name];
+        for (quint32 j = 0; j < numParams && is.status() == QDataStream::Ok; j++) {
+            QString param;
+            is >> param;
+            entry.m_params.push_back(param);
+        }
+
+        if (!readRTL(is, entry.m_rtl)) {
+            return false;
+        }
+    }
+
+    return is.status() == QDataStream::Ok && is.atEnd();
+}
+
+
+bool RTLInstDictCache::save(const RTLInstDict &dict, const QString &cacheFile,
+                            const QByteArray &sslHash)
+{
+    QByteArray contents;
+    QDataStream os(&contents, QIODevice::WriteOnly);
+    os.setVersion(QDataStream::Qt_5_0);
+
+    os << CACHE_MAGIC << FORMAT_VERSION << quint32(opNumOf) << sslHash;
+    os << qint32(dict.m_endianness);
+
+    os << quint32(dict.m_regIDs.size());
+    for (const auto &[name, id] : dict.m_regIDs) {
+        os << name << qint32(id);
+    }
+
+    os << quint32(dict.m_regInfo.size());
+    for (const auto &[id, reg] : dict.m_regInfo) {
+        os << qint32(id) << reg;
+    }
+
+    os << quint32(dict.m_specialRegInfo.size());
+    for (const auto &[name, reg] : dict.m_specialRegInfo) {
+        os << name << reg;
+    }
+
+    for (const std::set<QString> *names : { &dict.m_definedParams, &dict.m_flagFuncs }) {
+        os << quint32(names->size());
+        for (const QString &name : *names) {
+            os << name;
+        }
+    }
+
+    os << quint32(dict.m_instructions.size());
+    for (const auto &[name, entry] : dict.m_instructions) {
+        os << name << quint32(entry.m_params.size());
+        for (const QString &param : entry.m_params) {
+            os << param;
+        }
+
+        if (!writeRTL(os, entry.m_rtl)) {
+            return false;
+        }
+    }
+
+    if (!QDir().mkpath(QFileInfo(cacheFile).absolutePath())) {
+        return false;
+    }
+
+    QSaveFile file(cacheFile);
+    if (!file.open(QFile::WriteOnly) || file.write(contents) != contents.size()) {
+        return false;
+    }
+
+    return file.commit();
+}
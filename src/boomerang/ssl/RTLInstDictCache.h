@@ -0,0 +1,63 @@
+#pragma region License
+/*
+ * This file is part of the Boomerang Decompiler.
+ *
+ * See the file "LICENSE.TERMS" for information on usage and
+ * redistribution of this file, and for a DISCLAIMER OF ALL
+ * WARRANTIES.
+ */
+#pragma endregion License
+#pragma once
+
+
+#include "boomerang/core/BoomerangAPI.h"
+
+#include <QByteArray>
+#include <QString>
+
+
+class RTLInstDict;
+
+
+/**
+ * Binary cache for fully expanded instruction dictionaries, so that the SSL file
+ * does not have to be parsed again on every start.
+ *
+ * A cache file contains all registers, flag functions, instruction templates
+ * and their parameters of a single SSL file. It is only valid for SSL files
+ * with the same content hash, for the same version of Boomerang
+ * and for the same version of the file format.
+ */
+class BOOMERANG_API RTLInstDictCache
+{
+public:
+    /// Must be increased whenever the file format or the meaning of the serialized data
+    /// (e.g. the numbering of operators) changes.
+    static constexpr quint32 FORMAT_VERSION = 2;
+
+public:
+    /// \returns the hash of the contents of the file \p sslFileName and of the Boomerang version,
+    /// or an empty array if the file cannot be read.
+    static QByteArray hashSSLFile(const QString &sslFileName);
+
+    /// \returns the path of the cache file in \p cacheDir
+    /// for the SSL file \p sslFileName with hash \p sslHash.
+    static QString getCacheFilePath(const QString &cacheDir, const QString &sslFileName,
+                                    const QByteArray &sslHash);
+
+    /**
+     * Fill \p dict with the contents of the cache file \p cacheFile.
+     * \p dict must be empty.
+     * \returns false if the cache file does not exist, is damaged or is outdated,
+     * or was not created for an SSL file with hash \p sslHash.
+     * In this case, the contents of \p dict are unspecified.
+     */
+    static bool load(RTLInstDict &dict, const QString &cacheFile, const QByteArray &sslHash);
+
+    /**
+     * Write the contents of \p dict to \p cacheFile.
+     * \returns false if the cache file could not be written, or if \p dict contains
+     * expressions or statements that cannot be stored in a cache file.
+     */
+    static bool save(const RTLInstDict &dict, const QString &cacheFile, const QByteArray &sslHash);
+};
@@ -0,0 +1,173 @@
+#pragma region License
+/*
+ * This file is part of the Boomerang Decompiler.
+ *
+ * See the file "LICENSE.TERMS" for information on usage and
+ * redistribution of this file, and for a DISCLAIMER OF ALL
+ * WARRANTIES.
+ */
+#pragma endregion License
+#include "RegisterAliasModel.h"
+
+#include <set>
+
+
+void RegisterAliasModel::clear()
+{
+    m_regs.clear();
+    m_idxByID.clear();
+}
+
+
+void RegisterAliasModel::compile(const std::map<int, Register> &regInfo)
+{
+    clear();
+
+    // Parent register ID by child register ID
+    std::map<int, int> parents;
+
+    for (const auto &[id, reg] : regInfo) {
+        if (id < 0 || reg.getMappedIndex() < 0 || reg.getMappedOffset() < 0) {
+            continue;
+        }
+
+        auto parentIt = regInfo.find(reg.getMappedIndex());
+        if (parentIt == regInfo.end() || parentIt->first == id) {
+            continue;
+        }
+
+        // COVERS registers are larger than the register they are mapped to
+        const Register &parent = parentIt->second;
+        if (reg.getSize() >= parent.getSize() ||
+            reg.getMappedOffset() + reg.getSize() > parent.getSize()) {
+            continue;
+        }
+        else if (reg.isFloat() || parent.isFloat() || parent.getSize() > 64) {
+            continue; // not a plain bit field of an integer register
+        }
+
+        parents[id] = parentIt->first;
+    }
+
+    if (parents.empty()) {
+        return;
+    }
+
+    std::set<int> aliasedIDs;
+    for (const auto &[child, parent] : parents) {
+        aliasedIDs.insert(child);
+        aliasedIDs.insert(parent);
+    }
+
+    m_idxByID.assign(*aliasedIDs.rbegin() + 1, -1);
+
+    for (int id : aliasedIDs) {
+        m_idxByID[id] = static_cast<int>(m_regs.size());
+        m_regs.push_back({ id, regInfo.at(id).getSize(), -1, 0, RegMask() });
+    }
+
+    // Find the root register of every register by walking up the parent chain.
+    // The depth limit guards against cyclic SHARES declarations.
+    for (AliasedReg &reg : m_regs) {
+        int rootID = reg.regID;
+        int offset = 0;
+
+        for (std::size_t depth = 0; depth < m_regs.size(); depth++) {
+            auto parentIt = parents.find(rootID);
+            if (parentIt == parents.end()) {
+                break;
+            }
+
+            offset += regInfo.at(rootID).getMappedOffset();
+            rootID = parentIt->second;
+        }
+
+        reg.rootIdx = getIdx(rootID);
+        reg.rootOff = offset;
+    }
+
+    for (AliasedReg &reg : m_regs) {
+        reg.overlaps = createMask();
+    }
+
+    for (std::size_t i = 0; i < m_regs.size(); i++) {
+        for (std::size_t j = i + 1; j < m_regs.size(); j++) {
+            const AliasedReg &a = m_regs[i];
+            const AliasedReg &b = m_regs[j];
+
+            if (a.rootIdx != b.rootIdx || a.rootOff >= b.rootOff + b.size ||
+                b.rootOff >= a.rootOff + a.size) {
+                continue;
+            }
+
+            m_regs[i].overlaps[j / 64] |= uint64_t(1) << (j % 64);
+            m_regs[j].overlaps[i / 64] |= uint64_t(1) << (i % 64);
+        }
+    }
+}
+
+
+int RegisterAliasModel::getRootReg(int regID) const
+{
+    const int idx = getIdx(regID);
+    return idx != -1 ? m_regs[m_regs[idx].rootIdx].regID : regID;
+}
+
+
+int RegisterAliasModel::getBitOffset(int regID) const
+{
+    const int idx = getIdx(regID);
+    return idx != -1 ? m_regs[idx].rootOff : 0;
+}
+
+
+int RegisterAliasModel::getSize(int regID) const
+{
+    const int idx = getIdx(regID);
+    return idx != -1 ? m_regs[idx].size : 0;
+}
+
+
+void RegisterAliasModel::addToMask(RegMask &mask, int regID) const
+{
+    const int idx = getIdx(regID);
+    if (idx != -1) {
+        mask[idx / 64] |= uint64_t(1) << (idx % 64);
+    }
+}
+
+
+bool RegisterAliasModel::isInMask(const RegMask &mask, int regID) const
+{
+    const int idx = getIdx(regID);
+    return idx != -1 && (mask[idx / 64] & (uint64_t(1) << (idx % 64))) != 0;
+}
+
+
+std::vector<int> RegisterAliasModel::getOverlappingRegs(int regID, const RegMask &filter) const
+{
+    std::vector<int> result;
+
+    const int idx = getIdx(regID);
+    if (idx == -1) {
+        return result;
+    }
+
+    const RegMask &overlaps = m_regs[idx].overlaps;
+
+    for (std::size_t word = 0; word < overlaps.size(); word++) {
+        uint64_t bits = overlaps[word] & filter[word];
+
+        while (bits != 0) {
+            int bit = 0;
+            while ((bits & (uint64_t(1) << bit)) == 0) {
+                bit++;
+            }
+
+            result.push_back(m_regs[word * 64 + bit].regID);
+            bits &= bits - 1;
+        }
+    }
+
+    return result;
+}
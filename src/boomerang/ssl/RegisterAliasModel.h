@@ -0,0 +1,104 @@
+#pragma region License
+/*
+ * This file is part of the Boomerang Decompiler.
+ *
+ * See the file "LICENSE.TERMS" for information on usage and
+ * redistribution of this file, and for a DISCLAIMER OF ALL
+ * WARRANTIES.
+ */
+#pragma endregion License
+#pragma once
+
+
+#include "boomerang/ssl/Register.h"
+
+#include <cstdint>
+#include <map>
+#include <vector>
+
+
+/**
+ * Describes which registers of a machine overlap each other (e.g. %al, %ah, %ax and %eax
+ * on x86). The model is compiled from the SHARES declarations of the \@REGISTERS section
+ * of an SSL file, i.e. from the mapped index and mapped offset of each Register.
+ *
+ * Every register that takes part in aliasing gets a dense index, so sets of aliased
+ * registers can be represented as bit masks (RegMask) and tested cheaply.
+ */
+class BOOMERANG_API RegisterAliasModel
+{
+public:
+    /// A set of aliased registers, one bit per dense index.
+    typedef std::vector<uint64_t> RegMask;
+
+public:
+    RegisterAliasModel() = default;
+
+public:
+    /// Remove all registers from the model.
+    void clear();
+
+    /**
+     * Build the model from the register information of an SSL file.
+     * Only SHARES registers (registers that are a proper bit range of their parent register)
+     * of at most 64 bit integer registers are considered; COVERS registers (which span
+     * several registers) and floating point registers are ignored.
+     */
+    void compile(const std::map<int, Register> &regInfo);
+
+    /// \returns true if no register overlaps any other register.
+    bool isEmpty() const { return m_regs.empty(); }
+
+    /// \returns the number of registers taking part in aliasing.
+    int getNumAliasedRegs() const { return static_cast<int>(m_regs.size()); }
+
+    /// \returns true if the register \p regID overlaps at least one other register.
+    bool isAliased(int regID) const { return getIdx(regID) != -1; }
+
+    /// \returns the outermost register containing the register \p regID,
+    /// or \p regID itself if it is not contained in any other register.
+    int getRootReg(int regID) const;
+
+    /// \returns the bit offset of the register \p regID within its root register.
+    int getBitOffset(int regID) const;
+
+    /// \returns the size of the register \p regID in bits, or 0 if it is not aliased.
+    int getSize(int regID) const;
+
+    /// \returns an empty mask suitable for this model.
+    RegMask createMask() const { return RegMask((m_regs.size() + 63) / 64, 0); }
+
+    /// Add the register \p regID to \p mask. Does nothing if the register is not aliased.
+    void addToMask(RegMask &mask, int regID) const;
+
+    /// \returns true if \p mask contains the register \p regID.
+    bool isInMask(const RegMask &mask, int regID) const;
+
+    /**
+     * \returns the IDs of all registers in \p filter that overlap the register \p regID,
+     * excluding \p regID itself, sorted by dense index.
+     */
+    std::vector<int> getOverlappingRegs(int regID, const RegMask &filter) const;
+
+private:
+    struct AliasedReg
+    {
+        int regID;
+        int size;         ///< Size in bits
+        int rootIdx;      ///< Dense index of the root register
+        int rootOff;      ///< Bit offset of this register within the root register
+        RegMask overlaps; ///< All other registers sharing at least one bit with this one
+    };
+
+private:
+    /// \returns the dense index of the register \p regID, or -1 if it is not aliased.
+    int getIdx(int regID) const
+    {
+        return (regID >= 0 && regID < static_cast<int>(m_idxByID.size())) ? m_idxByID[regID]
+                                                                           : -1;
+    }
+
+private:
+    std::vector<AliasedReg> m_regs;
+    std::vector<int> m_idxByID; ///< Dense index by register ID, -1 if not aliased
+};
@@ -19,9 +19,11 @@
 #include "boomerang/ssl/type/PointerType.h"
 #include "boomerang/ssl/type/SizeType.h"
 #include "boomerang/ssl/type/VoidType.h"
+#include "boomerang/util/Util.h"
 #include "boomerang/util/log/Log.h"
 #include "boomerang/visitor/expmodifier/ExpModifier.h"
 #include "boomerang/visitor/expvisitor/ExpVisitor.h"
+#include "boomerang/visitor/expvisitor/RawExpVisitor.h"
 
 #include <QRegularExpression>
 
@@ -52,6 +54,7 @@ Binary::~Binary()
 void Binary::setSubExp2(SharedExp e)
 {
     subExp2 = e;
+    markModified();
     assert(subExp1 && subExp2);
 }
 
@@ -59,6 +62,7 @@ void Binary::setSubExp2(SharedExp e)
 SharedExp Binary::getSubExp2()
 {
     assert(subExp1 && subExp2);
+    invalidateCaches(); // the caller may modify the subexpression
     return subExp2;
 }
 
@@ -66,6 +70,7 @@ SharedExp Binary::getSubExp2()
 SharedExp &Binary::refSubExp2()
 {
     assert(subExp1 && subExp2);
+    markModified(); // the caller may replace the subexpression
     return subExp2;
 }
 
@@ -73,6 +78,7 @@ SharedExp &Binary::refSubExp2()
 void Binary::commute()
 {
     std::swap(subExp1, subExp2);
+    markModified();
     assert(subExp1 && subExp2);
 }
 
@@ -513,6 +519,23 @@ bool Binary::acceptVisitor(ExpVisitor *v)
 }
 
 
+bool Binary::acceptVisitor(RawExpVisitor *v) const
+{
+    bool visitChildren = true;
+    if (!v->preVisit(*this, visitChildren)) {
+        return false;
+    }
+
+    if (visitChildren) {
+        if (!subExp1->acceptVisitor(v) || !subExp2->acceptVisitor(v)) {
+            return false;
+        }
+    }
+
+    return v->postVisit(*this);
+}
+
+
 SharedExp Binary::acceptPreModifier(ExpModifier *mod, bool &visitChildren)
 {
     return mod->preModify(access<Binary>(), visitChildren);
@@ -523,6 +546,7 @@ SharedExp Binary::acceptChildModifier(ExpModifier *mod)
 {
     subExp1 = subExp1->acceptModifier(mod);
     subExp2 = subExp2->acceptModifier(mod);
+    markModified();
     return shared_from_this();
 }
 
@@ -531,3 +555,11 @@ SharedExp Binary::acceptPostModifier(ExpModifier *mod)
 {
     return mod->postModify(access<Binary>());
 }
+
+
+std::size_t Binary::computeHash() const
+{
+    std::size_t result = Unary::computeHash();
+    Util::hashCombine(result, subExp2->hash());
+    return result;
+}
@@ -76,6 +76,9 @@ public:
     /// \copydoc Unary::acceptVisitor
     virtual bool acceptVisitor(ExpVisitor *v) override;
 
+    /// \copydoc Unary::acceptVisitor
+    virtual bool acceptVisitor(RawExpVisitor *v) const override;
+
 protected:
     /// \copydoc Unary::acceptPreModifier
     virtual SharedExp acceptPreModifier(ExpModifier *mod, bool &visitChildren) override;
@@ -86,6 +89,9 @@ protected:
     /// \copydoc Unary::acceptPostModifier
     virtual SharedExp acceptPostModifier(ExpModifier *mod) override;
 
+    /// \copydoc Unary::computeHash
+    virtual std::size_t computeHash() const override;
+
 protected:
     SharedExp subExp2; ///< Second subexpression pointer
 };
@@ -16,14 +16,15 @@
 #include "boomerang/ssl/type/IntegerType.h"
 #include "boomerang/ssl/type/PointerType.h"
 #include "boomerang/ssl/type/VoidType.h"
+#include "boomerang/util/Util.h"
 #include "boomerang/util/log/Log.h"
 #include "boomerang/visitor/expmodifier/ExpModifier.h"
 #include "boomerang/visitor/expvisitor/ExpVisitor.h"
+#include "boomerang/visitor/expvisitor/RawExpVisitor.h"
 
 
 Const::Const(uint32_t i)
     : Exp(opIntConst)
-    , m_type(VoidType::get())
 {
     m_value.i = i;
 }
@@ -31,7 +32,6 @@ Const::Const(uint32_t i)
 
 Const::Const(int i)
     : Exp(opIntConst)
-    , m_type(VoidType::get())
 {
     m_value.i = i;
 }
@@ -39,7 +39,6 @@ Const::Const(int i)
 
 Const::Const(QWord ll)
     : Exp(opLongConst)
-    , m_type(VoidType::get())
 {
     m_value.ll = ll;
 }
@@ -47,7 +46,6 @@ Const::Const(QWord ll)
 
 Const::Const(double d)
     : Exp(opFltConst)
-    , m_type(VoidType::get())
 {
     m_value.d = d;
 }
@@ -55,15 +53,15 @@ Const::Const(double d)
 
 Const::Const(const QString &p)
     : Exp(opStrConst)
-    , m_type(VoidType::get())
 {
-    m_string = p;
+    if (!p.isEmpty()) {
+        getExtra().string = p;
+    }
 }
 
 
 Const::Const(Function *p)
     : Exp(opFuncConst)
-    , m_type(VoidType::get())
 {
     m_value.pp = p;
 }
@@ -71,7 +69,6 @@ Const::Const(Function *p)
 
 Const::Const(Address addr)
     : Exp(opIntConst)
-    , m_type(VoidType::get())
 {
     m_value.ll = addr.value();
 }
@@ -79,13 +76,90 @@ Const::Const(Address addr)
 
 Const::Const(const Const &other)
     : Exp(other.m_oper)
-    , m_string(other.m_string)
-    , m_type(other.m_type)
+    , m_extra(other.m_extra ? new ExtraData(*other.m_extra) : nullptr)
 {
     memcpy(&m_value, &other.m_value, sizeof(m_value));
 }
 
 
+Const &Const::operator=(const Const &other)
+{
+    if (this != &other) {
+        Exp::operator=(other);
+        memcpy(&m_value, &other.m_value, sizeof(m_value));
+        m_extra.reset(other.m_extra ? new ExtraData(*other.m_extra) : nullptr);
+    }
+
+    return *this;
+}
+
+
+void Const::setInt(int i)
+{
+    m_value.i = i;
+    markModified();
+}
+
+
+void Const::setLong(QWord ll)
+{
+    m_value.ll = ll;
+    markModified();
+}
+
+
+void Const::setFlt(double d)
+{
+    m_value.d = d;
+    markModified();
+}
+
+
+void Const::setStr(const QString &p)
+{
+    getExtra().string = p;
+    compactExtra();
+    markModified();
+}
+
+
+void Const::setAddr(Address a)
+{
+    m_value.ll = a.value();
+    markModified();
+}
+
+
+SharedType Const::getType()
+{
+    return (m_extra && m_extra->type) ? m_extra->type : VoidType::get();
+}
+
+
+const SharedType Const::getType() const
+{
+    return (m_extra && m_extra->type) ? m_extra->type : VoidType::get();
+}
+
+
+void Const::setType(SharedType ty)
+{
+    if (ty && !ty->isVoid()) {
+        getExtra().type = ty;
+    }
+    else if (m_extra) {
+        m_extra->type = nullptr;
+        compactExtra();
+    }
+}
+
+
+std::size_t Const::getOutOfLineSize() const
+{
+    return m_extra ? sizeof(ExtraData) : 0;
+}
+
+
 bool Const::operator<(const Exp &o) const
 {
     if (m_oper != o.getOper()) {
@@ -98,7 +172,8 @@ bool Const::operator<(const Exp &o) const
     case opIntConst: return m_value.i < otherConst.m_value.i;
     case opLongConst: return m_value.ll < otherConst.m_value.ll;
     case opFltConst: return m_value.d < otherConst.m_value.d;
-    case opStrConst: return m_string < otherConst.m_string;
+    case opStrConst: return getStr() < otherConst.getStr();
+    case opFuncConst: return m_value.pp < otherConst.m_value.pp;
 
     default: LOG_FATAL("Invalid operator %1", operToString(m_oper));
     }
@@ -135,7 +210,7 @@ SharedExp Const::clone() const
 void Const::printNoQuotes(OStream &os) const
 {
     if (m_oper == opStrConst) {
-        os << m_string;
+        os << getStr();
     }
     else {
         print(os);
@@ -166,7 +241,8 @@ bool Const::operator==(const Exp &other) const
     case opIntConst: return m_value.i == static_cast<const Const &>(other).m_value.i;
     case opLongConst: return m_value.ll == static_cast<const Const &>(other).m_value.ll;
     case opFltConst: return m_value.d == static_cast<const Const &>(other).m_value.d;
-    case opStrConst: return m_string == static_cast<const Const &>(other).m_string;
+    case opStrConst: return getStr() == static_cast<const Const &>(other).getStr();
+    case opFuncConst: return m_value.pp == static_cast<const Const &>(other).m_value.pp;
     default: LOG_FATAL("Invalid operator %1", operToString(m_oper));
     }
 
@@ -176,20 +252,24 @@ bool Const::operator==(const Exp &other) const
 
 SharedType Const::ascendType()
 {
-    if (m_type->resolvesToVoid()) {
+    SharedType ty = getType();
+
+    if (ty->resolvesToVoid()) {
         switch (m_oper) {
             // could be anything, Boolean, Character, we could be bit fiddling pointers for all we
             // know - trentw
         case opIntConst: return VoidType::get();
-        case opLongConst: return m_type = IntegerType::get(STD_SIZE * 2, Sign::Unknown);
-        case opFltConst: return m_type = FloatType::get(64);
-        case opStrConst: return m_type = PointerType::get(CharType::get());
-        case opFuncConst: return m_type = PointerType::get(FuncType::get());
+        case opLongConst: ty = IntegerType::get(STD_SIZE * 2, Sign::Unknown); break;
+        case opFltConst: ty = FloatType::get(64); break;
+        case opStrConst: ty = PointerType::get(CharType::get()); break;
+        case opFuncConst: ty = PointerType::get(FuncType::get()); break;
         default: assert(false); // Bad Const
         }
+
+        setType(ty);
     }
 
-    return m_type;
+    return ty;
 }
 
 
@@ -197,22 +277,24 @@ void Const::descendType(SharedType parentType, bool &changed, Statement *)
 {
     bool thisCh = false;
 
-    m_type = m_type->meetWith(parentType, thisCh);
+    setType(getType()->meetWith(parentType, thisCh));
     changed |= thisCh;
 
     if (thisCh) {
+        markModified();
+
         // May need to change the representation
-        if (m_type->resolvesToFloat()) {
+        if (getType()->resolvesToFloat()) {
             if (m_oper == opIntConst) {
                 m_oper    = opFltConst;
-                m_type    = FloatType::get(64);
                 float f   = *reinterpret_cast<float *>(&m_value.i);
                 m_value.d = static_cast<double>(f);
+                setType(FloatType::get(64));
             }
             else if (m_oper == opLongConst) {
                 m_oper    = opFltConst;
-                m_type    = FloatType::get(64);
                 m_value.d = *reinterpret_cast<double *>(&m_value.ll);
+                setType(FloatType::get(64));
             }
         }
 
@@ -227,6 +309,12 @@ bool Const::acceptVisitor(ExpVisitor *v)
 }
 
 
+bool Const::acceptVisitor(RawExpVisitor *v) const
+{
+    return v->visit(*this);
+}
+
+
 SharedExp Const::acceptPreModifier(ExpModifier *, bool &)
 {
     return shared_from_this();
@@ -237,3 +325,38 @@ SharedExp Const::acceptPostModifier(ExpModifier *mod)
 {
     return mod->postModify(access<Const>());
 }
+
+
+std::size_t Const::computeHash() const
+{
+    std::size_t result = Exp::computeHash();
+
+    switch (m_oper) {
+    case opIntConst: Util::hashCombine(result, std::hash<int>()(m_value.i)); break;
+    case opLongConst: Util::hashCombine(result, std::hash<QWord>()(m_value.ll)); break;
+    case opFltConst: Util::hashCombine(result, std::hash<double>()(m_value.d)); break;
+    case opStrConst: Util::hashCombine(result, qHash(getStr())); break;
+    case opFuncConst: Util::hashCombine(result, std::hash<Function *>()(m_value.pp)); break;
+    default: break;
+    }
+
+    return result;
+}
+
+
+Const::ExtraData &Const::getExtra()
+{
+    if (!m_extra) {
+        m_extra = std::make_unique<ExtraData>();
+    }
+
+    return *m_extra;
+}
+
+
+void Const::compactExtra()
+{
+    if (m_extra && m_extra->string.isEmpty() && !m_extra->type) {
+        m_extra.reset();
+    }
+}
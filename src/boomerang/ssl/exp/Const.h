@@ -19,7 +19,10 @@ class Function;
 
 /**
  * Const is a subclass of Exp, and holds either an integer,
- * floating point, string, or address constant
+ * floating point, string, or address constant.
+ *
+ * Most constants are untyped integers, so the string value and the type
+ * are only allocated for constants that actually have them.
  */
 class BOOMERANG_API Const : public Exp
 {
@@ -53,7 +56,7 @@ public:
     /// Nothing to destruct: Don't deallocate the string passed to constructor
     virtual ~Const() override = default;
 
-    Const &operator=(const Const &) = default;
+    Const &operator=(const Const &other);
     Const &operator=(Const &&) = default;
 
 public:
@@ -88,23 +91,27 @@ public:
     int getInt() const { return m_value.i; }
     QWord getLong() const { return m_value.ll; }
     double getFlt() const { return m_value.d; }
-    QString getStr() const { return m_string; }
+    QString getStr() const { return m_extra ? m_extra->string : QString(); }
     Address getAddr() const { return Address(static_cast<Address::value_type>(m_value.ll)); }
     QString getFuncName() const;
 
     // Set the constant
-    void setInt(int i) { m_value.i = i; }
-    void setLong(QWord ll) { m_value.ll = ll; }
-    void setFlt(double d) { m_value.d = d; }
-    void setStr(const QString &p) { m_string = p; }
-    void setAddr(Address a) { m_value.ll = a.value(); }
+    void setInt(int i);
+    void setLong(QWord ll);
+    void setFlt(double d);
+    void setStr(const QString &p);
+    void setAddr(Address a);
 
     /// \returns the type of the constant
-    SharedType getType() { return m_type; }
-    const SharedType getType() const { return m_type; }
+    SharedType getType();
+    const SharedType getType() const;
 
     /// Changes the type of this constant
-    void setType(SharedType ty) { m_type = ty; }
+    void setType(SharedType ty);
+
+    /// \returns the number of bytes allocated for the string value and the type
+    /// of this constant in addition to the constant itself.
+    std::size_t getOutOfLineSize() const;
 
     /// Print "recursive" (extra parens not wanted at outer levels)
     void printNoQuotes(OStream &os) const;
@@ -119,6 +126,9 @@ public:
     /// \copydoc Exp::acceptVisitor
     virtual bool acceptVisitor(ExpVisitor *v) override;
 
+    /// \copydoc Exp::acceptVisitor
+    virtual bool acceptVisitor(RawExpVisitor *v) const override;
+
 protected:
     /// \copydoc Exp::acceptPreModifier
     virtual SharedExp acceptPreModifier(ExpModifier *mod, bool &visitChildren) override;
@@ -126,8 +136,24 @@ protected:
     /// \copydoc Exp::acceptPostModifier
     virtual SharedExp acceptPostModifier(ExpModifier *mod) override;
 
+    /// \copydoc Exp::computeHash
+    virtual std::size_t computeHash() const override;
+
+private:
+    /// Data only some constants have
+    struct ExtraData
+    {
+        QString string;  ///< The string value of this constant
+        SharedType type; ///< Constants need types during type analysis; nullptr for void
+    };
+
+    /// \returns the extra data of this constant, allocating it if necessary.
+    ExtraData &getExtra();
+
+    /// Free the extra data if it does not contain anything.
+    void compactExtra();
+
 private:
-    Data m_value;      ///< The value of this constant
-    QString m_string;  ///< The string value of this constant
-    SharedType m_type; ///< Constants need types during type analysis
+    Data m_value; ///< The value of this constant
+    std::unique_ptr<ExtraData> m_extra;
 };
@@ -49,6 +49,7 @@
 #include <algorithm>
 #include <cassert>
 #include <cstring>
+#include <functional>
 #include <iomanip>
 #include <map>
 #include <numeric>
@@ -123,6 +124,30 @@ bool Exp::isAfpTerm()
 }
 
 
+std::size_t Exp::hash() const
+{
+    if (!m_hashValid) {
+        m_hash      = computeHash();
+        m_hashValid = true;
+    }
+
+    return m_hash;
+}
+
+
+std::size_t Exp::computeHash() const
+{
+    return std::hash<int>()(static_cast<int>(m_oper));
+}
+
+
+void Exp::markModified()
+{
+    ++m_modCount;
+    invalidateCaches();
+}
+
+
 SharedExp Exp::getGuard()
 {
     if (m_oper == opGuard) {
@@ -151,7 +176,13 @@ void Exp::doSearch(const Exp &pattern, SharedExp &toSearch, std::list<SharedExp
     // Either want to find all occurrences, or did not match at this level
     // Recurse into children, unless a matching opSubscript
     if (!compare || (toSearch->m_oper != opSubscript)) {
+        const std::size_t numMatches = matches.size();
         toSearch->doSearchChildren(pattern, matches, once);
+
+        if (matches.size() != numMatches) {
+            // The caller may replace matching subexpressions
+            toSearch->markModified();
+        }
     }
 }
 
@@ -199,40 +230,64 @@ SharedExp Exp::searchReplaceAll(const Exp &pattern, const SharedExp &replace, bo
 }
 
 
-bool Exp::search(const Exp &pattern, SharedExp &result)
+/**
+ * Pre-order search of \p exp and its children for \p pattern, with the same rules as
+ * Exp::doSearch (a matching subscript is not searched any further). Since nothing is replaced,
+ * no list of match locations is built, and no cached hash is invalidated.
+ * \param onMatch called for every match; return false to stop the search.
+ * \returns false if the search was stopped by \p onMatch
+ */
+template<typename Callback>
+static bool searchMatches(const Exp &pattern, const SharedExp &exp, Callback &&onMatch)
 {
-    std::list<SharedExp *> li;
-    result = nullptr; // In case it fails; don't leave it unassigned
-    // The search requires a reference to a pointer to this object.
-    // This isn't needed for searches, only for replacements, but we want to re-use the same search
-    // routine
-    SharedExp top = shared_from_this();
-    doSearch(pattern, top, li, false);
-
-    if (!li.empty()) {
-        result = *li.front();
+    const bool isMatch = (pattern == *exp);
+
+    if (isMatch && !onMatch(exp)) {
+        return false;
+    }
+
+    if (isMatch && exp->isSubscript()) {
         return true;
     }
 
-    return false;
+    switch (exp->getArity()) {
+    case 3:
+        return searchMatches(pattern, exp->getSubExp1(), onMatch) &&
+               searchMatches(pattern, exp->getSubExp2(), onMatch) &&
+               searchMatches(pattern, exp->getSubExp3(), onMatch);
+    case 2:
+        return searchMatches(pattern, exp->getSubExp1(), onMatch) &&
+               searchMatches(pattern, exp->getSubExp2(), onMatch);
+    case 1: return searchMatches(pattern, exp->getSubExp1(), onMatch);
+    default: return true;
+    }
 }
 
 
-bool Exp::searchAll(const Exp &pattern, std::list<SharedExp> &result)
+bool Exp::search(const Exp &pattern, SharedExp &result)
 {
-    std::list<SharedExp *> matches;
+    result = nullptr; // In case it fails; don't leave it unassigned
 
-    // The search requires a reference to a pointer to this object.
-    // This isn't needed for searches, only for replacements,
-    // but we want to re-use the same search routine
-    SharedExp toSearch = shared_from_this();
-    doSearch(pattern, toSearch, matches, false);
+    searchMatches(pattern, shared_from_this(), [&result](const SharedExp &match) {
+        result = match;
+        return false; // stop at the first match
+    });
 
-    for (auto it : matches) {
-        result.push_back(*it);
-    }
+    return result != nullptr;
+}
+
+
+bool Exp::searchAll(const Exp &pattern, std::list<SharedExp> &result)
+{
+    bool found = false;
+
+    searchMatches(pattern, shared_from_this(), [&result, &found](const SharedExp &match) {
+        result.push_back(match);
+        found = true;
+        return true;
+    });
 
-    return !matches.empty();
+    return found;
 }
 
 
@@ -322,14 +377,9 @@ SharedExp Exp::simplify()
 #if DEBUG_SIMP
     SharedExp save = clone();
 #endif
-    bool changed  = false; // True if simplified at this or lower level
-    SharedExp res = shared_from_this();
-
-    do {
-        ExpSimplifier es;
-        res     = res->acceptModifier(&es);
-        changed = es.isModified();
-    } while (changed); // If modified at this (or a lower) level, redo
+    ExpSimplifier es;
+    bool changed  = false;
+    SharedExp res = simplifyBottomUp(shared_from_this(), es, changed);
 
     // The below is still important. E.g. want to canonicalise sums, so we know that a + K + b is
     // the same as a + b + K No! This slows everything down, and it's slow enough as it is. Call
@@ -352,6 +402,81 @@ SharedExp Exp::simplifyAddr()
 }
 
 
+SharedExp Exp::simplifyBottomUp(const SharedExp &exp, ExpSimplifier &simplifier, bool &changed)
+{
+    SharedExp res = exp;
+
+    while (!res->m_simplified) {
+        // Simplify all subexpressions first.
+        simplifySubExps(res, simplifier, changed);
+
+        // Apply the rules to this expression until it does not change any more.
+        simplifier.clearModified();
+        bool visitChildren      = true;
+        const uint32_t modCount = res->m_modCount;
+        SharedExp pre           = res->acceptPreModifier(&simplifier, visitChildren);
+
+        if (simplifier.isModified() || pre != res) {
+            changed = true;
+            res     = pre;
+            continue;
+        }
+
+        SharedExp post = res->acceptPostModifier(&simplifier);
+
+        if (simplifier.isModified() || post != res || res->m_modCount != modCount) {
+            changed = true;
+            res     = post;
+            continue;
+        }
+
+        // The rules did not change this expression, but they may have looked at subexpressions
+        // through the non-const accessors. Those are simplified again; only if that actually
+        // changed any of them, the rules have to be applied to this expression again.
+        bool subExpChanged = false;
+        simplifySubExps(res, simplifier, subExpChanged);
+
+        if (subExpChanged) {
+            changed = true;
+            continue;
+        }
+
+        res->m_simplified = true;
+    }
+
+    return res;
+}
+
+
+void Exp::simplifySubExps(const SharedExp &exp, ExpSimplifier &simplifier, bool &changed)
+{
+    const Exp &constExp = *exp;
+
+    for (int i = 1; i <= exp->getArity(); i++) {
+        // Use the const accessors first to not invalidate the cached state of exp
+        const SharedConstExp constChild = (i == 1) ? constExp.getSubExp1()
+                                                   : ((i == 2) ? constExp.getSubExp2()
+                                                               : constExp.getSubExp3());
+
+        if (constChild->m_simplified) {
+            continue;
+        }
+
+        const SharedExp child = (i == 1) ? exp->getSubExp1()
+                                         : ((i == 2) ? exp->getSubExp2() : exp->getSubExp3());
+        const SharedExp newChild = simplifyBottomUp(child, simplifier, changed);
+
+        if (newChild != child) {
+            switch (i) {
+            case 1: exp->setSubExp1(newChild); break;
+            case 2: exp->setSubExp2(newChild); break;
+            default: exp->setSubExp3(newChild); break;
+            }
+        }
+    }
+}
+
+
 SharedExp Exp::simplifyArith()
 {
     ExpArithSimplifier eas;
@@ -17,6 +17,7 @@
 #include <QString>
 
 #include <cassert>
+#include <cstdint>
 #include <list>
 #include <memory>
 #include <set>
@@ -26,7 +27,9 @@
 class Exp;
 class Type;
 class ExpVisitor;
+class RawExpVisitor;
 class ExpModifier;
+class ExpSimplifier;
 class UserProc;
 class LocationSet;
 class Statement;
@@ -81,6 +84,14 @@ public:
 
     /// Type sensitive equality
     virtual bool operator==(const Exp &o) const = 0;
+
+    /**
+     * \returns a structural hash of this expression. Expressions that are equal
+     * according to equalExpStar have the same hash.
+     * The hash is cached in this expression until it is modified through one of
+     * its mutating accessors.
+     */
+    std::size_t hash() const;
     bool operator!=(const Exp &o) { return !(*this == o); }
 
     /// Type sensitive less than
@@ -99,7 +110,11 @@ public:
     const char *getOperName() const;
 
     /// A few simplifications use this
-    void setOper(OPER x) { m_oper = x; }
+    void setOper(OPER x)
+    {
+        m_oper = x;
+        markModified();
+    }
 
     /// \returns this expression as a string
     QString toString() const;
@@ -346,7 +361,12 @@ public:
         return nullptr;
     }
 
-    /// \returns  Pointer to the requested subexpression
+    /**
+     * \returns  Pointer to the requested subexpression.
+     * The non-const overloads assume that the caller may modify the subexpression in place,
+     * and invalidate the cached state of this expression. Subexpressions that are shared
+     * with other parents must not be modified in place.
+     */
     virtual SharedExp getSubExp1() { return nullptr; }
     virtual SharedConstExp getSubExp1() const { return nullptr; }
     virtual SharedExp getSubExp2() { return nullptr; }
@@ -423,11 +443,21 @@ public:
      * something powerful, but until then, don't rely on this code to do anything critical. - trent
      * 8/7/2002
      *
+     * Subexpressions are simplified bottom-up in a single traversal; each subexpression is
+     * simplified until it does not change any more before the rules for its parent are applied.
+     * Subexpressions that are already in simplified form (e.g. from an earlier call)
+     * are neither simplified nor traversed again. Like for hash(), modifications
+     * of shared subexpressions are only noticed by the parents they were accessed through.
+     *
      * \returns the simplified expression.
      * \sa ExpSimplifier
      */
     SharedExp simplify();
 
+    /// \returns true if this expression is known to be in simplified form, i.e. neither it
+    /// nor any of its subexpressions were modified since it was last simplified.
+    bool isSimplified() const { return m_simplified; }
+
     /**
      * Just do addressof simplification:
      *     a[ m[ any ]] == any,
@@ -508,6 +538,11 @@ public:
     /// \returns true to continue visiting parent and sibling expressions.
     virtual bool acceptVisitor(ExpVisitor *v) = 0;
 
+    /// Accept a raw expression visitor to visit this expression
+    /// without creating shared pointers for the visited expressions.
+    /// \returns true to continue visiting parent and sibling expressions.
+    virtual bool acceptVisitor(RawExpVisitor *v) const = 0;
+
     /// Accept an expression modifier to modify this expression and all subexpressions.
     /// \returns the modified expression.
     SharedExp acceptModifier(ExpModifier *mod);
@@ -522,6 +557,37 @@ protected:
     /// Accept an exppression modifier to modify this expression after modifying all subexpressions.
     virtual SharedExp acceptPostModifier(ExpModifier *mod) = 0;
 
+private:
+    /**
+     * Simplify \p exp and all its subexpressions bottom-up.
+     * Rules are only applied to subexpressions that are not already simplified.
+     * \param changed set to true if any rule changed \p exp or its subexpressions.
+     * \returns the simplified expression.
+     */
+    static SharedExp simplifyBottomUp(const SharedExp &exp, ExpSimplifier &simplifier,
+                                      bool &changed);
+
+    /// Simplify all subexpressions of \p exp that are not already simplified.
+    /// \param changed set to true if any rule changed one of the subexpressions.
+    static void simplifySubExps(const SharedExp &exp, ExpSimplifier &simplifier, bool &changed);
+
+protected:
+    /// Compute the hash of this expression from the hashes of its subexpressions.
+    /// \sa hash
+    virtual std::size_t computeHash() const;
+
+    /// Must be called whenever this expression is modified in place.
+    /// Invalidates the cached hash and simplified form of this expression.
+    void markModified();
+
+    /// Drop the cached hash and simplified form of this expression
+    /// because a subexpression may be modified.
+    void invalidateCaches()
+    {
+        m_hashValid  = false;
+        m_simplified = false;
+    }
+
 protected:
     template<typename CHILD>
     std::shared_ptr<CHILD> shared_from_base()
@@ -537,6 +603,13 @@ protected:
 
 protected:
     OPER m_oper; ///< The operator (e.g. opPlus)
+
+    /// Number of in-place modifications of this expression (not including its subexpressions)
+    uint32_t m_modCount = 0;
+
+    mutable std::size_t m_hash = 0;    ///< Cached value of computeHash()
+    mutable bool m_hashValid   = false; ///< True if m_hash is up to date
+    bool m_simplified          = false; ///< True if simplify() would not change this expression
 };
 
 
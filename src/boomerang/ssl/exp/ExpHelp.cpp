@@ -10,12 +10,84 @@
 #include "ExpHelp.h"
 
 #include "boomerang/ssl/exp/Exp.h"
+#include "boomerang/ssl/exp/RefExp.h"
+#include "boomerang/ssl/exp/TypedExp.h"
 #include "boomerang/ssl/statements/Assign.h"
+#include "boomerang/ssl/type/Type.h"
 #include "boomerang/util/log/Log.h"
 
 
+/// Structural equality of \p left and \p right. Unlike operator==, wildcards only match
+/// identical wildcards, and subscripts must refer to the same definition.
+static bool isStructurallyEqual(const Exp &left, const Exp &right)
+{
+    if (&left == &right) {
+        return true;
+    }
+    else if (left.getOper() != right.getOper() || left.getArity() != right.getArity()) {
+        return false;
+    }
+
+    switch (left.getOper()) {
+    case opSubscript:
+        if (static_cast<const RefExp &>(left).getDef() !=
+            static_cast<const RefExp &>(right).getDef()) {
+            return false;
+        }
+        break;
+
+    case opTypedExp:
+        if (*static_cast<const TypedExp &>(left).getType() !=
+            *static_cast<const TypedExp &>(right).getType()) {
+            return false;
+        }
+        break;
+
+    default: break;
+    }
+
+    switch (left.getArity()) {
+    case 0:
+        // Const and Terminal: operator== is strict for equal operators
+        return left == right;
+    case 1: return isStructurallyEqual(*left.getSubExp1(), *right.getSubExp1());
+    case 2:
+        return isStructurallyEqual(*left.getSubExp1(), *right.getSubExp1()) &&
+               isStructurallyEqual(*left.getSubExp2(), *right.getSubExp2());
+    default:
+        return isStructurallyEqual(*left.getSubExp1(), *right.getSubExp1()) &&
+               isStructurallyEqual(*left.getSubExp2(), *right.getSubExp2()) &&
+               isStructurallyEqual(*left.getSubExp3(), *right.getSubExp3());
+    }
+}
+
+
 // A helper class for comparing Exp*'s sensibly
 bool lessExpStar::operator()(const SharedConstExp &left, const SharedConstExp &right) const
 {
     return (*left < *right); // Compare the actual Exps
 }
+
+
+std::size_t hashExpStar::operator()(const SharedConstExp &exp) const
+{
+    return exp->hash();
+}
+
+
+std::size_t hashExpStar::operator()(const SharedExp &exp) const
+{
+    return exp->hash();
+}
+
+
+bool equalExpStar::operator()(const SharedConstExp &left, const SharedConstExp &right) const
+{
+    return isStructurallyEqual(*left, *right);
+}
+
+
+bool equalExpStar::operator()(const SharedExp &left, const SharedExp &right) const
+{
+    return isStructurallyEqual(*left, *right);
+}
@@ -13,6 +13,7 @@
 #include "boomerang/core/BoomerangAPI.h"
 
 #include <memory>
+#include <unordered_map>
 
 
 class Exp;
@@ -26,3 +27,27 @@ struct BOOMERANG_API lessExpStar
 {
     bool operator()(const SharedConstExp &left, const SharedConstExp &right) const;
 };
+
+
+/// A class for hashing Exp*s (hashing the actual expressions). Consistent with equalExpStar.
+struct BOOMERANG_API hashExpStar
+{
+    std::size_t operator()(const SharedConstExp &exp) const;
+    std::size_t operator()(const SharedExp &exp) const;
+};
+
+
+/// A class for comparing Exp*s for equality (comparing the actual expressions). Type sensitive.
+/// Unlike Exp::operator==, wildcards are not considered, and x{-} and x{implicit} are different.
+/// Consistent with hashExpStar.
+struct BOOMERANG_API equalExpStar
+{
+    bool operator()(const SharedConstExp &left, const SharedConstExp &right) const;
+    bool operator()(const SharedExp &left, const SharedExp &right) const;
+};
+
+
+/// An unordered map from expressions to \p Value where keys are compared by value.
+/// Use this instead of std::map<SharedExp, Value, lessExpStar> if the order of keys does not matter.
+template<typename Value>
+using ExpHashMap = std::unordered_map<SharedExp, Value, hashExpStar, equalExpStar>;
@@ -12,6 +12,7 @@
 #include "boomerang/ssl/RTL.h"
 #include "boomerang/visitor/expmodifier/ExpModifier.h"
 #include "boomerang/visitor/expvisitor/ExpVisitor.h"
+#include "boomerang/visitor/expvisitor/RawExpVisitor.h"
 
 
 FlagDef::FlagDef(const SharedExp &params, const SharedRTL &_rtl)
@@ -43,6 +44,23 @@ bool FlagDef::acceptVisitor(ExpVisitor *v)
 }
 
 
+bool FlagDef::acceptVisitor(RawExpVisitor *v) const
+{
+    bool visitChildren = true;
+    if (!v->preVisit(*this, visitChildren)) {
+        return false;
+    }
+
+    if (visitChildren) {
+        if (!subExp1->acceptVisitor(v)) {
+            return false;
+        }
+    }
+
+    return v->postVisit(*this);
+}
+
+
 SharedExp FlagDef::acceptPreModifier(ExpModifier *mod, bool &visitChildren)
 {
     return mod->preModify(access<FlagDef>(), visitChildren);
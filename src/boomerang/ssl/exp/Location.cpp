@@ -15,6 +15,7 @@
 #include "boomerang/util/log/Log.h"
 #include "boomerang/visitor/expmodifier/ExpModifier.h"
 #include "boomerang/visitor/expvisitor/ExpVisitor.h"
+#include "boomerang/visitor/expvisitor/RawExpVisitor.h"
 
 
 Location::Location(const Location &other)
@@ -148,6 +149,23 @@ bool Location::acceptVisitor(ExpVisitor *v)
 }
 
 
+bool Location::acceptVisitor(RawExpVisitor *v) const
+{
+    bool visitChildren = true;
+    if (!v->preVisit(*this, visitChildren)) {
+        return false;
+    }
+
+    if (visitChildren) {
+        if (!subExp1->acceptVisitor(v)) {
+            return false;
+        }
+    }
+
+    return v->postVisit(*this);
+}
+
+
 std::shared_ptr<Location> Location::local(const QString &name, UserProc *p)
 {
     return std::make_shared<Location>(opLocal, Const::get(name), p);
@@ -60,6 +60,9 @@ public:
     /// \copydoc Unary::acceptVisitor
     virtual bool acceptVisitor(ExpVisitor *v) override;
 
+    /// \copydoc Unary::acceptVisitor
+    virtual bool acceptVisitor(RawExpVisitor *v) const override;
+
 protected:
     /// \copydoc Exp::acceptPreModifier
     virtual SharedExp acceptPreModifier(ExpModifier *mod, bool &visitChildren) override;
@@ -11,9 +11,11 @@
 
 #include "boomerang/ssl/statements/Statement.h"
 #include "boomerang/ssl/type/VoidType.h"
+#include "boomerang/util/Util.h"
 #include "boomerang/util/log/Log.h"
 #include "boomerang/visitor/expmodifier/ExpModifier.h"
 #include "boomerang/visitor/expvisitor/ExpVisitor.h"
+#include "boomerang/visitor/expvisitor/RawExpVisitor.h"
 
 
 RefExp::RefExp(SharedExp e, Statement *d)
@@ -136,6 +138,23 @@ bool RefExp::acceptVisitor(ExpVisitor *v)
 }
 
 
+bool RefExp::acceptVisitor(RawExpVisitor *v) const
+{
+    bool visitChildren = true;
+    if (!v->preVisit(*this, visitChildren)) {
+        return false;
+    }
+
+    if (visitChildren) {
+        if (!subExp1->acceptVisitor(v)) {
+            return false;
+        }
+    }
+
+    return v->postVisit(*this);
+}
+
+
 bool RefExp::isImplicitDef() const
 {
     return m_def == nullptr || m_def->getKind() == StmtType::ImpAssign;
@@ -145,6 +164,7 @@ bool RefExp::isImplicitDef() const
 SharedExp RefExp::addSubscript(Statement *_def)
 {
     m_def = _def;
+    markModified();
     return shared_from_this();
 }
 
@@ -153,6 +173,7 @@ void RefExp::setDef(Statement *_def)
 {
     //         assert(_def != nullptr);
     m_def = _def;
+    markModified();
 }
 
 
@@ -197,3 +218,11 @@ SharedExp RefExp::acceptPostModifier(ExpModifier *mod)
 {
     return mod->postModify(access<RefExp>());
 }
+
+
+std::size_t RefExp::computeHash() const
+{
+    std::size_t result = Unary::computeHash();
+    Util::hashCombine(result, std::hash<Statement *>()(m_def));
+    return result;
+}
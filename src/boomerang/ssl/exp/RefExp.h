@@ -81,6 +81,9 @@ public:
     /// \copydoc Unary::acceptVisitor
     virtual bool acceptVisitor(ExpVisitor *v) override;
 
+    /// \copydoc Unary::acceptVisitor
+    virtual bool acceptVisitor(RawExpVisitor *v) const override;
+
 private:
     /// \copydoc Unary::acceptPreModifier
     virtual SharedExp acceptPreModifier(ExpModifier *mod, bool &visitChildren) override;
@@ -88,6 +91,9 @@ private:
     /// \copydoc Unary::acceptPostModifier
     virtual SharedExp acceptPostModifier(ExpModifier *mod) override;
 
+    /// \copydoc Unary::computeHash
+    virtual std::size_t computeHash() const override;
+
 private:
     Statement *m_def; ///< The defining statement
 };
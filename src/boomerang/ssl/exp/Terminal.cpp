@@ -15,6 +15,7 @@
 #include "boomerang/util/log/Log.h"
 #include "boomerang/visitor/expmodifier/ExpModifier.h"
 #include "boomerang/visitor/expvisitor/ExpVisitor.h"
+#include "boomerang/visitor/expvisitor/RawExpVisitor.h"
 
 
 Terminal::Terminal(OPER _op)
@@ -86,6 +87,12 @@ bool Terminal::acceptVisitor(ExpVisitor *v)
 }
 
 
+bool Terminal::acceptVisitor(RawExpVisitor *v) const
+{
+    return v->visit(*this);
+}
+
+
 SharedType Terminal::ascendType()
 {
     // Can also find various terminals at the leaves of an expression tree
@@ -58,6 +58,9 @@ public:
     /// \copydoc Exp::acceptVisitor
     bool acceptVisitor(ExpVisitor *v) override;
 
+    /// \copydoc Exp::acceptVisitor
+    bool acceptVisitor(RawExpVisitor *v) const override;
+
 protected:
     /// \copydoc Exp::acceptPreModifier
     virtual SharedExp acceptPreModifier(ExpModifier *mod, bool &visitChildren) override;
@@ -16,9 +16,11 @@
 #include "boomerang/ssl/type/FloatType.h"
 #include "boomerang/ssl/type/IntegerType.h"
 #include "boomerang/ssl/type/VoidType.h"
+#include "boomerang/util/Util.h"
 #include "boomerang/util/log/Log.h"
 #include "boomerang/visitor/expmodifier/ExpModifier.h"
 #include "boomerang/visitor/expvisitor/ExpVisitor.h"
+#include "boomerang/visitor/expvisitor/RawExpVisitor.h"
 
 
 Ternary::Ternary(OPER _op, SharedExp _e1, SharedExp _e2, SharedExp _e3)
@@ -52,6 +54,7 @@ void Ternary::setSubExp3(SharedExp e)
     }
 
     subExp3 = e;
+    markModified();
     assert(subExp1 && subExp2 && subExp3);
 }
 
@@ -59,6 +62,7 @@ void Ternary::setSubExp3(SharedExp e)
 SharedExp Ternary::getSubExp3()
 {
     assert(subExp1 && subExp2 && subExp3);
+    invalidateCaches(); // the caller may modify the subexpression
     return subExp3;
 }
 
@@ -73,6 +77,7 @@ SharedConstExp Ternary::getSubExp3() const
 SharedExp &Ternary::refSubExp3()
 {
     assert(subExp1 && subExp2 && subExp3);
+    markModified(); // the caller may replace the subexpression
     return subExp3;
 }
 
@@ -194,6 +199,24 @@ bool Ternary::acceptVisitor(ExpVisitor *v)
 }
 
 
+bool Ternary::acceptVisitor(RawExpVisitor *v) const
+{
+    bool visitChildren = true;
+    if (!v->preVisit(*this, visitChildren)) {
+        return false;
+    }
+
+    if (visitChildren) {
+        if (!subExp1->acceptVisitor(v) || !subExp2->acceptVisitor(v) ||
+            !subExp3->acceptVisitor(v)) {
+            return false;
+        }
+    }
+
+    return v->postVisit(*this);
+}
+
+
 SharedType Ternary::ascendType()
 {
     switch (m_oper) {
@@ -244,6 +267,7 @@ SharedExp Ternary::acceptChildModifier(ExpModifier *mod)
     subExp1 = subExp1->acceptModifier(mod);
     subExp2 = subExp2->acceptModifier(mod);
     subExp3 = subExp3->acceptModifier(mod);
+    markModified();
     return shared_from_this();
 }
 
@@ -252,3 +276,11 @@ SharedExp Ternary::acceptPostModifier(ExpModifier *mod)
 {
     return mod->postModify(access<Ternary>());
 }
+
+
+std::size_t Ternary::computeHash() const
+{
+    std::size_t result = Binary::computeHash();
+    Util::hashCombine(result, subExp3->hash());
+    return result;
+}
@@ -75,6 +75,9 @@ public:
     /// \copydoc Binary::acceptVisitor
     bool acceptVisitor(ExpVisitor *v) override;
 
+    /// \copydoc Binary::acceptVisitor
+    bool acceptVisitor(RawExpVisitor *v) const override;
+
 protected:
     /// \copydoc Binary::acceptPreModifier
     virtual SharedExp acceptPreModifier(ExpModifier *mod, bool &visitChildren) override;
@@ -85,6 +88,9 @@ protected:
     /// \copydoc Binary::acceptPostModifier
     virtual SharedExp acceptPostModifier(ExpModifier *mod) override;
 
+    /// \copydoc Binary::computeHash
+    virtual std::size_t computeHash() const override;
+
 private:
     SharedExp subExp3; ///< Third subexpression pointer
 };
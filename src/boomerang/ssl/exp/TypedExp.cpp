@@ -13,6 +13,7 @@
 #include "boomerang/util/log/Log.h"
 #include "boomerang/visitor/expmodifier/ExpModifier.h"
 #include "boomerang/visitor/expvisitor/ExpVisitor.h"
+#include "boomerang/visitor/expvisitor/RawExpVisitor.h"
 
 
 TypedExp::TypedExp(SharedExp e1)
@@ -139,6 +140,23 @@ bool TypedExp::acceptVisitor(ExpVisitor *v)
 }
 
 
+bool TypedExp::acceptVisitor(RawExpVisitor *v) const
+{
+    bool visitChildren = true;
+    if (!v->preVisit(*this, visitChildren)) {
+        return false;
+    }
+
+    if (visitChildren) {
+        if (!subExp1->acceptVisitor(v)) {
+            return false;
+        }
+    }
+
+    return v->postVisit(*this);
+}
+
+
 SharedType TypedExp::ascendType()
 {
     return m_type;
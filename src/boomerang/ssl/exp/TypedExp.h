@@ -65,6 +65,9 @@ public:
     /// \copydoc Unary::acceptVisitor
     virtual bool acceptVisitor(ExpVisitor *v) override;
 
+    /// \copydoc Unary::acceptVisitor
+    virtual bool acceptVisitor(RawExpVisitor *v) const override;
+
 protected:
     /// \copydoc Unary::acceptPreModifier
     virtual SharedExp acceptPreModifier(ExpModifier *mod, bool &visitChildren) override;
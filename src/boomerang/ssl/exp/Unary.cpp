@@ -21,9 +21,11 @@
 #include "boomerang/ssl/type/IntegerType.h"
 #include "boomerang/ssl/type/PointerType.h"
 #include "boomerang/ssl/type/VoidType.h"
+#include "boomerang/util/Util.h"
 #include "boomerang/util/log/Log.h"
 #include "boomerang/visitor/expmodifier/ExpModifier.h"
 #include "boomerang/visitor/expvisitor/ExpVisitor.h"
+#include "boomerang/visitor/expvisitor/RawExpVisitor.h"
 
 
 Unary::Unary(OPER _op, SharedExp e)
@@ -50,6 +52,7 @@ Unary::~Unary()
 void Unary::setSubExp1(SharedExp e)
 {
     subExp1 = e;
+    markModified();
     assert(subExp1);
 }
 
@@ -57,6 +60,7 @@ void Unary::setSubExp1(SharedExp e)
 SharedExp Unary::getSubExp1()
 {
     assert(subExp1);
+    invalidateCaches(); // the caller may modify the subexpression
     return subExp1;
 }
 
@@ -71,6 +75,7 @@ SharedConstExp Unary::getSubExp1() const
 SharedExp &Unary::refSubExp1()
 {
     assert(subExp1);
+    markModified(); // the caller may replace the subexpression
     return subExp1;
 }
 
@@ -173,6 +178,23 @@ bool Unary::acceptVisitor(ExpVisitor *v)
 }
 
 
+bool Unary::acceptVisitor(RawExpVisitor *v) const
+{
+    bool visitChildren = true;
+    if (!v->preVisit(*this, visitChildren)) {
+        return false;
+    }
+
+    if (visitChildren) {
+        if (!subExp1->acceptVisitor(v)) {
+            return false;
+        }
+    }
+
+    return v->postVisit(*this);
+}
+
+
 SharedType Unary::ascendType()
 {
     SharedType ta = subExp1->ascendType();
@@ -345,6 +367,7 @@ SharedExp Unary::acceptPreModifier(ExpModifier *mod, bool &visitChildren)
 SharedExp Unary::acceptChildModifier(ExpModifier *mod)
 {
     subExp1 = subExp1->acceptModifier(mod);
+    markModified();
     return shared_from_this();
 }
 
@@ -353,3 +376,11 @@ SharedExp Unary::acceptPostModifier(ExpModifier *mod)
 {
     return mod->postModify(access<Unary>());
 }
+
+
+std::size_t Unary::computeHash() const
+{
+    std::size_t result = Exp::computeHash();
+    Util::hashCombine(result, subExp1->hash());
+    return result;
+}
@@ -73,6 +73,9 @@ public:
     /// \copydoc Exp::acceptVisitor
     virtual bool acceptVisitor(ExpVisitor *v) override;
 
+    /// \copydoc Exp::acceptVisitor
+    virtual bool acceptVisitor(RawExpVisitor *v) const override;
+
 protected:
     /// \copydoc Exp::acceptPreModifier
     virtual SharedExp acceptPreModifier(ExpModifier *mod, bool &visitChildren) override;
@@ -83,6 +86,9 @@ protected:
     /// \copydoc Exp::acceptPostModifier
     virtual SharedExp acceptPostModifier(ExpModifier *mod) override;
 
+    /// \copydoc Exp::computeHash
+    virtual std::size_t computeHash() const override;
+
 protected:
     SharedExp subExp1; ///< One subexpression pointer
 };
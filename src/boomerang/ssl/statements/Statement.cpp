@@ -37,8 +37,11 @@
 #include "boomerang/visitor/expmodifier/ExpSSAXformer.h"
 #include "boomerang/visitor/expmodifier/ExpSubscripter.h"
 #include "boomerang/visitor/expmodifier/SizeStripper.h"
+#include "boomerang/visitor/expvisitor/BadMemofFinder.h"
 #include "boomerang/visitor/expvisitor/ConstFinder.h"
 #include "boomerang/visitor/expvisitor/ExpRegMapper.h"
+#include "boomerang/visitor/expvisitor/FlagsFinder.h"
+#include "boomerang/visitor/expvisitor/FusedExpVisitor.h"
 #include "boomerang/visitor/expvisitor/UsedLocalFinder.h"
 #include "boomerang/visitor/expvisitor/UsedLocsFinder.h"
 #include "boomerang/visitor/stmtexpvisitor/StmtConstFinder.h"
@@ -220,8 +223,7 @@ bool Statement::canPropagateToExp(const Exp &exp)
 }
 
 
-bool Statement::propagateTo(bool &convert, Settings *settings,
-                            std::map<SharedExp, int, lessExpStar> *destCounts,
+bool Statement::propagateTo(bool &convert, Settings *settings, ExpIntMap *destCounts,
                             LocationSet *usedByDomPhi, bool force)
 {
     bool change            = false;
@@ -247,9 +249,15 @@ bool Statement::propagateTo(bool &convert, Settings *settings,
             Assignment *def = static_cast<Assignment *>(e->access<RefExp>()->getDef());
             SharedExp rhs   = def->getRight();
 
+            // Look for bad memofs and flags in a single walk of the rhs
+            BadMemofFinder bmf;
+            FlagsFinder flagsFinder;
+            FusedExpVisitor fused({ &bmf, &flagsFinder });
+            rhs->acceptVisitor(&fused);
+
             // If force is true, ignore the fact that a memof should not be propagated (for switch
             // analysis)
-            if (rhs->containsBadMemof() && !(force && rhs->isMemOf())) {
+            if (bmf.isFound() && !(force && rhs->isMemOf())) {
                 // Must never propagate unsubscripted memofs, or memofs that don't yet have symbols.
                 // You could be propagating past a definition, thereby invalidating the IR
                 continue;
@@ -315,11 +323,11 @@ bool Statement::propagateTo(bool &convert, Settings *settings,
 
             // Check if the -l flag (propMaxDepth) prevents this propagation,
             // but always propagate to %flags
-            if (!destCounts || lhs->isFlags() || def->getRight()->containsFlags()) {
+            if (!destCounts || lhs->isFlags() || flagsFinder.isFound()) {
                 change |= doPropagateTo(e, def, convert, settings);
             }
             else {
-                std::map<SharedExp, int, lessExpStar>::iterator ff = destCounts->find(e);
+                ExpIntMap::iterator ff = destCounts->find(e);
 
                 if (ff == destCounts->end()) {
                     change |= doPropagateTo(e, def, convert, settings);
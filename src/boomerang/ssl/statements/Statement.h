@@ -94,7 +94,7 @@ enum class BranchType : uint8_t
  */
 class BOOMERANG_API Statement
 {
-    typedef std::map<SharedExp, int, lessExpStar> ExpIntMap;
+    typedef ExpHashMap<int> ExpIntMap;
 
 public:
     Statement();
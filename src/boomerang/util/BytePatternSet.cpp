@@ -0,0 +1,236 @@
+#pragma region License
+/*
+ * This file is part of the Boomerang Decompiler.
+ *
+ * See the file "LICENSE.TERMS" for information on usage and
+ * redistribution of this file, and for a DISCLAIMER OF ALL
+ * WARRANTIES.
+ */
+#pragma endregion License
+#include "BytePatternSet.h"
+
+#include <algorithm>
+#include <cassert>
+#include <queue>
+
+
+int BytePatternSet::addPattern(const QString &pattern)
+{
+    Pattern newPattern;
+    if (!parsePattern(pattern, newPattern)) {
+        return -1;
+    }
+
+    const int id = size();
+
+    // insert the anchor into the trie
+    int nodeIdx = 0;
+    for (std::size_t i = 0; i < newPattern.anchorLength; i++) {
+        const Byte b       = newPattern.bytes[newPattern.anchorOffset + i];
+        const int childIdx = findChild(nodeIdx, b);
+
+        if (childIdx != -1) {
+            nodeIdx = childIdx;
+            continue;
+        }
+
+        const int newIdx = static_cast<int>(m_nodes.size());
+        m_nodes.emplace_back();
+
+        std::vector<std::pair<Byte, int>> &children = m_nodes[nodeIdx].children;
+        children.insert(std::lower_bound(children.begin(), children.end(),
+                                         std::make_pair(b, 0)),
+                        { b, newIdx });
+
+        nodeIdx = newIdx;
+    }
+
+    m_nodes[nodeIdx].accepted.push_back(id);
+    m_patterns.push_back(std::move(newPattern));
+    m_linksValid = false;
+
+    return id;
+}
+
+
+int BytePatternSet::getPatternLength(int id) const
+{
+    assert(id >= 0 && id < size());
+    return static_cast<int>(m_patterns[id].bytes.size());
+}
+
+
+int BytePatternSet::getNumFixedBytes(int id) const
+{
+    assert(id >= 0 && id < size());
+    return m_patterns[id].numFixedBytes;
+}
+
+
+std::vector<std::pair<std::size_t, int>> BytePatternSet::findAllMatches(const Byte *data,
+                                                                        std::size_t size) const
+{
+    std::vector<std::pair<std::size_t, int>> result;
+    if (!data || m_patterns.empty()) {
+        return result;
+    }
+
+    updateLinks();
+
+    int state = 0;
+    for (std::size_t i = 0; i < size; i++) {
+        const Byte b = data[i];
+
+        while (state != 0 && findChild(state, b) == -1) {
+            state = m_nodes[state].fail;
+        }
+
+        const int next = findChild(state, b);
+        state          = (next != -1) ? next : 0;
+
+        for (int nodeIdx = state; nodeIdx != -1; nodeIdx = m_nodes[nodeIdx].output) {
+            for (int id : m_nodes[nodeIdx].accepted) {
+                const Pattern &pattern         = m_patterns[id];
+                const std::size_t prefixLength = pattern.anchorOffset + pattern.anchorLength;
+
+                if (i + 1 < prefixLength) {
+                    continue; // pattern would start before the buffer
+                }
+
+                const std::size_t start = i + 1 - prefixLength;
+                if (matchesAt(pattern, data, size, start)) {
+                    result.push_back({ start, id });
+                }
+            }
+        }
+    }
+
+    std::sort(result.begin(), result.end());
+    return result;
+}
+
+
+bool BytePatternSet::parsePattern(const QString &pattern, Pattern &result)
+{
+    QString digits = pattern;
+    digits.remove(' ').remove('\t');
+
+    if (digits.isEmpty() || (digits.length() % 2) != 0) {
+        return false;
+    }
+
+    result.bytes.clear();
+    result.isWild.clear();
+    result.numFixedBytes = 0;
+
+    for (int i = 0; i < digits.length(); i += 2) {
+        const QString byteStr = digits.mid(i, 2);
+
+        if (byteStr == "??") {
+            result.bytes.push_back(0);
+            result.isWild.push_back(true);
+            continue;
+        }
+
+        bool ok            = false;
+        const uint byteVal = byteStr.toUInt(&ok, 16);
+        if (!ok) {
+            return false;
+        }
+
+        result.bytes.push_back(static_cast<Byte>(byteVal));
+        result.isWild.push_back(false);
+        result.numFixedBytes++;
+    }
+
+    // Use the longest run of fixed bytes as anchor
+    result.anchorOffset = 0;
+    result.anchorLength = 0;
+
+    for (std::size_t i = 0; i < result.bytes.size();) {
+        if (result.isWild[i]) {
+            i++;
+            continue;
+        }
+
+        std::size_t end = i;
+        while (end < result.bytes.size() && !result.isWild[end]) {
+            end++;
+        }
+
+        if (end - i > result.anchorLength) {
+            result.anchorOffset = i;
+            result.anchorLength = end - i;
+        }
+
+        i = end;
+    }
+
+    return result.anchorLength > 0;
+}
+
+
+int BytePatternSet::findChild(int nodeIdx, Byte b) const
+{
+    const std::vector<std::pair<Byte, int>> &children = m_nodes[nodeIdx].children;
+
+    auto it = std::lower_bound(children.begin(), children.end(), std::make_pair(b, 0));
+    return (it != children.end() && it->first == b) ? it->second : -1;
+}
+
+
+void BytePatternSet::updateLinks() const
+{
+    if (m_linksValid) {
+        return;
+    }
+
+    // Breadth first, so the fail links of shallower nodes are known
+    std::queue<int> worklist;
+
+    for (const auto &child : m_nodes[0].children) {
+        m_nodes[child.second].fail   = 0;
+        m_nodes[child.second].output = -1;
+        worklist.push(child.second);
+    }
+
+    while (!worklist.empty()) {
+        const int nodeIdx = worklist.front();
+        worklist.pop();
+
+        for (const auto &[b, childIdx] : m_nodes[nodeIdx].children) {
+            int fail = m_nodes[nodeIdx].fail;
+            while (fail != 0 && findChild(fail, b) == -1) {
+                fail = m_nodes[fail].fail;
+            }
+
+            const int failChild = findChild(fail, b);
+            Node &child         = m_nodes[childIdx];
+
+            child.fail   = (failChild != -1) ? failChild : 0;
+            child.output = !m_nodes[child.fail].accepted.empty() ? child.fail
+                                                                 : m_nodes[child.fail].output;
+
+            worklist.push(childIdx);
+        }
+    }
+
+    m_linksValid = true;
+}
+
+
+bool BytePatternSet::matchesAt(const Pattern &pattern, const Byte *data, std::size_t size,
+                               std::size_t offset) const
+{
+    if (offset + pattern.bytes.size() > size) {
+        return false;
+    }
+
+    for (std::size_t i = 0; i < pattern.bytes.size(); i++) {
+        if (!pattern.isWild[i] && data[offset + i] != pattern.bytes[i]) {
+            return false;
+        }
+    }
+
+    return true;
+}
@@ -0,0 +1,93 @@
+#pragma region License
+/*
+ * This file is part of the Boomerang Decompiler.
+ *
+ * See the file "LICENSE.TERMS" for information on usage and
+ * redistribution of this file, and for a DISCLAIMER OF ALL
+ * WARRANTIES.
+ */
+#pragma endregion License
+#pragma once
+
+
+#include "boomerang/core/BoomerangAPI.h"
+#include "boomerang/util/Types.h"
+
+#include <QString>
+
+#include <vector>
+
+
+/**
+ * A set of byte patterns with wildcard bytes that can be searched for in a buffer
+ * in a single pass.
+ *
+ * The longest run of non-wildcard bytes of every pattern is inserted into an
+ * Aho-Corasick automaton. Every occurrence of such an anchor is then verified
+ * against the complete pattern.
+ */
+class BOOMERANG_API BytePatternSet
+{
+public:
+    BytePatternSet() = default;
+
+public:
+    /**
+     * Add a pattern given as a string of hexadecimal bytes, e.g. "55 89 E5 ?? ?? C3".
+     * Whitespace between bytes is optional; "??" matches any byte.
+     * \returns the ID of the pattern, or -1 if the pattern is malformed
+     * or does not contain any non-wildcard byte.
+     * IDs are assigned in insertion order, starting at 0.
+     */
+    int addPattern(const QString &pattern);
+
+    /// \returns the number of patterns in this set.
+    int size() const { return static_cast<int>(m_patterns.size()); }
+
+    /// \returns the length in bytes of the pattern with ID \p id.
+    int getPatternLength(int id) const;
+
+    /// \returns the number of non-wildcard bytes of the pattern with ID \p id.
+    int getNumFixedBytes(int id) const;
+
+    /**
+     * Find all occurrences of all patterns in \p data.
+     * \returns pairs of (offset, pattern ID), sorted by offset and pattern ID.
+     */
+    std::vector<std::pair<std::size_t, int>> findAllMatches(const Byte *data,
+                                                             std::size_t size) const;
+
+private:
+    struct Pattern
+    {
+        std::vector<Byte> bytes;
+        std::vector<bool> isWild;
+        std::size_t anchorOffset; ///< Offset of the anchor in the pattern
+        std::size_t anchorLength; ///< Number of bytes of the anchor
+        int numFixedBytes;
+    };
+
+    struct Node
+    {
+        std::vector<std::pair<Byte, int>> children; ///< Sorted by byte
+        int fail   = 0;  ///< Node of the longest proper suffix of this node that is in the trie
+        int output = -1; ///< Next node on the fail chain that accepts a pattern, or -1
+        std::vector<int> accepted; ///< IDs of the patterns whose anchor ends in this node
+    };
+
+private:
+    static bool parsePattern(const QString &pattern, Pattern &result);
+
+    int findChild(int nodeIdx, Byte b) const;
+
+    /// Compute fail and output links of all nodes, if patterns were added since the last call.
+    void updateLinks() const;
+
+    bool matchesAt(const Pattern &pattern, const Byte *data, std::size_t size,
+                   std::size_t offset) const;
+
+private:
+    std::vector<Pattern> m_patterns;
+    mutable std::vector<Node> m_nodes = { Node() }; ///< Node 0 is the root of the automaton
+    mutable bool m_linksValid         = true;
+};
@@ -11,11 +11,13 @@
 
 #include "boomerang/core/Project.h"
 #include "boomerang/core/Settings.h"
+#include "boomerang/db/CallGraphIndex.h"
 #include "boomerang/db/Prog.h"
 #include "boomerang/db/proc/UserProc.h"
 #include "boomerang/util/log/Log.h"
 
 #include <QSaveFile>
+
 #include <queue>
 
 
@@ -35,35 +37,38 @@ bool CallGraphDotWriter::writeCallGraph(const Prog *prog, const QString &dstFile
     ost << "digraph callgraph\n";
     ost << "{\n";
 
-    std::queue<Function *> procList;
-    std::unordered_set<Function *> seen;
+    const CallGraphIndex &callGraph = prog->getCallGraph();
+    std::queue<int> procList;
+    std::vector<bool> seen(callGraph.getNumProcs(), false);
 
     for (Function *entry : prog->getEntryProcs()) {
         // We have to explicitly write entry procedures here
         // because not every entry procedure has callees (e.g. hello world main)
         ost << "    " << entry->getName() << ";\n";
-        procList.push(entry);
+
+        const int entryIdx = callGraph.getIndexOf(entry);
+        if (entryIdx != -1) {
+            procList.push(entryIdx);
+        }
     }
 
     while (!procList.empty()) {
-        Function *currentProc = procList.front();
+        const int currentIdx = procList.front();
         procList.pop();
 
-        if (currentProc == reinterpret_cast<Function *>(-1)) {
-            continue;
-        }
-        else if (seen.find(currentProc) != seen.end()) {
+        if (seen[currentIdx]) {
             continue; // already processed
         }
-        seen.insert(currentProc);
+        seen[currentIdx] = true;
 
-        UserProc *up = static_cast<UserProc *>(currentProc);
+        const Function *currentProc = callGraph.getProc(currentIdx);
 
-        for (Function *callee : up->getCallees()) {
-            ost << "    " << up->getName() << " -> " << callee->getName() << ";\n";
+        for (int calleeIdx : callGraph.getCallees(currentIdx)) {
+            const Function *callee = callGraph.getProc(calleeIdx);
+            ost << "    " << currentProc->getName() << " -> " << callee->getName() << ";\n";
 
-            if (seen.find(callee) == seen.end() && !callee->isLib()) {
-                procList.push(callee);
+            if (!seen[calleeIdx] && !callee->isLib()) {
+                procList.push(calleeIdx);
             }
         }
     }
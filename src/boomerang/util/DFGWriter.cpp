@@ -30,10 +30,9 @@ void DFGWriter::printDFG(const UserProc *proc, const QString &fname)
     OStream out(&file);
     out << "digraph " << proc->getName() << " {\n";
     proc->numberStatements();
-    StatementList stmts;
-    proc->getStatements(stmts);
+    const auto stmts = proc->getStatementIndex();
 
-    for (Statement *s : stmts) {
+    for (Statement *s : *stmts) {
         if (s->isPhi()) {
             out << s->getNumber() << " [shape=\"triangle\"];\n";
         }
@@ -0,0 +1,171 @@
+#pragma region License
+/*
+ * This file is part of the Boomerang Decompiler.
+ *
+ * See the file "LICENSE.TERMS" for information on usage and
+ * redistribution of this file, and for a DISCLAIMER OF ALL
+ * WARRANTIES.
+ */
+#pragma endregion License
+#include "ExpPatternSet.h"
+
+#include "boomerang/ssl/exp/Exp.h"
+#include "boomerang/ssl/exp/TypedExp.h"
+#include "boomerang/ssl/type/Type.h"
+
+#include <algorithm>
+
+
+ExpPatternSet::ExpPatternSet(const std::initializer_list<SharedConstExp> &patterns)
+{
+    for (const SharedConstExp &pattern : patterns) {
+        addPattern(pattern);
+    }
+}
+
+
+int ExpPatternSet::addPattern(const SharedConstExp &pattern)
+{
+    const int id = size();
+    m_patterns.push_back(pattern);
+
+    FlatExp flat;
+    flatten(pattern.get(), flat);
+
+    int nodeIdx = 0;
+
+    for (const Exp *patNode : flat.nodes) {
+        Edge newEdge;
+        newEdge.pattern     = nullptr;
+        newEdge.skipSubtree = true;
+        newEdge.target      = -1;
+
+        switch (patNode->getOper()) {
+        case opWild: newEdge.oper = opWild; break;
+        case opWildIntConst: newEdge.oper = opIntConst; break;
+        case opWildStrConst: newEdge.oper = opStrConst; break;
+        case opWildMemOf: newEdge.oper = opMemOf; break;
+        case opWildRegOf: newEdge.oper = opRegOf; break;
+        case opWildAddrOf: newEdge.oper = opAddrOf; break;
+        default:
+            newEdge.oper        = patNode->getOper();
+            newEdge.skipSubtree = false;
+            newEdge.pattern     = patNode;
+            break;
+        }
+
+        // Share the edge with a previously added pattern if possible
+        std::vector<Edge> &edges = m_nodes[nodeIdx].edges;
+        auto it = std::find_if(edges.begin(), edges.end(), [&newEdge](const Edge &edge) {
+            return edge.oper == newEdge.oper && edge.skipSubtree == newEdge.skipSubtree &&
+                   (edge.skipSubtree || nodeMatches(*edge.pattern, *newEdge.pattern));
+        });
+
+        if (it != edges.end()) {
+            nodeIdx = it->target;
+        }
+        else {
+            newEdge.target = static_cast<int>(m_nodes.size());
+            m_nodes[nodeIdx].edges.push_back(newEdge);
+            m_nodes.emplace_back();
+            nodeIdx = newEdge.target;
+        }
+    }
+
+    m_nodes[nodeIdx].accepted.push_back(id);
+    return id;
+}
+
+
+int ExpPatternSet::findFirstMatch(const SharedConstExp &exp) const
+{
+    const std::vector<int> matches = findAllMatches(exp);
+    return matches.empty() ? -1 : matches.front();
+}
+
+
+std::vector<int> ExpPatternSet::findAllMatches(const SharedConstExp &exp) const
+{
+    std::vector<int> result;
+
+    if (!exp || m_patterns.empty()) {
+        return result;
+    }
+
+    FlatExp flat;
+    flatten(exp.get(), flat);
+    collectMatches(0, flat, 0, result);
+
+    std::sort(result.begin(), result.end());
+    return result;
+}
+
+
+void ExpPatternSet::flatten(const Exp *exp, FlatExp &flat)
+{
+    while (exp->isSubscript()) {
+        exp = exp->getSubExp1().get();
+    }
+
+    const std::size_t idx = flat.nodes.size();
+    flat.nodes.push_back(exp);
+    flat.subtreeSizes.push_back(1);
+
+    switch (exp->getArity()) {
+    case 3:
+        flatten(exp->getSubExp1().get(), flat);
+        flatten(exp->getSubExp2().get(), flat);
+        flatten(exp->getSubExp3().get(), flat);
+        break;
+    case 2:
+        flatten(exp->getSubExp1().get(), flat);
+        flatten(exp->getSubExp2().get(), flat);
+        break;
+    case 1: flatten(exp->getSubExp1().get(), flat); break;
+    default: break;
+    }
+
+    flat.subtreeSizes[idx] = static_cast<int>(flat.nodes.size() - idx);
+}
+
+
+bool ExpPatternSet::nodeMatches(const Exp &exp, const Exp &pattern)
+{
+    if (exp.getOper() != pattern.getOper() || exp.getArity() != pattern.getArity()) {
+        return false;
+    }
+    else if (exp.getArity() == 0) {
+        return exp == pattern; // compare values of constants
+    }
+    else if (exp.isTypedExp()) {
+        return *static_cast<const TypedExp &>(exp).getType() ==
+               *static_cast<const TypedExp &>(pattern).getType();
+    }
+
+    return true;
+}
+
+
+void ExpPatternSet::collectMatches(int nodeIdx, const FlatExp &flat, std::size_t pos,
+                                   std::vector<int> &result) const
+{
+    const Node &node = m_nodes[nodeIdx];
+
+    if (pos == flat.nodes.size()) {
+        result.insert(result.end(), node.accepted.begin(), node.accepted.end());
+        return;
+    }
+
+    const Exp *exp = flat.nodes[pos];
+
+    for (const Edge &edge : node.edges) {
+        if (edge.skipSubtree) {
+            if (edge.oper == opWild || edge.oper == exp->getOper()) {
+                collectMatches(edge.target, flat, pos + flat.subtreeSizes[pos], result);
+            }
+        }
+        else if (nodeMatches(*exp, *edge.pattern)) {
+            collectMatches(edge.target, flat, pos + 1, result);
+        }
+    }
+}
@@ -0,0 +1,90 @@
+#pragma region License
+/*
+ * This file is part of the Boomerang Decompiler.
+ *
+ * See the file "LICENSE.TERMS" for information on usage and
+ * redistribution of this file, and for a DISCLAIMER OF ALL
+ * WARRANTIES.
+ */
+#pragma endregion License
+#pragma once
+
+
+#include "boomerang/core/BoomerangAPI.h"
+#include "boomerang/ssl/exp/Operator.h"
+
+#include <memory>
+#include <vector>
+
+
+class Exp;
+
+using SharedConstExp = std::shared_ptr<const Exp>;
+
+
+/**
+ * A set of wildcard patterns that is compiled into a discrimination tree,
+ * so that an expression can be matched against all patterns in a single pass.
+ *
+ * Matching follows the rules of Exp::operator*=: Subscripts are ignored,
+ * opWild matches any subexpression, opWildIntConst and opWildStrConst match any
+ * integer and string constant, and opWildMemOf, opWildRegOf and opWildAddrOf match
+ * any memof, regof and addrof subexpression, respectively.
+ */
+class BOOMERANG_API ExpPatternSet
+{
+public:
+    ExpPatternSet() = default;
+    ExpPatternSet(const std::initializer_list<SharedConstExp> &patterns);
+
+public:
+    /// Add \p pattern to the set.
+    /// \returns the ID of the pattern. IDs are assigned in insertion order, starting at 0.
+    int addPattern(const SharedConstExp &pattern);
+
+    /// \returns the number of patterns in this set.
+    int size() const { return static_cast<int>(m_patterns.size()); }
+
+    /// \returns the ID of the first pattern (in insertion order) matching \p exp,
+    /// or -1 if no pattern matches.
+    int findFirstMatch(const SharedConstExp &exp) const;
+
+    /// \returns the IDs of all patterns matching \p exp, in ascending order.
+    std::vector<int> findAllMatches(const SharedConstExp &exp) const;
+
+private:
+    /// An expression flattened in pre-order, with subscripts removed.
+    struct FlatExp
+    {
+        std::vector<const Exp *> nodes;
+        std::vector<int> subtreeSizes; ///< Number of nodes in the subtree rooted at each node
+    };
+
+    struct Edge
+    {
+        OPER oper;          ///< Operator of the subexpression; opWild to match any subexpression
+        bool skipSubtree;   ///< If true, the edge matches the whole subexpression
+        const Exp *pattern; ///< The pattern node of non-skipping edges
+        int target;         ///< Index of the target node
+    };
+
+    struct Node
+    {
+        std::vector<Edge> edges;
+        std::vector<int> accepted; ///< IDs of the patterns ending in this node
+    };
+
+private:
+    static void flatten(const Exp *exp, FlatExp &flat);
+
+    /// \returns true if the expression node \p exp matches the pattern node \p pattern,
+    /// not considering children.
+    static bool nodeMatches(const Exp &exp, const Exp &pattern);
+
+    void collectMatches(int nodeIdx, const FlatExp &flat, std::size_t pos,
+                        std::vector<int> &result) const;
+
+private:
+    std::vector<SharedConstExp> m_patterns; ///< Keeps the patterns referenced by edges alive
+    std::vector<Node> m_nodes = { Node() }; ///< Node 0 is the root of the discrimination tree
+};
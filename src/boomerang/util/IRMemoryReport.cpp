@@ -0,0 +1,318 @@
+#pragma region License
+/*
+ * This file is part of the Boomerang Decompiler.
+ *
+ * See the file "LICENSE.TERMS" for information on usage and
+ * redistribution of this file, and for a DISCLAIMER OF ALL
+ * WARRANTIES.
+ */
+#pragma endregion License
+#include "IRMemoryReport.h"
+
+#include "boomerang/db/Prog.h"
+#include "boomerang/db/module/Module.h"
+#include "boomerang/db/proc/UserProc.h"
+#include "boomerang/ssl/exp/Binary.h"
+#include "boomerang/ssl/exp/Const.h"
+#include "boomerang/ssl/exp/FlagDef.h"
+#include "boomerang/ssl/exp/Location.h"
+#include "boomerang/ssl/exp/RefExp.h"
+#include "boomerang/ssl/exp/Terminal.h"
+#include "boomerang/ssl/exp/Ternary.h"
+#include "boomerang/ssl/exp/TypedExp.h"
+#include "boomerang/ssl/statements/BoolAssign.h"
+#include "boomerang/ssl/statements/BranchStatement.h"
+#include "boomerang/ssl/statements/CallStatement.h"
+#include "boomerang/ssl/statements/CaseStatement.h"
+#include "boomerang/ssl/statements/ImplicitAssign.h"
+#include "boomerang/ssl/statements/PhiAssign.h"
+#include "boomerang/ssl/statements/ReturnStatement.h"
+#include "boomerang/util/OStream.h"
+#include "boomerang/util/StatementList.h"
+#include "boomerang/visitor/expvisitor/ExpVisitor.h"
+#include "boomerang/visitor/expvisitor/RawExpVisitor.h"
+#include "boomerang/visitor/stmtexpvisitor/StmtExpVisitor.h"
+
+
+/// Counts all nodes of an expression that have not been counted yet.
+class ExpMemoryCounter : public RawExpVisitor
+{
+public:
+    ExpMemoryCounter(std::map<QString, IRMemoryReport::Entry> &entries,
+                     std::unordered_set<const Exp *> &seen)
+        : m_entries(entries)
+        , m_seen(seen)
+    {
+    }
+
+public:
+    bool preVisit(const Unary &exp, bool &visitChildren) override
+    {
+        visitChildren = count(exp, "Unary", sizeof(Unary));
+        return true;
+    }
+
+    bool preVisit(const Binary &exp, bool &visitChildren) override
+    {
+        visitChildren = count(exp, "Binary", sizeof(Binary));
+        return true;
+    }
+
+    bool preVisit(const Ternary &exp, bool &visitChildren) override
+    {
+        visitChildren = count(exp, "Ternary", sizeof(Ternary));
+        return true;
+    }
+
+    bool preVisit(const TypedExp &exp, bool &visitChildren) override
+    {
+        visitChildren = count(exp, "TypedExp", sizeof(TypedExp));
+        return true;
+    }
+
+    bool preVisit(const FlagDef &exp, bool &visitChildren) override
+    {
+        visitChildren = count(exp, "FlagDef", sizeof(FlagDef));
+        return true;
+    }
+
+    bool preVisit(const RefExp &exp, bool &visitChildren) override
+    {
+        visitChildren = count(exp, "RefExp", sizeof(RefExp));
+        return true;
+    }
+
+    bool preVisit(const Location &exp, bool &visitChildren) override
+    {
+        visitChildren = count(exp, "Location", sizeof(Location));
+        return true;
+    }
+
+    bool visit(const Const &exp) override
+    {
+        count(exp, "Const", sizeof(Const) + exp.getOutOfLineSize());
+        return true;
+    }
+
+    bool visit(const Terminal &exp) override
+    {
+        count(exp, "Terminal", sizeof(Terminal));
+        return true;
+    }
+
+private:
+    /// \returns true if \p exp has not been counted before.
+    bool count(const Exp &exp, const char *kind, std::size_t bytes)
+    {
+        if (!m_seen.insert(&exp).second) {
+            return false;
+        }
+
+        IRMemoryReport::Entry &entry = m_entries[kind];
+        entry.count++;
+        entry.bytes += bytes;
+        return true;
+    }
+
+private:
+    std::map<QString, IRMemoryReport::Entry> &m_entries;
+    std::unordered_set<const Exp *> &m_seen;
+};
+
+
+/// Passes the top level expressions of a statement to an IRMemoryReport.
+class ExpMemoryForwarder : public ExpVisitor
+{
+public:
+    ExpMemoryForwarder(IRMemoryReport *report)
+        : m_report(report)
+    {
+    }
+
+public:
+    bool preVisit(const std::shared_ptr<Unary> &exp, bool &visitChildren) override
+    {
+        return forward(exp, visitChildren);
+    }
+
+    bool preVisit(const std::shared_ptr<Binary> &exp, bool &visitChildren) override
+    {
+        return forward(exp, visitChildren);
+    }
+
+    bool preVisit(const std::shared_ptr<Ternary> &exp, bool &visitChildren) override
+    {
+        return forward(exp, visitChildren);
+    }
+
+    bool preVisit(const std::shared_ptr<TypedExp> &exp, bool &visitChildren) override
+    {
+        return forward(exp, visitChildren);
+    }
+
+    bool preVisit(const std::shared_ptr<FlagDef> &exp, bool &visitChildren) override
+    {
+        return forward(exp, visitChildren);
+    }
+
+    bool preVisit(const std::shared_ptr<RefExp> &exp, bool &visitChildren) override
+    {
+        return forward(exp, visitChildren);
+    }
+
+    bool preVisit(const std::shared_ptr<Location> &exp, bool &visitChildren) override
+    {
+        return forward(exp, visitChildren);
+    }
+
+    bool visit(const std::shared_ptr<Const> &exp) override
+    {
+        m_report->addExp(exp);
+        return true;
+    }
+
+    bool visit(const std::shared_ptr<Terminal> &exp) override
+    {
+        m_report->addExp(exp);
+        return true;
+    }
+
+private:
+    bool forward(const SharedConstExp &exp, bool &visitChildren)
+    {
+        m_report->addExp(exp);
+        visitChildren = false; // already done by addExp
+        return true;
+    }
+
+private:
+    IRMemoryReport *m_report;
+};
+
+
+void IRMemoryReport::addProg(const Prog *prog)
+{
+    for (const auto &module : prog->getModuleList()) {
+        for (Function *func : *module) {
+            if (func->isLib()) {
+                continue;
+            }
+
+            UserProc *proc = static_cast<UserProc *>(func);
+            if (!proc->isDecoded()) {
+                continue;
+            }
+
+            StatementList stmts;
+            proc->getStatements(stmts);
+
+            for (Statement *stmt : stmts) {
+                addStatement(stmt);
+            }
+        }
+    }
+}
+
+
+void IRMemoryReport::addStatement(Statement *stmt)
+{
+    const char *kind  = nullptr;
+    std::size_t bytes = 0;
+
+    switch (stmt->getKind()) {
+    case StmtType::Assign: kind = "Assign"; bytes = sizeof(Assign); break;
+    case StmtType::PhiAssign: kind = "PhiAssign"; bytes = sizeof(PhiAssign); break;
+    case StmtType::ImpAssign: kind = "ImplicitAssign"; bytes = sizeof(ImplicitAssign); break;
+    case StmtType::BoolAssign: kind = "BoolAssign"; bytes = sizeof(BoolAssign); break;
+    case StmtType::Call: kind = "CallStatement"; bytes = sizeof(CallStatement); break;
+    case StmtType::Ret: kind = "ReturnStatement"; bytes = sizeof(ReturnStatement); break;
+    case StmtType::Branch: kind = "BranchStatement"; bytes = sizeof(BranchStatement); break;
+    case StmtType::Goto: kind = "GotoStatement"; bytes = sizeof(GotoStatement); break;
+    case StmtType::Case: kind = "CaseStatement"; bytes = sizeof(CaseStatement); break;
+    case StmtType::INVALID: return;
+    }
+
+    Entry &entry = m_stmtEntries[kind];
+    entry.count++;
+    entry.bytes += bytes;
+
+    // also count the expressions in the collectors of calls and returns
+    ExpMemoryForwarder forwarder(this);
+    StmtExpVisitor visitor(&forwarder, false);
+    stmt->accept(&visitor);
+}
+
+
+void IRMemoryReport::addExp(const SharedConstExp &exp)
+{
+    if (exp) {
+        ExpMemoryCounter counter(m_expEntries, m_seenExps);
+        exp->acceptVisitor(&counter);
+    }
+}
+
+
+IRMemoryReport::Entry IRMemoryReport::getEntry(const QString &kind) const
+{
+    auto it = m_stmtEntries.find(kind);
+    if (it != m_stmtEntries.end()) {
+        return it->second;
+    }
+
+    it = m_expEntries.find(kind);
+    return (it != m_expEntries.end()) ? it->second : Entry();
+}
+
+
+std::size_t IRMemoryReport::getNumStatements() const
+{
+    std::size_t result = 0;
+    for (const auto &entry : m_stmtEntries) {
+        result += entry.second.count;
+    }
+
+    return result;
+}
+
+
+std::size_t IRMemoryReport::getTotalBytes() const
+{
+    std::size_t result = 0;
+    for (const auto &entries : { &m_stmtEntries, &m_expEntries }) {
+        for (const auto &entry : *entries) {
+            result += entry.second.bytes;
+        }
+    }
+
+    return result;
+}
+
+
+void IRMemoryReport::print(OStream &os) const
+{
+    const auto printEntries = [&os](const std::map<QString, Entry> &entries) {
+        for (const auto &[kind, entry] : entries) {
+            os << QString("    %1 %2 %3\n")
+                      .arg(kind, -20)
+                      .arg(entry.count, 12)
+                      .arg(entry.bytes, 14);
+        }
+    };
+
+    os << QString("%1 %2 %3\n").arg("Node kind", -24).arg("Count", 12).arg("Bytes", 14);
+    os << "Statements:\n";
+    printEntries(m_stmtEntries);
+    os << "Expressions:\n";
+    printEntries(m_expEntries);
+
+    const std::size_t numStmts = getNumStatements();
+    const std::size_t total    = getTotalBytes();
+
+    os << QString("Total: %1 bytes for %2 statements").arg(total).arg(numStmts);
+    if (numStmts > 0) {
+        os << QString(" (%1 bytes per statement)").arg(static_cast<double>(total) / numStmts, 0,
+                                                         'f', 1);
+    }
+
+    os << "\n";
+}
@@ -0,0 +1,71 @@
+#pragma region License
+/*
+ * This file is part of the Boomerang Decompiler.
+ *
+ * See the file "LICENSE.TERMS" for information on usage and
+ * redistribution of this file, and for a DISCLAIMER OF ALL
+ * WARRANTIES.
+ */
+#pragma endregion License
+#pragma once
+
+
+#include "boomerang/ssl/exp/ExpHelp.h"
+
+#include <QString>
+
+#include <map>
+#include <unordered_set>
+
+
+class OStream;
+class Prog;
+class Statement;
+
+
+/**
+ * Measures the memory used by statements and expressions, broken down by node kind.
+ * Expression nodes shared by several statements or expressions are only counted once.
+ * Types and the containers holding statements (RTLs, BBs, collectors) are not counted.
+ */
+class BOOMERANG_API IRMemoryReport
+{
+public:
+    /// Memory used by all nodes of a single kind
+    struct Entry
+    {
+        std::size_t count = 0; ///< Number of nodes
+        std::size_t bytes = 0; ///< Total size of all nodes in bytes
+    };
+
+public:
+    IRMemoryReport() = default;
+
+public:
+    /// Add all statements of all decoded procedures of \p prog.
+    void addProg(const Prog *prog);
+
+    /// Add \p stmt and all expressions used by it.
+    void addStatement(Statement *stmt);
+
+    /// Add all nodes of \p exp that have not been added yet.
+    void addExp(const SharedConstExp &exp);
+
+    /// \returns the memory used by statements or expressions of kind \p kind,
+    /// e.g. "Assign" or "Const".
+    Entry getEntry(const QString &kind) const;
+
+    /// \returns the number of statements added so far.
+    std::size_t getNumStatements() const;
+
+    /// \returns the number of bytes used by all statements and expressions added so far.
+    std::size_t getTotalBytes() const;
+
+    /// Print the memory used by each node kind and the average memory used per statement.
+    void print(OStream &os) const;
+
+private:
+    std::map<QString, Entry> m_stmtEntries;
+    std::map<QString, Entry> m_expEntries;
+    std::unordered_set<const Exp *> m_seenExps;
+};
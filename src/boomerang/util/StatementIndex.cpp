@@ -0,0 +1,47 @@
+#pragma region License
+/*
+ * This file is part of the Boomerang Decompiler.
+ *
+ * See the file "LICENSE.TERMS" for information on usage and
+ * redistribution of this file, and for a DISCLAIMER OF ALL
+ * WARRANTIES.
+ */
+#pragma endregion License
+#include "StatementIndex.h"
+
+#include "boomerang/ssl/statements/Statement.h"
+#include "boomerang/util/Util.h"
+
+#include <algorithm>
+
+
+StatementIndex::StatementIndex(std::vector<Statement *> stmts)
+    : m_stmts(std::move(stmts))
+{
+    int maxNumber = 0;
+
+    for (const Statement *stmt : m_stmts) {
+        maxNumber = std::max(maxNumber, stmt->getNumber());
+    }
+
+    m_byNumber.resize(maxNumber + 1, nullptr);
+
+    for (Statement *stmt : m_stmts) {
+        const int number = stmt->getNumber();
+
+        // statements that have not been numbered yet have number 0
+        if (number > 0 && m_byNumber[number] == nullptr) {
+            m_byNumber[number] = stmt;
+        }
+    }
+}
+
+
+Statement *StatementIndex::findByNumber(int number) const
+{
+    if (!Util::inRange(number, 1, static_cast<int>(m_byNumber.size()))) {
+        return nullptr;
+    }
+
+    return m_byNumber[number];
+}
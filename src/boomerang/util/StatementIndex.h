@@ -0,0 +1,52 @@
+#pragma region License
+/*
+ * This file is part of the Boomerang Decompiler.
+ *
+ * See the file "LICENSE.TERMS" for information on usage and
+ * redistribution of this file, and for a DISCLAIMER OF ALL
+ * WARRANTIES.
+ */
+#pragma endregion License
+#pragma once
+
+
+#include "boomerang/core/BoomerangAPI.h"
+
+#include <vector>
+
+
+class Statement;
+
+
+/**
+ * A non-owning, immutable index of all statements of a procedure.
+ * Holds the statements in CFG order and maps statement numbers to statements.
+ * \sa UserProc::getStatementIndex
+ */
+class BOOMERANG_API StatementIndex
+{
+    typedef std::vector<Statement *> StmtVec;
+
+public:
+    typedef StmtVec::size_type size_type;
+    typedef StmtVec::const_iterator const_iterator;
+
+public:
+    /// \param stmts all statements in CFG order
+    explicit StatementIndex(std::vector<Statement *> stmts);
+
+public:
+    const_iterator begin() const { return m_stmts.begin(); }
+    const_iterator end() const { return m_stmts.end(); }
+
+    bool empty() const { return m_stmts.empty(); }
+    size_type size() const { return m_stmts.size(); }
+
+    /// \returns the statement with number \p number, or nullptr if there is no such statement.
+    /// If several statements have the same number, the first one is returned.
+    Statement *findByNumber(int number) const;
+
+private:
+    StmtVec m_stmts;    ///< All statements in CFG order
+    StmtVec m_byNumber; ///< Maps statement number -> statement
+};
@@ -135,14 +135,14 @@ public:
     /// Find a definition for \p loc on the LHS of each assignment in this set.
     /// If found, return pointer to the Assign with that LHS (else return nullptr)
     template<typename = std::enable_if<std::is_base_of<Assign, T>::value>>
-    Assign *lookupLoc(SharedExp loc)
+    Assign *lookupLoc(SharedExp loc) const
     {
         if (!loc) {
             return nullptr;
         }
 
         Assign as(loc, Terminal::get(opWild));
-        iterator ff = m_set.find(&as);
+        const_iterator ff = m_set.find(&as);
 
         return (ff != end()) ? *ff : nullptr;
     }
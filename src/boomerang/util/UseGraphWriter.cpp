@@ -32,10 +32,9 @@ void UseGraphWriter::writeUseGraph(const UserProc *proc, const QString &filePath
 
     OStream out(&file);
     out << "digraph " << proc->getName() << " {\n";
-    StatementList stmts;
-    proc->getStatements(stmts);
+    const auto stmts = proc->getStatementIndex();
 
-    for (Statement *s : stmts) {
+    for (Statement *s : *stmts) {
         if (s->isPhi()) {
             out << s->getNumber() << " [shape=diamond];\n";
         }
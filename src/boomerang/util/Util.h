@@ -52,6 +52,13 @@ bool isContained(const Cont &cont, const T &value)
 }
 
 
+/// Combine the hash value \p hash into \p seed.
+inline void hashCombine(std::size_t &seed, std::size_t hash)
+{
+    seed ^= hash + 0x9e3779b9 + (seed << 6) + (seed >> 2);
+}
+
+
 template<class Container>
 void clone(const Container &from, Container &to)
 {
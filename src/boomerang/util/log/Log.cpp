@@ -104,12 +104,12 @@ void Log::addLogSink(std::unique_ptr<ILogSink> s)
 }
 
 
-void Log::addDefaultLogSinks(const QString &outputDir)
+void Log::addDefaultLogSinks(const QString &outputDir, bool append)
 {
     addLogSink(std::make_unique<ConsoleLogSink>());
 
     QFileInfo fi(QDir(outputDir), "boomerang.log");
-    addLogSink(std::make_unique<FileLogSink>(fi.absoluteFilePath()));
+    addLogSink(std::make_unique<FileLogSink>(fi.absoluteFilePath(), append));
 
     writeLogHeader();
 }
@@ -108,7 +108,10 @@ public:
 
     /// Add a log sink / target. Takes ownership of the pointer.
     void addLogSink(std::unique_ptr<ILogSink> s);
-    void addDefaultLogSinks(const QString &outputDir);
+
+    /// Log to the console and to boomerang.log in \p outputDir.
+    /// If \p append is true, an existing log file is continued instead of truncated.
+    void addDefaultLogSinks(const QString &outputDir, bool append = false);
 
     void removeAllSinks();
 
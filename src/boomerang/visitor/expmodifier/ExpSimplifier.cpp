@@ -485,8 +485,15 @@ SharedExp ExpSimplifier::postModify(const std::shared_ptr<Binary> &exp)
 
     // For (a || b) or (a && b) recurse on a and b
     if ((exp->getOper() == opOr) || (exp->getOper() == opAnd)) {
-        exp->refSubExp1() = exp->getSubExp1()->acceptModifier(this);
-        exp->refSubExp2() = exp->getSubExp2()->acceptModifier(this);
+        // Operands that are already simplified (e.g. by Exp::simplify) are not touched
+        // so they are not marked as modified again
+        if (!exp->getSubExp1()->isSimplified()) {
+            exp->setSubExp1(exp->getSubExp1()->acceptModifier(this));
+        }
+
+        if (!exp->getSubExp2()->isSimplified()) {
+            exp->setSubExp2(exp->getSubExp2()->acceptModifier(this));
+        }
 
         if (!m_modified && *exp->getSubExp1() == *exp->getSubExp2()) {
             m_modified = true;
@@ -23,6 +23,9 @@
  *  - Replacing left/right shift by multiplication/division
  *
  * Read the code and the tests for full details.
+ *
+ * The rules for an expression assume that all its subexpressions have already been simplified,
+ * so this modifier should only be used via Exp::simplify, which applies the rules bottom-up.
  * \sa Exp::simplify
  */
 class ExpSimplifier : public ExpModifier
@@ -19,9 +19,9 @@ BadMemofFinder::BadMemofFinder()
 }
 
 
-bool BadMemofFinder::preVisit(const std::shared_ptr<Location> &exp, bool &visitChildren)
+bool BadMemofFinder::preVisit(const Location &exp, bool &visitChildren)
 {
-    if (exp->isMemOf()) {
+    if (exp.isMemOf()) {
         m_found = true; // A bare memof
         return false;
     }
@@ -31,14 +31,13 @@ bool BadMemofFinder::preVisit(const std::shared_ptr<Location> &exp, bool &visitC
 }
 
 
-bool BadMemofFinder::preVisit(const std::shared_ptr<RefExp> &exp, bool &visitChildren)
+bool BadMemofFinder::preVisit(const RefExp &exp, bool &visitChildren)
 {
-    SharedExp base = exp->getSubExp1();
+    SharedConstExp base = exp.getSubExp1();
 
     if (base->isMemOf()) {
         // Beware: it may be possible to have a bad memof inside a subscripted one
-        SharedExp addr = base->getSubExp1();
-        addr->acceptVisitor(this);
+        base->getSubExp1()->acceptVisitor(this);
 
         if (m_found) {
             return false; // Don't continue searching
@@ -10,7 +10,7 @@
 #pragma once
 
 
-#include "boomerang/visitor/expvisitor/ExpVisitor.h"
+#include "boomerang/visitor/expvisitor/RawExpVisitor.h"
 
 
 class UserProc;
@@ -20,7 +20,7 @@ class UserProc;
  * Search an expression for a bad memof
  * (non subscripted or not linked with a symbol, i.e. local or parameter)
  */
-class BadMemofFinder : public ExpVisitor
+class BadMemofFinder : public RawExpVisitor
 {
 public:
     BadMemofFinder();
@@ -30,11 +30,11 @@ public:
     bool isFound() { return m_found; }
 
 public:
-    /// \copydoc ExpVisitor::preVisit
-    virtual bool preVisit(const std::shared_ptr<Location> &exp, bool &visitChildren) override;
+    /// \copydoc RawExpVisitor::preVisit
+    virtual bool preVisit(const Location &exp, bool &visitChildren) override;
 
-    /// \copydoc ExpVisitor::preVisit
-    virtual bool preVisit(const std::shared_ptr<RefExp> &exp, bool &visitChildren) override;
+    /// \copydoc RawExpVisitor::preVisit
+    virtual bool preVisit(const RefExp &exp, bool &visitChildren) override;
 
 private:
     bool m_found;
@@ -19,15 +19,15 @@ ComplexityFinder::ComplexityFinder(UserProc *proc)
 }
 
 
-bool ComplexityFinder::preVisit(const std::shared_ptr<Location> &exp, bool &visitChildren)
+bool ComplexityFinder::preVisit(const Location &exp, bool &visitChildren)
 {
-    if (m_proc && (m_proc->findFirstSymbol(exp) != nullptr)) {
+    if (m_proc && !m_proc->findFirstSymbol(exp.shared_from_this()).isEmpty()) {
         // This is mapped to a local. Count it as zero, not about 3 (m[r28+4] -> memof, regof, plus)
         visitChildren = false;
         return true;
     }
 
-    if (exp->isMemOf() || exp->isArrayIndex()) {
+    if (exp.isMemOf() || exp.isArrayIndex()) {
         m_count++; // Count the more complex unaries
     }
 
@@ -36,7 +36,7 @@ bool ComplexityFinder::preVisit(const std::shared_ptr<Location> &exp, bool &visi
 }
 
 
-bool ComplexityFinder::preVisit(const std::shared_ptr<Unary> & /*exp*/, bool &visitChildren)
+bool ComplexityFinder::preVisit(const Unary & /*exp*/, bool &visitChildren)
 {
     m_count++;
 
@@ -45,7 +45,7 @@ bool ComplexityFinder::preVisit(const std::shared_ptr<Unary> & /*exp*/, bool &vi
 }
 
 
-bool ComplexityFinder::preVisit(const std::shared_ptr<Binary> & /*exp*/, bool &visitChildren)
+bool ComplexityFinder::preVisit(const Binary & /*exp*/, bool &visitChildren)
 {
     m_count++;
     visitChildren = true;
@@ -53,7 +53,7 @@ bool ComplexityFinder::preVisit(const std::shared_ptr<Binary> & /*exp*/, bool &v
 }
 
 
-bool ComplexityFinder::preVisit(const std::shared_ptr<Ternary> & /*exp*/, bool &visitChildren)
+bool ComplexityFinder::preVisit(const Ternary & /*exp*/, bool &visitChildren)
 {
     m_count++;
     visitChildren = true;
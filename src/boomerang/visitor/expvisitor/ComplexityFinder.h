@@ -10,7 +10,7 @@
 #pragma once
 
 
-#include "boomerang/visitor/expvisitor/ExpVisitor.h"
+#include "boomerang/visitor/expvisitor/RawExpVisitor.h"
 
 
 class UserProc;
@@ -19,7 +19,7 @@ class UserProc;
 /**
  *
  */
-class ComplexityFinder : public ExpVisitor
+class ComplexityFinder : public RawExpVisitor
 {
 public:
     ComplexityFinder(UserProc *proc);
@@ -28,17 +28,17 @@ public:
 public:
     int getDepth() { return m_count; }
 
-    /// \copydoc ExpVisitor::preVisit
-    virtual bool preVisit(const std::shared_ptr<Unary> &exp, bool &visitChildren) override;
+    /// \copydoc RawExpVisitor::preVisit
+    virtual bool preVisit(const Unary &exp, bool &visitChildren) override;
 
-    /// \copydoc ExpVisitor::preVisit
-    virtual bool preVisit(const std::shared_ptr<Binary> &exp, bool &visitChildren) override;
+    /// \copydoc RawExpVisitor::preVisit
+    virtual bool preVisit(const Binary &exp, bool &visitChildren) override;
 
-    /// \copydoc ExpVisitor::preVisit
-    virtual bool preVisit(const std::shared_ptr<Ternary> &exp, bool &visitChildren) override;
+    /// \copydoc RawExpVisitor::preVisit
+    virtual bool preVisit(const Ternary &exp, bool &visitChildren) override;
 
-    /// \copydoc ExpVisitor::preVisit
-    virtual bool preVisit(const std::shared_ptr<Location> &exp, bool &visitChildren) override;
+    /// \copydoc RawExpVisitor::preVisit
+    virtual bool preVisit(const Location &exp, bool &visitChildren) override;
 
 private:
     int m_count = 0;
@@ -23,7 +23,7 @@
 class ExpDestCounter : public ExpVisitor
 {
 public:
-    typedef std::map<SharedExp, int, lessExpStar> ExpCountMap;
+    typedef ExpHashMap<int> ExpCountMap;
 
 public:
     ExpDestCounter(ExpCountMap &dc);
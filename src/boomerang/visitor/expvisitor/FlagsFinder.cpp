@@ -18,9 +18,9 @@ FlagsFinder::FlagsFinder()
 }
 
 
-bool FlagsFinder::preVisit(const std::shared_ptr<Binary> &e, bool &visitChildren)
+bool FlagsFinder::preVisit(const Binary &e, bool &visitChildren)
 {
-    if (e->isFlagCall()) {
+    if (e.isFlagCall()) {
         m_found = true;
         return false; // Don't continue searching
     }
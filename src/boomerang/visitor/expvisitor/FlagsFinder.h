@@ -10,13 +10,13 @@
 #pragma once
 
 
-#include "boomerang/visitor/expvisitor/ExpVisitor.h"
+#include "boomerang/visitor/expvisitor/RawExpVisitor.h"
 
 
 /**
  * Search an expression for flags calls, e.g. SETFFLAGS(...) & 0x45
  */
-class BOOMERANG_API FlagsFinder : public ExpVisitor
+class BOOMERANG_API FlagsFinder : public RawExpVisitor
 {
 public:
     FlagsFinder();
@@ -25,8 +25,8 @@ public:
 public:
     bool isFound() { return m_found; }
 
-    /// \copydoc ExpVisitor::preVisit
-    virtual bool preVisit(const std::shared_ptr<Binary> &exp, bool &visitChildren) override;
+    /// \copydoc RawExpVisitor::preVisit
+    virtual bool preVisit(const Binary &exp, bool &visitChildren) override;
 
 private:
     bool m_found;
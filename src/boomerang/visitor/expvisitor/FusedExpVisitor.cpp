@@ -0,0 +1,190 @@
+#pragma region License
+/*
+ * This file is part of the Boomerang Decompiler.
+ *
+ * See the file "LICENSE.TERMS" for information on usage and
+ * redistribution of this file, and for a DISCLAIMER OF ALL
+ * WARRANTIES.
+ */
+#pragma endregion License
+#include "FusedExpVisitor.h"
+
+#include "boomerang/ssl/exp/Binary.h"
+#include "boomerang/ssl/exp/Const.h"
+#include "boomerang/ssl/exp/FlagDef.h"
+#include "boomerang/ssl/exp/Location.h"
+#include "boomerang/ssl/exp/RefExp.h"
+#include "boomerang/ssl/exp/Terminal.h"
+#include "boomerang/ssl/exp/Ternary.h"
+#include "boomerang/ssl/exp/TypedExp.h"
+
+
+FusedExpVisitor::FusedExpVisitor(const std::initializer_list<RawExpVisitor *> &visitors)
+    : m_visitors(visitors)
+    , m_aborted(visitors.size(), false)
+    , m_suspendedAt(visitors.size(), -1)
+{
+}
+
+
+bool FusedExpVisitor::preVisit(const Unary &exp, bool &visitChildren)
+{
+    return doPreVisit(exp, visitChildren);
+}
+
+
+bool FusedExpVisitor::postVisit(const Unary &exp)
+{
+    return doPostVisit(exp);
+}
+
+
+bool FusedExpVisitor::preVisit(const Binary &exp, bool &visitChildren)
+{
+    return doPreVisit(exp, visitChildren);
+}
+
+
+bool FusedExpVisitor::postVisit(const Binary &exp)
+{
+    return doPostVisit(exp);
+}
+
+
+bool FusedExpVisitor::preVisit(const Ternary &exp, bool &visitChildren)
+{
+    return doPreVisit(exp, visitChildren);
+}
+
+
+bool FusedExpVisitor::postVisit(const Ternary &exp)
+{
+    return doPostVisit(exp);
+}
+
+
+bool FusedExpVisitor::preVisit(const TypedExp &exp, bool &visitChildren)
+{
+    return doPreVisit(exp, visitChildren);
+}
+
+
+bool FusedExpVisitor::postVisit(const TypedExp &exp)
+{
+    return doPostVisit(exp);
+}
+
+
+bool FusedExpVisitor::preVisit(const FlagDef &exp, bool &visitChildren)
+{
+    return doPreVisit(exp, visitChildren);
+}
+
+
+bool FusedExpVisitor::postVisit(const FlagDef &exp)
+{
+    return doPostVisit(exp);
+}
+
+
+bool FusedExpVisitor::preVisit(const RefExp &exp, bool &visitChildren)
+{
+    return doPreVisit(exp, visitChildren);
+}
+
+
+bool FusedExpVisitor::postVisit(const RefExp &exp)
+{
+    return doPostVisit(exp);
+}
+
+
+bool FusedExpVisitor::preVisit(const Location &exp, bool &visitChildren)
+{
+    return doPreVisit(exp, visitChildren);
+}
+
+
+bool FusedExpVisitor::postVisit(const Location &exp)
+{
+    return doPostVisit(exp);
+}
+
+
+bool FusedExpVisitor::visit(const Const &exp)
+{
+    return doVisit(exp);
+}
+
+
+bool FusedExpVisitor::visit(const Terminal &exp)
+{
+    return doVisit(exp);
+}
+
+
+template<class T>
+bool FusedExpVisitor::doPreVisit(const T &exp, bool &visitChildren)
+{
+    m_depth++;
+    visitChildren = false;
+
+    for (std::size_t i = 0; i < m_visitors.size(); i++) {
+        if (!isActive(i)) {
+            continue;
+        }
+
+        bool visitorWantsChildren = true;
+        if (!m_visitors[i]->preVisit(exp, visitorWantsChildren)) {
+            m_aborted[i] = true;
+            m_numAborted++;
+        }
+        else if (!visitorWantsChildren) {
+            m_suspendedAt[i] = m_depth; // resumed in the corresponding postVisit
+        }
+        else {
+            visitChildren = true;
+        }
+    }
+
+    return m_numAborted < static_cast<int>(m_visitors.size());
+}
+
+
+template<class T>
+bool FusedExpVisitor::doPostVisit(const T &exp)
+{
+    for (std::size_t i = 0; i < m_visitors.size(); i++) {
+        if (m_aborted[i]) {
+            continue;
+        }
+        else if (m_suspendedAt[i] == m_depth) {
+            m_suspendedAt[i] = -1;
+        }
+        else if (m_suspendedAt[i] != -1) {
+            continue; // children of an ancestor are skipped
+        }
+
+        if (!m_visitors[i]->postVisit(exp)) {
+            m_aborted[i] = true;
+            m_numAborted++;
+        }
+    }
+
+    m_depth--;
+    return m_numAborted < static_cast<int>(m_visitors.size());
+}
+
+
+template<class T>
+bool FusedExpVisitor::doVisit(const T &exp)
+{
+    for (std::size_t i = 0; i < m_visitors.size(); i++) {
+        if (isActive(i) && !m_visitors[i]->visit(exp)) {
+            m_aborted[i] = true;
+            m_numAborted++;
+        }
+    }
+
+    return m_numAborted < static_cast<int>(m_visitors.size());
+}
@@ -0,0 +1,85 @@
+#pragma region License
+/*
+ * This file is part of the Boomerang Decompiler.
+ *
+ * See the file "LICENSE.TERMS" for information on usage and
+ * redistribution of this file, and for a DISCLAIMER OF ALL
+ * WARRANTIES.
+ */
+#pragma endregion License
+#pragma once
+
+
+#include "boomerang/visitor/expvisitor/RawExpVisitor.h"
+
+#include <vector>
+
+
+/**
+ * Runs several RawExpVisitors in a single traversal of an expression.
+ * Every visitor sees exactly the calls it would see when visiting the expression on its own:
+ * If a visitor does not want to visit the children of an expression, it is suspended
+ * until its postVisit for that expression; if a visitor aborts the visitation,
+ * it does not receive any more calls. The traversal ends early when all visitors aborted.
+ */
+class BOOMERANG_API FusedExpVisitor : public RawExpVisitor
+{
+public:
+    FusedExpVisitor(const std::initializer_list<RawExpVisitor *> &visitors);
+    virtual ~FusedExpVisitor() = default;
+
+public:
+    /// \copydoc RawExpVisitor::preVisit
+    bool preVisit(const Unary &exp, bool &visitChildren) override;
+    /// \copydoc RawExpVisitor::preVisit
+    bool preVisit(const Binary &exp, bool &visitChildren) override;
+    /// \copydoc RawExpVisitor::preVisit
+    bool preVisit(const Ternary &exp, bool &visitChildren) override;
+    /// \copydoc RawExpVisitor::preVisit
+    bool preVisit(const TypedExp &exp, bool &visitChildren) override;
+    /// \copydoc RawExpVisitor::preVisit
+    bool preVisit(const FlagDef &exp, bool &visitChildren) override;
+    /// \copydoc RawExpVisitor::preVisit
+    bool preVisit(const RefExp &exp, bool &visitChildren) override;
+    /// \copydoc RawExpVisitor::preVisit
+    bool preVisit(const Location &exp, bool &visitChildren) override;
+
+    /// \copydoc RawExpVisitor::postVisit
+    bool postVisit(const Unary &exp) override;
+    /// \copydoc RawExpVisitor::postVisit
+    bool postVisit(const Binary &exp) override;
+    /// \copydoc RawExpVisitor::postVisit
+    bool postVisit(const Ternary &exp) override;
+    /// \copydoc RawExpVisitor::postVisit
+    bool postVisit(const TypedExp &exp) override;
+    /// \copydoc RawExpVisitor::postVisit
+    bool postVisit(const FlagDef &exp) override;
+    /// \copydoc RawExpVisitor::postVisit
+    bool postVisit(const RefExp &exp) override;
+    /// \copydoc RawExpVisitor::postVisit
+    bool postVisit(const Location &exp) override;
+
+    /// \copydoc RawExpVisitor::visit
+    bool visit(const Const &exp) override;
+    /// \copydoc RawExpVisitor::visit
+    bool visit(const Terminal &exp) override;
+
+private:
+    template<class T>
+    bool doPreVisit(const T &exp, bool &visitChildren);
+
+    template<class T>
+    bool doPostVisit(const T &exp);
+
+    template<class T>
+    bool doVisit(const T &exp);
+
+    bool isActive(std::size_t i) const { return !m_aborted[i] && m_suspendedAt[i] == -1; }
+
+private:
+    std::vector<RawExpVisitor *> m_visitors;
+    std::vector<bool> m_aborted;    ///< Visitors that aborted the visitation
+    std::vector<int> m_suspendedAt; ///< Depth at which the visitor skips the children, or -1
+    int m_depth      = 0;           ///< Number of compound expressions currently being visited
+    int m_numAborted = 0;
+};
@@ -18,9 +18,9 @@ MemDepthFinder::MemDepthFinder()
 }
 
 
-bool MemDepthFinder::preVisit(const std::shared_ptr<Location> &e, bool &visitChildren)
+bool MemDepthFinder::preVisit(const Location &e, bool &visitChildren)
 {
-    if (e->isMemOf()) {
+    if (e.isMemOf()) {
         ++depth;
     }
 
@@ -10,19 +10,19 @@
 #pragma once
 
 
-#include "boomerang/visitor/expvisitor/ExpVisitor.h"
+#include "boomerang/visitor/expvisitor/RawExpVisitor.h"
 
 
 /// Used by range analysis
-class MemDepthFinder : public ExpVisitor
+class MemDepthFinder : public RawExpVisitor
 {
 public:
     MemDepthFinder();
     virtual ~MemDepthFinder() = default;
 
 public:
-    /// \copydoc ExpVisitor::preVisit
-    virtual bool preVisit(const std::shared_ptr<Location> &exp, bool &visitChildren) override;
+    /// \copydoc RawExpVisitor::preVisit
+    virtual bool preVisit(const Location &exp, bool &visitChildren) override;
 
     int getDepth() { return depth; }
 
@@ -0,0 +1,113 @@
+#pragma region License
+/*
+ * This file is part of the Boomerang Decompiler.
+ *
+ * See the file "LICENSE.TERMS" for information on usage and
+ * redistribution of this file, and for a DISCLAIMER OF ALL
+ * WARRANTIES.
+ */
+#pragma endregion License
+#include "RawExpVisitor.h"
+
+
+bool RawExpVisitor::preVisit(const Unary &, bool &visitChildren)
+{
+    visitChildren = true;
+    return true;
+}
+
+
+bool RawExpVisitor::postVisit(const Unary &)
+{
+    return true;
+}
+
+
+bool RawExpVisitor::preVisit(const Binary &, bool &visitChildren)
+{
+    visitChildren = true;
+    return true;
+}
+
+
+bool RawExpVisitor::postVisit(const Binary &)
+{
+    return true;
+}
+
+
+bool RawExpVisitor::preVisit(const Ternary &, bool &visitChildren)
+{
+    visitChildren = true;
+    return true;
+}
+
+
+bool RawExpVisitor::postVisit(const Ternary &)
+{
+    return true;
+}
+
+
+bool RawExpVisitor::preVisit(const TypedExp &, bool &visitChildren)
+{
+    visitChildren = true;
+    return true;
+}
+
+
+bool RawExpVisitor::postVisit(const TypedExp &)
+{
+    return true;
+}
+
+
+bool RawExpVisitor::preVisit(const FlagDef &, bool &visitChildren)
+{
+    visitChildren = true;
+    return true;
+}
+
+
+bool RawExpVisitor::postVisit(const FlagDef &)
+{
+    return true;
+}
+
+
+bool RawExpVisitor::preVisit(const RefExp &, bool &visitChildren)
+{
+    visitChildren = true;
+    return true;
+}
+
+
+bool RawExpVisitor::postVisit(const RefExp &)
+{
+    return true;
+}
+
+
+bool RawExpVisitor::preVisit(const Location &, bool &visitChildren)
+{
+    visitChildren = true;
+    return true;
+}
+
+
+bool RawExpVisitor::postVisit(const Location &)
+{
+    return true;
+}
+
+
+bool RawExpVisitor::visit(const Const &)
+{
+    return true;
+}
+
+
+bool RawExpVisitor::visit(const Terminal &)
+{
+    return true;
+}
@@ -0,0 +1,93 @@
+#pragma region License
+/*
+ * This file is part of the Boomerang Decompiler.
+ *
+ * See the file "LICENSE.TERMS" for information on usage and
+ * redistribution of this file, and for a DISCLAIMER OF ALL
+ * WARRANTIES.
+ */
+#pragma endregion License
+#pragma once
+
+
+#include "boomerang/core/BoomerangAPI.h"
+
+
+class Unary;
+class Binary;
+class Ternary;
+class TypedExp;
+class FlagDef;
+class RefExp;
+class Location;
+class Const;
+class Terminal;
+
+
+/**
+ * Like ExpVisitor, but visits expressions by reference instead of by shared pointer.
+ * Since no shared pointers are created for the visited nodes, this is the cheaper choice
+ * for visitors that only inspect expressions. Visitors that need to keep references
+ * to the visited expressions can still call shared_from_this() for the nodes they keep.
+ */
+class BOOMERANG_API RawExpVisitor
+{
+public:
+    RawExpVisitor()          = default;
+    virtual ~RawExpVisitor() = default;
+
+public:
+    /**
+     * Visit the expression before all subexpressions.
+     * The default behaviour is to visit all expressions and all children.
+     *
+     * \param exp the expression to evaluate
+     * \param visitChildren if true, also visit the children of \p exp.
+     *
+     * \retval true  to continue visiting
+     * \retval false to abort visitation immediately.
+     */
+    virtual bool preVisit(const Unary &exp, bool &visitChildren);
+    /// \copydoc RawExpVisitor::preVisit
+    virtual bool preVisit(const Binary &exp, bool &visitChildren);
+    /// \copydoc RawExpVisitor::preVisit
+    virtual bool preVisit(const Ternary &exp, bool &visitChildren);
+    /// \copydoc RawExpVisitor::preVisit
+    virtual bool preVisit(const TypedExp &exp, bool &visitChildren);
+    /// \copydoc RawExpVisitor::preVisit
+    virtual bool preVisit(const FlagDef &exp, bool &visitChildren);
+    /// \copydoc RawExpVisitor::preVisit
+    virtual bool preVisit(const RefExp &exp, bool &visitChildren);
+    /// \copydoc RawExpVisitor::preVisit
+    virtual bool preVisit(const Location &exp, bool &visitChildren);
+
+    /**
+     * Visit the expression after all subexpressions.
+     * \param exp expression to evaluate
+     * \retval true  to continue visiting
+     * \retval false to abort visitation immedately.
+     */
+    virtual bool postVisit(const Unary &exp);
+    /// \copydoc RawExpVisitor::postVisit
+    virtual bool postVisit(const Binary &exp);
+    /// \copydoc RawExpVisitor::postVisit
+    virtual bool postVisit(const Ternary &exp);
+    /// \copydoc RawExpVisitor::postVisit
+    virtual bool postVisit(const TypedExp &exp);
+    /// \copydoc RawExpVisitor::postVisit
+    virtual bool postVisit(const FlagDef &exp);
+    /// \copydoc RawExpVisitor::postVisit
+    virtual bool postVisit(const RefExp &exp);
+    /// \copydoc RawExpVisitor::postVisit
+    virtual bool postVisit(const Location &exp);
+
+    /// Visit this Const.
+    /// \retval true  to continue visiting parent and sibling expressions.
+    /// \retval false to abort visitation immediately.
+    virtual bool visit(const Const &exp);
+
+    /// Visit this Terminal expression.
+    /// \retval true  to continue visiting parent and sibling expressions.
+    /// \retval false to abort visitation immediately.
+    virtual bool visit(const Terminal &exp);
+};
@@ -14,11 +14,14 @@
 #include "boomerang/util/LocationSet.h"
 #include "boomerang/util/log/Log.h"
 
+#include <QStandardPaths>
+
 
 TestProject::TestProject()
 {
     getSettings()->setDataDirectory(BOOMERANG_TEST_BASE "share/boomerang/");
     getSettings()->setPluginDirectory(BOOMERANG_TEST_BASE "lib/boomerang/plugins/");
+    getSettings()->setCacheDirectory(m_cacheDir.path());
 }
 
 
@@ -26,6 +29,9 @@ void BoomerangTest::initTestCase()
 {
     Log::getOrCreateLog();
 
+    // Projects created by the tests must not write into the cache directory of the user
+    QStandardPaths::setTestModeEnabled(true);
+
     qRegisterMetaType<SharedTypeWrapper>();
     qRegisterMetaType<SharedExpWrapper>();
 }
@@ -14,6 +14,7 @@
 #include "boomerang/ssl/type/Type.h"
 #include "boomerang/ssl/exp/Exp.h"
 
+#include <QTemporaryDir>
 #include <QTest>
 
 
@@ -24,6 +25,9 @@ class TestProject : public Project
 {
 public:
     TestProject();
+
+private:
+    QTemporaryDir m_cacheDir; ///< Keeps cache files out of the cache directory of the user
 };
 
 
@@ -0,0 +1,150 @@
+#pragma region License
+/*
+ * This file is part of the Boomerang Decompiler.
+ *
+ * See the file "LICENSE.TERMS" for information on usage and
+ * redistribution of this file, and for a DISCLAIMER OF ALL
+ * WARRANTIES.
+ */
+#pragma endregion License
+#include "ControlFlowAnalyzerTest.h"
+
+
+#include "boomerang/codegen/ControlFlowAnalyzer.h"
+#include "boomerang/db/BasicBlock.h"
+#include "boomerang/db/proc/ProcCFG.h"
+#include "boomerang/db/proc/UserProc.h"
+#include "boomerang/ssl/RTL.h"
+#include "boomerang/ssl/exp/Terminal.h"
+#include "boomerang/ssl/statements/Assign.h"
+#include "boomerang/ssl/type/VoidType.h"
+
+
+static BasicBlock *createBB(ProcCFG *cfg, BBType bbType, Address addr)
+{
+    std::unique_ptr<RTLList> rtls(new RTLList);
+    rtls->push_back(std::unique_ptr<RTL>(
+        new RTL(addr, { new Assign(VoidType::get(), Terminal::get(opNil), Terminal::get(opNil)) })));
+
+    return cfg->createBB(bbType, std::move(rtls));
+}
+
+
+void ControlFlowAnalyzerTest::testIfThenElse()
+{
+    UserProc proc(Address(0x1000), "test", nullptr);
+    ProcCFG *cfg = proc.getCFG();
+
+    BasicBlock *cond   = createBB(cfg, BBType::Twoway, Address(0x1000));
+    BasicBlock *thenBB = createBB(cfg, BBType::Oneway, Address(0x1100));
+    BasicBlock *elseBB = createBB(cfg, BBType::Oneway, Address(0x1200));
+    BasicBlock *ret    = createBB(cfg, BBType::Ret, Address(0x1300));
+
+    cfg->addEdge(cond, thenBB);
+    cfg->addEdge(cond, elseBB);
+    cfg->addEdge(thenBB, ret);
+    cfg->addEdge(elseBB, ret);
+    proc.setEntryBB();
+
+    ControlFlowAnalyzer cfa;
+    cfa.structureCFG(cfg);
+
+    QVERIFY(cfa.getCondFollow(cond) == ret);
+    QVERIFY(cfa.getStructType(cond) == StructType::Cond);
+    QVERIFY(cfa.getCondType(cond) == CondType::IfThenElse);
+    QVERIFY(cfa.getLoopHead(thenBB) == nullptr);
+    QVERIFY(cfa.getLoopHead(elseBB) == nullptr);
+}
+
+
+void ControlFlowAnalyzerTest::testPreTestedLoop()
+{
+    UserProc proc(Address(0x1000), "test", nullptr);
+    ProcCFG *cfg = proc.getCFG();
+
+    BasicBlock *entry  = createBB(cfg, BBType::Fall, Address(0x1000));
+    BasicBlock *header = createBB(cfg, BBType::Twoway, Address(0x1100));
+    BasicBlock *body   = createBB(cfg, BBType::Oneway, Address(0x1200));
+    BasicBlock *ret    = createBB(cfg, BBType::Ret, Address(0x1300));
+
+    cfg->addEdge(entry, header);
+    cfg->addEdge(header, body);
+    cfg->addEdge(header, ret);
+    cfg->addEdge(body, header);
+    proc.setEntryBB();
+
+    ControlFlowAnalyzer cfa;
+    cfa.structureCFG(cfg);
+
+    QVERIFY(cfa.getCondFollow(header) == ret);
+    QVERIFY(cfa.getLoopType(header) == LoopType::PreTested);
+    QVERIFY(cfa.getLatchNode(header) == body);
+    QVERIFY(cfa.getLoopFollow(header) == ret);
+    QVERIFY(cfa.getLoopHead(body) == header);
+    QVERIFY(cfa.isLatchNode(body));
+    QVERIFY(cfa.isBackEdge(body, header));
+    QVERIFY(!cfa.isBackEdge(header, body));
+}
+
+
+void ControlFlowAnalyzerTest::testEndlessLoopInBranch()
+{
+    UserProc proc(Address(0x1000), "test", nullptr);
+    ProcCFG *cfg = proc.getCFG();
+
+    BasicBlock *cond = createBB(cfg, BBType::Twoway, Address(0x1000));
+    BasicBlock *loop = createBB(cfg, BBType::Oneway, Address(0x1100));
+    BasicBlock *ret  = createBB(cfg, BBType::Ret, Address(0x1200));
+
+    cfg->addEdge(cond, loop);
+    cfg->addEdge(cond, ret);
+    cfg->addEdge(loop, loop);
+    proc.setEntryBB();
+
+    ControlFlowAnalyzer cfa;
+    cfa.structureCFG(cfg);
+
+    // only the virtual exit post dominates the condition, so it does not have a follow
+    QVERIFY(cfa.getCondFollow(cond) == nullptr);
+
+    QVERIFY(cfa.getLoopType(loop) == LoopType::Endless);
+    QVERIFY(cfa.getLatchNode(loop) == loop);
+}
+
+
+void ControlFlowAnalyzerTest::testSequentialLoops()
+{
+    UserProc proc(Address(0x1000), "test", nullptr);
+    ProcCFG *cfg = proc.getCFG();
+
+    BasicBlock *entry   = createBB(cfg, BBType::Fall, Address(0x1000));
+    BasicBlock *header1 = createBB(cfg, BBType::Twoway, Address(0x1100));
+    BasicBlock *body1   = createBB(cfg, BBType::Oneway, Address(0x1200));
+    BasicBlock *header2 = createBB(cfg, BBType::Twoway, Address(0x1300));
+    BasicBlock *body2   = createBB(cfg, BBType::Oneway, Address(0x1400));
+    BasicBlock *ret     = createBB(cfg, BBType::Ret, Address(0x1500));
+
+    cfg->addEdge(entry, header1);
+    cfg->addEdge(header1, body1);
+    cfg->addEdge(header1, header2);
+    cfg->addEdge(body1, header1);
+    cfg->addEdge(header2, body2);
+    cfg->addEdge(header2, ret);
+    cfg->addEdge(body2, header2);
+    proc.setEntryBB();
+
+    ControlFlowAnalyzer cfa;
+    cfa.structureCFG(cfg);
+
+    QVERIFY(cfa.getLoopType(header1) == LoopType::PreTested);
+    QVERIFY(cfa.getLoopFollow(header1) == header2);
+    QVERIFY(cfa.getLoopHead(body1) == header1);
+
+    QVERIFY(cfa.getLoopType(header2) == LoopType::PreTested);
+    QVERIFY(cfa.getLoopFollow(header2) == ret);
+    QVERIFY(cfa.getLoopHead(body2) == header2);
+    QVERIFY(cfa.getLoopHead(header2) == nullptr);
+}
+
+
+QTEST_GUILESS_MAIN(ControlFlowAnalyzerTest)
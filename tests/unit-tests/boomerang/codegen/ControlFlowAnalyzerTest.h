@@ -0,0 +1,28 @@
+#pragma region License
+/*
+ * This file is part of the Boomerang Decompiler.
+ *
+ * See the file "LICENSE.TERMS" for information on usage and
+ * redistribution of this file, and for a DISCLAIMER OF ALL
+ * WARRANTIES.
+ */
+#pragma endregion License
+#pragma once
+
+
+#include "TestUtils.h"
+
+
+/**
+ * Tests for post dominators and loop structuring of the ControlFlowAnalyzer
+ */
+class ControlFlowAnalyzerTest : public BoomerangTest
+{
+    Q_OBJECT
+
+private slots:
+    void testIfThenElse();
+    void testPreTestedLoop();
+    void testEndlessLoopInBranch(); ///< tests a branch that cannot reach the exit
+    void testSequentialLoops();
+};
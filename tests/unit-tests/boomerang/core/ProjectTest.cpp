@@ -12,9 +12,27 @@
 
 #include "boomerang/core/Project.h"
 #include "boomerang/core/Settings.h"
+#include "boomerang/core/Watcher.h"
 #include "boomerang/db/Prog.h"
 
 
+class CountingWatcher : public IWatcher
+{
+public:
+    void onFunctionCreated(Function *) override { numCreated++; }
+    void onFunctionRemoved(Function *) override { numRemoved++; }
+    void onInstructionsDecoded(const std::vector<DecodedRange> &ranges) override
+    {
+        batches.push_back(ranges);
+    }
+
+public:
+    int numCreated = 0;
+    int numRemoved = 0;
+    std::vector<std::vector<DecodedRange>> batches;
+};
+
+
 void ProjectTest::testLoadBinaryFile()
 {
     Project project;
@@ -122,4 +140,67 @@ void ProjectTest::testGenerateCode()
 }
 
 
+void ProjectTest::testWatcherSubscription()
+{
+    Project project;
+    CountingWatcher watcher;
+
+    QVERIFY(!project.isWatched(WatchEvent::FunctionRemoved));
+
+    project.addWatcher(&watcher, watchEventMask(WatchEvent::FunctionRemoved));
+    QVERIFY(project.isWatched(WatchEvent::FunctionRemoved));
+    QVERIFY(!project.isWatched(WatchEvent::FunctionCreated));
+
+    project.alertFunctionCreated(nullptr);
+    project.alertFunctionRemoved(nullptr);
+    QCOMPARE(watcher.numCreated, 0);
+    QCOMPARE(watcher.numRemoved, 1);
+
+    // re-adding replaces the subscription
+    project.addWatcher(&watcher);
+    project.alertFunctionCreated(nullptr);
+    project.alertFunctionRemoved(nullptr);
+    QCOMPARE(watcher.numCreated, 1);
+    QCOMPARE(watcher.numRemoved, 2);
+
+    project.removeWatcher(&watcher);
+    QVERIFY(!project.isWatched(WatchEvent::FunctionRemoved));
+    project.alertFunctionRemoved(nullptr);
+    QCOMPARE(watcher.numRemoved, 2);
+}
+
+
+void ProjectTest::testDecodedInstructionBatches()
+{
+    Project project;
+    CountingWatcher watcher;
+
+    // nobody is interested
+    project.alertInstructionDecoded(Address(0x1000), 2);
+    project.alertEndDecode();
+
+    project.addWatcher(&watcher, watchEventMask(WatchEvent::InstructionsDecoded));
+    project.alertInstructionDecoded(Address(0x1000), 2);
+    project.alertInstructionDecoded(Address(0x1002), 3);
+    project.alertInstructionDecoded(Address(0x2000), 1);
+    QVERIFY(watcher.batches.empty());
+
+    project.alertEndDecode();
+    QCOMPARE(watcher.batches.size(), std::size_t(1));
+
+    const std::vector<DecodedRange> &ranges = watcher.batches[0];
+    QCOMPARE(ranges.size(), std::size_t(2));
+    QCOMPARE(ranges[0].start, Address(0x1000));
+    QCOMPARE(ranges[0].numBytes, 5);
+    QCOMPARE(ranges[0].numInstructions, 2);
+    QCOMPARE(ranges[1].start, Address(0x2000));
+    QCOMPARE(ranges[1].numBytes, 1);
+    QCOMPARE(ranges[1].numInstructions, 1);
+
+    // nothing pending, nothing delivered
+    project.alertEndDecode();
+    QCOMPARE(watcher.batches.size(), std::size_t(1));
+}
+
+
 QTEST_GUILESS_MAIN(ProjectTest)
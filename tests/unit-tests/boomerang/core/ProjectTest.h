@@ -34,4 +34,10 @@ private slots:
     void testDecodeBinaryFile();
     void testDecompileBinaryFile();
     void testGenerateCode();
+
+    /// Test that watchers only receive the events they subscribed to
+    void testWatcherSubscription();
+
+    /// Test coalescing decoded instructions into batches
+    void testDecodedInstructionBatches();
 };
@@ -0,0 +1,115 @@
+#pragma region License
+/*
+ * This file is part of the Boomerang Decompiler.
+ *
+ * See the file "LICENSE.TERMS" for information on usage and
+ * redistribution of this file, and for a DISCLAIMER OF ALL
+ * WARRANTIES.
+ */
+#pragma endregion License
+#include "CallGraphIndexTest.h"
+
+
+#include "boomerang/db/CallGraphIndex.h"
+#include "boomerang/db/proc/LibProc.h"
+#include "boomerang/db/proc/UserProc.h"
+
+#include <algorithm>
+#include <cstdlib>
+
+
+static std::vector<int> toVector(CallGraphIndex::IndexRange range)
+{
+    std::vector<int> result(range.begin(), range.end());
+    std::sort(result.begin(), result.end());
+    return result;
+}
+
+
+static int positionOf(const CallGraphIndex &callGraph, int idx)
+{
+    const std::vector<int> &order = callGraph.getBottomUpOrder();
+    return static_cast<int>(std::find(order.begin(), order.end(), idx) - order.begin());
+}
+
+
+void CallGraphIndexTest::testBuild()
+{
+    UserProc main(Address(0x1000), "main", nullptr);
+    UserProc foo(Address(0x2000), "foo", nullptr);
+    UserProc bar(Address(0x3000), "bar", nullptr);
+    LibProc puts(Address(0x4000), "puts", nullptr);
+    UserProc unknown(Address(0x5000), "unknown", nullptr);
+
+    main.addCallee(&foo);
+    main.addCallee(&puts);
+    foo.addCallee(&bar);
+    foo.addCallee(&puts);
+    bar.addCallee(&unknown); // not part of the call graph
+
+    CallGraphIndex callGraph;
+    callGraph.build({ &main, &foo, &bar, &puts });
+
+    QCOMPARE(callGraph.getNumProcs(), 4);
+    QCOMPARE(callGraph.getIndexOf(&main), 0);
+    QCOMPARE(callGraph.getIndexOf(&puts), 3);
+    QCOMPARE(callGraph.getIndexOf(&unknown), -1);
+    QCOMPARE(callGraph.getProc(1), static_cast<Function *>(&foo));
+
+    QCOMPARE(toVector(callGraph.getCallees(0)), std::vector<int>({ 1, 3 }));
+    QCOMPARE(toVector(callGraph.getCallees(1)), std::vector<int>({ 2, 3 }));
+    QVERIFY(callGraph.getCallees(2).empty());
+    QVERIFY(callGraph.getCallees(3).empty());
+
+    QVERIFY(callGraph.getCallers(0).empty());
+    QCOMPARE(toVector(callGraph.getCallers(1)), std::vector<int>({ 0 }));
+    QCOMPARE(toVector(callGraph.getCallers(2)), std::vector<int>({ 1 }));
+    QCOMPARE(toVector(callGraph.getCallers(3)), std::vector<int>({ 0, 1 }));
+
+    callGraph.clear();
+    QCOMPARE(callGraph.getNumProcs(), 0);
+    QCOMPARE(callGraph.getIndexOf(&main), -1);
+}
+
+
+void CallGraphIndexTest::testSCCs()
+{
+    UserProc main(Address(0x1000), "main", nullptr);
+    UserProc even(Address(0x2000), "even", nullptr);
+    UserProc odd(Address(0x3000), "odd", nullptr);
+    UserProc leaf(Address(0x4000), "leaf", nullptr);
+    UserProc fib(Address(0x5000), "fib", nullptr);
+
+    main.addCallee(&even);
+    main.addCallee(&fib);
+    even.addCallee(&odd);
+    odd.addCallee(&even);
+    odd.addCallee(&leaf);
+    fib.addCallee(&fib);
+
+    CallGraphIndex callGraph;
+    callGraph.build({ &main, &even, &odd, &leaf, &fib });
+
+    QCOMPARE(callGraph.getNumSCCs(), 4);
+    QCOMPARE(callGraph.getSCC(1), callGraph.getSCC(2));
+    QVERIFY(callGraph.getSCC(0) != callGraph.getSCC(1));
+    QVERIFY(callGraph.getSCC(3) < callGraph.getSCC(1));
+    QVERIFY(callGraph.getSCC(1) < callGraph.getSCC(0));
+    QVERIFY(callGraph.getSCC(4) < callGraph.getSCC(0));
+
+    QVERIFY(!callGraph.isRecursive(0));
+    QVERIFY(callGraph.isRecursive(1));
+    QVERIFY(callGraph.isRecursive(2));
+    QVERIFY(!callGraph.isRecursive(3));
+    QVERIFY(callGraph.isRecursive(4));
+
+    // callees before callers, recursion groups are adjacent
+    QCOMPARE(callGraph.getBottomUpOrder().size(), std::size_t(5));
+    QVERIFY(positionOf(callGraph, 3) < positionOf(callGraph, 2));
+    QVERIFY(positionOf(callGraph, 2) < positionOf(callGraph, 0));
+    QVERIFY(positionOf(callGraph, 4) < positionOf(callGraph, 0));
+    QCOMPARE(std::abs(positionOf(callGraph, 1) - positionOf(callGraph, 2)), 1);
+}
+
+
+QTEST_GUILESS_MAIN(CallGraphIndexTest)
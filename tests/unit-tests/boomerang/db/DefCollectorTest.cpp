@@ -0,0 +1,104 @@
+#pragma region License
+/*
+ * This file is part of the Boomerang Decompiler.
+ *
+ * See the file "LICENSE.TERMS" for information on usage and
+ * redistribution of this file, and for a DISCLAIMER OF ALL
+ * WARRANTIES.
+ */
+#pragma endregion License
+#include "DefCollectorTest.h"
+
+
+#include "boomerang/db/DefCollector.h"
+#include "boomerang/ssl/exp/Const.h"
+#include "boomerang/ssl/exp/Location.h"
+#include "boomerang/ssl/exp/RefExp.h"
+#include "boomerang/ssl/exp/Ternary.h"
+#include "boomerang/ssl/statements/Assign.h"
+
+#include <iterator>
+
+
+void DefCollectorTest::testUpdateDefs()
+{
+    Assign def1(Location::regOf(REG_PENT_EAX), Const::get(1));
+    Assign def2(Location::regOf(REG_PENT_EAX), Const::get(2));
+    Assign def3(Location::regOf(REG_PENT_ECX), Const::get(3));
+
+    DefCollector col;
+    QVERIFY(!col.isInitialised());
+
+    ExpHashMap<std::deque<Statement *>> stacks;
+    stacks[Location::regOf(REG_PENT_EAX)].push_back(&def1);
+    stacks[Location::regOf(REG_PENT_ECX)]; // does not reach
+
+    col.updateDefs(stacks, nullptr);
+    QVERIFY(col.isInitialised());
+    QCOMPARE(std::distance(col.begin(), col.end()), std::ptrdiff_t(1));
+    QVERIFY(col.existsOnLeft(Location::regOf(REG_PENT_EAX)));
+    QVERIFY(!col.existsOnLeft(Location::regOf(REG_PENT_ECX)));
+
+    // existing definitions are kept, new ones are added
+    stacks[Location::regOf(REG_PENT_EAX)].push_back(&def2);
+    stacks[Location::regOf(REG_PENT_ECX)].push_back(&def3);
+
+    col.updateDefs(stacks, nullptr);
+    QCOMPARE(std::distance(col.begin(), col.end()), std::ptrdiff_t(2));
+    QVERIFY(*col.findDefFor(Location::regOf(REG_PENT_EAX)) ==
+            *RefExp::get(Location::regOf(REG_PENT_EAX), &def1));
+    QVERIFY(*col.findDefFor(Location::regOf(REG_PENT_ECX)) ==
+            *RefExp::get(Location::regOf(REG_PENT_ECX), &def3));
+}
+
+
+void DefCollectorTest::testUpdateDefsPartial()
+{
+    const SharedExp eax    = Location::regOf(REG_PENT_EAX);
+    const SharedExp eaxLow = Ternary::get(opAt, eax->clone(), Const::get(0), Const::get(7));
+
+    Assign def1(eax->clone(), Const::get(1));
+    Assign def2(eaxLow->clone(), Const::get(2));
+
+    ExpHashMap<std::deque<Statement *>> stacks;
+    stacks[eax->clone()].push_back(&def1);
+    stacks[eaxLow->clone()].push_back(&def2);
+
+    // Must give the same result as inserting the definitions one by one,
+    // even though the collector is empty at first
+    DefCollector expected;
+    for (auto &stack : stacks) {
+        expected.insert(new Assign(stack.first->clone(),
+                                   RefExp::get(stack.first->clone(), stack.second.back())));
+    }
+
+    DefCollector col;
+    col.updateDefs(stacks, nullptr);
+    QCOMPARE(std::distance(col.begin(), col.end()),
+             std::distance(expected.begin(), expected.end()));
+
+    // eax@[0:7] already defines eax
+    DefCollector partial;
+    partial.insert(new Assign(eaxLow->clone(), Const::get(3)));
+    partial.updateDefs(stacks, nullptr);
+    QCOMPARE(std::distance(partial.begin(), partial.end()), std::ptrdiff_t(1));
+    QVERIFY(partial.existsOnLeft(eax));
+}
+
+
+void DefCollectorTest::testFindDefFor()
+{
+    DefCollector col;
+    QVERIFY(col.findDefFor(Location::regOf(REG_PENT_EAX)) == nullptr);
+
+    col.insert(new Assign(Location::regOf(REG_PENT_EAX), Const::get(5)));
+    col.insert(new Assign(Location::regOf(REG_PENT_EAX), Const::get(6))); // ignored
+
+    QCOMPARE(std::distance(col.begin(), col.end()), std::ptrdiff_t(1));
+    QVERIFY(*col.findDefFor(Location::regOf(REG_PENT_EAX)) == *Const::get(5));
+    QVERIFY(col.findDefFor(Location::regOf(REG_PENT_ECX)) == nullptr);
+    QVERIFY(col.existsOnLeft(Location::regOf(REG_PENT_EAX)));
+}
+
+
+QTEST_GUILESS_MAIN(DefCollectorTest)
@@ -0,0 +1,157 @@
+#pragma region License
+/*
+ * This file is part of the Boomerang Decompiler.
+ *
+ * See the file "LICENSE.TERMS" for information on usage and
+ * redistribution of this file, and for a DISCLAIMER OF ALL
+ * WARRANTIES.
+ */
+#pragma endregion License
+#include "ProofCacheTest.h"
+
+
+#include "boomerang/db/ProofCache.h"
+#include "boomerang/db/proc/UserProc.h"
+#include "boomerang/ssl/exp/Binary.h"
+#include "boomerang/ssl/exp/Const.h"
+#include "boomerang/ssl/exp/Location.h"
+
+
+void ProofCacheTest::testGetPreservationOffset()
+{
+    const SharedExp esp = Location::regOf(REG_PENT_ESP);
+    int offset          = -1;
+
+    QVERIFY(ProofCache::getPreservationOffset(esp, esp, offset));
+    QCOMPARE(offset, 0);
+
+    const SharedExp espPlus4 = Binary::get(opPlus, esp, Const::get(4));
+    QVERIFY(ProofCache::getPreservationOffset(esp, espPlus4, offset));
+    QCOMPARE(offset, 4);
+
+    const SharedExp espMinus8 = Binary::get(opMinus, esp, Const::get(8));
+    QVERIFY(ProofCache::getPreservationOffset(esp, espMinus8, offset));
+    QCOMPARE(offset, -8);
+
+    const SharedExp ebp = Location::regOf(REG_PENT_EBP);
+    QVERIFY(!ProofCache::getPreservationOffset(esp, ebp, offset));
+    QVERIFY(!ProofCache::getPreservationOffset(esp, Binary::get(opPlus, ebp, Const::get(4)),
+                                               offset));
+}
+
+
+void ProofCacheTest::testLookup()
+{
+    UserProc proc(Address(0x1000), "test", nullptr);
+    ProofCache cache;
+    bool result = false;
+
+    const SharedExp esp = Location::regOf(REG_PENT_ESP);
+    QVERIFY(!cache.lookup(&proc, esp, 0, result));
+
+    cache.beginProof(&proc);
+    cache.endProof();
+    cache.store(&proc, esp, 0, false);
+
+    result = true;
+    QVERIFY(cache.lookup(&proc, Location::regOf(REG_PENT_ESP), 0, result));
+    QVERIFY(!result);
+    QVERIFY(!cache.lookup(&proc, esp, 4, result));
+    QVERIFY(!cache.lookup(&proc, Location::regOf(REG_PENT_EBP), 0, result));
+}
+
+
+void ProofCacheTest::testInvalidate()
+{
+    UserProc proc(Address(0x1000), "test", nullptr);
+    ProofCache cache;
+    bool result = false;
+
+    const SharedExp esp = Location::regOf(REG_PENT_ESP);
+
+    cache.beginProof(&proc);
+    cache.endProof();
+    cache.store(&proc, esp, 0, true);
+    QVERIFY(cache.lookup(&proc, esp, 0, result));
+    QVERIFY(result);
+
+    cache.invalidate(&proc);
+    QVERIFY(!cache.lookup(&proc, esp, 0, result));
+}
+
+
+void ProofCacheTest::testDependencies()
+{
+    UserProc caller(Address(0x1000), "caller", nullptr);
+    UserProc callee(Address(0x2000), "callee", nullptr);
+    UserProc other(Address(0x3000), "other", nullptr);
+    ProofCache cache;
+    bool result = false;
+
+    const SharedExp esp = Location::regOf(REG_PENT_ESP);
+
+    cache.beginProof(&caller);
+    cache.addDependency(&callee);
+    cache.endProof();
+    cache.store(&caller, esp, 0, false);
+
+    cache.invalidate(&other);
+    QVERIFY(cache.lookup(&caller, esp, 0, result));
+
+    // The summary of the callee changed, so the proof has to be redone
+    cache.invalidate(&callee);
+    QVERIFY(!cache.lookup(&caller, esp, 0, result));
+}
+
+
+void ProofCacheTest::testTransitiveDependencies()
+{
+    // caller -> middle -> callee
+    UserProc caller(Address(0x1000), "caller", nullptr);
+    UserProc middle(Address(0x2000), "middle", nullptr);
+    UserProc callee(Address(0x3000), "callee", nullptr);
+    ProofCache cache;
+    bool result = false;
+
+    const SharedExp esp = Location::regOf(REG_PENT_ESP);
+
+    cache.beginProof(&middle);
+    cache.addDependency(&callee);
+    cache.endProof();
+    cache.store(&middle, esp, 0, true);
+
+    // The proof for the caller uses the cached result for the middle proc
+    cache.beginProof(&caller);
+    cache.addDependency(&middle);
+    QVERIFY(cache.lookup(&middle, esp, 0, result));
+    QVERIFY(result);
+    cache.endProof();
+    cache.store(&caller, esp, 0, true);
+
+    QVERIFY(cache.lookup(&caller, esp, 0, result));
+
+    // The callee changed, so both the proof for the middle proc
+    // and the proof for the caller relying on it are stale
+    cache.invalidate(&callee);
+    QVERIFY(!cache.lookup(&middle, esp, 0, result));
+    QVERIFY(!cache.lookup(&caller, esp, 0, result));
+}
+
+
+void ProofCacheTest::testPremises()
+{
+    ProofCache cache;
+    QVERIFY(!cache.hasPremises());
+
+    cache.addPremise();
+    cache.addPremise();
+    QVERIFY(cache.hasPremises());
+
+    cache.removePremise();
+    QVERIFY(cache.hasPremises());
+    cache.removePremise();
+    QVERIFY(!cache.hasPremises());
+}
+
+
+QTEST_GUILESS_MAIN(ProofCacheTest)
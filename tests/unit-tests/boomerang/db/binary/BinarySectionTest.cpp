@@ -76,13 +76,38 @@ void BinarySectionTest::testAddDefinedArea()
 void BinarySectionTest::testAttributes()
 {
     BinarySection section(Address(0x1000), 0x1000, "testSection");
-    QVariantMap varMap = section.getAttributesForRange(Address(0x1000), Address(0x2000));
-    QVERIFY(varMap.empty());
-
-    section.setAttributeForRange("ReadOnly", true, Address(0x1000), Address(0x1800));
-    varMap = section.getAttributesForRange(Address(0x1000), Address(0x2000));
-    QVERIFY(!varMap.empty());
-    QVERIFY(section.isAttributeInRange("ReadOnly", Address(0x1000), Address(0x2000)));
+    QVERIFY(!section.hasAttributesInRange(Address(0x1000), Address(0x2000)));
+
+    section.setAttributeForRange(SectionAttr::ReadOnly, Address(0x1000), Address(0x1800));
+    QVERIFY(section.hasAttributesInRange(Address(0x1000), Address(0x2000)));
+    QVERIFY(section.isAttributeInRange(SectionAttr::ReadOnly, Address(0x1000), Address(0x2000)));
+    QVERIFY(section.isReadOnlyRange(Address(0x1700), Address(0x1900)));
+    QVERIFY(!section.isReadOnlyRange(Address(0x1800), Address(0x2000)));
+    QVERIFY(!section.isStringsRange(Address(0x1000), Address(0x2000)));
+
+    // overlapping ranges
+    section.setAttributeForRange(SectionAttr::StringsSection, Address(0x1400), Address(0x1C00));
+    QVERIFY(!section.isStringsRange(Address(0x1000), Address(0x1400)));
+    QVERIFY(section.isStringsRange(Address(0x13FF), Address(0x1401)));
+    QVERIFY(section.isStringsRange(Address(0x1A00), Address(0x1A01)));
+    QVERIFY(section.isReadOnlyRange(Address(0x1600), Address(0x1601)));
+    QVERIFY(!section.isReadOnlyRange(Address(0x1A00), Address(0x1A01)));
+    QVERIFY(!section.hasAttributesInRange(Address(0x1C00), Address(0x2000)));
+
+    // whole ranges, spanning several split ranges
+    QVERIFY(section.isAttributeInWholeRange(SectionAttr::StringsSection, Address(0x1400),
+                                            Address(0x1C00)));
+    QVERIFY(section.isAttributeInWholeRange(SectionAttr::ReadOnly, Address(0x1000),
+                                            Address(0x1800)));
+    QVERIFY(!section.isAttributeInWholeRange(SectionAttr::StringsSection, Address(0x13FF),
+                                             Address(0x1401)));
+    QVERIFY(!section.isAttributeInWholeRange(SectionAttr::StringsSection, Address(0x1B00),
+                                             Address(0x1D00)));
+
+    // empty range
+    QVERIFY(!section.hasAttributesInRange(Address(0x1600), Address(0x1600)));
+    QVERIFY(!section.isAttributeInWholeRange(SectionAttr::ReadOnly, Address(0x1600),
+                                             Address(0x1600)));
 }
 
 QTEST_GUILESS_MAIN(BinarySectionTest)
@@ -66,6 +66,52 @@ void BinarySymbolTableTest::testCreateSymbol()
 }
 
 
+void BinarySymbolTableTest::testCreateSymbols()
+{
+    BinarySymbolTable tbl;
+    BinarySymbol *existing = tbl.createSymbol(Address(0x1000), "existing");
+    QVERIFY(tbl.renameSymbol("existing", "renamed"));
+
+    const std::vector<BinarySymbol *> syms = tbl.createSymbols({
+        { Address(0x3000), "foo" },
+        { Address(0x1000), "bar" },      // address already exists
+        { Address(0x2000), "renamed" },  // name already exists
+        { Address(0x4000), "foo" },      // name exists in the same batch
+        { Address(0x3000), "baz" },      // address exists in the same batch
+        { Address(0x5000), "loc", true } // local symbol
+    });
+
+    QCOMPARE(syms.size(), static_cast<std::size_t>(6));
+    QVERIFY(syms[0] != nullptr);
+    QCOMPARE(syms[0]->getName(), QString("foo"));
+    QVERIFY(syms[1] == nullptr);
+    QVERIFY(syms[2] == existing);
+    QVERIFY(syms[3] == syms[0]);
+    QVERIFY(syms[4] == nullptr);
+    QVERIFY(syms[5] != nullptr);
+    QCOMPARE(tbl.size(), 3);
+
+    QVERIFY(tbl.findSymbolByAddress(Address(0x1000)) == existing);
+    QVERIFY(tbl.findSymbolByAddress(Address(0x2000)) == existing);
+    QVERIFY(tbl.findSymbolByAddress(Address(0x3000)) == syms[0]);
+    QVERIFY(tbl.findSymbolByAddress(Address(0x4000)) == syms[0]);
+    QVERIFY(tbl.findSymbolByAddress(Address(0x5000)) == syms[5]);
+
+    QVERIFY(tbl.findSymbolByName("existing") == nullptr);
+    QVERIFY(tbl.findSymbolByName("renamed") == existing);
+    QVERIFY(tbl.findSymbolByName("foo") == syms[0]);
+    QVERIFY(tbl.findSymbolByName("loc") == nullptr);
+
+    // renaming and single insertions still work after a bulk insertion
+    QVERIFY(tbl.renameSymbol("foo", "foo2"));
+    QVERIFY(tbl.findSymbolByName("foo") == nullptr);
+    QVERIFY(tbl.findSymbolByName("foo2") == syms[0]);
+    QVERIFY(tbl.createSymbol(Address(0x6000), "foo") != nullptr);
+    QVERIFY(tbl.findSymbolByName("foo") != syms[0]);
+    QCOMPARE(tbl.size(), 4);
+}
+
+
 void BinarySymbolTableTest::testFindSymbolByAddress()
 {
     BinarySymbolTable tbl;
@@ -23,6 +23,7 @@ private slots:
     void testClear();
 
     void testCreateSymbol();
+    void testCreateSymbols();
     void testFindSymbolByAddress();
     void testFindSymbolByName();
     void testRenameSymbol();
@@ -0,0 +1,95 @@
+#pragma region License
+/*
+ * This file is part of the Boomerang Decompiler.
+ *
+ * See the file "LICENSE.TERMS" for information on usage and
+ * redistribution of this file, and for a DISCLAIMER OF ALL
+ * WARRANTIES.
+ */
+#pragma endregion License
+#include "ByteSignatureMatcherTest.h"
+
+
+#include "boomerang/db/binary/BinaryImage.h"
+#include "boomerang/db/binary/BinarySection.h"
+#include "boomerang/db/binary/BinarySymbol.h"
+#include "boomerang/db/binary/BinarySymbolTable.h"
+#include "boomerang/db/binary/ByteSignatureMatcher.h"
+
+#include <QByteArray>
+
+
+void ByteSignatureMatcherTest::testAddSignature()
+{
+    ByteSignatureMatcher matcher;
+    QCOMPARE(matcher.size(), 0);
+
+    QVERIFY(matcher.addSignature("foo", "55 89 E5 ?? ?? 83 EC 18 89 7D FC"));
+    QCOMPARE(matcher.size(), 1);
+
+    QVERIFY(!matcher.addSignature("", "55 89 E5 83 EC 18 89 7D FC"));    // no name
+    QVERIFY(!matcher.addSignature("bar", "55 89 E5 XY 83 EC 18 89 7D")); // malformed
+    QVERIFY(!matcher.addSignature("baz", "55 89 E5 ?? ?? ?? 83 EC 18")); // too few fixed bytes
+}
+
+
+void ByteSignatureMatcherTest::testReadSignatureFile()
+{
+    ByteSignatureMatcher matcher;
+    QVERIFY(!matcher.readSignatureFile(BOOMERANG_TEST_BASE "share/boomerang/signatures/none.sig"));
+
+    QVERIFY(matcher.readSignatureFile(BOOMERANG_TEST_BASE
+                                      "share/boomerang/signatures/mingw32.sig"));
+    QCOMPARE(matcher.size(), 5);
+}
+
+
+void ByteSignatureMatcherTest::testRecognizeFunctions()
+{
+    // foo at 0x1002, bar at 0x1010, foo at 0x1020 (already named 'main')
+    QByteArray data(0x30, '\x90');
+    data.replace(0x02, 10, "\x55\x89\xE5\x12\x34\x83\xEC\x18\x89\x7D", 10);
+    data.replace(0x10, 9, "\x51\x89\xE1\x83\xC1\x08\x3D\x00\x10", 9);
+    data.replace(0x20, 10, "\x55\x89\xE5\x56\x78\x83\xEC\x18\x89\x7D", 10);
+
+    BinaryImage img(QByteArray{});
+    BinarySymbolTable symbols;
+
+    BinarySection *text = img.createSection("text", Address(0x1000), Address(0x1000) + data.size());
+    text->setHostAddr(HostAddress(data.constData()));
+    text->setCode(true);
+
+    BinarySection *sect = img.createSection("data", Address(0x2000), Address(0x2000) + data.size());
+    sect->setHostAddr(HostAddress(data.constData()));
+    sect->setData(true);
+
+    symbols.createSymbol(Address(0x1020), "main");
+
+    ByteSignatureMatcher matcher;
+    QVERIFY(matcher.addSignature("foo", "55 89 E5 ?? ?? 83 EC 18 89 7D"));
+    QVERIFY(matcher.addSignature("bar", "51 89 E1 83 C1 08 3D 00 10"));
+
+    // data sections are not scanned; the symbol 'main' is kept
+    QCOMPARE(matcher.recognizeFunctions(&img, &symbols), 2);
+
+    const BinarySymbol *foo = symbols.findSymbolByAddress(Address(0x1002));
+    QVERIFY(foo != nullptr);
+    QCOMPARE(foo->getName(), QString("foo"));
+    QVERIFY(foo->isFunction());
+    QVERIFY(foo->isStaticFunction());
+
+    const BinarySymbol *bar = symbols.findSymbolByAddress(Address(0x1010));
+    QVERIFY(bar != nullptr);
+    QCOMPARE(bar->getName(), QString("bar"));
+    QVERIFY(bar->isStaticFunction());
+
+    const BinarySymbol *mainSym = symbols.findSymbolByAddress(Address(0x1020));
+    QVERIFY(mainSym != nullptr);
+    QCOMPARE(mainSym->getName(), QString("main"));
+    QVERIFY(!mainSym->isStaticFunction());
+
+    QVERIFY(symbols.findSymbolByAddress(Address(0x2002)) == nullptr);
+}
+
+
+QTEST_GUILESS_MAIN(ByteSignatureMatcherTest)
@@ -0,0 +1,100 @@
+#pragma region License
+/*
+ * This file is part of the Boomerang Decompiler.
+ *
+ * See the file "LICENSE.TERMS" for information on usage and
+ * redistribution of this file, and for a DISCLAIMER OF ALL
+ * WARRANTIES.
+ */
+#pragma endregion License
+#include "StringLiteralIndexTest.h"
+
+
+#include "boomerang/db/binary/BinaryImage.h"
+#include "boomerang/db/binary/BinarySection.h"
+#include "boomerang/db/binary/StringLiteralIndex.h"
+
+#include <QByteArray>
+
+
+static QByteArray createSectionData()
+{
+    QByteArray data;
+    data.append("Hello\0", 6);            // 0x1000
+    data.append("ab\0", 3);               // 0x1006: too short
+    data.append("Caf\xE9 au lait\0", 13); // 0x1009: one non-text character
+    data.append("\x01\x02wxyz\0", 7);     // 0x1016: two non-text characters
+    data.append("\0", 1);
+    data.append("W\0i\0d\0e\0\0\0", 10);  // 0x101E: UTF-16, not indexed
+    data.append("tail", 4);               // 0x1028: not terminated
+    return data;
+}
+
+
+void StringLiteralIndexTest::testBuild()
+{
+    QByteArray data = createSectionData();
+    BinaryImage img(QByteArray{});
+
+    StringLiteralIndex index;
+    index.build(&img);
+    QCOMPARE(index.size(), 0);
+
+    BinarySection *code = img.createSection("code", Address(0x2000), Address(0x2000) + data.size());
+    code->setHostAddr(HostAddress(data.constData()));
+    code->setCode(true);
+    code->setReadOnly(true);
+
+    BinarySection *sect = img.createSection("data", Address(0x1000), Address(0x1000) + data.size());
+    sect->setHostAddr(HostAddress(data.constData()));
+    sect->setReadOnly(true);
+
+    // code sections are not scanned
+    index.build(&img);
+    QCOMPARE(index.size(), 2);
+
+    index.clear();
+    QCOMPARE(index.size(), 0);
+}
+
+
+void StringLiteralIndexTest::testFindLiteral()
+{
+    QByteArray data = createSectionData();
+    BinaryImage img(QByteArray{});
+
+    BinarySection *sect = img.createSection("data", Address(0x1000), Address(0x1000) + data.size());
+    sect->setHostAddr(HostAddress(data.constData()));
+    sect->setReadOnly(true);
+    sect->setAttributeForRange(SectionAttr::StringsSection, Address(0x1000), Address(0x1006));
+    sect->setAttributeForRange(SectionAttr::StringsSection, Address(0x1010), Address(0x1016));
+
+    StringLiteralIndex index;
+    index.build(&img);
+
+    const StringLiteralIndex::StringLiteral *hello = index.findLiteral(Address(0x1000));
+    QVERIFY(hello != nullptr);
+    QCOMPARE(hello->addr, Address(0x1000));
+    QVERIFY(hello->data == data.constData());
+    QCOMPARE(hello->length, 5U);
+    QVERIFY(hello->stringsRange == StringLiteralIndex::StringsRange::Inside);
+
+    QVERIFY(index.findLiteral(Address(0x1004)) == hello);
+    QVERIFY(index.findLiteral(Address(0x1005)) == nullptr);
+    QVERIFY(index.findLiteral(Address(0x1006)) == nullptr);
+    QVERIFY(index.findLiteral(Address(0x0FFF)) == nullptr);
+
+    const StringLiteralIndex::StringLiteral *cafe = index.findLiteral(Address(0x1009));
+    QVERIFY(cafe != nullptr);
+    QCOMPARE(cafe->length, 12U);
+    // only the end of the literal is in the strings range
+    QVERIFY(cafe->stringsRange == StringLiteralIndex::StringsRange::Partial);
+
+    QVERIFY(index.findLiteral(Address(0x1016)) == nullptr);
+    QVERIFY(index.findLiteral(Address(0x1028)) == nullptr);
+
+    QVERIFY(index.findLiteral(Address(0x101E)) == nullptr);
+}
+
+
+QTEST_GUILESS_MAIN(StringLiteralIndexTest)
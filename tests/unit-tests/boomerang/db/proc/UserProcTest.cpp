@@ -113,6 +113,65 @@ void UserProcTest::testInsertAssignAfter()
 }
 
 
+void UserProcTest::testGetStatementIndex()
+{
+    UserProc proc(Address(0x1000), "test", nullptr);
+
+    std::unique_ptr<RTLList> bbRTLs(new RTLList);
+    bbRTLs->push_back(std::unique_ptr<RTL>(new RTL(Address(0x1000), { })));
+    proc.getCFG()->createBB(BBType::Fall, std::move(bbRTLs));
+    proc.setEntryBB();
+
+    QVERIFY(proc.getStatementIndex()->empty());
+
+    Assign *as = proc.insertAssignAfter(nullptr, Location::regOf(REG_PENT_EAX), Location::regOf(REG_PENT_ECX));
+    Assign *as2 = new Assign(VoidType::get(), Location::regOf(REG_PENT_EDX), Location::regOf(REG_PENT_EBX));
+    proc.insertStatementAfter(as, as2);
+    proc.numberStatements();
+
+    const auto stmts = proc.getStatementIndex();
+    QCOMPARE(stmts->size(), static_cast<size_t>(2));
+    QVERIFY(*stmts->begin() == as);
+    QVERIFY(*std::next(stmts->begin()) == as2);
+    QVERIFY(proc.getStatementIndex() == stmts); // cached
+
+    QVERIFY(proc.getStatementByNumber(0) == nullptr);
+    QVERIFY(proc.getStatementByNumber(1) == as);
+    QVERIFY(proc.getStatementByNumber(2) == as2);
+    QVERIFY(proc.getStatementByNumber(3) == nullptr);
+
+    // removing a statement invalidates the index, but not existing snapshots
+    QVERIFY(proc.removeStatement(as));
+    QCOMPARE(proc.getStatementIndex()->size(), static_cast<size_t>(1));
+    QCOMPARE(stmts->size(), static_cast<size_t>(2));
+    QVERIFY(proc.getStatementByNumber(1) == nullptr);
+    QVERIFY(proc.getStatementByNumber(2) == as2);
+    delete as;
+
+    // changing the statements of another proc does not invalidate the index
+    const auto stmts2 = proc.getStatementIndex();
+
+    UserProc other(Address(0x2000), "other", nullptr);
+    std::unique_ptr<RTLList> otherRTLs(new RTLList);
+    otherRTLs->push_back(std::unique_ptr<RTL>(new RTL(Address(0x2000), { })));
+    other.getCFG()->createBB(BBType::Fall, std::move(otherRTLs));
+    other.setEntryBB();
+    other.insertAssignAfter(nullptr, Location::regOf(REG_PENT_EAX), Location::regOf(REG_PENT_ECX));
+
+    QVERIFY(proc.getStatementIndex() == stmts2);
+
+    // replacing a statement invalidates the index
+    RTL *rtl    = proc.getEntryBB()->getRTLs()->front().get();
+    Assign *as3 = new Assign(VoidType::get(), Location::regOf(REG_PENT_ESI), Location::regOf(REG_PENT_EDI));
+    as3->setBB(proc.getEntryBB());
+    rtl->replace(rtl->begin(), as3);
+
+    QVERIFY(proc.getStatementIndex() != stmts2);
+    QVERIFY(*proc.getStatementIndex()->begin() == as3);
+    delete as2;
+}
+
+
 void UserProcTest::testInsertStatementAfter()
 {
     UserProc proc(Address(0x1000), "test", nullptr);
@@ -0,0 +1,138 @@
+#pragma region License
+/*
+ * This file is part of the Boomerang Decompiler.
+ *
+ * See the file "LICENSE.TERMS" for information on usage and
+ * redistribution of this file, and for a DISCLAIMER OF ALL
+ * WARRANTIES.
+ */
+#pragma endregion License
+#include "IncrementalDecompilerTest.h"
+
+
+#include "boomerang/core/Project.h"
+#include "boomerang/core/Settings.h"
+#include "boomerang/db/Prog.h"
+#include "boomerang/db/proc/UserProc.h"
+#include "boomerang/decomp/IncrementalDecompiler.h"
+#include "boomerang/ssl/type/FloatType.h"
+#include "boomerang/ssl/type/IntegerType.h"
+
+
+#define HELLO_CLANG4 getFullSamplePath("elf/hello-clang4-dynamic")
+
+
+static void decompileHello(Project &project)
+{
+    project.getSettings()->setDataDirectory(BOOMERANG_TEST_BASE "share/boomerang/");
+    project.getSettings()->setPluginDirectory(BOOMERANG_TEST_BASE "lib/boomerang/plugins/");
+    project.loadPlugins();
+
+    QVERIFY(project.loadBinaryFile(HELLO_CLANG4));
+    QVERIFY(project.decodeBinaryFile());
+    QVERIFY(project.decompileBinaryFile());
+    QVERIFY(project.generateCode());
+}
+
+
+void IncrementalDecompilerTest::testNotDecompiled()
+{
+    Project project;
+    project.getSettings()->setDataDirectory(BOOMERANG_TEST_BASE "share/boomerang/");
+    project.getSettings()->setPluginDirectory(BOOMERANG_TEST_BASE "lib/boomerang/plugins/");
+    project.loadPlugins();
+
+    QVERIFY(project.loadBinaryFile(HELLO_CLANG4));
+    QVERIFY(project.decodeBinaryFile());
+
+    IncrementalDecompiler *inc = project.getIncrementalDecompiler();
+    Function *main             = project.getProg()->getFunctionByName("main");
+    QVERIFY(main != nullptr);
+
+    inc->functionRenamed(main);
+    inc->signatureChanged(main);
+    QVERIFY(!inc->hasInvalidatedProcs());
+    QVERIFY(inc->getChangedModules().empty());
+}
+
+
+void IncrementalDecompilerTest::testFunctionRenamed()
+{
+    Project project;
+    decompileHello(project);
+
+    IncrementalDecompiler *inc = project.getIncrementalDecompiler();
+    QVERIFY(inc->isProgDecompiled());
+    QVERIFY(inc->isCodeGenerated());
+    QVERIFY(inc->getChangedModules().empty());
+
+    UserProc *main = static_cast<UserProc *>(project.getProg()->getFunctionByName("main"));
+    QVERIFY(main != nullptr);
+    QCOMPARE(main->getStatus(), PROC_CODE_GENERATED);
+
+    main->setName("main2");
+    inc->functionRenamed(main);
+
+    QVERIFY(!inc->hasInvalidatedProcs());
+    QCOMPARE(main->getStatus(), PROC_FINAL);
+    QVERIFY(inc->getChangedModules().count(main->getModule()) == 1);
+    QVERIFY(inc->getChangedModules().count(project.getProg()->getRootModule()) == 1);
+
+    QVERIFY(project.generateCode());
+    QVERIFY(inc->getChangedModules().empty());
+    QCOMPARE(main->getStatus(), PROC_CODE_GENERATED);
+}
+
+
+void IncrementalDecompilerTest::testSignatureChanged()
+{
+    Project project;
+    decompileHello(project);
+
+    IncrementalDecompiler *inc = project.getIncrementalDecompiler();
+    UserProc *main = static_cast<UserProc *>(project.getProg()->getFunctionByName("main"));
+    QVERIFY(main != nullptr);
+
+    inc->signatureChanged(main);
+    QVERIFY(inc->hasInvalidatedProcs());
+    QVERIFY(inc->getChangedModules().count(main->getModule()) == 1);
+
+    QVERIFY(project.decompileBinaryFile());
+    QVERIFY(!inc->hasInvalidatedProcs());
+    QVERIFY(main->isDecompiled());
+
+    // nothing left to do
+    QVERIFY(project.decompileBinaryFile());
+    QVERIFY(project.generateCode());
+    QVERIFY(inc->getChangedModules().empty());
+}
+
+
+void IncrementalDecompilerTest::testGlobalChanged()
+{
+    Project project;
+    decompileHello(project);
+
+    IncrementalDecompiler *inc = project.getIncrementalDecompiler();
+    Prog *prog                 = project.getProg();
+
+    // not used by any procedure
+    Global *global = prog->createGlobal(Address(0x10000000), IntegerType::get(32), "unusedGlobal");
+    QVERIFY(global != nullptr);
+
+    // same type, no change
+    QVERIFY(project.setGlobalType("unusedGlobal", IntegerType::get(32)));
+    QVERIFY(inc->getChangedModules().empty());
+
+    // type changes made by the analyses are not user edits
+    prog->setGlobalType("unusedGlobal", IntegerType::get(16));
+    QVERIFY(inc->getChangedModules().empty());
+
+    QVERIFY(!project.setGlobalType("noSuchGlobal", FloatType::get(32)));
+    QVERIFY(project.setGlobalType("unusedGlobal", FloatType::get(32)));
+    QVERIFY(!inc->hasInvalidatedProcs());
+    QVERIFY(inc->getChangedModules().count(prog->getRootModule()) == 1);
+}
+
+
+QTEST_GUILESS_MAIN(IncrementalDecompilerTest)
@@ -0,0 +1,35 @@
+#pragma region License
+/*
+ * This file is part of the Boomerang Decompiler.
+ *
+ * See the file "LICENSE.TERMS" for information on usage and
+ * redistribution of this file, and for a DISCLAIMER OF ALL
+ * WARRANTIES.
+ */
+#pragma endregion License
+#pragma once
+
+
+#include "TestUtils.h"
+
+
+/**
+ * Test re-decompiling procedures after interactive edits.
+ */
+class IncrementalDecompilerTest : public BoomerangTest
+{
+    Q_OBJECT
+
+private slots:
+    /// Edits before the program is decompiled do not invalidate anything
+    void testNotDecompiled();
+
+    /// Renaming only requires the code to be generated again
+    void testFunctionRenamed();
+
+    /// Changing a signature requires procedures to be decompiled again
+    void testSignatureChanged();
+
+    /// Changing the type of a global only affects procedures using it
+    void testGlobalChanged();
+};
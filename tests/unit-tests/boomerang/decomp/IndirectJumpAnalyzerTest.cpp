@@ -0,0 +1,75 @@
+#pragma region License
+/*
+ * This file is part of the Boomerang Decompiler.
+ *
+ * See the file "LICENSE.TERMS" for information on usage and
+ * redistribution of this file, and for a DISCLAIMER OF ALL
+ * WARRANTIES.
+ */
+#pragma endregion License
+#include "IndirectJumpAnalyzerTest.h"
+
+
+#include "boomerang/core/Project.h"
+#include "boomerang/core/Settings.h"
+#include "boomerang/db/BasicBlock.h"
+#include "boomerang/db/Prog.h"
+#include "boomerang/db/proc/ProcCFG.h"
+#include "boomerang/db/proc/UserProc.h"
+#include "boomerang/decomp/IndirectJumpAnalyzer.h"
+#include "boomerang/ssl/RTL.h"
+#include "boomerang/ssl/exp/Binary.h"
+#include "boomerang/ssl/exp/Const.h"
+#include "boomerang/ssl/exp/Location.h"
+#include "boomerang/ssl/statements/Assign.h"
+#include "boomerang/ssl/statements/CallStatement.h"
+
+
+#define HELLO_CLANG4 getFullSamplePath("elf/hello-clang4-dynamic")
+
+
+void IndirectJumpAnalyzerTest::testIndirectCall()
+{
+    // same as -ic
+    Project project;
+    project.getSettings()->setDataDirectory(BOOMERANG_TEST_BASE "share/boomerang/");
+    project.getSettings()->setPluginDirectory(BOOMERANG_TEST_BASE "lib/boomerang/plugins/");
+    project.getSettings()->decodeThruIndCall = true;
+    project.loadPlugins();
+
+    QVERIFY(project.loadBinaryFile(HELLO_CLANG4));
+    QVERIFY(project.decodeBinaryFile());
+
+    // frame_dummy is not called by main and was not decoded.
+    // The only entry of .init_array at 0x08049F08 points to it.
+    Prog *prog = project.getProg();
+    QVERIFY(prog->getFunctionByAddr(Address(0x080483C0)) == nullptr);
+
+    // call m[m[r24] + 4] where m[r24] is the address of the table with the function pointer
+    UserProc proc(Address(0x1000), "test", prog->getRootModule());
+
+    CallStatement *call = new CallStatement();
+    call->setIsComputed(true);
+    call->setDest(Location::memOf(
+        Binary::get(opPlus, Location::memOf(Location::regOf(REG_PENT_EAX)), Const::get(4))));
+    call->getDefCollector()->insert(new Assign(Location::memOf(Location::regOf(REG_PENT_EAX)),
+                                               Const::get(Address(0x08049F08))));
+
+    std::unique_ptr<RTLList> bbRTLs(new RTLList);
+    bbRTLs->push_back(std::unique_ptr<RTL>(new RTL(Address(0x1000), { call })));
+    proc.getCFG()->createBB(BBType::CompCall, std::move(bbRTLs));
+    proc.setEntryBB();
+
+    // Resolving an indirect call does not change the CFG of the caller
+    IndirectJumpAnalyzer analyzer;
+    QVERIFY(!analyzer.analyzeIndirectTransfers(&proc));
+
+    QCOMPARE(analyzer.getDecodedCallees().size(), std::size_t(1));
+    UserProc *callee = analyzer.getDecodedCallees().front();
+    QCOMPARE(callee->getEntryAddress(), Address(0x080483C0));
+    QVERIFY(callee->isDecoded());
+    QVERIFY(!callee->isDecompiled());
+}
+
+
+QTEST_GUILESS_MAIN(IndirectJumpAnalyzerTest)
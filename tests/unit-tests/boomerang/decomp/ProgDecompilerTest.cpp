@@ -0,0 +1,202 @@
+#pragma region License
+/*
+ * This file is part of the Boomerang Decompiler.
+ *
+ * See the file "LICENSE.TERMS" for information on usage and
+ * redistribution of this file, and for a DISCLAIMER OF ALL
+ * WARRANTIES.
+ */
+#pragma endregion License
+#include "ProgDecompilerTest.h"
+
+
+#include "boomerang/core/Project.h"
+#include "boomerang/core/Settings.h"
+#include "boomerang/core/Watcher.h"
+#include "boomerang/db/Prog.h"
+#include "boomerang/db/module/Module.h"
+#include "boomerang/db/proc/UserProc.h"
+#include "boomerang/ifc/ILogSink.h"
+#include "boomerang/ssl/statements/CallStatement.h"
+#include "boomerang/util/log/Log.h"
+
+#include <QFile>
+#include <QTemporaryDir>
+#include <QTextStream>
+
+#include <memory>
+
+
+#define HELLO_CLANG4      getFullSamplePath("elf/hello-clang4-dynamic")
+#define CALLCHAIN_PENTIUM getFullSamplePath("pentium/callchain")
+
+
+/// Everything written to the log while decompiling
+static QString g_log;
+
+
+/// Collects everything written to the log in g_log.
+class StringLogSink : public ILogSink
+{
+public:
+    void write(const QString &s) override { g_log += s; }
+    void flush() override {}
+};
+
+
+/// Checks that no proc is streamed out while one of its callers is still being decompiled.
+class StreamingWatcher : public IWatcher
+{
+public:
+    StreamingWatcher(Prog *prog)
+        : m_prog(prog)
+    {
+    }
+
+    void onEndDecompile(UserProc *) override
+    {
+        for (const auto &module : m_prog->getModuleList()) {
+            for (Function *func : *module) {
+                if (func->isLib() || !static_cast<UserProc *>(func)->isStateReleased()) {
+                    continue;
+                }
+
+                for (const CallStatement *caller : static_cast<UserProc *>(func)->getCallers()) {
+                    const ProcStatus status = caller->getProc()->getStatus();
+                    if (status >= PROC_VISITED && status < PROC_FINAL) {
+                        m_streamedTooEarly = true;
+                    }
+                }
+            }
+        }
+    }
+
+public:
+    bool m_streamedTooEarly = false;
+
+private:
+    Prog *m_prog;
+};
+
+
+static void decompileHello(Project &project)
+{
+    project.getSettings()->setDataDirectory(BOOMERANG_TEST_BASE "share/boomerang/");
+    project.getSettings()->setPluginDirectory(BOOMERANG_TEST_BASE "lib/boomerang/plugins/");
+    project.loadPlugins();
+
+    g_log.clear();
+    Log::getOrCreateLog().removeAllSinks();
+    Log::getOrCreateLog().addLogSink(std::make_unique<StringLogSink>());
+
+    QVERIFY(project.loadBinaryFile(HELLO_CLANG4));
+    QVERIFY(project.decodeBinaryFile());
+    QVERIFY(project.decompileBinaryFile());
+}
+
+
+void ProgDecompilerTest::testNoBudget()
+{
+    Project project;
+    decompileHello(project);
+
+    UserProc *main = static_cast<UserProc *>(project.getProg()->getFunctionByName("main"));
+    QVERIFY(main != nullptr);
+    QVERIFY(main->getDecompileNote().isEmpty());
+    QVERIFY(!g_log.contains("is incomplete"));
+}
+
+
+void ProgDecompilerTest::testProcPassBudget()
+{
+    // same as --proc-passes 1
+    Project project;
+    project.getSettings()->procPassBudget = 1;
+
+    decompileHello(project);
+
+    UserProc *main = static_cast<UserProc *>(project.getProg()->getFunctionByName("main"));
+    QVERIFY(main != nullptr);
+    QCOMPARE(main->getDecompileNote(),
+             QString("Decompilation incomplete: budget of 1 passes exceeded"));
+
+    // summary at the end of decompilation
+    QVERIFY(g_log.contains("procedures is incomplete:"));
+    QVERIFY(g_log.contains("main: Decompilation incomplete: budget of 1 passes exceeded"));
+}
+
+
+void ProgDecompilerTest::testStreamingBudget()
+{
+    QTemporaryDir outputDir;
+    QVERIFY(outputDir.isValid());
+
+    // same as --stream 1
+    Project project;
+    project.getSettings()->setDataDirectory(BOOMERANG_TEST_BASE "share/boomerang/");
+    project.getSettings()->setPluginDirectory(BOOMERANG_TEST_BASE "lib/boomerang/plugins/");
+    project.getSettings()->setOutputDirectory(outputDir.path());
+    project.getSettings()->streamDecompilation = true;
+    project.getSettings()->streamProcBudget    = 1;
+    project.loadPlugins();
+
+    QVERIFY(project.loadBinaryFile(CALLCHAIN_PENTIUM));
+    QVERIFY(project.decodeBinaryFile());
+
+    StreamingWatcher watcher(project.getProg());
+    project.addWatcher(&watcher, watchEventMask(WatchEvent::EndDecompile));
+    const bool decompiled = project.decompileBinaryFile();
+    project.removeWatcher(&watcher);
+
+    QVERIFY(decompiled);
+    QVERIFY(!watcher.m_streamedTooEarly);
+
+    // everything was streamed out at the end of decompilation
+    for (const auto &module : project.getProg()->getModuleList()) {
+        for (Function *func : *module) {
+            if (!func->isLib()) {
+                QVERIFY(static_cast<UserProc *>(func)->isDecompiled());
+                QVERIFY(static_cast<UserProc *>(func)->isStateReleased());
+            }
+        }
+    }
+
+    QVERIFY(project.generateCode());
+
+    QFile outFile(project.getProg()->getRootModule()->getOutPath("c"));
+    QVERIFY(outFile.open(QFile::ReadOnly | QFile::Text));
+    const QStringList lines = QTextStream(&outFile).readAll().split('\n');
+
+    // Each procedure is defined exactly once, and declared before it is called
+    for (const auto &module : project.getProg()->getModuleList()) {
+        for (Function *func : *module) {
+            if (func->isLib()) {
+                continue;
+            }
+
+            const QString name = func->getName() + "(";
+            int firstUse       = -1;
+            int numDefinitions = 0;
+
+            for (int i = 0; i < lines.size(); i++) {
+                if (!lines[i].contains(name)) {
+                    continue;
+                }
+                else if (firstUse == -1) {
+                    firstUse = i;
+                }
+
+                if (!lines[i].startsWith(' ') && !lines[i].endsWith(';')) {
+                    numDefinitions++;
+                }
+            }
+
+            QVERIFY(firstUse != -1);
+            QVERIFY(!lines[firstUse].startsWith(' ')); // a prototype or the definition
+            QCOMPARE(numDefinitions, 1);
+        }
+    }
+}
+
+
+QTEST_GUILESS_MAIN(ProgDecompilerTest)
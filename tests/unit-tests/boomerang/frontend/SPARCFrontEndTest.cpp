@@ -10,6 +10,7 @@
 #include "SPARCFrontEndTest.h"
 
 
+#include "boomerang/core/Settings.h"
 #include "boomerang/db/BasicBlock.h"
 #include "boomerang/db/proc/ProcCFG.h"
 #include "boomerang/db/proc/UserProc.h"
@@ -386,4 +387,58 @@ void SPARCFrontendTest::testDelaySlot()
     QCOMPARE(actual, expected);
 }
 
+
+void SPARCFrontendTest::testDecodeCache()
+{
+    // same as --decode-cache
+    Project project;
+    project.getSettings()->setDataDirectory(BOOMERANG_TEST_BASE "share/boomerang/");
+    project.getSettings()->setPluginDirectory(BOOMERANG_TEST_BASE "lib/boomerang/plugins/");
+    project.getSettings()->decodeCache     = true;
+    project.getSettings()->decodeCacheSize = 1;
+    project.loadPlugins();
+
+    QVERIFY(project.loadBinaryFile(HELLO_SPARC));
+    SPARCFrontEnd *fe = dynamic_cast<SPARCFrontEnd *>(project.getProg()->getFrontEnd());
+    QVERIFY(fe != nullptr);
+    QVERIFY(fe->isDecodeCacheEnabled());
+
+    bool    gotMain;
+    Address addr = fe->findMainEntryPoint(gotMain);
+    QVERIFY(addr != Address::INVALID);
+
+    DecodeResult first;
+    QVERIFY(fe->decodeSingleInstruction(addr, first));
+    QVERIFY(first.rtl != nullptr);
+    QCOMPARE(first.numBytes, 4);
+
+    // Only instructions that were actually decoded are cached
+    QVERIFY(fe->isInstructionCached(addr));
+    QVERIFY(!fe->isInstructionCached(addr + 4));
+
+    QString expected;
+    OStream expectedStrm(&expected);
+    first.rtl->print(expectedStrm);
+
+    // The cached RTL is not shared with the caller
+    first.rtl->clear();
+
+    DecodeResult second;
+    QVERIFY(fe->decodeSingleInstruction(addr, second));
+    QVERIFY(second.rtl != nullptr);
+    QCOMPARE(second.numBytes, 4);
+
+    QString actual;
+    OStream actualStrm(&actual);
+    second.rtl->print(actualStrm);
+    QCOMPARE(actual, expected);
+
+    // The cache is full, so the next instruction is decoded but not cached
+    DecodeResult next;
+    QVERIFY(fe->decodeSingleInstruction(addr + 4, next));
+    QVERIFY(next.rtl != nullptr);
+    QVERIFY(!fe->isInstructionCached(addr + 4));
+}
+
+
 QTEST_GUILESS_MAIN(SPARCFrontendTest)
@@ -23,4 +23,5 @@ private slots:
     void test3();
     void testBranch();
     void testDelaySlot();
+    void testDecodeCache();
 };
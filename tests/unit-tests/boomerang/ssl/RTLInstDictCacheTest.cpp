@@ -0,0 +1,133 @@
+#pragma region License
+/*
+ * This file is part of the Boomerang Decompiler.
+ *
+ * See the file "LICENSE.TERMS" for information on usage and
+ * redistribution of this file, and for a DISCLAIMER OF ALL
+ * WARRANTIES.
+ */
+#pragma endregion License
+#include "RTLInstDictCacheTest.h"
+
+
+#include "boomerang/ssl/RTL.h"
+#include "boomerang/ssl/RTLInstDict.h"
+#include "boomerang/ssl/RTLInstDictCache.h"
+#include "boomerang/ssl/exp/Const.h"
+#include "boomerang/ssl/exp/Location.h"
+#include "boomerang/util/OStream.h"
+
+#include <QFile>
+#include <QTemporaryDir>
+
+
+#define SPARC_SSL BOOMERANG_TEST_BASE "share/boomerang/ssl/sparc.ssl"
+
+
+static QString instantiate(RTLInstDict &dict, const QString &name, int numParams)
+{
+    const std::vector<SharedExp> actuals = { Location::regOf(8), Const::get(4),
+                                             Location::regOf(9) };
+
+    std::unique_ptr<RTL> rtl = dict.instantiateRTL(
+        name, Address(0x1000), std::vector<SharedExp>(actuals.begin(), actuals.begin() + numParams));
+
+    if (!rtl) {
+        return QString();
+    }
+
+    QString result;
+    OStream os(&result);
+    rtl->print(os);
+    return result;
+}
+
+
+static void compareDicts(RTLInstDict &expected, RTLInstDict &actual)
+{
+    for (int regID = 0; regID < 100; regID++) {
+        QCOMPARE(actual.getRegNameByID(regID), expected.getRegNameByID(regID));
+        QCOMPARE(actual.getRegSizeByID(regID), expected.getRegSizeByID(regID));
+    }
+
+    const std::pair<QString, int> instructions[] = {
+        { "LD", 2 }, { "ADDCC", 3 }, { "UMUL", 3 }, { "SDIVCC", 3 }
+    };
+
+    for (const auto &[name, numParams] : instructions) {
+        QCOMPARE(actual.getSignature(name), expected.getSignature(name));
+        QCOMPARE(expected.getSignature(name).second, DWord(numParams));
+
+        const QString expectedRTL = instantiate(expected, name, numParams);
+        QVERIFY(!expectedRTL.isEmpty());
+        QCOMPARE(instantiate(actual, name, numParams), expectedRTL);
+    }
+}
+
+
+void RTLInstDictCacheTest::testSaveLoad()
+{
+    QTemporaryDir cacheDir;
+    QVERIFY(cacheDir.isValid());
+
+    const QByteArray sslHash = RTLInstDictCache::hashSSLFile(SPARC_SSL);
+    QVERIFY(!sslHash.isEmpty());
+
+    const QString cacheFile = RTLInstDictCache::getCacheFilePath(cacheDir.path(), SPARC_SSL,
+                                                                 sslHash);
+
+    RTLInstDict parsed;
+    QVERIFY(parsed.readSSLFile(SPARC_SSL));
+
+    // creates the cache file
+    RTLInstDict first;
+    QVERIFY(first.readSSLFile(SPARC_SSL, cacheDir.path()));
+    QVERIFY(QFile::exists(cacheFile));
+
+    RTLInstDict loaded;
+    QVERIFY(RTLInstDictCache::load(loaded, cacheFile, sslHash));
+    compareDicts(parsed, loaded);
+
+    // the cache file is only valid for the same SSL file
+    RTLInstDict other;
+    QVERIFY(!RTLInstDictCache::load(other, cacheFile, QByteArray("other hash")));
+
+    RTLInstDict cached;
+    QVERIFY(cached.readSSLFile(SPARC_SSL, cacheDir.path()));
+    compareDicts(parsed, cached);
+}
+
+
+void RTLInstDictCacheTest::testInvalidCache()
+{
+    QTemporaryDir cacheDir;
+    QVERIFY(cacheDir.isValid());
+
+    const QByteArray sslHash = RTLInstDictCache::hashSSLFile(SPARC_SSL);
+    const QString cacheFile  = RTLInstDictCache::getCacheFilePath(cacheDir.path(), SPARC_SSL,
+                                                                  sslHash);
+
+    {
+        QFile file(cacheFile);
+        QVERIFY(file.open(QFile::WriteOnly));
+        file.write("this is not a cache file");
+    }
+
+    RTLInstDict damaged;
+    QVERIFY(!RTLInstDictCache::load(damaged, cacheFile, sslHash));
+
+    // falls back to parsing and replaces the damaged file
+    RTLInstDict dict;
+    QVERIFY(dict.readSSLFile(SPARC_SSL, cacheDir.path()));
+
+    RTLInstDict parsed;
+    QVERIFY(parsed.readSSLFile(SPARC_SSL));
+    compareDicts(parsed, dict);
+
+    RTLInstDict loaded;
+    QVERIFY(RTLInstDictCache::load(loaded, cacheFile, sslHash));
+    compareDicts(parsed, loaded);
+}
+
+
+QTEST_GUILESS_MAIN(RTLInstDictCacheTest)
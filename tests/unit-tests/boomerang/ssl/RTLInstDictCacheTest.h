@@ -0,0 +1,26 @@
+#pragma region License
+/*
+ * This file is part of the Boomerang Decompiler.
+ *
+ * See the file "LICENSE.TERMS" for information on usage and
+ * redistribution of this file, and for a DISCLAIMER OF ALL
+ * WARRANTIES.
+ */
+#pragma endregion License
+#pragma once
+
+
+#include "TestUtils.h"
+
+
+class RTLInstDictCacheTest : public BoomerangTest
+{
+    Q_OBJECT
+
+private slots:
+    /// A dictionary read from the cache must be the same as the parsed dictionary
+    void testSaveLoad();
+
+    /// Damaged or outdated cache files must be ignored and replaced
+    void testInvalidCache();
+};
@@ -0,0 +1,115 @@
+#pragma region License
+/*
+ * This file is part of the Boomerang Decompiler.
+ *
+ * See the file "LICENSE.TERMS" for information on usage and
+ * redistribution of this file, and for a DISCLAIMER OF ALL
+ * WARRANTIES.
+ */
+#pragma endregion License
+#include "RegisterAliasModelTest.h"
+
+
+#include "boomerang/ssl/RTLInstDict.h"
+#include "boomerang/ssl/RegisterAliasModel.h"
+
+
+#define X86_SSL BOOMERANG_TEST_BASE "share/boomerang/ssl/x86.ssl"
+
+
+static Register makeReg(const QString &name, int size, int mappedIndex = -1,
+                        int mappedOffset = -1)
+{
+    Register reg(name, size, false);
+    reg.setMappedIndex(mappedIndex);
+    reg.setMappedOffset(mappedOffset);
+    return reg;
+}
+
+
+void RegisterAliasModelTest::testCompile()
+{
+    std::map<int, Register> regInfo;
+    regInfo[0] = makeReg("%r0", 32);
+    regInfo[1] = makeReg("%r1", 32);
+    regInfo[2] = makeReg("%r0lo", 16, 0, 0);
+    regInfo[3] = makeReg("%r0hi", 16, 0, 16);
+    regInfo[4] = makeReg("%r0b1", 8, 2, 8);
+    regInfo[5] = makeReg("%r0r1", 64, 0, 0); // COVERS %r0 to %r1
+
+    RegisterAliasModel model;
+    QVERIFY(model.isEmpty());
+
+    model.compile(regInfo);
+    QCOMPARE(model.getNumAliasedRegs(), 4);
+    QVERIFY(model.isAliased(0));
+    QVERIFY(!model.isAliased(1));
+    QVERIFY(!model.isAliased(5));
+    QVERIFY(!model.isAliased(-1));
+    QVERIFY(!model.isAliased(1000));
+
+    QCOMPARE(model.getRootReg(4), 0);
+    QCOMPARE(model.getRootReg(1), 1);
+    QCOMPARE(model.getBitOffset(3), 16);
+    QCOMPARE(model.getBitOffset(4), 8);
+    QCOMPARE(model.getSize(4), 8);
+    QCOMPARE(model.getSize(1), 0);
+
+    RegisterAliasModel::RegMask all = model.createMask();
+    for (int regID = 0; regID < 6; regID++) {
+        model.addToMask(all, regID);
+    }
+
+    QVERIFY(model.isInMask(all, 4));
+    QVERIFY(!model.isInMask(all, 1));
+
+    QCOMPARE(model.getOverlappingRegs(0, all), std::vector<int>({ 2, 3, 4 }));
+    QCOMPARE(model.getOverlappingRegs(2, all), std::vector<int>({ 0, 4 }));
+    QCOMPARE(model.getOverlappingRegs(3, all), std::vector<int>({ 0 }));
+    QCOMPARE(model.getOverlappingRegs(4, all), std::vector<int>({ 0, 2 }));
+    QCOMPARE(model.getOverlappingRegs(1, all), std::vector<int>());
+
+    // only registers in the filter are reported
+    RegisterAliasModel::RegMask used = model.createMask();
+    model.addToMask(used, 4);
+    QCOMPARE(model.getOverlappingRegs(0, used), std::vector<int>({ 4 }));
+    QCOMPARE(model.getOverlappingRegs(3, used), std::vector<int>());
+
+    model.clear();
+    QVERIFY(model.isEmpty());
+    QVERIFY(!model.isAliased(0));
+}
+
+
+void RegisterAliasModelTest::testX86Aliases()
+{
+    RTLInstDict dict;
+    QVERIFY(dict.readSSLFile(X86_SSL));
+
+    const RegisterAliasModel &model = dict.getRegisterAliases();
+    QVERIFY(!model.isEmpty());
+
+    const int eax = dict.getRegIDByName("%eax");
+    const int ax  = dict.getRegIDByName("%ax");
+    const int al  = dict.getRegIDByName("%al");
+    const int ah  = dict.getRegIDByName("%ah");
+    const int ebx = dict.getRegIDByName("%ebx");
+
+    QCOMPARE(model.getRootReg(ah), eax);
+    QCOMPARE(model.getBitOffset(ah), 8);
+    QCOMPARE(model.getBitOffset(al), 0);
+    QCOMPARE(model.getSize(ax), 16);
+
+    RegisterAliasModel::RegMask used = model.createMask();
+    model.addToMask(used, eax);
+    model.addToMask(used, al);
+    model.addToMask(used, ah);
+    model.addToMask(used, ebx);
+
+    // %al and %ah do not overlap each other
+    QCOMPARE(model.getOverlappingRegs(al, used), std::vector<int>({ eax }));
+    QCOMPARE(model.getOverlappingRegs(ax, used), std::vector<int>({ al, ah, eax }));
+}
+
+
+QTEST_GUILESS_MAIN(RegisterAliasModelTest)
@@ -0,0 +1,26 @@
+#pragma region License
+/*
+ * This file is part of the Boomerang Decompiler.
+ *
+ * See the file "LICENSE.TERMS" for information on usage and
+ * redistribution of this file, and for a DISCLAIMER OF ALL
+ * WARRANTIES.
+ */
+#pragma endregion License
+#pragma once
+
+
+#include "TestUtils.h"
+
+
+class RegisterAliasModelTest : public BoomerangTest
+{
+    Q_OBJECT
+
+private slots:
+    /// Test compiling SHARES and COVERS registers into the model
+    void testCompile();
+
+    /// Test the register aliases of the x86 SSL file
+    void testX86Aliases();
+};
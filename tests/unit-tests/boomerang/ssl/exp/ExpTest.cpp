@@ -10,6 +10,7 @@
 #include "ExpTest.h"
 
 
+#include "boomerang/db/proc/LibProc.h"
 #include "boomerang/ssl/exp/Const.h"
 #include "boomerang/ssl/exp/Location.h"
 #include "boomerang/ssl/exp/RefExp.h"
@@ -17,11 +18,13 @@
 #include "boomerang/ssl/exp/Ternary.h"
 #include "boomerang/ssl/exp/TypedExp.h"
 #include "boomerang/ssl/statements/Assign.h"
+#include "boomerang/ssl/statements/ImplicitAssign.h"
 #include "boomerang/visitor/expvisitor/FlagsFinder.h"
 #include "boomerang/ssl/type/IntegerType.h"
 #include "boomerang/ssl/type/CharType.h"
 #include "boomerang/ssl/type/PointerType.h"
 #include "boomerang/ssl/type/FloatType.h"
+#include "boomerang/ssl/type/VoidType.h"
 #include "boomerang/util/LocationSet.h"
 
 #include <map>
@@ -60,6 +63,37 @@ void ExpTest::testFlt()
 }
 
 
+void ExpTest::testConstExtraData()
+{
+    std::shared_ptr<Const> c = Const::get(5);
+    QVERIFY(c->getType()->isVoid());
+    QCOMPARE(c->getOutOfLineSize(), std::size_t(0));
+
+    c->setType(IntegerType::get(32, Sign::Signed));
+    QVERIFY(*c->getType() == *IntegerType::get(32, Sign::Signed));
+    QVERIFY(c->getOutOfLineSize() > 0);
+
+    // changing the type of the original must not change the type of a copy
+    std::shared_ptr<Const> copy = c->clone()->access<Const>();
+    QVERIFY(copy->getType()->resolvesToInteger());
+
+    c->setType(VoidType::get());
+    QVERIFY(c->getType()->isVoid());
+    QCOMPARE(c->getOutOfLineSize(), std::size_t(0));
+    QVERIFY(copy->getType()->resolvesToInteger());
+
+    std::shared_ptr<Const> str = Const::get(QString("hello"));
+    QCOMPARE(str->getStr(), QString("hello"));
+    QVERIFY(*str == *Const::get(QString("hello")));
+    QVERIFY(!(*str == *Const::get(QString("world"))));
+
+    str->setStr("world");
+    QCOMPARE(str->getStr(), QString("world"));
+    QVERIFY(str->ascendType()->resolvesToPointer());
+    QVERIFY(str->getType()->resolvesToPointer());
+}
+
+
 void ExpTest::testRegOf2()
 {
     QString     actual;
@@ -528,6 +562,66 @@ void ExpTest::testMapOfExp()
 }
 
 
+void ExpTest::testHashMapOfExp()
+{
+    SharedExp e1 = Binary::get(opPlus, Location::regOf(REG_PENT_ECX), Const::get(4));
+    SharedExp e2 = e1->clone();
+    QCOMPARE(e1->hash(), e2->hash());
+
+    ExpHashMap<int> m;
+    m[e1] = 1;
+    QCOMPARE(m.size(), static_cast<size_t>(1));
+    QCOMPARE(m.count(e2), static_cast<size_t>(1));
+
+    // the hash must follow in-place modifications of subexpressions
+    e2->access<Const, 2>()->setInt(8);
+    QVERIFY(*e1 != *e2);
+    QCOMPARE(m.count(e2), static_cast<size_t>(0));
+    m[e2] = 2;
+    QCOMPARE(m.size(), static_cast<size_t>(2));
+
+    e2->access<Const, 2>()->setInt(4);
+    QCOMPARE(e1->hash(), e2->hash());
+
+    // the cached hash is invalidated by modifications through the subexpression accessors
+    SharedExp e3 = e1->clone();
+    QCOMPARE(e3->hash(), e1->hash());
+    e3->getSubExp1()->setOper(opTemp);
+    QCOMPARE(e3->hash(), e3->clone()->hash());
+    QCOMPARE(m.count(e3), static_cast<size_t>(0));
+
+    // function pointer constants are valid keys
+    LibProc proc1(Address(0x1000), "foo", nullptr);
+    LibProc proc2(Address(0x2000), "bar", nullptr);
+
+    ExpHashMap<int> funcs;
+    funcs[Const::get(&proc1)] = 1;
+    funcs[Const::get(&proc2)] = 2;
+    QCOMPARE(funcs.size(), static_cast<size_t>(2));
+    QCOMPARE(funcs[Const::get(&proc1)], 1);
+
+    // x{-} and x{implicit} compare equal, but are different keys
+    SharedExp ecx = Location::regOf(REG_PENT_ECX);
+    ImplicitAssign imp(ecx);
+    SharedExp ref1 = RefExp::get(ecx, nullptr);
+    SharedExp ref2 = RefExp::get(ecx, &imp);
+    QVERIFY(*ref1 == *ref2);
+    QVERIFY(!equalExpStar()(ref1, ref2));
+
+    ExpHashMap<int> refs;
+    refs[ref1] = 1;
+    refs[ref2] = 2;
+    QCOMPARE(refs.size(), static_cast<size_t>(2));
+
+    // wildcards only match themselves
+    SharedExp wild = RefExp::get(ecx, STMT_WILD);
+    QVERIFY(*wild == *ref2);
+    QVERIFY(!equalExpStar()(wild, ref2));
+    QVERIFY(equalExpStar()(wild, RefExp::get(ecx->clone(), STMT_WILD)));
+    QVERIFY(!equalExpStar()(Terminal::get(opWild), ecx));
+}
+
+
 void ExpTest::testList()
 {
     QCOMPARE(Binary::get(opList, Terminal::get(opNil), Terminal::get(opNil))->toString(), QString(""));
@@ -37,6 +37,9 @@ private slots:
     /// Test float constant
     void testFlt();
 
+    /// Test string values and types of constants, which are not stored in the constant itself
+    void testConstExtraData();
+
     /**
      * Tests r[2], which is used in many tests. Also tests opRegOf,
      * and ostream::operator&(Exp*)
@@ -102,6 +105,9 @@ private slots:
     /// Test maps of Exp*s; exercises some comparison operators
     void testMapOfExp();
 
+    /// Test structural hashes and ExpHashMap lookups
+    void testHashMapOfExp();
+
     /// Test the opList creating and printing
     void testList();
 
@@ -0,0 +1,93 @@
+#pragma region License
+/*
+ * This file is part of the Boomerang Decompiler.
+ *
+ * See the file "LICENSE.TERMS" for information on usage and
+ * redistribution of this file, and for a DISCLAIMER OF ALL
+ * WARRANTIES.
+ */
+#pragma endregion License
+#include "BytePatternSetTest.h"
+
+
+#include "boomerang/util/BytePatternSet.h"
+
+
+void BytePatternSetTest::testAddPattern()
+{
+    BytePatternSet patterns;
+    QCOMPARE(patterns.size(), 0);
+
+    QCOMPARE(patterns.addPattern("55 89 E5"), 0);
+    QCOMPARE(patterns.addPattern("5589e5??c3"), 1);
+    QCOMPARE(patterns.size(), 2);
+    QCOMPARE(patterns.getPatternLength(1), 5);
+    QCOMPARE(patterns.getNumFixedBytes(1), 4);
+
+    QCOMPARE(patterns.addPattern(""), -1);
+    QCOMPARE(patterns.addPattern("55 8"), -1);     // odd number of digits
+    QCOMPARE(patterns.addPattern("55 XY"), -1);    // not hexadecimal
+    QCOMPARE(patterns.addPattern("?? ?? ??"), -1); // no fixed byte
+    QCOMPARE(patterns.size(), 2);
+}
+
+
+void BytePatternSetTest::testExactMatch()
+{
+    BytePatternSet patterns;
+    patterns.addPattern("55 89 E5");
+
+    const Byte data[] = { 0x90, 0x55, 0x89, 0xE5, 0xC3, 0x55, 0x89, 0x55, 0x89, 0xE5 };
+
+    const auto matches = patterns.findAllMatches(data, sizeof(data));
+
+    QCOMPARE(matches.size(), static_cast<std::size_t>(2));
+    QCOMPARE(matches[0].first, static_cast<std::size_t>(1));
+    QCOMPARE(matches[1].first, static_cast<std::size_t>(7));
+
+    QVERIFY(patterns.findAllMatches(data, 3).empty());
+    QVERIFY(patterns.findAllMatches(nullptr, 0).empty());
+}
+
+
+void BytePatternSetTest::testWildcards()
+{
+    BytePatternSet patterns;
+    patterns.addPattern("E8 ?? ?? ?? ?? 85 C0");
+    patterns.addPattern("?? 89 E5"); // wildcard before the anchor
+
+    const Byte data[] = { 0x55, 0x89, 0xE5, 0xE8, 0x10, 0x20, 0x30, 0x40, 0x85, 0xC0, 0xE8, 0x85 };
+
+    const auto matches = patterns.findAllMatches(data, sizeof(data));
+
+    QCOMPARE(matches.size(), static_cast<std::size_t>(2));
+    QVERIFY(matches[0] == std::make_pair(static_cast<std::size_t>(0), 1));
+    QVERIFY(matches[1] == std::make_pair(static_cast<std::size_t>(3), 0));
+
+    // The pattern must not extend past the end of the data
+    QVERIFY(patterns.findAllMatches(data + 3, 6).empty());
+
+    // The wildcard of pattern 1 would start before the data
+    QVERIFY(patterns.findAllMatches(data + 1, 2).empty());
+}
+
+
+void BytePatternSetTest::testOverlappingPatterns()
+{
+    BytePatternSet patterns;
+    patterns.addPattern("89 E5 83");
+    patterns.addPattern("55 89 E5 83 EC");
+    patterns.addPattern("E5 83");
+
+    const Byte data[] = { 0x55, 0x89, 0xE5, 0x83, 0xEC };
+
+    const auto matches = patterns.findAllMatches(data, sizeof(data));
+
+    QCOMPARE(matches.size(), static_cast<std::size_t>(3));
+    QVERIFY(matches[0] == std::make_pair(static_cast<std::size_t>(0), 1));
+    QVERIFY(matches[1] == std::make_pair(static_cast<std::size_t>(1), 0));
+    QVERIFY(matches[2] == std::make_pair(static_cast<std::size_t>(2), 2));
+}
+
+
+QTEST_GUILESS_MAIN(BytePatternSetTest)
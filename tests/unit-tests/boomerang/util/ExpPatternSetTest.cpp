@@ -0,0 +1,117 @@
+#pragma region License
+/*
+ * This file is part of the Boomerang Decompiler.
+ *
+ * See the file "LICENSE.TERMS" for information on usage and
+ * redistribution of this file, and for a DISCLAIMER OF ALL
+ * WARRANTIES.
+ */
+#pragma endregion License
+#include "ExpPatternSetTest.h"
+
+
+#include "boomerang/ssl/exp/Binary.h"
+#include "boomerang/ssl/exp/Const.h"
+#include "boomerang/ssl/exp/Location.h"
+#include "boomerang/ssl/exp/RefExp.h"
+#include "boomerang/ssl/exp/Terminal.h"
+#include "boomerang/ssl/statements/Assign.h"
+#include "boomerang/util/ExpPatternSet.h"
+
+
+void ExpPatternSetTest::testEmpty()
+{
+    ExpPatternSet patterns;
+    QCOMPARE(patterns.size(), 0);
+    QCOMPARE(patterns.findFirstMatch(Location::regOf(REG_PENT_EAX)), -1);
+    QVERIFY(patterns.findAllMatches(Location::regOf(REG_PENT_EAX)).empty());
+}
+
+
+void ExpPatternSetTest::testExactMatch()
+{
+    ExpPatternSet patterns = { Binary::get(opPlus, Location::regOf(REG_PENT_EAX), Const::get(4)),
+                               Binary::get(opPlus, Location::regOf(REG_PENT_EAX), Const::get(8)) };
+
+    QCOMPARE(patterns.size(), 2);
+    QCOMPARE(patterns.findFirstMatch(
+                 Binary::get(opPlus, Location::regOf(REG_PENT_EAX), Const::get(4))),
+             0);
+    QCOMPARE(patterns.findFirstMatch(
+                 Binary::get(opPlus, Location::regOf(REG_PENT_EAX), Const::get(8))),
+             1);
+    QCOMPARE(patterns.findFirstMatch(
+                 Binary::get(opPlus, Location::regOf(REG_PENT_ECX), Const::get(4))),
+             -1);
+    QCOMPARE(patterns.findFirstMatch(
+                 Binary::get(opMinus, Location::regOf(REG_PENT_EAX), Const::get(4))),
+             -1);
+    QCOMPARE(patterns.findFirstMatch(Location::regOf(REG_PENT_EAX)), -1);
+}
+
+
+void ExpPatternSetTest::testWildcards()
+{
+    // m[<expr> * 4 + K]
+    ExpPatternSet patterns = { Location::memOf(
+        Binary::get(opPlus, Binary::get(opMult, Terminal::get(opWild), Const::get(4)),
+                    Terminal::get(opWildIntConst))) };
+
+    SharedExp matching = Location::memOf(Binary::get(
+        opPlus,
+        Binary::get(opMult, Binary::get(opMinus, Location::regOf(REG_PENT_EAX), Const::get(1)),
+                    Const::get(4)),
+        Const::get(0x8048000)));
+
+    SharedExp notMatching = Location::memOf(
+        Binary::get(opPlus, Binary::get(opMult, Location::regOf(REG_PENT_EAX), Const::get(4)),
+                    Location::regOf(REG_PENT_EBX)));
+
+    QCOMPARE(patterns.findFirstMatch(matching), 0);
+    QCOMPARE(patterns.findFirstMatch(notMatching), -1);
+
+    // opWildMemOf matches the whole memof
+    patterns.addPattern(Binary::get(opPlus, Terminal::get(opWildMemOf), Const::get(4)));
+    QCOMPARE(patterns.findFirstMatch(Binary::get(opPlus, matching, Const::get(4))), 1);
+    QCOMPARE(patterns.findFirstMatch(
+                 Binary::get(opPlus, Location::regOf(REG_PENT_EAX), Const::get(4))),
+             -1);
+}
+
+
+void ExpPatternSetTest::testSubscripts()
+{
+    Assign asgn(Location::regOf(REG_PENT_EAX), Const::get(5));
+
+    SharedExp pattern = Location::memOf(
+        Binary::get(opPlus, RefExp::get(Terminal::get(opWild), STMT_WILD), Const::get(4)));
+    ExpPatternSet patterns = { pattern };
+
+    SharedExp exp = RefExp::get(
+        Location::memOf(
+            Binary::get(opPlus, RefExp::get(Location::regOf(REG_PENT_EAX), &asgn), Const::get(4))),
+        nullptr);
+
+    // same result as the subscript-insensitive comparison
+    QVERIFY(*exp *= *pattern);
+    QCOMPARE(patterns.findFirstMatch(exp), 0);
+}
+
+
+void ExpPatternSetTest::testMultipleMatches()
+{
+    ExpPatternSet patterns = { Location::memOf(Terminal::get(opWild)),
+                               Location::memOf(Location::regOf(REG_PENT_ESP)),
+                               Terminal::get(opWildMemOf),
+                               Location::memOf(Location::regOf(REG_PENT_EAX)) };
+
+    const std::vector<int> matches = patterns.findAllMatches(
+        Location::memOf(Location::regOf(REG_PENT_ESP)));
+
+    QCOMPARE(matches, std::vector<int>({ 0, 1, 2 }));
+    QCOMPARE(patterns.findFirstMatch(Location::memOf(Location::regOf(REG_PENT_EAX))), 0);
+    QCOMPARE(patterns.findFirstMatch(Location::regOf(REG_PENT_EAX)), -1);
+}
+
+
+QTEST_GUILESS_MAIN(ExpPatternSetTest)
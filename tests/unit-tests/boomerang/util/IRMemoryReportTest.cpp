@@ -0,0 +1,78 @@
+#pragma region License
+/*
+ * This file is part of the Boomerang Decompiler.
+ *
+ * See the file "LICENSE.TERMS" for information on usage and
+ * redistribution of this file, and for a DISCLAIMER OF ALL
+ * WARRANTIES.
+ */
+#pragma endregion License
+#include "IRMemoryReportTest.h"
+
+
+#include "boomerang/ssl/exp/Binary.h"
+#include "boomerang/ssl/exp/Const.h"
+#include "boomerang/ssl/exp/Location.h"
+#include "boomerang/ssl/statements/Assign.h"
+#include "boomerang/util/IRMemoryReport.h"
+#include "boomerang/util/OStream.h"
+
+
+void IRMemoryReportTest::testAddExp()
+{
+    IRMemoryReport report;
+
+    // m[r28 + 4] + m[r28 + 4], with both operands being the same node
+    SharedExp mem = Location::memOf(Binary::get(opPlus,
+                                                Location::regOf(REG_PENT_ESP),
+                                                Const::get(4)));
+    SharedExp exp = Binary::get(opPlus, mem, mem);
+
+    report.addExp(exp);
+
+    QCOMPARE(report.getEntry("Binary").count, std::size_t(2));
+    QCOMPARE(report.getEntry("Binary").bytes, 2 * sizeof(Binary));
+    QCOMPARE(report.getEntry("Location").count, std::size_t(2));
+    QCOMPARE(report.getEntry("Const").count, std::size_t(2));
+    QCOMPARE(report.getEntry("Terminal").count, std::size_t(0));
+
+    // adding the same expression again does not change anything
+    report.addExp(mem);
+    QCOMPARE(report.getEntry("Location").count, std::size_t(2));
+    QCOMPARE(report.getNumStatements(), std::size_t(0));
+}
+
+
+void IRMemoryReportTest::testAddStatement()
+{
+    IRMemoryReport report;
+
+    Assign asgn(Location::regOf(REG_PENT_EAX), Const::get(5));
+    report.addStatement(&asgn);
+
+    QCOMPARE(report.getNumStatements(), std::size_t(1));
+    QCOMPARE(report.getEntry("Assign").count, std::size_t(1));
+    QCOMPARE(report.getEntry("Location").count, std::size_t(1));
+    QCOMPARE(report.getEntry("Const").count, std::size_t(2)); // 5 and the register number
+    QCOMPARE(report.getTotalBytes(), sizeof(Assign) + sizeof(Location) + 2 * sizeof(Const));
+}
+
+
+void IRMemoryReportTest::testPrint()
+{
+    IRMemoryReport report;
+
+    Assign asgn(Location::regOf(REG_PENT_EAX), Const::get(5));
+    report.addStatement(&asgn);
+
+    QString actual;
+    OStream os(&actual);
+    report.print(os);
+
+    QVERIFY(actual.contains("Assign"));
+    QVERIFY(actual.contains("Const"));
+    QVERIFY(actual.contains("bytes per statement"));
+}
+
+
+QTEST_GUILESS_MAIN(IRMemoryReportTest)
@@ -699,4 +699,64 @@ void ExpSimplifierTest::testSimplify_data()
     }
 }
 
+
+void ExpSimplifierTest::testSimplifyModified()
+{
+    SharedExp exp = Binary::get(opPlus,
+                                Location::regOf(REG_PENT_EAX),
+                                Binary::get(opMult, Const::get(2), Const::get(3)));
+
+    exp = exp->simplify();
+    QCOMPARE(exp->toString(), Binary::get(opPlus, Location::regOf(REG_PENT_EAX), Const::get(6))->toString());
+
+    // simplifying again does not change anything
+    exp = exp->simplify();
+    QCOMPARE(exp->toString(), Binary::get(opPlus, Location::regOf(REG_PENT_EAX), Const::get(6))->toString());
+
+    // modify a subexpression in place
+    exp->access<Const, 2>()->setInt(0);
+    exp = exp->simplify();
+    QCOMPARE(exp->toString(), Location::regOf(REG_PENT_EAX)->toString());
+
+    // replace a subexpression
+    exp = Binary::get(opPlus, exp, Const::get(4))->simplify();
+    bool change = false;
+    exp = exp->searchReplaceAll(*Location::regOf(REG_PENT_EAX), Const::get(6), change);
+    QVERIFY(change);
+    exp = exp->simplify();
+    QCOMPARE(exp->toString(), Const::get(10)->toString());
+}
+
+
+void ExpSimplifierTest::testSimplifySharedSubtree()
+{
+    SharedExp shared = Binary::get(opPlus, Location::regOf(REG_PENT_EAX), Const::get(4));
+    SharedExp exp1   = Location::memOf(shared);
+    SharedExp exp2   = Binary::get(opMult, shared, Location::regOf(REG_PENT_ECX));
+
+    exp1 = exp1->simplify();
+    exp2 = exp2->simplify();
+    QVERIFY(exp1->isSimplified());
+    QVERIFY(exp2->isSimplified());
+    QVERIFY(exp1->getSubExp1() == shared);
+    QVERIFY(exp2->getSubExp1() == shared);
+
+    // r24 + -4 is changed to r24 - 4 in place when simplifying exp1
+    exp1->access<Const, 1, 2>()->setInt(-4);
+    QVERIFY(!exp1->isSimplified());
+    exp1 = exp1->simplify();
+    QVERIFY(exp1->isSimplified());
+    QVERIFY(exp1->getSubExp1() == shared);
+    QCOMPARE(exp1->toString(), Location::memOf(Binary::get(opMinus,
+        Location::regOf(REG_PENT_EAX), Const::get(4)))->toString());
+
+    // exp2 sees the simplified subexpression
+    exp2 = exp2->simplify();
+    QVERIFY(exp2->getSubExp1() == shared);
+    QCOMPARE(exp2->toString(), Binary::get(opMult,
+        Binary::get(opMinus, Location::regOf(REG_PENT_EAX), Const::get(4)),
+        Location::regOf(REG_PENT_ECX))->toString());
+}
+
+
 QTEST_GUILESS_MAIN(ExpSimplifierTest)
@@ -20,4 +20,11 @@ class ExpSimplifierTest : public BoomerangTest
 private slots:
     void testSimplify();
     void testSimplify_data();
+
+    /// Test that expressions modified after they were simplified are simplified again
+    void testSimplifyModified();
+
+    /// Test that a subexpression shared by two expressions and modified through one of them
+    /// is simplified in place, so the other one sees the simplified form
+    void testSimplifySharedSubtree();
 };
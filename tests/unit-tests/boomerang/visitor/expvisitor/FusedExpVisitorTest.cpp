@@ -0,0 +1,172 @@
+#pragma region License
+/*
+ * This file is part of the Boomerang Decompiler.
+ *
+ * See the file "LICENSE.TERMS" for information on usage and
+ * redistribution of this file, and for a DISCLAIMER OF ALL
+ * WARRANTIES.
+ */
+#pragma endregion License
+#include "FusedExpVisitorTest.h"
+
+
+#include "boomerang/ssl/exp/Binary.h"
+#include "boomerang/ssl/exp/Const.h"
+#include "boomerang/ssl/exp/Location.h"
+#include "boomerang/ssl/exp/RefExp.h"
+#include "boomerang/ssl/exp/Terminal.h"
+#include "boomerang/ssl/statements/Assign.h"
+#include "boomerang/visitor/expvisitor/BadMemofFinder.h"
+#include "boomerang/visitor/expvisitor/FlagsFinder.h"
+#include "boomerang/visitor/expvisitor/FusedExpVisitor.h"
+
+
+/// Records all calls; optionally skips the children of memofs
+/// or aborts when visiting a certain constant.
+class TraceVisitor : public RawExpVisitor
+{
+public:
+    TraceVisitor(bool skipMemOf, int abortAt)
+        : m_skipMemOf(skipMemOf)
+        , m_abortAt(abortAt)
+    {}
+
+public:
+    bool preVisit(const Binary &exp, bool &visitChildren) override
+    {
+        m_trace << QString("pre ") + exp.getOperName();
+        visitChildren = true;
+        return true;
+    }
+
+    bool preVisit(const RefExp &exp, bool &visitChildren) override
+    {
+        m_trace << QString("pre ") + exp.getOperName();
+        visitChildren = true;
+        return true;
+    }
+
+    bool preVisit(const Location &exp, bool &visitChildren) override
+    {
+        m_trace << QString("pre ") + exp.getOperName();
+        visitChildren = !(m_skipMemOf && exp.isMemOf());
+        return true;
+    }
+
+    bool postVisit(const Binary &exp) override
+    {
+        m_trace << QString("post ") + exp.getOperName();
+        return true;
+    }
+
+    bool postVisit(const RefExp &exp) override
+    {
+        m_trace << QString("post ") + exp.getOperName();
+        return true;
+    }
+
+    bool postVisit(const Location &exp) override
+    {
+        m_trace << QString("post ") + exp.getOperName();
+        return true;
+    }
+
+    bool visit(const Const &exp) override
+    {
+        m_trace << QString("visit %1").arg(exp.getInt());
+        return exp.getInt() != m_abortAt;
+    }
+
+    bool visit(const Terminal &exp) override
+    {
+        m_trace << QString("visit ") + exp.getOperName();
+        return true;
+    }
+
+    const QStringList &getTrace() const { return m_trace; }
+
+private:
+    bool m_skipMemOf;
+    int m_abortAt;
+    QStringList m_trace;
+};
+
+
+void FusedExpVisitorTest::testSameAsSeparate()
+{
+    // m[r28 + 4] + m[r29]{-} * 8
+    SharedExp e = Binary::get(opPlus,
+                              Location::memOf(Binary::get(opPlus,
+                                                          Location::regOf(REG_PENT_ESP),
+                                                          Const::get(4))),
+                              Binary::get(opMult,
+                                          RefExp::get(Location::memOf(Location::regOf(REG_PENT_EBP)), nullptr),
+                                          Const::get(8)));
+
+    TraceVisitor single1(false, -1);
+    TraceVisitor single2(true, -1);
+    TraceVisitor single3(false, 4);
+    e->acceptVisitor(&single1);
+    e->acceptVisitor(&single2);
+    e->acceptVisitor(&single3);
+
+    TraceVisitor fused1(false, -1);
+    TraceVisitor fused2(true, -1);
+    TraceVisitor fused3(false, 4);
+    FusedExpVisitor fused({ &fused1, &fused2, &fused3 });
+    QVERIFY(e->acceptVisitor(&fused));
+
+    QCOMPARE(fused1.getTrace(), single1.getTrace());
+    QCOMPARE(fused2.getTrace(), single2.getTrace());
+    QCOMPARE(fused3.getTrace(), single3.getTrace());
+
+    // When all visitors abort, the fused visitation aborts as well
+    TraceVisitor aborting1(false, 4);
+    TraceVisitor aborting2(true, 8);
+    FusedExpVisitor allAbort({ &aborting1, &aborting2 });
+    QVERIFY(!e->acceptVisitor(&allAbort));
+}
+
+
+void FusedExpVisitorTest::testFinders()
+{
+    Assign s7(Terminal::get(opNil), Terminal::get(opNil));
+    s7.setNumber(7);
+
+    // SETFFLAGS(m[0x1000]{7}) + m[0x2000]
+    SharedExp e1 = Binary::get(opPlus,
+                               Binary::get(opFlagCall,
+                                           Const::get("SETFFLAGS"),
+                                           Binary::get(opList,
+                                                       RefExp::get(Location::memOf(Const::get(0x1000)), &s7),
+                                                       Terminal::get(opNil))),
+                               Location::memOf(Const::get(0x2000)));
+
+    // r28 + m[0x1000]{7}
+    SharedExp e2 = Binary::get(opPlus,
+                               Location::regOf(REG_PENT_ESP),
+                               RefExp::get(Location::memOf(Const::get(0x1000)), &s7));
+
+    {
+        BadMemofFinder bmf;
+        FlagsFinder ff;
+        FusedExpVisitor fused({ &bmf, &ff });
+        e1->acceptVisitor(&fused);
+
+        QVERIFY(bmf.isFound());
+        QVERIFY(ff.isFound());
+    }
+
+    {
+        BadMemofFinder bmf;
+        FlagsFinder ff;
+        FusedExpVisitor fused({ &bmf, &ff });
+        e2->acceptVisitor(&fused);
+
+        QVERIFY(!bmf.isFound());
+        QVERIFY(!ff.isFound());
+    }
+}
+
+
+QTEST_GUILESS_MAIN(FusedExpVisitorTest)
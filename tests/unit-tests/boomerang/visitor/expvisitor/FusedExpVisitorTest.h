@@ -0,0 +1,26 @@
+#pragma region License
+/*
+ * This file is part of the Boomerang Decompiler.
+ *
+ * See the file "LICENSE.TERMS" for information on usage and
+ * redistribution of this file, and for a DISCLAIMER OF ALL
+ * WARRANTIES.
+ */
+#pragma endregion License
+#pragma once
+
+
+#include "TestUtils.h"
+
+
+class FusedExpVisitorTest : public BoomerangTest
+{
+    Q_OBJECT
+
+private slots:
+    /// Each fused visitor must see the same calls as when visiting on its own
+    void testSameAsSeparate();
+
+    /// Test the fused FlagsFinder and BadMemofFinder used by statement propagation
+    void testFinders();
+};